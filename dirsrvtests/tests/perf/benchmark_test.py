@@ -0,0 +1,324 @@
+# --- BEGIN COPYRIGHT BLOCK ---
+# Copyright (C) 2026 Red Hat, Inc.
+# All rights reserved.
+#
+# License: GPL (version 3 or any later version).
+# See LICENSE for details.
+# --- END COPYRIGHT BLOCK ---
+#
+
+# Reproducible performance benchmark
+#
+# Provision a local instance with a synthetic tree (users, nested groups with
+# memberOf, a CoS, a VLV index) and run a fixed set of workloads against it.
+# The search/bind/modify workloads are driven by ldclt, the paged and VLV
+# scans (ldclt does not support these controls) by python-ldap threads.
+#
+# For each workload the throughput comes from the client and the latency
+# percentiles from the server histograms (cn=latency,cn=monitor), as the
+# difference between the histograms read before and after the workload.
+#
+# The results are written as JSON in PERF_RESULTS and, if PERF_BASELINE is
+# set, compared to a previous result file: the test fails if the throughput
+# of a workload dropped by more than PERF_TOLERANCE.
+#
+#   PERF_USERS=100000 PERF_BASELINE=baseline.json \
+#       py.test -s dirsrvtests/tests/perf/benchmark_test.py
+#
+# Environment:
+#   PERF_USERS      number of users                         (default 10000)
+#   PERF_GROUP_SIZE number of users per leaf group           (default 100)
+#   PERF_FANOUT     number of sub groups per nested group    (default 10)
+#   PERF_THREADS    client threads per workload              (default 16)
+#   PERF_ROUNDS     duration of a workload, by 10s samples   (default 3)
+#   PERF_RESULTS    result file                (default benchmark_results.json)
+#   PERF_BASELINE   baseline result file                    (default none)
+#   PERF_TOLERANCE  allowed throughput regression           (default 0.10)
+
+import json
+import logging
+import os
+import threading
+import time
+import ldap
+import pytest
+from ldap.controls import SimplePagedResultsControl
+from ldap.controls.sss import SSSRequestControl
+from ldap.controls.vlv import VLVRequestControl
+from lib389._constants import DEFAULT_SUFFIX, DN_DM, PASSWORD
+from lib389.dbgen import dbgen_users, get_index
+from lib389.index import VLVSearch, VLVIndex
+from lib389.ldclt import Ldclt
+from lib389.monitor import MonitorLatency
+from lib389.plugins import MemberOfPlugin
+from lib389.topologies import topology_st as topo
+from lib389.utils import get_ds_version
+
+pytestmark = pytest.mark.tier3
+
+log = logging.getLogger(__name__)
+
+USERS = int(os.environ.get('PERF_USERS', '10000'))
+GROUP_SIZE = int(os.environ.get('PERF_GROUP_SIZE', '100'))
+FANOUT = int(os.environ.get('PERF_FANOUT', '10'))
+THREADS = int(os.environ.get('PERF_THREADS', '16'))
+ROUNDS = int(os.environ.get('PERF_ROUNDS', '3'))
+RESULTS = os.environ.get('PERF_RESULTS', 'benchmark_results.json')
+BASELINE = os.environ.get('PERF_BASELINE')
+TOLERANCE = float(os.environ.get('PERF_TOLERANCE', '0.10'))
+
+PEOPLE = f'ou=people,{DEFAULT_SUFFIX}'
+GROUPS = f'ou=groups,{DEFAULT_SUFFIX}'
+DIGITS = len(str(USERS))
+UID_MASK = 'user' + 'X' * DIGITS
+PAGE_SIZE = 500
+VLV_WINDOW = 20
+
+# workload -> server operation type used for its latency percentiles
+WORKLOADS = {
+    'auth_storm': 'bind',
+    'uid_lookup': 'search',
+    'group_subtree_search': 'search',
+    'modify_burst': 'modify',
+    'paged_scan': 'search',
+    'vlv_scan': 'search',
+}
+
+results = {}
+
+
+def _write_groups(ldif):
+    """Nested groups: leaf groups of GROUP_SIZE users, grouped FANOUT by FANOUT
+    until a single top group contains everything.
+    """
+    level = 0
+    groups = []
+    for i in range(0, USERS, GROUP_SIZE):
+        cn = f'bgroup_0_{len(groups)}'
+        ldif.write(f'dn: cn={cn},{GROUPS}\nobjectClass: top\nobjectClass: groupOfNames\ncn: {cn}\n')
+        for u in range(i + 1, min(i + GROUP_SIZE, USERS) + 1):
+            ldif.write(f'member: uid=user{get_index(u, USERS)},{PEOPLE}\n')
+        ldif.write('\n')
+        groups.append(cn)
+    while len(groups) > 1:
+        level += 1
+        parents = []
+        for i in range(0, len(groups), FANOUT):
+            cn = f'bgroup_{level}_{len(parents)}'
+            ldif.write(f'dn: cn={cn},{GROUPS}\nobjectClass: top\nobjectClass: groupOfNames\ncn: {cn}\n')
+            for child in groups[i:i + FANOUT]:
+                ldif.write(f'member: cn={child},{GROUPS}\n')
+            ldif.write('\n')
+            parents.append(cn)
+        groups = parents
+
+
+def _write_cos(ldif):
+    """A pointer CoS providing postalCode to all the users"""
+    ldif.write(f'dn: cn=benchTemplate,{DEFAULT_SUFFIX}\nobjectClass: top\nobjectClass: extensibleObject\n'
+               f'objectClass: cosTemplate\ncn: benchTemplate\npostalCode: 94043\n\n')
+    ldif.write(f'dn: cn=benchCoS,{DEFAULT_SUFFIX}\nobjectClass: top\nobjectClass: cosSuperDefinition\n'
+               f'objectClass: cosPointerDefinition\ncn: benchCoS\n'
+               f'cosTemplateDn: cn=benchTemplate,{DEFAULT_SUFFIX}\ncosAttribute: postalCode\n\n')
+
+
+@pytest.fixture(scope="module")
+def bench(topo):
+    """Provision the instance with the synthetic tree"""
+    inst = topo.standalone
+
+    MemberOfPlugin(inst).enable()
+    vlv_search = VLVSearch(inst)
+    vlv_search.create(basedn='cn=userRoot,cn=ldbm database,cn=plugins,cn=config',
+                      properties={'objectclass': ['top', 'vlvSearch'],
+                                  'cn': 'benchSrch',
+                                  'vlvbase': PEOPLE,
+                                  'vlvfilter': '(uid=*)',
+                                  'vlvscope': str(ldap.SCOPE_SUBTREE)})
+    VLVIndex(inst).create(basedn='cn=benchSrch,cn=userRoot,cn=ldbm database,cn=plugins,cn=config',
+                          properties={'objectclass': ['top', 'vlvIndex'],
+                                      'cn': 'benchIdx',
+                                      'vlvsort': 'cn'})
+    inst.config.set('nsslapd-threadnumber', str(THREADS))
+
+    log.info(f'Generating {USERS} users ...')
+    ldif_file = os.path.join(inst.get_ldif_dir(), 'benchmark.ldif')
+    dbgen_users(inst, USERS, ldif_file, DEFAULT_SUFFIX, generic=True, parent=PEOPLE)
+    with open(ldif_file, 'a') as ldif:
+        _write_groups(ldif)
+        _write_cos(ldif)
+
+    log.info('Importing ...')
+    inst.stop()
+    assert inst.ldif2db('userRoot', None, None, None, ldif_file)
+    inst.start()
+
+    log.info('Computing memberOf ...')
+    task = MemberOfPlugin(inst).fixup(DEFAULT_SUFFIX)
+    task.wait(timeout=3600)
+    assert task.get_exit_code() == 0
+    return inst
+
+
+def _server_percentiles(before, after, optype):
+    """Percentiles (usec) of the operations run between two histogram reads"""
+    key = (optype, 'operation')
+    buckets = {}
+    for limit, count in after.get(key, {}).items():
+        delta = count - before.get(key, {}).get(limit, 0)
+        if delta > 0:
+            buckets[limit] = delta
+    total = sum(buckets.values())
+    percentiles = {}
+    for name, ratio in (('p50', 0.50), ('p90', 0.90), ('p99', 0.99), ('max', 1.0)):
+        count = 0
+        percentiles[name] = 0
+        for limit in sorted(buckets):
+            count += buckets[limit]
+            if count >= ratio * total:
+                percentiles[name] = limit
+                break
+    return percentiles
+
+
+def _python_loadtest(inst, operation):
+    """Run operation(conn, thread index) in THREADS threads for ROUNDS * 10s"""
+    deadline = time.monotonic() + ROUNDS * 10
+    counts = [0] * THREADS
+    errors = [0] * THREADS
+
+    def worker(idx):
+        conn = ldap.initialize(inst.toLDAPURL())
+        conn.simple_bind_s(DN_DM, PASSWORD)
+        while time.monotonic() < deadline:
+            try:
+                operation(conn, idx)
+                counts[idx] += 1
+            except ldap.LDAPError:
+                errors[idx] += 1
+        conn.unbind_s()
+
+    start = time.monotonic()
+    threads = [threading.Thread(target=worker, args=(i,)) for i in range(THREADS)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    total = sum(counts)
+    return {'rate': total / (time.monotonic() - start), 'total': total, 'errors': sum(errors)}
+
+
+def _paged_scan(conn, idx):
+    """Read all the users by pages of PAGE_SIZE"""
+    ctrl = SimplePagedResultsControl(True, size=PAGE_SIZE, cookie='')
+    while True:
+        msgid = conn.search_ext(PEOPLE, ldap.SCOPE_SUBTREE, '(uid=*)', ['uid', 'cn'], serverctrls=[ctrl])
+        _, _, _, rctrls = conn.result3(msgid)
+        cookies = [c.cookie for c in rctrls if c.controlType == SimplePagedResultsControl.controlType]
+        if not cookies or not cookies[0]:
+            break
+        ctrl.cookie = cookies[0]
+
+
+def _vlv_scan(conn, idx):
+    """Read a random VLV_WINDOW entries window of the users sorted by cn"""
+    vlv = VLVRequestControl(criticality=True, before_count=0, after_count=VLV_WINDOW - 1,
+                            offset=1 + (int(time.monotonic() * 1000003) % USERS), content_count=0,
+                            greater_than_or_equal=None, context_id=None)
+    sss = SSSRequestControl(criticality=True, ordering_rules=['cn'])
+    conn.search_ext_s(PEOPLE, ldap.SCOPE_SUBTREE, '(uid=*)', ['uid', 'cn'], serverctrls=[vlv, sss])
+
+
+def _run_workload(inst, workload):
+    ld = Ldclt(inst)
+    if workload == 'auth_storm':
+        return ld.bind_loadtest(PEOPLE, min=1, max=USERS, rounds=ROUNDS, threads=THREADS,
+                                stats=True, digits=DIGITS)
+    if workload == 'uid_lookup':
+        return ld.search_loadtest(PEOPLE, f'(uid={UID_MASK})', min=1, max=USERS, rounds=ROUNDS,
+                                  threads=THREADS, stats=True)
+    if workload == 'group_subtree_search':
+        return ld.search_loadtest(GROUPS, f'(member=uid={UID_MASK},{PEOPLE})', min=1, max=USERS,
+                                  rounds=ROUNDS, threads=THREADS, stats=True)
+    if workload == 'modify_burst':
+        return ld.modify_loadtest(PEOPLE, f'uid={UID_MASK}', min=1, max=USERS, rounds=ROUNDS,
+                                  threads=THREADS, stats=True)
+    if workload == 'paged_scan':
+        return _python_loadtest(inst, _paged_scan)
+    if workload == 'vlv_scan':
+        return _python_loadtest(inst, _vlv_scan)
+    raise ValueError(workload)
+
+
+@pytest.mark.parametrize('workload', list(WORKLOADS))
+def test_benchmark(bench, workload):
+    """Run a benchmark workload
+
+    :id: 5d0b7a3e-1c4f-4e92-8a61-2f9d3c7b8e10
+    :parametrized: yes
+    :setup: Standalone instance provisioned with the synthetic tree
+    :steps:
+        1. Read the server latency histograms
+        2. Run the workload
+        3. Read the server latency histograms again
+    :expectedresults:
+        1. Success
+        2. Operations were run
+        3. Success
+    """
+    monitor = MonitorLatency(bench)
+    before = monitor.get_histograms()
+    stats = _run_workload(bench, workload)
+    after = monitor.get_histograms()
+
+    stats['latency_us'] = _server_percentiles(before, after, WORKLOADS[workload])
+    log.info(f'{workload}: {stats}')
+    results[workload] = stats
+    assert stats['total'] > 0
+
+
+def test_benchmark_baseline(bench):
+    """Write the results and compare them to the baseline
+
+    :id: 8f2c4e61-7a3b-4d05-9e18-6b1a0c5d2f47
+    :setup: Standalone instance, test_benchmark has run
+    :steps:
+        1. Write the results in PERF_RESULTS
+        2. Compare the throughputs with the PERF_BASELINE ones
+    :expectedresults:
+        1. Success
+        2. No workload throughput dropped by more than PERF_TOLERANCE
+    """
+    report = {
+        'version': get_ds_version(bench.ds_paths),
+        'users': USERS,
+        'threads': THREADS,
+        'rounds': ROUNDS,
+        'workloads': results,
+    }
+    with open(RESULTS, 'w') as f:
+        json.dump(report, f, indent=4, sort_keys=True)
+    log.info(f'Results written in {RESULTS}')
+
+    if BASELINE is None:
+        pytest.skip('PERF_BASELINE is not set')
+    with open(BASELINE, 'r') as f:
+        baseline = json.load(f)
+    regressions = []
+    for workload, stats in baseline['workloads'].items():
+        if workload not in results:
+            continue
+        ratio = results[workload]['rate'] / stats['rate'] if stats['rate'] else 1.0
+        log.info(f"{workload}: {results[workload]['rate']:.2f} ops/s vs {stats['rate']:.2f} ops/s "
+                 f"baseline ({ratio:.2%}), p99 {results[workload]['latency_us']['p99']} us vs "
+                 f"{stats['latency_us']['p99']} us")
+        if ratio < 1.0 - TOLERANCE:
+            regressions.append(workload)
+    assert not regressions, f'Throughput regression for {regressions}'
+
+
+if __name__ == '__main__':
+    # Run isolated
+    # -s for DEBUG mode
+    CURRENT_FILE = os.path.realpath(__file__)
+    pytest.main("-s %s" % CURRENT_FILE)
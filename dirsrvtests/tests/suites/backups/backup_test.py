@@ -23,6 +23,7 @@ from lib389.dbgen import dbgen_users
 from lib389.tasks import BackupTask, RestoreTask
 from lib389.config import BDB_LDBMConfig
 from lib389.idm.nscontainer import nsContainers
+from lib389.idm.user import UserAccounts
 from lib389 import DSEldif
 from lib389.utils import ds_is_older, get_default_db_lib
 from lib389.replica import ReplicationManager
@@ -389,6 +390,89 @@ def test_online_backup_and_dse_write(topo):
     event.clear()
 
 
+@pytest.mark.skipif(get_default_db_lib() != "mdb", reason="Incremental backups need lmdb")
+def test_incremental_backup(topo):
+    """Test a chain of incremental backups and its restore
+
+    :id: 6b0c3e52-8a4f-11f0-9d1e-482ae39447e5
+    :setup: One standalone instance
+    :steps:
+        1. Perform a full backup
+        2. Add some users then perform an incremental backup based on the full one
+        3. Check that the incremental backup only contains the changed blocks
+        4. Add some users then perform an incremental backup based on the previous one
+        5. Delete all the test users
+        6. Restore the last incremental backup
+        7. Check that all the test users are back
+        8. Check that an incremental backup based on itself is rejected
+    :expectedresults:
+        1. Success
+        2. Success
+        3. The backup has a delta file and no data.mdb
+        4. Success
+        5. Success
+        6. Success
+        7. Success
+        8. The backup task fails
+    """
+    inst = topo.standalone
+    users = UserAccounts(inst, DEFAULT_SUFFIX)
+    bak_full = os.path.join(inst.ds_paths.backup_dir, 'incr_full')
+    bak_incr1 = os.path.join(inst.ds_paths.backup_dir, 'incr_1')
+    bak_incr2 = os.path.join(inst.ds_paths.backup_dir, 'incr_2')
+
+    # Step 1. Perform a full backup
+    task = inst.backup_online(archive=bak_full)
+    task.wait()
+    assert task.get_exit_code() == 0
+    assert os.path.isfile(os.path.join(bak_full, 'data.mdb.blocks'))
+
+    # Step 2. Add some users then perform an incremental backup
+    for i in range(20):
+        users.create_test_user(uid=5000 + i)
+    task = inst.backup_online(archive=bak_incr1, incremental_base=bak_full)
+    task.wait()
+    assert task.get_exit_code() == 0
+
+    # Step 3. Check the content of the incremental backup
+    assert os.path.isfile(os.path.join(bak_incr1, 'data.mdb.delta'))
+    assert os.path.isfile(os.path.join(bak_incr1, 'data.mdb.blocks'))
+    assert not os.path.exists(os.path.join(bak_incr1, 'data.mdb'))
+    assert os.path.getsize(os.path.join(bak_incr1, 'data.mdb.delta')) < \
+        os.path.getsize(os.path.join(bak_full, 'data.mdb'))
+
+    # Step 4. Add some users then perform a second incremental backup
+    for i in range(20, 40):
+        users.create_test_user(uid=5000 + i)
+    task = inst.backup_online(archive=bak_incr2, incremental_base=bak_incr1)
+    task.wait()
+    assert task.get_exit_code() == 0
+
+    # Step 5. Delete the test users
+    for i in range(40):
+        users.get(f'test_user_{5000 + i}').delete()
+
+    # Step 6. Restore the last incremental backup
+    task = inst.restore_online(archive=bak_incr2)
+    task.wait()
+    assert task.get_exit_code() == 0
+
+    # Step 7. Check that the test users are back
+    for i in range(40):
+        assert users.get(f'test_user_{5000 + i}').exists()
+
+    # Step 8. A backup can not be its own base
+    task = inst.backup_online(archive=bak_incr2, incremental_base=bak_incr2)
+    task.wait()
+    assert task.get_exit_code() != 0
+
+    for bak_dir in (bak_full, bak_incr1, bak_incr2):
+        shutil.rmtree(bak_dir, ignore_errors=True)
+    for user in users.list():
+        if user.rdn.startswith('test_user_5'):
+            user.delete()
+
+
 if __name__ == '__main__':
     # Run isolated
     # -s for DEBUG mode
@@ -0,0 +1,76 @@
+# --- BEGIN COPYRIGHT BLOCK ---
+# Copyright (C) 2026 Red Hat, Inc.
+# All rights reserved.
+#
+# License: GPL (version 3 or any later version).
+# See LICENSE for details.
+# --- END COPYRIGHT BLOCK ---
+
+import pytest
+from lib389.idm.account import Accounts, Account
+from lib389.topologies import topology_i2 as topology
+from lib389.backend import Backends
+from lib389._constants import DEFAULT_SUFFIX
+from lib389.plugins import ChainingBackendPlugin
+from lib389.chaining import ChainingLinks
+from lib389.mappingTree import MappingTrees
+
+pytestmark = pytest.mark.tier1
+
+
+def _histogram_total(value):
+    return sum(int(bucket.split(':')[1]) for bucket in value.split())
+
+
+def test_chaining_monitor_histograms(topology):
+    """Test the connection wait and in flight histograms of the chaining monitor
+
+    :id: 5d0f8c1e-7a43-4b52-9c1d-2e6f3a9b8d47
+    :setup: Two standalones in chaining.
+    :steps:
+        1. Configure chaining between the nodes
+        2. Do some searches through chaining
+        3. Read the monitor entry of the chaining link
+    :expectedresults:
+        1. Success
+        2. Success
+        3. Each histogram counts the operations sent to the farm server
+    """
+    st1 = topology.ins["standalone1"]
+    st2 = topology.ins["standalone2"]
+
+    # Setup st1 to chain to st2
+    for be in Backends(st1).list():
+        be.delete()
+
+    ChainingBackendPlugin(st1).enable()
+    chain = ChainingLinks(st1).create(properties={
+        'cn': 'demochain',
+        'nsslapd-suffix': DEFAULT_SUFFIX,
+        'nsmultiplexorbinddn': '',
+        'nsmultiplexorcredentials': '',
+        'nsfarmserverurl': st2.toLDAPURL(),
+    })
+
+    mts = MappingTrees(st1)
+    for mt in mts.list():
+        mt.delete()
+    mts.ensure_state(properties={
+        'cn': DEFAULT_SUFFIX,
+        'nsslapd-state': 'backend',
+        'nsslapd-backend': 'demochain',
+    })
+    st1.restart()
+
+    anon_conn = Account(st1, dn='').bind(password='')
+    accounts = Accounts(anon_conn, DEFAULT_SUFFIX)
+    searches = 5
+    for i in range(searches):
+        assert len(accounts.list()) > 0
+
+    monitor = chain.get_monitor()
+    wait = monitor.get_attr_val_utf8('nsOpConnectionWaitHistogram')
+    inflight = monitor.get_attr_val_utf8('nsOpConnectionInFlightHistogram')
+    assert wait and inflight
+    assert _histogram_total(wait) >= searches
+    assert _histogram_total(wait) == _histogram_total(inflight)
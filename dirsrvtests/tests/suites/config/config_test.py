@@ -719,6 +719,8 @@ def test_lmdb_config(create_lmdb_instance):
         7. Set a value for nsslapd-mdb-max-size and test the value is properly set
         8. Set a value for nsslapd-mdb-max-readers and test the value is properly set
         9. Set a value for nsslapd-mdb-max-dbs and test the value is properly set
+        10. Set a value for nsslapd-mdb-reindex-throttle and test the value is properly set
+        11. Set a value for nsslapd-mdb-export-threads and test the value is properly set
     :expectedresults:
         1. Success
         2. Success
@@ -729,6 +731,8 @@ def test_lmdb_config(create_lmdb_instance):
         7. Success
         8. Success
         9. Success
+        10. Success
+        11. Success
     """
 
     res = subprocess.run(('dscreate', 'create-template'), stdout=subprocess.PIPE,
@@ -756,6 +760,8 @@ def test_lmdb_config(create_lmdb_instance):
     set_and_check(inst, db_config, 'mdb_max_size', 'nsslapd-mdb-max-size', parse_size('2G'))
     set_and_check(inst, db_config, 'mdb_max_readers', 'nsslapd-mdb-max-readers', 200)
     set_and_check(inst, db_config, 'mdb_max_dbs', 'nsslapd-mdb-max-dbs', 200)
+    set_and_check(inst, db_config, 'mdb_reindex_throttle', 'nsslapd-mdb-reindex-throttle', 50)
+    set_and_check(inst, db_config, 'mdb_export_threads', 'nsslapd-mdb-export-threads', 4)
 
 
 def test_numlisteners_limit(topo):
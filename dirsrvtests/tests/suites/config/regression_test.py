@@ -7,6 +7,7 @@
 # --- END COPYRIGHT BLOCK ---
 #
 import os
+import signal
 import logging
 import pytest
 import time
@@ -16,7 +17,9 @@ from lib389.config import BDB_LDBMConfig, LDBMConfig, Config
 from lib389.backend import Backends
 from lib389.topologies import topology_st as topo
 from lib389.idm.user import UserAccounts, TEST_USER_PROPERTIES
-from lib389._constants import DEFAULT_SUFFIX, PASSWORD, DN_DM
+from lib389.idm.group import Groups
+from lib389.idm.organizationalunit import OrganizationalUnits
+from lib389._constants import DEFAULT_SUFFIX, DEFAULT_BENAME, PASSWORD, DN_DM
 
 pytestmark = pytest.mark.tier0
 
@@ -248,3 +251,160 @@ def test_instance_readonly_mode(topo):
     assert dse_mtime != new_dse_mtime
     assert inst.config.get_attr_val_utf8(RO_ATTR) == "off"
     inst.config.replace(attr, val)
+
+
+def test_outofline_values(topo):
+    """Check that the large attributes stored out of line are kept whole
+
+    :id: 6f1c2a4e-8b3d-4f0e-9a57-2d4c0e8b1f93
+    :setup: Standalone Instance
+    :steps:
+        1. Set nsslapd-outofline-values-threshold to 10 on userRoot
+        2. Create a group with 30 members
+        3. Add and remove members
+        4. Restart the instance and check the members
+        5. Export the backend and check the members in the LDIF
+        6. Disable the out of line values and restart the instance
+        7. Modify the group
+        8. Restart the instance and check the members
+    :expectedresults:
+        1. Success
+        2. Success
+        3. Success
+        4. The group has all its members
+        5. The group has all its members
+        6. The group has all its members: the values still stored out of
+           line are read
+        7. Success
+        8. The group has all its members
+    """
+
+    inst = topo.standalone
+    backend = Backends(inst).get(DEFAULT_BENAME)
+    backend.replace('nsslapd-outofline-values-threshold', '10')
+
+    members = [f'uid=member{i},ou=People,{DEFAULT_SUFFIX}' for i in range(30)]
+    groups = Groups(inst, DEFAULT_SUFFIX)
+    group = groups.create(properties={'cn': 'outofline_group', 'member': members})
+    group.add('member', f'uid=member30,ou=People,{DEFAULT_SUFFIX}')
+    group.remove('member', members[0])
+    expected = set(m.lower() for m in members[1:] + [f'uid=member30,ou=People,{DEFAULT_SUFFIX}'])
+
+    inst.restart()
+    assert set(m.lower() for m in group.get_attr_vals_utf8('member')) == expected
+
+    ldif_file = os.path.join(inst.get_ldif_dir(), 'outofline.ldif')
+    inst.stop()
+    assert inst.db2ldif(bename=DEFAULT_BENAME, suffixes=[DEFAULT_SUFFIX], excludeSuffixes=None,
+                        encrypt=False, repl_data=False, outputfile=ldif_file)
+    inst.start()
+    with open(ldif_file) as f:
+        exported = set(line.split(':', 1)[1].strip().lower() for line in f if line.lower().startswith('member:'))
+    assert expected <= exported
+
+    backend.replace('nsslapd-outofline-values-threshold', '0')
+    inst.restart()
+    assert set(m.lower() for m in group.get_attr_vals_utf8('member')) == expected
+
+    group.remove('member', members[1])
+    expected.discard(members[1].lower())
+    inst.restart()
+    assert set(m.lower() for m in group.get_attr_vals_utf8('member')) == expected
+    group.delete()
+
+
+def test_numsubordinates_in_memory(topo):
+    """Check the subordinate counts kept in memory instead of in the parent
+
+    :id: 0b7e5d2c-3f4a-4c61-8e19-a5d7b2c4e6f8
+    :setup: Standalone Instance
+    :steps:
+        1. Set nsslapd-numsubordinates-flush-interval to 2 on userRoot
+        2. Add 20 users under a new organizational unit and delete 5 of them
+        3. Check numSubordinates and hasSubordinates of the unit
+        4. Delete the unit
+        5. Wait for the flush and search (numSubordinates>=15)
+        6. Restart the instance and check numSubordinates
+        7. Delete the users and check hasSubordinates
+    :expectedresults:
+        1. Success
+        2. Success
+        3. numSubordinates is 15 and hasSubordinates is TRUE
+        4. Fails with NOT_ALLOWED_ON_NONLEAF
+        5. The unit is found
+        6. numSubordinates is 15
+        7. hasSubordinates is FALSE
+    """
+
+    inst = topo.standalone
+    backend = Backends(inst).get(DEFAULT_BENAME)
+    backend.replace('nsslapd-numsubordinates-flush-interval', '2')
+
+    ou = OrganizationalUnits(inst, DEFAULT_SUFFIX).create(properties={'ou': 'subcount'})
+    users = UserAccounts(inst, DEFAULT_SUFFIX, rdn='ou=subcount')
+    accounts = [users.create_test_user(uid=i) for i in range(20)]
+    for account in accounts[:5]:
+        account.delete()
+    assert ou.get_attr_val_int('numSubordinates') == 15
+    assert ou.get_attr_val_utf8('hasSubordinates') == 'TRUE'
+
+    with pytest.raises(ldap.NOT_ALLOWED_ON_NONLEAF):
+        ou.delete()
+
+    time.sleep(4)
+    found = inst.search_s(DEFAULT_SUFFIX, ldap.SCOPE_SUBTREE, '(&(ou=subcount)(numSubordinates>=15))', ['ou'])
+    assert len(found) == 1
+
+    inst.restart()
+    assert ou.get_attr_val_int('numSubordinates') == 15
+
+    for account in accounts[5:]:
+        account.delete()
+    assert ou.get_attr_val_utf8('hasSubordinates') == 'FALSE'
+    ou.delete()
+    backend.replace('nsslapd-numsubordinates-flush-interval', '0')
+
+
+def test_numsubordinates_after_crash(topo):
+    """Check the subordinate counts are recounted when the flush was lost
+
+    :id: 6c1f4e8a-92b3-4d57-a0e6-3b8d5f7c1a24
+    :setup: Standalone Instance
+    :steps:
+        1. Set nsslapd-numsubordinates-flush-interval to 600 on userRoot
+        2. Add 3 users under a new organizational unit
+        3. Kill the instance before the counts are flushed and start it
+        4. Check numSubordinates of the unit
+        5. Delete the unit
+        6. Delete the users and the unit
+    :expectedresults:
+        1. Success
+        2. Success
+        3. Success
+        4. numSubordinates is 3
+        5. Fails with NOT_ALLOWED_ON_NONLEAF
+        6. Success
+    """
+
+    inst = topo.standalone
+    backend = Backends(inst).get(DEFAULT_BENAME)
+    backend.replace('nsslapd-numsubordinates-flush-interval', '600')
+
+    ou = OrganizationalUnits(inst, DEFAULT_SUFFIX).create(properties={'ou': 'subcrash'})
+    users = UserAccounts(inst, DEFAULT_SUFFIX, rdn='ou=subcrash')
+    accounts = [users.create_test_user(uid=i) for i in range(3)]
+
+    with open(inst.pid_file()) as f:
+        pid = int(f.readline().strip())
+    os.kill(pid, signal.SIGKILL)
+    time.sleep(2)
+    inst.start()
+
+    assert ou.get_attr_val_int('numSubordinates') == 3
+    with pytest.raises(ldap.NOT_ALLOWED_ON_NONLEAF):
+        ou.delete()
+
+    for account in accounts:
+        account.delete()
+    ou.delete()
+    backend.replace('nsslapd-numsubordinates-flush-interval', '0')
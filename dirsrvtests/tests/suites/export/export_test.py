@@ -6,6 +6,7 @@
 # See LICENSE for details.
 # --- END COPYRIGHT BLOCK ---
 
+import gzip
 import os
 import pytest
 import subprocess
@@ -15,6 +16,8 @@ from lib389.utils import *
 from lib389.paths import Paths
 from lib389.cli_base import FakeArgs
 from lib389.cli_ctl.dbtasks import dbtasks_db2ldif
+from lib389.backend import Backends, DatabaseConfig
+from lib389.idm.user import UserAccounts
 
 pytestmark = pytest.mark.tier1
 
@@ -26,6 +29,7 @@ def run_db2ldif_and_clear_logs(topology, instance, backend, ldif, output_msg, en
     args.encrypted = encrypt
     args.replication = repl
     args.ldif = ldif
+    args.gzip = False
 
     dbtasks_db2ldif(instance, topology.logcap.log, args)
 
@@ -133,3 +137,106 @@ def test_dbtasks_db2ldif_with_non_accessible_ldif_file_path_output(topo):
 
     log.info("Restarting the instance...")
     topo.standalone.start()
+
+
+@pytest.mark.skipif(get_default_db_lib() != "mdb", reason="Parallel export is only supported by lmdb")
+def test_parallel_export(topo):
+    """Check that the export threads produce the same ldif as the serial export
+
+    :id: 3e0c1f4a-8d52-4b7e-9f61-2a7c5d9e4b13
+    :setup: Standalone Instance
+    :steps:
+        1. Add entries
+        2. Export with nsslapd-mdb-export-threads set to 0
+        3. Export with nsslapd-mdb-export-threads set to 4
+        4. Export with gzip compression
+        5. Export in a .gz file without gzip compression
+        6. Compare the exported ldif files
+    :expectedresults:
+        1. Success
+        2. Success
+        3. Success
+        4. Success
+        5. Success
+        6. The ldif files are identical, only the one exported with
+           compression is compressed
+    """
+    inst = topo.standalone
+    users = UserAccounts(inst, DEFAULT_SUFFIX)
+    for i in range(1500):
+        users.create_test_user(uid=3800 + i)
+    db_config = DatabaseConfig(inst)
+
+    def export(threads, ldif, compress=False):
+        db_config.replace('nsslapd-mdb-export-threads', str(threads))
+        inst.stop()
+        assert inst.db2ldif(bename=DEFAULT_BENAME, suffixes=None, excludeSuffixes=None,
+                            encrypt=False, repl_data=False, outputfile=ldif, gzip=compress)
+        inst.start()
+
+    serial_ldif = os.path.join(inst.get_ldif_dir(), 'serial_export.ldif')
+    parallel_ldif = os.path.join(inst.get_ldif_dir(), 'parallel_export.ldif')
+    gz_ldif = os.path.join(inst.get_ldif_dir(), 'parallel_export.ldif.gz')
+    plain_gz_ldif = os.path.join(inst.get_ldif_dir(), 'plain_export.ldif.gz')
+    export(0, serial_ldif)
+    export(4, parallel_ldif)
+    export(0, gz_ldif, compress=True)
+    export(0, plain_gz_ldif)
+    db_config.replace('nsslapd-mdb-export-threads', '0')
+
+    with open(serial_ldif, 'rb') as f:
+        serial = f.read()
+    with open(parallel_ldif, 'rb') as f:
+        assert f.read() == serial
+    with gzip.open(gz_ldif, 'rb') as f:
+        assert f.read() == serial
+    with open(plain_gz_ldif, 'rb') as f:
+        assert f.read() == serial
+    assert serial.count(b'\ndn: ') >= 1500
+
+
+@pytest.mark.skipif(get_default_db_lib() != "mdb", reason="Compressed export is only supported by lmdb")
+def test_gzip_export_import(topo):
+    """Check that a gzip compressed export can be imported back
+
+    :id: 8b5d2e71-4c09-4f3a-a6de-1f0b7c93e25a
+    :setup: Standalone Instance
+    :steps:
+        1. Add entries
+        2. Export the backend with the gzip option of the export task
+        3. Delete the entries
+        4. Import the compressed ldif file
+        5. Check the entries
+    :expectedresults:
+        1. Success
+        2. Success, the ldif file is gzip compressed
+        3. Success
+        4. Success
+        5. The entries are back
+    """
+    inst = topo.standalone
+    users = UserAccounts(inst, DEFAULT_SUFFIX)
+    uids = [str(5800 + i) for i in range(200)]
+    for uid in uids:
+        users.create_test_user(uid=int(uid))
+    backend = Backends(inst).get(DEFAULT_BENAME)
+
+    ldif = os.path.join(inst.get_ldif_dir(), 'gzip_export.ldif.gz')
+    task = backend.export_ldif(ldif=ldif, gzip=True)
+    task.wait()
+    assert task.get_exit_code() == 0
+    with gzip.open(ldif, 'rb') as f:
+        data = f.read()
+    for uid in uids:
+        assert f'dn: uid=test_user_{uid},'.encode() in data
+
+    for user in users.list():
+        if user.get_attr_val_utf8('uidNumber') in uids:
+            user.delete()
+
+    task = backend.import_ldif([ldif])
+    task.wait()
+    assert task.get_exit_code() == 0
+    found = [user.get_attr_val_utf8('uidNumber') for user in UserAccounts(inst, DEFAULT_SUFFIX).list()]
+    for uid in uids:
+        assert uid in found
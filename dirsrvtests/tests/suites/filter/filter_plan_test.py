@@ -0,0 +1,97 @@
+# --- BEGIN COPYRIGHT BLOCK ---
+# Copyright (C) 2026 Red Hat, Inc.
+# All rights reserved.
+#
+# License: GPL (version 3 or any later version).
+# See LICENSE for details.
+# --- END COPYRIGHT BLOCK ---
+#
+"""Test the cost-based ordering of the AND filter components"""
+
+import logging
+import time
+import pytest
+from lib389._constants import DEFAULT_SUFFIX
+from lib389._mapped_object import DSLdapObjects
+from lib389.config import LDBMConfig
+from lib389.dirsrv_log import DirsrvAccessLog
+from lib389.idm.user import UserAccounts
+from lib389.topologies import topology_st
+
+pytestmark = pytest.mark.tier1
+
+log = logging.getLogger(__name__)
+
+NB_USERS = 12
+
+
+@pytest.fixture(scope="function")
+def plan_users(topology_st, request):
+    inst = topology_st.standalone
+    users = UserAccounts(inst, DEFAULT_SUFFIX)
+    created = []
+    for i in range(NB_USERS):
+        created.append(users.create(properties={
+            'uid': f'plan{i}',
+            'cn': f'plan{i}',
+            'sn': f'plan{i}',
+            'uidNumber': str(5000 + i),
+            'gidNumber': '5000',
+            'homeDirectory': f'/home/plan{i}',
+            'telephoneNumber': '5551234',
+            'description': 'planned' if i % 2 else 'unplanned'}))
+
+    def fin():
+        for user in created:
+            user.delete()
+    request.addfinalizer(fin)
+
+    return created
+
+
+def test_and_filter_plan(topology_st, plan_users):
+    """Test that an AND filter stops reading the indexes of the
+    components that are far less selective than the candidates
+
+    :id: 0d4b9f3e-6a71-4c2e-8f5a-2b7e1c9d4a06
+    :setup: Standalone Instance
+    :steps:
+        1. Enable nsslapd-search-filter-planning
+        2. Search with an AND filter mixing an indexed and
+           an unindexed component
+        3. Check the returned entries
+        4. Check the access log notes of the search
+        5. Disable nsslapd-search-filter-planning and search again
+    :expectedresults:
+        1. Success
+        2. Success
+        3. Only the entries matching both components are returned
+        4. The search is logged with notes=U,C
+        5. The same entries are returned and the search is not planned
+    """
+    inst = topology_st.standalone
+    inst.config.set("nsslapd-accesslog-logbuffering", "off")
+    access_log = DirsrvAccessLog(inst)
+    ldbm_config = LDBMConfig(inst)
+    ldbm_config.replace('nsslapd-search-filter-planning', 'on')
+
+    r_init = access_log.match(r'.*notes=U,C.*')
+
+    log.info("Search the entries with the AND filter")
+    raw_objects = DSLdapObjects(inst, basedn=DEFAULT_SUFFIX)
+    entries = raw_objects.filter("(&(telephoneNumber=5551234)(description=planned))")
+    assert len(entries) == NB_USERS // 2
+    for entry in entries:
+        assert entry.get_attr_val_utf8('description') == 'planned'
+
+    log.info("Check the search was planned")
+    time.sleep(.5)
+    r_plan = access_log.match(r'.*notes=U,C.*')
+    assert len(r_init) + 1 == len(r_plan)
+
+    log.info("Check planning can be turned off")
+    ldbm_config.replace('nsslapd-search-filter-planning', 'off')
+    entries = raw_objects.filter("(&(telephoneNumber=5551234)(description=planned))")
+    assert len(entries) == NB_USERS // 2
+    time.sleep(.5)
+    assert len(access_log.match(r'.*notes=U,C.*')) == len(r_plan)
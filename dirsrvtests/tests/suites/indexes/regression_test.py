@@ -27,7 +27,7 @@ from lib389.plugins import MemberOfPlugin
 from lib389.properties import TASK_WAIT
 from lib389.tasks import Tasks, Task
 from lib389.topologies import topology_st as topo
-from lib389.utils import ds_is_older
+from lib389.utils import ds_is_older, get_default_db_lib
 
 pytestmark = pytest.mark.tier1
 
@@ -594,6 +594,55 @@ def test_reindex_extended_matching_rule(topo, add_backend_and_ldif_50K_users):
     ) == 0
 
 
+@pytest.mark.skipif(get_default_db_lib() != "mdb", reason="The writer batches are lmdb specific")
+def test_online_reindex_batches(topo, add_backend_and_ldif_50K_users):
+    """Check an online reindex spanning many writer txns while the backend is updated
+
+    :id: 3e9d6a41-7c2b-4f08-b5e1-d84a0f6c92b7
+    :setup: Standalone instance + a second backend with 50K users
+    :steps:
+        1. Set nsslapd-mdb-reindex-throttle to 50
+        2. Start a reindex of objectclass, uid, cn and sn without waiting for it
+        3. Modify the sn of 20 users and add 20 users while the reindex runs
+        4. Wait for the reindex task
+        5. Search the entries through the reindexed attributes
+    :expectedresults:
+        1. Success
+        2. Success
+        3. Success
+        4. The task succeeds
+        5. The keys shared by all the entries span the writer txns without
+           losing an id, and the live updates are indexed
+    """
+
+    inst = topo.standalone
+    DatabaseConfig(inst).set([('nsslapd-mdb-reindex-throttle', '50')])
+
+    tasks = Tasks(inst)
+    assert tasks.reindex(
+        suffix=SUFFIX2,
+        attrname=['objectclass', 'uid', 'cn', 'sn'],
+    ) == 0
+
+    for i in range(1, 21):
+        UserAccount(inst, f'uid=user{i:05d},ou=people,{SUFFIX2}').replace('sn', 'reindexed')
+    users = UserAccounts(inst, SUFFIX2, rdn=None)
+    for i in range(1, 21):
+        users.create_test_user(uid=i, gid=i)
+
+    (done, exitcode, warningcode) = inst.tasks.checkTask(tasks.entry, True)
+    assert exitcode == 0
+
+    assert len(inst.search_s(SUFFIX2, ldap.SCOPE_SUBTREE, '(objectclass=inetorgperson)', ['dn'])) == 50020
+    assert len(inst.search_s(SUFFIX2, ldap.SCOPE_SUBTREE, '(uid=user*)', ['dn'])) == 50000
+    assert len(inst.search_s(SUFFIX2, ldap.SCOPE_SUBTREE, '(uid=test_user_*)', ['dn'])) == 20
+    assert len(inst.search_s(SUFFIX2, ldap.SCOPE_SUBTREE, '(cn=user49999)', ['dn'])) == 1
+    assert len(inst.search_s(SUFFIX2, ldap.SCOPE_SUBTREE, '(sn=reindexed)', ['dn'])) == 20
+    assert len(inst.search_s(SUFFIX2, ldap.SCOPE_SUBTREE, '(&(uid=user00001)(sn=reindexed))', ['dn'])) == 1
+
+    DatabaseConfig(inst).set([('nsslapd-mdb-reindex-throttle', '0')])
+
+
 def test_update_eq_index_after_deleting_and_readding_attribute_in_one_step(topo):
     """ Test that 'eq' index is properly updated
     when deleting and re-adding an attribute in one step
@@ -759,6 +808,102 @@ def test_update_eq_index_after_deleting_and_readding_attribute_in_one_step(topo)
         assert False
 
 
+def test_positional_substring_index(topo):
+    """Check the substring searches with a positional substring index
+
+    :id: 5e3b9a1c-7f24-4d86-b0c5-2a8e61d4f973
+    :setup: Standalone instance
+    :steps:
+        1. Create a sub index with nsSubStrPositional on description
+        2. Enable nsslapd-search-bypass-filter-test
+        3. Add users with single and multi-valued descriptions, some of them
+           holding the n-grams of the assertions in the wrong order or at
+           the wrong position
+        4. Reindex description
+        5. Run substring searches with initial, any and final components
+        6. Modify and delete description values, search again
+    :expectedresults:
+        1. Success
+        2. Success
+        3. Success
+        4. Success
+        5. Only the entries matching the filter are returned, including when
+           the n-grams of the assertion are spread across several values,
+           are not adjacent or do not hold the anchors
+        6. The positional keys of the old values are removed
+    """
+    inst = topo.standalone
+    attr = 'description'
+    backend = Backends(inst).get(DEFAULT_BENAME)
+    indexes = backend.get_indexes()
+    try:
+        indexes.get(attr).delete()
+    except ldap.NO_SUCH_OBJECT:
+        pass
+    index = indexes.create(properties={
+        'cn': attr,
+        'nsSystemIndex': 'false',
+        'nsIndexType': ['eq', 'sub'],
+        })
+    index.add('objectClass', 'extensibleObject')
+    index.replace('nsSubStrPositional', 'on')
+    # Restart needed with lmdb (to open the dbi handle)
+    inst.restart()
+
+    # The candidates of an exact positional lookup are not filter tested
+    db_config = DatabaseConfig(inst)
+    bypass = db_config.get_attr_val_utf8('nsslapd-search-bypass-filter-test')
+    db_config.replace('nsslapd-search-bypass-filter-test', 'on')
+
+    users = UserAccounts(inst, DEFAULT_SUFFIX)
+    values = {
+        1: ['John Smith'],
+        2: ['Smithers'],
+        3: ['Goldsmith'],
+        4: ['smi', 'thereof'],              # n-grams of "smith" in two values
+        5: ['Sam Ithaca smile'],            # n-grams of "smith" not in order
+        6: ['blacksmith and locksmith'],
+        7: ['ith mit smi'],                 # all the n-grams of "smith", in reverse order
+        8: ['smitten with'],                # "smi" and "mit" adjacent, "ith" elsewhere
+        9: ['xsmithx'],                     # "smith" neither initial nor final
+    }
+    created = []
+    for uid, vals in values.items():
+        user = users.create_test_user(uid=2000 + uid)
+        user.replace(attr, vals)
+        created.append(user)
+    backend.reindex(attrs=[attr], wait=True)
+
+    def search(filt):
+        # a single substring filter, the filter test may be skipped
+        entries = inst.search_s(DEFAULT_SUFFIX, ldap.SCOPE_SUBTREE, f'({filt})', ['uid'])
+        uids = [e.getValue('uid').decode() for e in entries if e.hasAttr('uid')]
+        return sorted(int(uid[len('test_user_'):]) - 2000 for uid in uids if uid.startswith('test_user_2'))
+
+    assert search(f'{attr}=*smith*') == [1, 2, 3, 6, 9]
+    assert search(f'{attr}=smith*') == [2]
+    assert search(f'{attr}=*smith') == [1, 3, 6]
+    assert search(f'{attr}=*smi*th*') == [1, 2, 3, 6, 8, 9]
+    assert search(f'{attr}=black*lock*') == [6]
+    assert search(f'{attr}=*smith*smith') == [6]
+    assert search(f'{attr}=*john smith*') == [1]
+    assert search(f'{attr}=*ith*smi*') == [5, 6, 7]
+    assert search(f'{attr}=*mith*') == [1, 2, 3, 6, 9]
+    assert search(f'{attr}=ith*') == [7]
+    assert search(f'{attr}=*with') == [8]
+
+    created[0].replace(attr, 'Jane Doe')
+    created[3].remove(attr, 'thereof')
+    assert search(f'{attr}=*smith*') == [2, 3, 6, 9]
+    assert search(f'{attr}=*doe') == [1]
+    assert search(f'{attr}=smi*') == [2, 4, 8]
+
+    for user in created:
+        user.delete()
+    index.delete()
+    db_config.replace('nsslapd-search-bypass-filter-test', bypass)
+
+
 if __name__ == "__main__":
     # Run isolated
     # -s for DEBUG mode
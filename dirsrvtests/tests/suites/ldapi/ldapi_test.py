@@ -9,9 +9,11 @@
 import logging
 import pytest
 import os
+import pwd
 import subprocess
 from lib389._constants import DEFAULT_SUFFIX, DN_DM
 from lib389.idm.user import UserAccounts
+from lib389.monitor import Monitor
 from lib389.ldapi import LDAPIMapping, LDAPIFixedMapping
 from lib389.topologies import topology_st as topo
 from lib389.tasks import LDAPIMappingReloadTask
@@ -155,6 +157,75 @@ def test_ldapi_authdn_attr_rewrite(topo, request):
     assert topo.standalone.ds_access_log.match(f'.*AUTOBIND dn="{LDAP_ENTRY_DN3}".*')
 
 
+def test_ldapi_autobind_cache(topo, request):
+    """Test the autobind reuses the entry a uid/gid was mapped to
+
+    :id: 0b6f2d1c-93e4-4c8a-b7d5-61a2f4e8c930
+    :setup: Standalone Instance
+    :steps:
+        1. Set LDAPI configuration to map the uid/gid to entries
+        2. Create an OS user and the LDAP entry with its uid/gid
+        3. Do two LDAPI ldapsearch as the OS user
+        4. Check the monitor
+        5. Change the uidNumber of the LDAP entry
+        6. Do an LDAPI ldapsearch as the OS user
+    :expectedresults:
+        1. Success
+        2. Success
+        3. Both searches are bound as the LDAP entry
+        4. The second bind was found in the autobind cache
+        5. Success
+        6. The search is not bound as the LDAP entry anymore
+    """
+
+    LINUX_USER = "ldapi_test_lib389_cache"
+    LINUX_PWD = "5ecret_137"
+    LDAP_ENTRY_DN = "uid=test_ldapi_cache,ou=people,dc=example,dc=com"
+
+    def fin():
+        subprocess.run(['userdel', '-r', LINUX_USER])
+    request.addfinalizer(fin)
+
+    # Must be root
+    if os.geteuid() != 0:
+        return
+
+    inst = topo.standalone
+    inst.config.set('nsslapd-accesslog-logbuffering', 'off')
+    inst.config.set('nsslapd-ldapiautobind', 'on')
+    inst.config.set('nsslapd-ldapimaptoentries', 'on')
+    inst.config.set('nsslapd-ldapiuidnumbertype', 'uidNumber')
+    inst.config.set('nsslapd-ldapigidnumbertype', 'gidNumber')
+    inst.config.set('nsslapd-ldapientrysearchbase', DEFAULT_SUFFIX)
+    ldapi_socket = inst.config.get_attr_val_utf8('nsslapd-ldapifilepath').replace('/', '%2F')
+
+    subprocess.run(['useradd', '-u', '5010', '-p', LINUX_PWD, LINUX_USER])
+    pw = pwd.getpwnam(LINUX_USER)
+    user = UserAccounts(inst, DEFAULT_SUFFIX).create(properties={
+        'uid': 'test_ldapi_cache',
+        'cn': 'test_ldapi_cache',
+        'sn': 'test_ldapi_cache',
+        'uidNumber': str(pw.pw_uid),
+        'gidNumber': str(pw.pw_gid),
+        'homeDirectory': '/home/test_ldapi_cache'})
+    inst.deleteAccessLogs(restart=True)
+
+    ldapsearch_cmd = f'ldapsearch -b \'\' -s base -Y EXTERNAL -H ldapi://{ldapi_socket}'
+    for i in range(2):
+        os.system(f'su {LINUX_USER} -c "{ldapsearch_cmd}"')
+    assert len(inst.ds_access_log.match(f'.*AUTOBIND dn="{LDAP_ENTRY_DN}".*')) == 2
+
+    monitor = Monitor(inst)
+    assert int(monitor.get_attr_val_utf8('ldapiautobindcachehits')) >= 1
+    assert int(monitor.get_attr_val_utf8('ldapiautobindcacheentries')) >= 1
+
+    # The change flushes the cache, the uid is no longer mapped to the entry
+    user.replace('uidNumber', '5011')
+    assert int(monitor.get_attr_val_utf8('ldapiautobindcacheentries')) == 0
+    os.system(f'su {LINUX_USER} -c "{ldapsearch_cmd}"')
+    assert len(inst.ds_access_log.match(f'.*AUTOBIND dn="{LDAP_ENTRY_DN}".*')) == 2
+
+
 if __name__ == '__main__':
     # Run isolated
     # -s for DEBUG mode
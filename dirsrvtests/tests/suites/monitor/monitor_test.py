@@ -14,6 +14,8 @@ from lib389.backend import Backends, DatabaseConfig
 from lib389._constants import *
 from lib389.topologies import topology_st as topo
 from lib389._mapped_object import DSLdapObjects
+from lib389.idm.domain import Domain
+from lib389.idm.user import UserAccounts
 
 pytestmark = pytest.mark.tier1
 
@@ -177,8 +179,120 @@ def test_num_subordinates_with_monitor_suffix(topo):
     assert len(filter2) == num_subordinates_val
 
 
+def test_monitor_entry_batching(topo):
+    """Test the search entries are written in batches
+
+    :id: 6e4a9c27-1d85-4f3b-b0e2-8a7d5c93f146
+    :setup: Single instance
+    :steps:
+        1. Create some users
+        2. Search them with the default nsslapd-search-entry-batch-size
+        3. Set nsslapd-search-entry-batch-size to 0 and search them again
+    :expectedresults:
+        1. Success
+        2. The entries are written with fewer socket writes than entries
+        3. Each entry is written with its own socket write
+    """
+    inst = topo.standalone
+    users = UserAccounts(inst, DEFAULT_SUFFIX)
+    for i in range(50):
+        users.create_test_user(uid=2000 + i)
+    inst.config.replace('nsslapd-search-entry-batch-latency', '1000')
+
+    def _search_writes():
+        before = Monitor(inst).get_attrs_vals_utf8(['entrywrites', 'entriessent'])
+        assert len(users.filter('(uid=test_user_2*)')) == 50
+        after = Monitor(inst).get_attrs_vals_utf8(['entrywrites', 'entriessent'])
+        return (int(after['entrywrites'][0]) - int(before['entrywrites'][0]),
+                int(after['entriessent'][0]) - int(before['entriessent'][0]))
+
+    writes, entries = _search_writes()
+    log.info(f'batched: {writes} writes for {entries} entries')
+    assert entries >= 50
+    assert writes * 2 < entries
+
+    inst.config.replace('nsslapd-search-entry-batch-size', '0')
+    writes, entries = _search_writes()
+    log.info(f'not batched: {writes} writes for {entries} entries')
+    assert writes == entries
+
+    inst.config.replace('nsslapd-search-entry-batch-size', '16384')
+    inst.config.replace('nsslapd-search-entry-batch-latency', '20')
+    for user in users.list():
+        if user.get_attr_val_utf8('uid').startswith('test_user_2'):
+            user.delete()
+
+
 if __name__ == '__main__':
     # Run isolated
     # -s for DEBUG mode
     CURRENT_FILE = os.path.realpath(__file__)
     pytest.main("-s %s" % CURRENT_FILE)
+
+
+def test_monitor_latency(topo):
+    """Test the operation latency histograms
+
+    :id: 3b1f8e52-9d64-4a07-b2c6-7e05d1a4f9c3
+    :setup: Single instance
+    :steps:
+        1. Run some searches and a modify
+        2. Get the cn=latency,cn=monitor entry
+        3. Check the recorded phases
+    :expectedresults:
+        1. Success
+        2. Success
+        3. The searches and the modify phases are recorded and
+           the percentiles are ordered
+    """
+    inst = topo.standalone
+    for i in range(10):
+        DSLdapObjects(inst, basedn=DEFAULT_SUFFIX).filter("(objectClass=*)")
+    Domain(inst, DEFAULT_SUFFIX).replace('description', 'latency')
+
+    latencies = MonitorLatency(inst).get_latencies()
+    log.info(f'latencies: {latencies}')
+    for phase in ['operation', 'queuewait', 'candidates', 'entries', 'result']:
+        assert ('search', phase) in latencies
+        assert latencies[('search', phase)]['count'] >= 10
+    for phase in ['operation', 'txncommit']:
+        assert ('modify', phase) in latencies
+    for stat in latencies.values():
+        assert stat['p50'] <= stat['p90'] <= stat['p99']
+
+
+def test_monitor_bind_crypto(topo):
+    """Test the bind password verification statistics
+
+    :id: 8c2e4d71-5a3f-4b96-a0d8-19f6c7e2b4a5
+    :setup: Single instance
+    :steps:
+        1. Create a user and bind as this user
+        2. Get the cn=bind crypto,cn=monitor entry
+        3. Set nsslapd-bind-crypto-max-pending
+        4. Bind as the user again
+    :expectedresults:
+        1. Success
+        2. The verifications are counted and none is pending
+        3. Success
+        4. Success, the limit is not reached by a single bind
+    """
+    inst = topo.standalone
+    users = UserAccounts(inst, DEFAULT_SUFFIX)
+    user = users.create_test_user(uid=1036)
+    user.set('userPassword', 'password')
+    user.bind('password')
+
+    status = MonitorBindCrypto(inst).get_status()
+    log.info(f'bind crypto: {status}')
+    assert status['verifications'] >= 1
+    assert status['pending'] == 0
+    assert status['maxPending'] == 0
+
+    inst.config.replace('nsslapd-bind-crypto-max-pending', '4')
+    user.bind('password')
+    status = MonitorBindCrypto(inst).get_status()
+    assert status['maxPending'] == 4
+    assert status['rejected'] == 0
+    inst.config.replace('nsslapd-bind-crypto-max-pending', '0')
+    user.delete()
@@ -1271,6 +1271,74 @@ def test_search_stress_abandon(create_40k_users, create_user):
         paged_search(conn, create_40k_users.suffix, [req_ctrl], search_flt, searchreq_attrlist, abandon_rate=abandon_rate)
 
 
+def test_search_resume_after_reconnect(topology_st, create_user):
+    """Verify that a simple paged search can be resumed from a new
+    connection of the same user
+
+    :id: 9b7e2f41-6c3a-4d58-8e1f-2a5c7d90b364
+    :setup: Standalone instance, test user for binding,
+            varying number of users for the search base
+    :steps:
+        1. Bind as test user and get the first page of a paged search
+        2. Close the connection
+        3. Bind as test user on a new connection and send the search
+           with the cookie of the first page
+        4. Send the cookie from another identity
+        5. Check the paged results cursors in cn=monitor
+    :expectedresults:
+        1. Search should be successfully initiated
+        2. Success
+        3. The search goes on with the entries not returned yet
+        4. The cookie is refused
+        5. The resumed search is counted
+    """
+
+    users_num = 20
+    page_size = 5
+    users_list = add_users(topology_st, users_num, DEFAULT_SUFFIX)
+    search_flt = r'(uid=test*)'
+    searchreq_attrlist = ['dn', 'sn']
+    inst = topology_st.standalone
+
+    try:
+        conn = create_user.bind(TEST_USER_PWD)
+        req_ctrl = SimplePagedResultsControl(True, size=page_size, cookie='')
+        msgid = conn.search_ext(DEFAULT_SUFFIX, ldap.SCOPE_SUBTREE,
+                                search_flt, searchreq_attrlist, serverctrls=[req_ctrl])
+        rtype, first_page, rmsgid, rctrls = conn.result3(msgid)
+        cookie = [c for c in rctrls if c.controlType == SimplePagedResultsControl.controlType][0].cookie
+        assert len(first_page) == page_size
+        assert cookie
+        conn.unbind_s()
+
+        # The cookie does not resume the search of another identity
+        req_ctrl.cookie = cookie
+        with pytest.raises(ldap.LDAPError):
+            msgid = inst.search_ext(DEFAULT_SUFFIX, ldap.SCOPE_SUBTREE,
+                                    search_flt, searchreq_attrlist, serverctrls=[req_ctrl])
+            inst.result3(msgid)
+
+        conn = create_user.bind(TEST_USER_PWD)
+        dns = [dn for dn, attrs in first_page]
+        while cookie:
+            req_ctrl.cookie = cookie
+            msgid = conn.search_ext(DEFAULT_SUFFIX, ldap.SCOPE_SUBTREE,
+                                    search_flt, searchreq_attrlist, serverctrls=[req_ctrl])
+            rtype, rdata, rmsgid, rctrls = conn.result3(msgid)
+            dns += [dn for dn, attrs in rdata]
+            cookie = [c for c in rctrls if c.controlType == SimplePagedResultsControl.controlType][0].cookie
+        conn.unbind_s()
+
+        assert len(dns) == users_num
+        assert len(set(dns)) == users_num
+
+        monitor = inst.search_s('cn=monitor', ldap.SCOPE_BASE, '(objectclass=*)',
+                                ['pagedresultscursorsresumed'])[0]
+        assert int(monitor.getValue('pagedresultscursorsresumed')) >= 1
+    finally:
+        del_users(users_list)
+
+
 if __name__ == '__main__':
     # Run isolated
     # -s for DEBUG mode
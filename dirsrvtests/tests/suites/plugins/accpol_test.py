@@ -602,6 +602,48 @@ def test_lastlogin_history_size_non_integer(topology_st, setup_account_policy_pl
         ap_config.replace('lastLoginHistorySize', str(LOGIN_HIST_SIZE_NON_INTEGER))
 
 
+def test_lastlogin_flush_interval(topology_st, setup_test_user, setup_account_policy_plugin):
+    """Verify that the login times kept in memory are visible and written back
+
+    :id: 0f3c8d2a-5e71-4b9f-a6d4-2c8e1b7f9a35
+    :setup: Standalone instance, Global account policy plugin configuration,
+            set alwaysrecordlogin to yes, and a test user.
+    :steps:
+        1. Set lastLoginFlushInterval to 3600
+        2. Bind as the test user
+        3. Search for the lastLoginTime attribute of the test user
+        4. Restart the server
+        5. Search for the lastLoginTime attribute of the test user
+        6. Set lastLoginFlushInterval back to 0
+    :expectedresults:
+        1. Success
+        2. Success
+        3. The login time of the bind is returned before it is written
+        4. Success
+        5. The login time was written when the plugin stopped
+        6. Success
+    """
+
+    USER_PW = 'password'
+
+    inst = topology_st[0]
+    user = setup_test_user
+    ap_config = setup_account_policy_plugin
+
+    ap_config.replace('lastLoginFlushInterval', '3600')
+    inst.restart()
+
+    before = time.strftime('%Y%m%d%H%M%SZ', time.gmtime(time.time() - 1))
+    user_binds(user, USER_PW, 1)
+    last_login = user.get_attr_val_utf8('lastLoginTime')
+    assert last_login is not None and last_login >= before
+
+    inst.restart()
+    assert user.get_attr_val_utf8('lastLoginTime') == last_login
+
+    ap_config.replace('lastLoginFlushInterval', '0')
+
+
 def test_glact_login(topology_st, accpol_global):
     """Verify if user account can be activated by replacing the lastLoginTime attribute.
 
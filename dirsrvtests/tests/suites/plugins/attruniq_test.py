@@ -9,6 +9,7 @@
 import pytest
 import ldap
 import logging
+import time
 from lib389.plugins import AttributeUniquenessPlugin
 from lib389.idm.user import UserAccounts
 from lib389.idm.group import Groups
@@ -154,3 +155,86 @@ def test_multiple_attr_uniqueness(topology_st):
     testuser2.delete()
     attruniq.disable()
     attruniq.delete()
+
+
+def _cache_stats(attruniq):
+    return (attruniq.get_attr_val_int('uniqueness-cache-hits'),
+            attruniq.get_attr_val_int('uniqueness-cache-misses'))
+
+
+def test_attr_uniqueness_cache(topology_st):
+    """Test that the uniqueness cache gives the same answers as the searches
+
+    :id: 5d0e9a8c-2f4b-4d55-9a34-8c1e3b6f7a21
+    :setup: Standalone instance
+    :steps:
+        1. Add a user with 'mail=non-uniq@value.net' before the plugin is enabled
+        2. Setup attribute uniqueness plugin for 'mail' with uniqueness-cache on and restart
+        3. Try adding the existing 'mail' value to another user
+        4. Add a new unique 'mail' value to the second user
+        5. Try adding that new value to the first user
+        6. Delete the second user and add its 'mail' value to the first user
+        7. Replace the 'mail' values of the first user
+        8. Add one of the replaced values to a third user
+        9. Try adding the new value of the first user to the third user
+        10. Check uniqueness-cache-hits and uniqueness-cache-misses after each step
+    :expectedresults:
+        1. Success
+        2. Success
+        3. Should raise CONSTRAINT_VIOLATION
+        4. Success
+        5. Should raise CONSTRAINT_VIOLATION
+        6. Success
+        7. Success
+        8. Success
+        9. Should raise CONSTRAINT_VIOLATION
+        10. The existing values are hits, the unused and the uncounted values
+            are misses that did not search
+    """
+    users = UserAccounts(topology_st.standalone, DEFAULT_SUFFIX)
+    testuser1 = users.create_test_user(300, 300)
+    testuser1.add('mail', MAIL_ATTR_VALUE)
+
+    attruniq = AttributeUniquenessPlugin(topology_st.standalone, dn="cn=attruniq,cn=plugins,cn=config")
+    attruniq.create(properties={'cn': 'attruniq'})
+    attruniq.add_unique_attribute('mail')
+    attruniq.add_unique_subtree(DEFAULT_SUFFIX)
+    attruniq.enable_cache()
+    attruniq.enable()
+    topology_st.standalone.restart()
+    # Let the cache be loaded, checks fall back to searches until then
+    time.sleep(5)
+    (hits, misses) = _cache_stats(attruniq)
+
+    testuser2 = users.create_test_user(400, 400)
+    with pytest.raises(ldap.CONSTRAINT_VIOLATION):
+        testuser2.add('mail', MAIL_ATTR_VALUE)
+    assert _cache_stats(attruniq) == (hits + 1, misses)
+
+    # A value nobody holds does not need a search
+    testuser2.add('mail', MAIL_ATTR_VALUE_ALT)
+    assert _cache_stats(attruniq) == (hits + 1, misses + 1)
+    with pytest.raises(ldap.CONSTRAINT_VIOLATION):
+        testuser1.add('mail', MAIL_ATTR_VALUE_ALT)
+    assert _cache_stats(attruniq) == (hits + 2, misses + 1)
+
+    # The values of a deleted entry are uncounted
+    testuser2.delete()
+    testuser1.add('mail', MAIL_ATTR_VALUE_ALT)
+    assert _cache_stats(attruniq) == (hits + 2, misses + 2)
+
+    # So are the replaced ones, while the new ones are counted
+    testuser1.replace('mail', 'replaced@value.net')
+    (hits, misses) = _cache_stats(attruniq)
+    testuser3 = users.create_test_user(500, 500)
+    testuser3.add('mail', MAIL_ATTR_VALUE)
+    assert _cache_stats(attruniq) == (hits, misses + 1)
+    with pytest.raises(ldap.CONSTRAINT_VIOLATION):
+        testuser3.add('mail', 'replaced@value.net')
+    assert _cache_stats(attruniq) == (hits + 1, misses + 1)
+
+    # Cleanup
+    testuser3.delete()
+    testuser1.delete()
+    attruniq.disable()
+    attruniq.delete()
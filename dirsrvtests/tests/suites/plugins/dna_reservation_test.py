@@ -0,0 +1,121 @@
+# --- BEGIN COPYRIGHT BLOCK ---
+# Copyright (C) 2026 Red Hat, Inc.
+# All rights reserved.
+#
+# License: GPL (version 3 or any later version).
+# See LICENSE for details.
+# --- END COPYRIGHT BLOCK ---
+#
+"""Test DNA plugin value reservation"""
+
+import logging
+import pytest
+from lib389._constants import DEFAULT_SUFFIX
+from lib389._mapped_object import DSLdapObject
+from lib389.plugins import DNAPlugin, DNAPluginConfigs
+from lib389.idm.organizationalunit import OrganizationalUnits
+from lib389.idm.user import UserAccounts
+from lib389.topologies import topology_st
+from lib389.utils import *
+
+pytestmark = pytest.mark.tier1
+
+log = logging.getLogger(__name__)
+
+
+@pytest.fixture(scope="function")
+def dna_plugin(topology_st, request):
+    inst = topology_st.standalone
+    plugin = DNAPlugin(inst)
+    ous = OrganizationalUnits(inst, DEFAULT_SUFFIX)
+    ou_people = ous.get("People")
+
+    log.info("Add dna plugin config entry with a reservation of 10 values...")
+    configs = DNAPluginConfigs(inst, plugin.dn)
+    dna_config = configs.create(properties={'cn': 'dna reservation',
+                                            'dnaType': 'uidNumber',
+                                            'dnaMaxValue': '1000',
+                                            'dnaMagicRegen': '-1',
+                                            'dnaFilter': '(objectclass=posixAccount)',
+                                            'dnaScope': ou_people.dn,
+                                            'dnaNextValue': '1',
+                                            'dnaReservationSize': '10'})
+
+    log.info("Enable the DNA plugin and restart...")
+    plugin.enable()
+    inst.restart()
+
+    def fin():
+        inst.stop()
+        dse_ldif = DSEldif(inst)
+        dse_ldif.delete_dn(f'cn=dna reservation,{plugin.dn}')
+        inst.start()
+        for user in UserAccounts(inst, DEFAULT_SUFFIX).list():
+            if user.get_attr_val_utf8('uid').startswith('reserve'):
+                user.delete()
+    request.addfinalizer(fin)
+
+    return dna_config
+
+
+def _add_user(inst, idx):
+    users = UserAccounts(inst, DEFAULT_SUFFIX)
+    return users.create(properties={
+        'uid': f'reserve{idx}',
+        'cn': f'reserve{idx}',
+        'sn': f'reserve{idx}',
+        'uidNumber': '-1',  # Magic regen value
+        'gidNumber': '111',
+        'homeDirectory': f'/home/reserve{idx}'})
+
+
+def test_dna_reservation(topology_st, dna_plugin):
+    """Test that DNA only stores the next value once per reservation
+
+    :id: 5f0b7a52-1c7e-4a53-9b8e-3a1f0c6d2e41
+    :setup: Standalone Instance
+    :steps:
+        1. Add 12 users that trigger DNA to assign a value
+        2. Check the assigned values and the stored dnaNextValue
+        3. Check the allocation statistics on the config entry
+        4. Check the statistics of the range in cn=monitor
+        5. Restart the server and add another user
+    :expectedresults:
+        1. Success
+        2. Values are assigned in order, dnaNextValue is only
+           written at the start of each reservation
+        3. The statistics count every allocation and both
+           reservation writes
+        4. The monitor entry has the same statistics
+        5. The new user gets the stored dnaNextValue, no value is reused
+    """
+    inst = topology_st.standalone
+
+    log.info("Add users and check the assigned values")
+    for i in range(1, 13):
+        user = _add_user(inst, i)
+        assert user.get_attr_val_int('uidNumber') == i
+
+    # Only the 1st and the 11th allocation wrote the next value
+    assert dna_plugin.get_attr_val_int('dnaNextValue') == 21
+
+    log.info("Check the allocation statistics")
+    assert dna_plugin.get_attr_val_int('dnaAllocationCount') == 12
+    assert dna_plugin.get_attr_val_int('dnaReservationWrites') == 2
+    assert dna_plugin.get_attr_val_int('dnaReservedValue') == 21
+
+    log.info("Check the statistics published in cn=monitor")
+    monitor = DSLdapObject(inst, dn='cn=Distributed Numeric Assignment Plugin,cn=monitor')
+    ranges = {}
+    for value in monitor.get_attr_vals_utf8('dnaRangeStatistics'):
+        fields = value.split(' ', 6)
+        ranges[fields[6].lower()] = {k: int(v) for k, v in (f.split('=') for f in fields[:6])}
+    stats = ranges[dna_plugin.dn.lower()]
+    assert stats['dnaAllocationCount'] == 12
+    assert stats['dnaReservationWrites'] == 2
+    assert stats['dnaReservedValue'] == 21
+
+    log.info("Restart and check that the unused reservation is skipped")
+    inst.restart()
+    user = _add_user(inst, 13)
+    assert user.get_attr_val_int('uidNumber') == 21
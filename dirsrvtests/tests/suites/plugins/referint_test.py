@@ -12,6 +12,7 @@ Created on Dec 12, 2019
 @author: tbordaz
 '''
 import logging
+import time
 import pytest
 from lib389 import Entry
 from lib389.plugins import ReferentialIntegrityPlugin
@@ -142,6 +143,58 @@ def test_invalid_referint_log(topo):
     assert inst.status()
 
 
+def test_referint_delayed_batch(topo):
+    """Deleted entries queued by the delayed update thread are removed
+    from the groups in batches and the queue state is published
+
+    :id: 2c7f5b0e-8d4a-4f2e-9a63-5b1d7c0e4f18
+    :setup: Standalone Instance
+    :steps:
+        1. Set the referint update delay
+        2. Create a group with 20 members
+        3. Delete all the members
+        4. Wait for the delayed updates to be processed
+        5. Check the queue statistics on the plugin entry
+    :expectedresults:
+        1. Success
+        2. Success
+        3. Success
+        4. The group has no member left
+        5. The queue is empty and all 20 updates were processed
+    """
+
+    inst = topo.standalone
+
+    plugin = ReferentialIntegrityPlugin(inst)
+    plugin.enable()
+    plugin.set_update_delay('2')
+    inst.restart()
+
+    users = UserAccounts(inst, DEFAULT_SUFFIX)
+    members = []
+    for i in range(20):
+        members.append(users.create_test_user(uid=3000 + i))
+    groups = Groups(inst, DEFAULT_SUFFIX)
+    group = groups.create(properties={'cn': 'batch_group',
+                                      'member': [m.dn for m in members]})
+
+    for member in members:
+        member.delete()
+
+    for _ in range(30):
+        if not group.present('member'):
+            break
+        time.sleep(1)
+    assert not group.present('member')
+
+    assert int(plugin.get_attr_val_utf8('referint-queue-depth')) == 0
+    assert int(plugin.get_attr_val_utf8('referint-processed-updates')) >= 20
+
+    group.delete()
+    plugin.set_update_delay('0')
+    inst.restart()
+
+
 if __name__ == '__main__':
     # Run isolated
     # -s for DEBUG mode
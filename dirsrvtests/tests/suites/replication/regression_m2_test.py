@@ -35,6 +35,7 @@ from lib389.replica import (
     BootstrapReplicationManager, NormalizedRidDict
 )
 from lib389.agreement import Agreements
+from lib389.backend import Backends
 from lib389 import pid_from_file
 from lib389.dseldif import *
 from lib389.tasks import Tasks
@@ -1149,6 +1150,59 @@ def test_bulk_import(preserve_topo_m2):
     assert len(users_s1) == len(users_s2)
 
 
+def test_bulk_import_batches(preserve_topo_m2):
+    """Test that a total update sending the entries by batches is working properly
+
+    :id: 0f3c9a64-8bd2-11f0-a8e5-482ae39447e5
+    :setup: Two suppliers replicated instances
+    :steps:
+        1. Generate LDIF file
+        2. Import the ldif file
+        3. Add replication_managers group
+        4. Set nsds5ReplicaTotalUpdateBatchSize on the agreement
+        5. Perform bulk import
+        6. Check that the entries were sent by batches
+        7. Check that replication is still working
+        8. Check that the replicas have the same number of users
+    :expectedresults:
+        1. Operation successful
+        2. Operation successful
+        3. Operation successful
+        4. Operation successful
+        5. Operation successful
+        6. The error log reports the number of batches
+        7. Replication should be in sync
+        8. Replicas should have same number of user entries
+    """
+    s1 = preserve_topo_m2.ms["supplier1"]
+    s2 = preserve_topo_m2.ms["supplier2"]
+    ldif_file = f'{s1.get_ldif_dir()}/db2K.ldif'
+    dbgen_users(s1, 2000, ldif_file, DEFAULT_SUFFIX)
+    s1.tasks.importLDIF(benamebase=DEFAULT_BENAME,
+                        input_file=ldif_file,
+                        args={TASK_WAIT: True})
+
+    repl = ReplicationManager(DEFAULT_SUFFIX)
+    repl._create_service_group(s1)
+    repl._create_service_account(s1, s2)
+
+    agmt = Agreements(s1).list()[0]
+    agmt.replace('nsds5ReplicaTotalUpdateBatchSize', '300')
+    agmt.begin_reinit()
+    (done, error) = agmt.wait_reinit()
+    assert done is True
+    assert error is False
+    assert s1.ds_error_log.match(r'.*The entries were sent in [0-9]+ batches.*')
+
+    repl.test_replication_topology(preserve_topo_m2)
+
+    users_s1 =  s1.search_s(DEFAULT_SUFFIX, ldap.SCOPE_SUBTREE, "(uid=*)", escapehatch='i am sure')
+    users_s2 =  s2.search_s(DEFAULT_SUFFIX, ldap.SCOPE_SUBTREE, "(uid=*)", escapehatch='i am sure')
+    log.info(f"{len(users_s1)} user entries on supplier1, {len(users_s2)} on supplier2")
+    assert len(users_s1) == len(users_s2)
+    agmt.remove_all('nsds5ReplicaTotalUpdateBatchSize')
+
+
 def check_monitoring_status(inst):
     creds = { 'binddn': DN_DM, 'bindpw': PW_DM }
     repl_monitor = ReplicationMonitor(inst)
@@ -1378,6 +1432,66 @@ def test_online_reinit_may_hang(topo_with_sigkill):
 ##############################################################################
 
 
+def test_delete_parent_with_unflushed_child(topo_m2, request):
+    """Check that URP sees the children counted in memory only
+
+    :id: 6c1f0e4a-9b2d-4d7e-a3c5-2f8e7b1d9a40
+    :setup: Two suppliers replication setup
+    :steps:
+        1. Set nsslapd-numsubordinates-flush-interval to 600 on both suppliers
+        2. Add an organizational unit on supplier1 and wait for replication
+        3. Pause replication
+        4. Add a user under the unit on supplier1
+        5. Delete the unit on supplier2
+        6. Resume replication and wait for it
+        7. Check the unit and the user on both suppliers
+    :expectedresults:
+        1. Success
+        2. Success
+        3. Success
+        4. Success
+        5. Success
+        6. Success
+        7. The unit is a glue entry and the user is not orphaned
+    """
+
+    m1 = topo_m2.ms["supplier1"]
+    m2 = topo_m2.ms["supplier2"]
+    repl = ReplicationManager(DEFAULT_SUFFIX)
+
+    log.info('Keep the subordinate counts in memory long enough for the test')
+    for inst in (m1, m2):
+        Backends(inst).get(DEFAULT_BENAME).replace('nsslapd-numsubordinates-flush-interval', '600')
+
+    ous = OrganizationalUnits(m1, DEFAULT_SUFFIX)
+    ou = ous.create(properties={'ou': 'unflushed_parent'})
+    repl.wait_for_replication(m1, m2)
+
+    topo_m2.pause_all_replicas()
+    log.info('Add a child on supplier1 and delete its parent on supplier2')
+    users = UserAccounts(m1, DEFAULT_SUFFIX, rdn='ou=unflushed_parent')
+    user = users.create_test_user(uid=1042)
+    m2.delete_s(ou.dn)
+    topo_m2.resume_all_replicas()
+    repl.wait_for_replication(m1, m2)
+    repl.wait_for_replication(m2, m1)
+
+    for inst in (m1, m2):
+        log.info('Check the parent and the child on {}'.format(inst.serverid))
+        entries = inst.search_s(ou.dn, ldap.SCOPE_BASE, '(objectclass=glue)')
+        assert len(entries) == 1
+        assert UserAccount(inst, user.dn).exists()
+
+    def fin():
+        for inst in (m1, m2):
+            Backends(inst).get(DEFAULT_BENAME).replace('nsslapd-numsubordinates-flush-interval', '0')
+        UserAccount(m1, user.dn).delete()
+        m1.delete_s(ou.dn)
+        repl.wait_for_replication(m1, m2)
+
+    request.addfinalizer(fin)
+
+
 if __name__ == '__main__':
     # Run isolated
     # -s for DEBUG mode
@@ -839,6 +839,77 @@ def test_rewriter_with_invalid_filter(topo, request):
     entries = inst.search_s(DEFAULT_SUFFIX, ldap.SCOPE_SUBTREE, "(nsrole=%s)" % role.dn)
 
 
+def test_nsrole_from_roles_index(topo, request):
+    """Check the nsrole values computed from the roles index
+
+    :id: 5b8e2f14-3c1a-4d57-9a0e-7f6b1c2d8e43
+    :setup: Standalone instance
+    :steps:
+        1. Create users with different departments and a managed role on one of them
+        2. Create filtered roles with equality, OR, AND and NOT filters and a nested role
+        3. Check the nsrole values of the users
+        4. Change the filter of a role and delete another one
+        5. Check the nsrole values of the users
+    :expectedresults:
+        1. Success
+        2. Success
+        3. Each user has exactly the roles it is a member of
+        4. Success
+        5. The nsrole values follow the role definitions
+    """
+    inst = topo.standalone
+    users = UserAccounts(inst, DEFAULT_SUFFIX)
+    user_eng = users.create_test_user(uid=1001, gid=1001)
+    user_eng.replace('description', 'eng')
+    user_sales = users.create_test_user(uid=1002, gid=1002)
+    user_sales.replace('description', 'sales')
+    user_other = users.create_test_user(uid=1003, gid=1003)
+    user_other.replace('description', 'other')
+
+    managed = ManagedRoles(inst, DEFAULT_SUFFIX).create(properties={'cn': 'index_managed'})
+    user_other.replace('nsroledn', managed.dn)
+
+    filtered_roles = FilteredRoles(inst, DEFAULT_SUFFIX)
+    eng = filtered_roles.create(properties={'cn': 'index_eng',
+                                            'nsRoleFilter': '(description=ENG)'})
+    either = filtered_roles.create(properties={'cn': 'index_either',
+                                               'nsRoleFilter': '(|(description=eng)(description=sales))'})
+    both = filtered_roles.create(properties={'cn': 'index_both',
+                                             'nsRoleFilter': '(&(description=sales)(uid=test_user_1*))'})
+    not_eng = filtered_roles.create(properties={'cn': 'index_not_eng',
+                                                'nsRoleFilter': '(&(uid=test_user_100*)(!(description=eng)))'})
+    nested = NestedRoles(inst, DEFAULT_SUFFIX).create(properties={'cn': 'index_nested',
+                                                                  'nsRoleDN': [eng.dn, managed.dn]})
+    roles = [managed, eng, either, both, not_eng, nested]
+
+    def fin():
+        for role in roles:
+            if role.exists():
+                role.delete()
+        for user in [user_eng, user_sales, user_other]:
+            user.delete()
+
+    request.addfinalizer(fin)
+
+    def nsrole(user):
+        return sorted(v.lower() for v in user.get_attr_vals_utf8('nsrole'))
+
+    def expected(*members):
+        return sorted(role.dn.lower() for role in members)
+
+    time.sleep(1)
+    assert nsrole(user_eng) == expected(eng, either, nested)
+    assert nsrole(user_sales) == expected(either, both, not_eng)
+    assert nsrole(user_other) == expected(managed, not_eng, nested)
+
+    eng.replace('nsRoleFilter', '(description=other)')
+    either.delete()
+    time.sleep(1)
+    assert nsrole(user_eng) == []
+    assert nsrole(user_sales) == expected(both, not_eng)
+    assert nsrole(user_other) == expected(managed, eng, not_eng, nested)
+
+
 if __name__ == "__main__":
     CURRENT_FILE = os.path.realpath(__file__)
     pytest.main("-s -v %s" % CURRENT_FILE)
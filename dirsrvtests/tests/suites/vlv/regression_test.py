@@ -1175,6 +1175,56 @@ def test_vlv_with_mr(vlv_setup_with_uid_mr):
 
 
 
+def test_vlv_modify_skips_unrelated_indexes(topology_st):
+    """Test the VLV index is kept right when modifying the entries
+
+    :id: 3c6f2b8e-8a1d-4f57-b0e4-6d9a2c1e7f35
+    :setup: Standalone instance.
+    :steps:
+        1. Cleanup leftover from previous tests
+        2. Add users, create a VLV sorted by cn and reindex it
+        3. Modify an attribute neither in the VLV filter nor in its sort
+        4. Modify the cn of a user
+    :expectedresults:
+        1. Should Success.
+        2. Should Success.
+        3. The VLV search order is unchanged
+        4. The user moves to the end of the VLV search
+    """
+
+    NUM_USERS = 20
+    inst = topology_st.standalone
+    cleanup(inst)
+    add_users(inst, NUM_USERS)
+
+    vlv_search, vlv_index = create_vlv_search_and_index(inst)
+    assert Tasks(inst).reindex(
+        suffix=DEFAULT_SUFFIX,
+        attrname=vlv_index.rdn,
+        args={TASK_WAIT: True},
+        vlv=True
+    ) == 0
+
+    conn = open_new_ldapi_conn(inst.serverid)
+    count = len(conn.search_s(DEFAULT_SUFFIX, ldap.SCOPE_SUBTREE, "(uid=*)"))
+    users = UserAccounts(inst, DEFAULT_SUFFIX)
+    user = users.get(f'testuser{STARTING_UID_INDEX + 5}')
+
+    user.replace('description', 'not in the vlv index')
+    check_vlv_search(conn, offset=5)
+
+    user.replace('cn', 'zzz moved to the end')
+    vlv_control = VLVRequestControl(criticality=True, before_count=0, after_count=count,
+                                    offset=1, content_count=0, greater_than_or_equal=None,
+                                    context_id=None)
+    sss_control = SSSRequestControl(criticality=True, ordering_rules=['cn'])
+    result = conn.search_ext_s(base=DEFAULT_SUFFIX, scope=ldap.SCOPE_SUBTREE,
+                               filterstr='(uid=*)', serverctrls=[vlv_control, sss_control])
+    assert len(result) == count
+    assert result[-1][0].lower() == user.dn.lower()
+    user.delete()
+
+
 if __name__ == "__main__":
     # Run isolated
     # -s for DEBUG mode
@@ -267,6 +267,7 @@ class logAnalyser:
         Set up data structures for parsing and storing log data.
         """
         self.notesA = {}
+        self.notesC = {}
         self.notesF = {}
         self.notesM = {}
         self.notesP = {}
@@ -347,6 +348,7 @@ class logAnalyser:
         self.result = {
             'result_ctr': 0,
             'notesA_ctr': 0,    # dynamically referenced
+            'notesC_ctr': 0,    # dynamically referenced
             'notesF_ctr': 0,    # dynamically referenced
             'notesM_ctr': 0,    # dynamically referenced
             'notesP_ctr': 0,    # dynamically referenced
@@ -358,6 +360,7 @@ class logAnalyser:
             'total_wtime': 0.0,
             'total_optime': 0.0,
             'notesA_map': {},
+            'notesC_map': {},
             'notesF_map': {},
             'notesM_map': {},
             'notesP_map': {},
@@ -174,6 +174,20 @@ acct_policy_entry2config(Slapi_Entry *e, acctPluginCfg *newcfg)
         }
     }
 
+    config_val = get_attr_string_val(e, CFG_LASTLOGIN_FLUSH_INTERVAL);
+    if (config_val) {
+        value = strtol(config_val, 0, 0);
+        if (value >= 0) {
+            newcfg->login_flush_interval = value;
+        } else {
+            slapi_log_err(SLAPI_LOG_WARNING, PLUGIN_NAME,
+                          "acct_policy_entry2config - Invalid value for %s: %d, "
+                          "the login times are written at each bind\n",
+                          CFG_LASTLOGIN_FLUSH_INTERVAL, value);
+        }
+        slapi_ch_free_string(&config_val);
+    }
+
     /* the default limit if not set in the acctPolicySubentry */
     config_val = get_attr_string_val(e, newcfg->limit_attr_name);
     if (config_val) {
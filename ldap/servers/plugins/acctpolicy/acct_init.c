@@ -194,13 +194,19 @@ acct_policy_start(Slapi_PBlock *pb)
         return (CALLBACK_ERR);
     }
 
+    if (acct_pending_start()) {
+        slapi_log_err(SLAPI_LOG_ERR, PLUGIN_NAME,
+                      "acct_policy_start failed to create the pending logins\n");
+        return (CALLBACK_ERR);
+    }
+
     /* Show the configuration */
     cfg = get_config();
     slapi_log_err(SLAPI_LOG_PLUGIN, PLUGIN_NAME, "acct_policy_start - config: "
                                                  "stateAttrName=%s altStateAttrName=%s specAttrName=%s limitAttrName=%s "
-                                                 "alwaysRecordLogin=%d\n",
+                                                 "alwaysRecordLogin=%d lastLoginFlushInterval=%d\n",
                   cfg->state_attr_name, cfg->alt_state_attr_name ? cfg->alt_state_attr_name : "not configured", cfg->spec_attr_name,
-                  cfg->limit_attr_name, cfg->always_record_login);
+                  cfg->limit_attr_name, cfg->always_record_login, cfg->login_flush_interval);
 
     return (CALLBACK_OK);
 }
@@ -210,6 +216,7 @@ acct_policy_close(Slapi_PBlock *pb __attribute__((unused)))
 {
     int rc = 0;
 
+    acct_pending_stop();
     slapi_destroy_rwlock(config_rwlock);
     config_rwlock = NULL;
     slapi_sdn_free(&_PluginDN);
@@ -235,7 +242,8 @@ acct_preop_init(Slapi_PBlock *pb)
     if (slapi_pblock_set(pb, SLAPI_PLUGIN_PRE_BIND_FN, (void *)acct_bind_preop) != 0 ||
         slapi_pblock_set(pb, SLAPI_PLUGIN_PRE_ADD_FN, (void *)acct_add_pre_op) != 0 ||
         slapi_pblock_set(pb, SLAPI_PLUGIN_PRE_MODIFY_FN, (void *)acct_mod_pre_op) != 0 ||
-        slapi_pblock_set(pb, SLAPI_PLUGIN_PRE_DELETE_FN, (void *)acct_del_pre_op) != 0) {
+        slapi_pblock_set(pb, SLAPI_PLUGIN_PRE_DELETE_FN, (void *)acct_del_pre_op) != 0 ||
+        slapi_pblock_set(pb, SLAPI_PLUGIN_PRE_ENTRY_FN, (void *)acct_pending_pre_entry) != 0) {
         slapi_log_err(SLAPI_LOG_ERR, PRE_PLUGIN_NAME,
                       "acct_preop_init - Failed to set plugin callback function\n");
         return (CALLBACK_ERR);
@@ -0,0 +1,297 @@
+/******************************************************************************
+Copyright (C) 2026 Red Hat, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+version 2 as published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+******************************************************************************/
+
+/*
+ * Write-behind of the login times
+ *
+ * When lastLoginFlushInterval is set, a bind does not modify the entry: the
+ * login time is kept in memory, where the inactivity check and the searches
+ * see it, and the latest login time of each entry is written back once per
+ * interval.  The writes are done by a thread of the plugin, not by the event
+ * queue thread shared with the rest of the server.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "acctpolicy.h"
+#include "slapi-plugin.h"
+#include "plhash.h"
+
+typedef struct acct_pending_login
+{
+    char *dn;
+    char *ndn;
+    char *timestr;
+} acctPendingLogin;
+
+static PLHashTable *pending_logins = NULL;
+static Slapi_Mutex *pending_lock = NULL;
+static int32_t pending_count = 0;
+static Slapi_CondVar *pending_cv = NULL;
+static PRThread *pending_flush_thread = NULL;
+static int32_t pending_stopping = 0;
+static time_t pending_last_flush = 0;
+
+static void acct_pending_flush_main(void *arg);
+
+static void
+acct_pending_login_free(acctPendingLogin **login)
+{
+    slapi_ch_free_string(&(*login)->dn);
+    slapi_ch_free_string(&(*login)->ndn);
+    slapi_ch_free_string(&(*login)->timestr);
+    slapi_ch_free((void **)login);
+}
+
+static PRIntn
+acct_pending_free_entry(PLHashEntry *he, PRIntn i __attribute__((unused)), void *arg __attribute__((unused)))
+{
+    acctPendingLogin *login = (acctPendingLogin *)he->value;
+
+    acct_pending_login_free(&login);
+    return HT_ENUMERATE_REMOVE;
+}
+
+int
+acct_pending_start(void)
+{
+    if ((pending_lock = slapi_new_mutex()) == NULL) {
+        return (CALLBACK_ERR);
+    }
+    if ((pending_cv = slapi_new_condvar(pending_lock)) == NULL) {
+        return (CALLBACK_ERR);
+    }
+    pending_logins = PL_NewHashTable(0, PL_HashString, PL_CompareStrings,
+                                     PL_CompareValues, NULL, NULL);
+    pending_last_flush = slapi_current_rel_time_t();
+    pending_stopping = 0;
+    pending_flush_thread = PR_CreateThread(PR_USER_THREAD, acct_pending_flush_main, NULL,
+                                           PR_PRIORITY_NORMAL, PR_GLOBAL_THREAD,
+                                           PR_JOINABLE_THREAD, SLAPD_DEFAULT_THREAD_STACKSIZE);
+    if (pending_flush_thread == NULL) {
+        return (CALLBACK_ERR);
+    }
+
+    return (CALLBACK_OK);
+}
+
+void
+acct_pending_stop(void)
+{
+    if (pending_lock == NULL) {
+        return;
+    }
+    if (pending_flush_thread) {
+        slapi_lock_mutex(pending_lock);
+        pending_stopping = 1;
+        slapi_notify_condvar(pending_cv, 1);
+        slapi_unlock_mutex(pending_lock);
+        PR_JoinThread(pending_flush_thread);
+        pending_flush_thread = NULL;
+    }
+
+    if (pending_logins) {
+        /* Do not lose the logins of the last interval */
+        acct_pending_flush();
+        /* and free the ones that could not be written */
+        PL_HashTableEnumerateEntries(pending_logins, acct_pending_free_entry, NULL);
+        pending_count = 0;
+        PL_HashTableDestroy(pending_logins);
+        pending_logins = NULL;
+    }
+    if (pending_cv) {
+        slapi_destroy_condvar(pending_cv);
+        pending_cv = NULL;
+    }
+    slapi_destroy_mutex(pending_lock);
+    pending_lock = NULL;
+}
+
+/*
+  Keeps the login time of an entry until the next flush, it replaces the one
+  of a previous bind
+*/
+void
+acct_pending_record(const char *dn, const char *timestr)
+{
+    Slapi_DN *sdn = slapi_sdn_new_dn_byref(dn);
+    acctPendingLogin *login;
+
+    slapi_lock_mutex(pending_lock);
+    login = (acctPendingLogin *)PL_HashTableLookup(pending_logins, slapi_sdn_get_ndn(sdn));
+    if (login) {
+        slapi_ch_free_string(&login->timestr);
+    } else {
+        login = (acctPendingLogin *)slapi_ch_calloc(1, sizeof(acctPendingLogin));
+        login->dn = slapi_ch_strdup(dn);
+        login->ndn = slapi_ch_strdup(slapi_sdn_get_ndn(sdn));
+        PL_HashTableAdd(pending_logins, login->ndn, login);
+        slapi_atomic_incr_32(&pending_count, __ATOMIC_RELEASE);
+    }
+    login->timestr = slapi_ch_strdup(timestr);
+    slapi_unlock_mutex(pending_lock);
+
+    slapi_sdn_free(&sdn);
+}
+
+/*
+  Returns a copy of the login time not yet written in the entry, NULL if
+  there is none
+*/
+char *
+acct_pending_get(const char *ndn)
+{
+    acctPendingLogin *login;
+    char *timestr = NULL;
+
+    if (slapi_atomic_load_32(&pending_count, __ATOMIC_ACQUIRE) == 0) {
+        return NULL;
+    }
+
+    slapi_lock_mutex(pending_lock);
+    login = (acctPendingLogin *)PL_HashTableLookup(pending_logins, ndn);
+    if (login) {
+        timestr = slapi_ch_strdup(login->timestr);
+    }
+    slapi_unlock_mutex(pending_lock);
+
+    return timestr;
+}
+
+static PRIntn
+acct_pending_collect(PLHashEntry *he, PRIntn i __attribute__((unused)), void *arg)
+{
+    acctPendingLogin *login = (acctPendingLogin *)he->value;
+    acctPendingLogin ***logins = (acctPendingLogin ***)arg;
+
+    **logins = (acctPendingLogin *)slapi_ch_calloc(1, sizeof(acctPendingLogin));
+    (**logins)->dn = slapi_ch_strdup(login->dn);
+    (**logins)->ndn = slapi_ch_strdup(login->ndn);
+    (**logins)->timestr = slapi_ch_strdup(login->timestr);
+    (*logins)++;
+
+    return HT_ENUMERATE_NEXT;
+}
+
+/*
+  Writes the pending login times in the entries. A login time stays visible
+  in memory until it is written, unless a newer bind replaced it meanwhile.
+*/
+void
+acct_pending_flush(void)
+{
+    acctPendingLogin **logins = NULL;
+    acctPendingLogin **next = NULL;
+    acctPendingLogin *login = NULL;
+    int32_t count, i;
+
+    slapi_lock_mutex(pending_lock);
+    pending_last_flush = slapi_current_rel_time_t();
+    count = slapi_atomic_load_32(&pending_count, __ATOMIC_ACQUIRE);
+    if (count == 0) {
+        slapi_unlock_mutex(pending_lock);
+        return;
+    }
+    next = logins = (acctPendingLogin **)slapi_ch_calloc(count, sizeof(acctPendingLogin *));
+    PL_HashTableEnumerateEntries(pending_logins, acct_pending_collect, &next);
+    slapi_unlock_mutex(pending_lock);
+
+    config_rd_lock();
+    for (i = 0; i < count; i++) {
+        if (acct_write_login(logins[i]->dn, logins[i]->timestr)) {
+            /* The entry was deleted or renamed, the login time is dropped */
+            slapi_log_err(SLAPI_LOG_PLUGIN, POST_PLUGIN_NAME,
+                          "acct_pending_flush - Dropping the login time %s of \"%s\"\n",
+                          logins[i]->timestr, logins[i]->dn);
+        }
+    }
+    config_unlock();
+
+    slapi_lock_mutex(pending_lock);
+    for (i = 0; i < count; i++) {
+        login = (acctPendingLogin *)PL_HashTableLookup(pending_logins, logins[i]->ndn);
+        if (login && (strcmp(login->timestr, logins[i]->timestr) == 0)) {
+            PL_HashTableRemove(pending_logins, login->ndn);
+            acct_pending_login_free(&login);
+            slapi_atomic_decr_32(&pending_count, __ATOMIC_RELEASE);
+        }
+        acct_pending_login_free(&logins[i]);
+    }
+    slapi_unlock_mutex(pending_lock);
+
+    slapi_ch_free((void **)&logins);
+}
+
+/*
+  Wakes up every second, the flush itself follows the configured interval so
+  that a change of the configuration applies without restarting the plugin
+*/
+static void
+acct_pending_flush_main(void *arg __attribute__((unused)))
+{
+    struct timeval tick = {1, 0};
+    int interval;
+
+    slapi_lock_mutex(pending_lock);
+    while (!pending_stopping) {
+        slapi_wait_condvar_pt(pending_cv, pending_lock, &tick);
+        if (pending_stopping) {
+            break;
+        }
+        slapi_unlock_mutex(pending_lock);
+
+        config_rd_lock();
+        interval = get_config()->login_flush_interval;
+        config_unlock();
+        if ((interval <= 0) || (slapi_current_rel_time_t() - pending_last_flush >= interval)) {
+            acct_pending_flush();
+        }
+
+        slapi_lock_mutex(pending_lock);
+    }
+    slapi_unlock_mutex(pending_lock);
+}
+
+/*
+  Search pre entry callback, returns the pending login time instead of the
+  one stored in the entry
+*/
+int
+acct_pending_pre_entry(Slapi_PBlock *pb)
+{
+    Slapi_Entry *e = NULL;
+    Slapi_Entry *ecopy = NULL;
+    char *timestr = NULL;
+
+    slapi_pblock_get(pb, SLAPI_SEARCH_ENTRY_ORIG, &e);
+    if ((e == NULL) || ((timestr = acct_pending_get(slapi_entry_get_ndn(e))) == NULL)) {
+        return SLAPI_PLUGIN_SUCCESS;
+    }
+
+    slapi_pblock_get(pb, SLAPI_SEARCH_ENTRY_COPY, &ecopy);
+    if (ecopy == NULL) {
+        ecopy = slapi_entry_dup(e);
+        slapi_pblock_set(pb, SLAPI_SEARCH_ENTRY_COPY, ecopy);
+    }
+    config_rd_lock();
+    slapi_entry_attr_set_charptr(ecopy, get_config()->always_record_login_attr, timestr);
+    config_unlock();
+    slapi_ch_free_string(&timestr);
+
+    return SLAPI_PLUGIN_SUCCESS;
+}
@@ -71,6 +71,23 @@ bail:
     return ret;
 }
 
+/*
+  Returns the value of a login state attribute, the login time of the last
+  bind when it is not yet written in the entry
+*/
+static char *
+acct_get_login_time(Slapi_Entry *target_entry, acctPluginCfg *cfg, char *attr_name)
+{
+    char *timestr = NULL;
+
+    if ((strcasecmp(attr_name, cfg->always_record_login_attr) == 0) &&
+        ((timestr = acct_pending_get(slapi_entry_get_ndn(target_entry))) != NULL)) {
+        return timestr;
+    }
+
+    return get_attr_string_val(target_entry, attr_name);
+}
+
 /*
   Checks bind entry for last login state and compares current time with last
   login time plus the limit to decide whether to deny the bind.
@@ -92,7 +109,7 @@ acct_inact_limit(Slapi_PBlock *pb, const char *dn, Slapi_Entry *target_entry, ac
         /*
          * Check both state and alternate state attributes.
          */
-        if ((lasttimestr = get_attr_string_val(target_entry, cfg->state_attr_name)) != NULL) {
+        if ((lasttimestr = acct_get_login_time(target_entry, cfg, cfg->state_attr_name)) != NULL) {
             slapi_log_err(SLAPI_LOG_PLUGIN, PRE_PLUGIN_NAME,
                           "acct_inact_limit - \"%s\" login timestamp is %s (found in attribute '%s')\n",
                           dn, lasttimestr, cfg->state_attr_name);
@@ -112,7 +129,7 @@ acct_inact_limit(Slapi_PBlock *pb, const char *dn, Slapi_Entry *target_entry, ac
 
         /* Check alternate state attribute next... */
         if (cfg->alt_state_attr_name &&
-                ((lasttimestr = get_attr_string_val(target_entry, cfg->alt_state_attr_name)) == NULL))
+                ((lasttimestr = acct_get_login_time(target_entry, cfg, cfg->alt_state_attr_name)) == NULL))
         {
             goto done;
         }
@@ -139,12 +156,12 @@ acct_inact_limit(Slapi_PBlock *pb, const char *dn, Slapi_Entry *target_entry, ac
          * Check state attribute, if not present in entry only then try
          * alternate state attribute
          */
-        if ((lasttimestr = get_attr_string_val(target_entry, cfg->state_attr_name)) != NULL) {
+        if ((lasttimestr = acct_get_login_time(target_entry, cfg, cfg->state_attr_name)) != NULL) {
             slapi_log_err(SLAPI_LOG_PLUGIN, PRE_PLUGIN_NAME,
                           "acct_inact_limit - \"%s\" login timestamp is %s (found in attribute '%s')\n",
                           dn, lasttimestr, cfg->state_attr_name);
         } else if (cfg->alt_state_attr_name &&
-            ((lasttimestr = get_attr_string_val(target_entry, cfg->alt_state_attr_name)) != NULL))
+            ((lasttimestr = acct_get_login_time(target_entry, cfg, cfg->alt_state_attr_name)) != NULL))
         {
             slapi_log_err(SLAPI_LOG_PLUGIN, PRE_PLUGIN_NAME,
                           "acct_inact_limit - \"%s\" alternate timestamp is %s (found in attribute '%s')\n",
@@ -308,11 +325,11 @@ acct_update_login_history(const char *dn, char *timestr)
 }
 
 /*
-  This is called after binds, it updates an attribute in the account
-  and the login time history.
+  Writes a login time in the account and the login time history, the caller
+  holds the config lock.
 */
-static int
-acct_record_login(const char *dn)
+int
+acct_write_login(const char *dn, char *timestr)
 {
     int ldrc;
     int rc = 0; /* Optimistic default */
@@ -320,24 +337,14 @@ acct_record_login(const char *dn)
     LDAPMod mod;
     struct berval *vals[2];
     struct berval val;
-    char *timestr = NULL;
     acctPluginCfg *cfg;
     void *plugin_id;
     Slapi_PBlock *modpb = NULL;
     int skip_mod_attrs = 1; /* value doesn't matter as long as not NULL */
 
-    config_rd_lock();
     cfg = get_config();
-
-    /* if we are not allowed to modify the state attr we're done
-         * this could be intentional, so just return
-         */
-    if (!update_is_allowed_attr(cfg->always_record_login_attr))
-        goto done;
-
     plugin_id = get_identity();
 
-    timestr = epochtimeToGentime(slapi_current_utc_time());
     val.bv_val = timestr;
     val.bv_len = strlen(val.bv_val);
 
@@ -363,13 +370,12 @@ acct_record_login(const char *dn)
 
     if (ldrc != LDAP_SUCCESS) {
         slapi_log_err(SLAPI_LOG_ERR, POST_PLUGIN_NAME,
-                      "acct_record_login - Recording %s=%s failed on \"%s\" err=%d\n", cfg->always_record_login_attr,
+                      "acct_write_login - Recording %s=%s failed on \"%s\" err=%d\n", cfg->always_record_login_attr,
                       timestr, dn, ldrc);
         rc = -1;
-        goto done;
     } else {
         slapi_log_err(SLAPI_LOG_PLUGIN, POST_PLUGIN_NAME,
-                      "acct_record_login - Recorded %s=%s on \"%s\"\n", cfg->always_record_login_attr, timestr, dn);
+                      "acct_write_login - Recorded %s=%s on \"%s\"\n", cfg->always_record_login_attr, timestr, dn);
 
         /* update login history */
         if (cfg->login_history_attr) {
@@ -377,9 +383,41 @@ acct_record_login(const char *dn)
         }
     }
 
+    slapi_pblock_destroy(modpb);
+
+    return (rc);
+}
+
+/*
+  This is called after binds, it records the login time in the account,
+  either immediately or at the next flush of the pending logins.
+*/
+static int
+acct_record_login(const char *dn)
+{
+    int rc = 0; /* Optimistic default */
+    char *timestr = NULL;
+    acctPluginCfg *cfg;
+
+    config_rd_lock();
+    cfg = get_config();
+
+    /* if we are not allowed to modify the state attr we're done
+         * this could be intentional, so just return
+         */
+    if (!update_is_allowed_attr(cfg->always_record_login_attr))
+        goto done;
+
+    timestr = epochtimeToGentime(slapi_current_utc_time());
+
+    if (cfg->login_flush_interval > 0) {
+        acct_pending_record(dn, timestr);
+    } else {
+        rc = acct_write_login(dn, timestr);
+    }
+
 done:
     config_unlock();
-    slapi_pblock_destroy(modpb);
     slapi_ch_free_string(&timestr);
 
     return (rc);
@@ -32,6 +32,7 @@ Hewlett-Packard Development Company, L.P.
 #define CFG_RECORD_LOGIN_ATTR "alwaysRecordLoginAttr"
 #define LASTLOGIN_HISTORY_ATTR "lastLoginHistory"
 #define LASTLOGIN_HISTORY_SIZE_ATTR "lastLoginHistorySize"
+#define CFG_LASTLOGIN_FLUSH_INTERVAL "lastLoginFlushInterval"
 
 #define DEFAULT_LASTLOGIN_STATE_ATTR "lastLoginTime"
 #define DEFAULT_ALT_LASTLOGIN_STATE_ATTR "createTimestamp"
@@ -65,6 +66,7 @@ typedef struct acct_plugin_cfg
     char *always_record_login_attr;
     char *login_history_attr;
     int login_history_size;
+    int login_flush_interval; /* seconds between two writes of the login times, 0 writes at each bind */
     unsigned long inactivitylimit;
     PRBool check_all_state_attrs;
 } acctPluginCfg;
@@ -99,7 +101,16 @@ void config_rd_lock(void);
 void config_wr_lock(void);
 void config_unlock(void);
 
+/* acct_pending.c */
+int acct_pending_start(void);
+void acct_pending_stop(void);
+void acct_pending_record(const char *dn, const char *timestr);
+char *acct_pending_get(const char *ndn);
+void acct_pending_flush(void);
+int acct_pending_pre_entry(Slapi_PBlock *pb);
+
 /* acc_plugins.c */
+int acct_write_login(const char *dn, char *timestr);
 int acct_add_pre_op(Slapi_PBlock *pb);
 int acct_mod_pre_op(Slapi_PBlock *pb);
 int acct_del_pre_op(Slapi_PBlock *pb);
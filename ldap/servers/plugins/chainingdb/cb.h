@@ -64,6 +64,8 @@
 #define CB_MONITOR_COMPARECOUNT "nsCompareCount"
 #define CB_MONITOR_OUTGOINGCONN "nsOpenOpConnectionCount"
 #define CB_MONITOR_OUTGOINGBINDCOUNT "nsOpenBindConnectionCount"
+#define CB_MONITOR_WAITHISTOGRAM "nsOpConnectionWaitHistogram"
+#define CB_MONITOR_INFLIGHTHISTOGRAM "nsOpConnectionInFlightHistogram"
 
 /* Global configuration */
 #define CB_CONFIG_GLOBAL_FORWARD_CTRLS "nsTransmittedControls"
@@ -230,6 +232,9 @@ typedef struct _cb_backend
 /**************  WARNING: Be careful if you want to change this constant. It is used in hexadecimal in cb_conn_stateless.c in the function PR_ThreadSelf() ************/
 #define MAX_CONN_ARRAY 2048 /* we suppose the number of threads in the server not to exceed this limit*/
 /**********************************************************************************************************/
+
+#define CB_HISTOGRAM_BUCKETS 24 /* bucket i counts the values in [2^(i-1), 2^i[, the last one the larger values */
+
 typedef struct _cb_outgoing_conn
 {
     LDAP *ld;
@@ -264,6 +269,11 @@ typedef struct
         Slapi_CondVar *conn_list_cv;
         cb_outgoing_conn *conn_list;
         unsigned int conn_list_count;
+        time_t stale_check_time; /* last scan of conn_list for the connection lifetime */
+
+        /* log2 histograms, protected by conn_list_mutex */
+        uint64_t wait_histogram[CB_HISTOGRAM_BUCKETS];     /* wait for a connection, in us */
+        uint64_t inflight_histogram[CB_HISTOGRAM_BUCKETS]; /* operations sharing the connection */
 
     } conn;
 
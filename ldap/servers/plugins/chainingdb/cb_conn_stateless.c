@@ -53,6 +53,7 @@
 
 static void cb_close_and_dispose_connection(cb_outgoing_conn *conn);
 static void cb_check_for_stale_connections(cb_conn_pool *pool);
+static void cb_histogram_add(uint64_t *histogram, uint64_t value);
 
 PRUint32 PR_GetThreadID(PRThread *thread);
 
@@ -137,9 +138,12 @@ cb_get_connection(cb_conn_pool *pool,
     int rc = LDAP_SUCCESS; /* optimistic */
     cb_outgoing_conn *conn = NULL;
     cb_outgoing_conn *connprev = NULL;
+    cb_outgoing_conn *connbest = NULL;
     LDAP *ld = NULL;
     int checktime = 0;
     struct timeval bind_to, op_to;
+    struct timeval wait_to = {1, 0};
+    struct timespec start_time, wait_time;
     unsigned int maxconcurrency, maxconnections;
     char *password, *binddn, *hostname;
     unsigned int port;
@@ -160,6 +164,7 @@ cb_get_connection(cb_conn_pool *pool,
     **   ( checked in the loop )
     */
     *cc = NULL;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
 
     slapi_rwlock_rdlock(pool->rwl_config_lock);
     maxconcurrency = pool->conn.maxconcurrency;
@@ -281,7 +286,14 @@ cb_get_connection(cb_conn_pool *pool,
                 }
             }
         } else {
+            /*
+             * Operations are pipelined on the connections, libldap matches
+             * the responses to their requests by message id. Use the least
+             * loaded connection so that a slow operation delays as few others
+             * as possible.
+             */
             connprev = NULL;
+            connbest = NULL;
             for (conn = pool->conn.conn_list; conn != NULL; conn = conn->next) {
                 if (cb_debug_on()) {
                     slapi_log_err(SLAPI_LOG_PLUGIN, CB_PLUGIN_SUBSYSTEM,
@@ -289,15 +301,20 @@ cb_get_connection(cb_conn_pool *pool,
                                   conn->status, conn->refcount);
                 }
 
-                if (conn->status == CB_CONNSTATUS_OK && conn->refcount < maxconcurrency) {
-                    if (cb_debug_on()) {
-                        slapi_log_err(SLAPI_LOG_PLUGIN, CB_PLUGIN_SUBSYSTEM,
-                                      "cb_get_connection - server found conn 0x%p to use)\n", conn);
-                    }
-                    goto unlock_and_return; /* found one */
+                if (conn->status == CB_CONNSTATUS_OK && conn->refcount < maxconcurrency &&
+                    (connbest == NULL || conn->refcount < connbest->refcount)) {
+                    connbest = conn;
                 }
                 connprev = conn;
             }
+            if (connbest) {
+                conn = connbest;
+                if (cb_debug_on()) {
+                    slapi_log_err(SLAPI_LOG_PLUGIN, CB_PLUGIN_SUBSYSTEM,
+                                  "cb_get_connection - server found conn 0x%p to use)\n", conn);
+                }
+                goto unlock_and_return; /* found one */
+            }
         }
 
         if (secure || pool->conn.conn_list_count < maxconnections) {
@@ -487,8 +504,10 @@ cb_get_connection(cb_conn_pool *pool,
                           "cb_get_connection - waiting for conn to free up\n");
         }
 
+        /* Wake up regularly to check the time limit */
         if (!secure)
-            slapi_wait_condvar_pt(pool->conn.conn_list_cv, pool->conn.conn_list_mutex, NULL);
+            slapi_wait_condvar_pt(pool->conn.conn_list_cv, pool->conn.conn_list_mutex,
+                                  checktime ? &wait_to : NULL);
 
         if (cb_debug_on()) {
             slapi_log_err(SLAPI_LOG_PLUGIN, CB_PLUGIN_SUBSYSTEM,
@@ -501,6 +520,12 @@ unlock_and_return:
         ++conn->refcount;
         *lld = conn->ld;
         *cc = conn;
+
+        clock_gettime(CLOCK_MONOTONIC, &wait_time);
+        slapi_timespec_diff(&wait_time, &start_time, &wait_time);
+        cb_histogram_add(pool->conn.wait_histogram,
+                         (uint64_t)wait_time.tv_sec * 1000000 + wait_time.tv_nsec / 1000);
+        cb_histogram_add(pool->conn.inflight_histogram, conn->refcount);
         if (cb_debug_on()) {
             slapi_log_err(SLAPI_LOG_PLUGIN, CB_PLUGIN_SUBSYSTEM,
                           "cb_get_connection - ld=0x%p (concurrency now %lu)\n", *lld, conn->refcount);
@@ -612,6 +637,19 @@ cb_release_op_connection(cb_conn_pool *pool, LDAP *lld, int dispose)
 }
 
 
+/* Counts a value in a log2 histogram of the pool, conn_list_mutex held */
+static void
+cb_histogram_add(uint64_t *histogram, uint64_t value)
+{
+    int bucket = 0;
+
+    while (value && (bucket < CB_HISTOGRAM_BUCKETS - 1)) {
+        value >>= 1;
+        bucket++;
+    }
+    histogram[bucket]++;
+}
+
 static void
 cb_close_and_dispose_connection(cb_outgoing_conn *conn)
 {
@@ -628,6 +666,7 @@ cb_check_for_stale_connections(cb_conn_pool *pool)
     time_t curtime;
     int connlifetime;
     int myself;
+    int closed = 0;
 
     slapi_rwlock_rdlock(pool->rwl_config_lock);
     connlifetime = pool->conn.connlifetime;
@@ -638,8 +677,7 @@ cb_check_for_stale_connections(cb_conn_pool *pool)
 
     slapi_lock_mutex(pool->conn.conn_list_mutex);
 
-    if (connlifetime > 0)
-        curtime = slapi_current_rel_time_t();
+    curtime = slapi_current_rel_time_t();
 
     if (pool->secure) {
         myself = PR_ThreadSelf();
@@ -679,6 +717,17 @@ cb_check_for_stale_connections(cb_conn_pool *pool)
         return;
     }
 
+    /*
+     * The connections marked stale are closed by their last release, only
+     * the lifetime needs a scan. It is in seconds: scan the shared list at
+     * most once per second rather than for each operation.
+     */
+    if ((connlifetime <= 0) || (curtime == pool->conn.stale_check_time)) {
+        slapi_unlock_mutex(pool->conn.conn_list_mutex);
+        return;
+    }
+    pool->conn.stale_check_time = curtime;
+
     for (conn = pool->conn.conn_list; conn != NULL; conn = conn_next) {
         if ((conn->status == CB_CONNSTATUS_STALE) ||
             ((connlifetime > 0) && (curtime - conn->opentime > connlifetime))) {
@@ -698,6 +747,7 @@ cb_check_for_stale_connections(cb_conn_pool *pool)
                 --pool->conn.conn_list_count;
                 conn_next = conn->next;
                 cb_close_and_dispose_connection(conn);
+                closed = 1;
                 continue;
             }
 
@@ -716,11 +766,12 @@ cb_check_for_stale_connections(cb_conn_pool *pool)
         conn_next = conn->next;
     }
 
-    /* Generate an event to wake up threads waiting */
-    /* for a conn to be released. Useful to detect  */
-    /* exceeded time limit. May be expensive        */
+    /* Wake up a thread waiting for a connection */
+    /* if there is room for a new one            */
 
-    slapi_notify_condvar(pool->conn.conn_list_cv, 0);
+    if (closed) {
+        slapi_notify_condvar(pool->conn.conn_list_cv, 0);
+    }
 
     slapi_unlock_mutex(pool->conn.conn_list_mutex);
 }
@@ -43,8 +43,33 @@ extern cb_instance_config_info cb_the_instance_config[];
 **        outgoingopconnections
 **        outgoingbindconnections
 **
+**    Operation connections, as "<limit>:<count> ..." log2 histograms
+**        wait for a connection, in microseconds
+**        operations in flight on the connection used
+**
 */
 
+/* Values below <limit> were counted <count> times, empty buckets are skipped */
+static void
+cb_monitor_histogram(char *buf, size_t size, uint64_t *histogram)
+{
+    size_t len = 0;
+
+    buf[0] = '\0';
+    for (int i = 0; i < CB_HISTOGRAM_BUCKETS && len < size; i++) {
+        if (histogram[i] == 0) {
+            continue;
+        }
+        if (i == CB_HISTOGRAM_BUCKETS - 1) {
+            len += snprintf(buf + len, size - len, "%sinf:%" PRIu64,
+                            len ? " " : "", histogram[i]);
+        } else {
+            len += snprintf(buf + len, size - len, "%s%" PRIu64 ":%" PRIu64,
+                            len ? " " : "", (uint64_t)1 << i, histogram[i]);
+        }
+    }
+}
+
 int
 cb_search_monitor_callback(Slapi_PBlock *pb __attribute__((unused)),
                            Slapi_Entry *e,
@@ -60,6 +85,8 @@ cb_search_monitor_callback(Slapi_PBlock *pb __attribute__((unused)),
     unsigned long deletecount, addcount, modifycount, modrdncount, searchbasecount, searchonelevelcount;
     unsigned long searchsubtreecount, abandoncount, bindcount, unbindcount, comparecount;
     unsigned int outgoingconn, outgoingbindconn;
+    uint64_t waithistogram[CB_HISTOGRAM_BUCKETS];
+    uint64_t inflighthistogram[CB_HISTOGRAM_BUCKETS];
     cb_backend_instance *inst = (cb_backend_instance *)arg;
 
     /* First make sure the backend instance is configured */
@@ -98,6 +125,8 @@ cb_search_monitor_callback(Slapi_PBlock *pb __attribute__((unused)),
 
     slapi_lock_mutex(inst->pool->conn.conn_list_mutex);
     outgoingconn = inst->pool->conn.conn_list_count;
+    memcpy(waithistogram, inst->pool->conn.wait_histogram, sizeof(waithistogram));
+    memcpy(inflighthistogram, inst->pool->conn.inflight_histogram, sizeof(inflighthistogram));
     slapi_unlock_mutex(inst->pool->conn.conn_list_mutex);
 
     slapi_lock_mutex(inst->bind_pool->conn.conn_list_mutex);
@@ -169,6 +198,24 @@ cb_search_monitor_callback(Slapi_PBlock *pb __attribute__((unused)),
     val.bv_len = strlen(buf);
     slapi_entry_attr_replace(e, CB_MONITOR_OUTGOINGBINDCOUNT, (struct berval **)vals);
 
+    cb_monitor_histogram(buf, sizeof(buf), waithistogram);
+    val.bv_val = buf;
+    val.bv_len = strlen(buf);
+    if (val.bv_len) {
+        slapi_entry_attr_replace(e, CB_MONITOR_WAITHISTOGRAM, (struct berval **)vals);
+    } else {
+        slapi_entry_attr_delete(e, CB_MONITOR_WAITHISTOGRAM);
+    }
+
+    cb_monitor_histogram(buf, sizeof(buf), inflighthistogram);
+    val.bv_val = buf;
+    val.bv_len = strlen(buf);
+    if (val.bv_len) {
+        slapi_entry_attr_replace(e, CB_MONITOR_INFLIGHTHISTOGRAM, (struct berval **)vals);
+    } else {
+        slapi_entry_attr_delete(e, CB_MONITOR_INFLIGHTHISTOGRAM);
+    }
+
     *returnCode = LDAP_SUCCESS;
     return (SLAPI_DSE_CALLBACK_OK);
 }
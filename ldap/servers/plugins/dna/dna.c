@@ -81,6 +81,22 @@
 #define DNA_NEXT_RANGE "dnaNextRange"
 #define DNA_RANGE_REQUEST_TIMEOUT "dnaRangeRequestTimeout"
 
+/* Number of values reserved each time dnaNextValue is written */
+#define DNA_RESERVATION "dnaReservationSize"
+
+/* Allocation statistics, added to the config entries when searched */
+#define DNA_STAT_ALLOCATIONS "dnaAllocationCount"
+#define DNA_STAT_RATE "dnaAllocationRate"
+#define DNA_STAT_AVG_TIME "dnaAllocationAvgTime"
+#define DNA_STAT_MAX_TIME "dnaAllocationMaxTime"
+#define DNA_STAT_RESERVATIONS "dnaReservationWrites"
+#define DNA_STAT_RESERVED "dnaReservedValue"
+#define DNA_STAT_COUNT 6
+
+/* The statistics of every range, whatever the location of its config */
+#define DNA_MONITOR_DN "cn=Distributed Numeric Assignment Plugin,cn=monitor"
+#define DNA_MONITOR_STATS "dnaRangeStatistics"
+
 /* Replication types */
 #define DNA_REPL_BIND_DN "nsds5ReplicaBindDN"
 #define DNA_REPL_BIND_DNGROUP "nsds5ReplicaBindDNGroup"
@@ -139,7 +155,8 @@ struct configEntry
     char *remote_bind_method;
     char *remote_conn_prot;
     PRUint64 timeout;
-    /* This lock protects the 5 members below.  All
+    PRUint64 reservation;
+    /* This lock protects the 7 members below.  All
      * of the above members are safe to read as long
      * as you call dna_read_lock() first. */
     Slapi_Mutex *lock;
@@ -148,6 +165,15 @@ struct configEntry
     PRUint64 remaining;
     PRUint64 next_range_lower;
     PRUint64 next_range_upper;
+    PRUint64 reserved;         /* dnaNextValue as stored in the config entry */
+    PRUint64 shared_remaining; /* dnaRemainingValues as last published */
+    /* Allocation statistics.  The counters are atomic
+     * so the monitor can read them without the lock. */
+    time_t stats_start;
+    Slapi_Counter *alloc_count;
+    Slapi_Counter *alloc_time;
+    Slapi_Counter *alloc_max_time;
+    Slapi_Counter *reserve_count;
     /* This lock protects the extend_in_progress
      * member.  This is used to prevent us from
      * processing a range extention request and
@@ -237,6 +263,13 @@ static void dna_notice_allocation(struct configEntry *config_entry,
                                   PRUint64 new,
                                   PRUint64 last);
 static int dna_update_shared_config(struct configEntry *config_entry);
+static int dna_shared_config_is_stale(struct configEntry *config_entry);
+static PRUint64 dna_reservation_mark(struct configEntry *config_entry, PRUint64 nextval);
+static int dna_persist_nextval(struct configEntry *config_entry, PRUint64 value);
+static void dna_record_allocation(struct configEntry *config_entry, struct timespec *start);
+static int dna_config_search(Slapi_PBlock *pb, Slapi_Entry *e, Slapi_Entry *entryAfter, int *returncode, char *returntext, void *arg);
+static int dna_monitor_search(Slapi_PBlock *pb, Slapi_Entry *e, Slapi_Entry *entryAfter, int *returncode, char *returntext, void *arg);
+static void dna_monitor_add(void);
 static void dna_update_config_event(time_t event_time, void *arg);
 static int dna_get_shared_servers(struct configEntry *config_entry, PRCList **servers, int get_all);
 static void dna_free_shared_server(struct dnaServer **server);
@@ -332,7 +365,9 @@ dna_config_copy(void)
             new_entry->timeout = config_entry->timeout;
             new_entry->interval = config_entry->interval;
             new_entry->threshold = config_entry->threshold;
+            new_entry->reservation = config_entry->reservation;
             new_entry->nextval = config_entry->nextval;
+            new_entry->reserved = config_entry->reserved;
             new_entry->maxval = config_entry->maxval;
             new_entry->remaining = config_entry->remaining;
             new_entry->extend_in_progress = config_entry->extend_in_progress;
@@ -662,6 +697,15 @@ dna_start(Slapi_PBlock *pb)
         return DNA_FAILURE;
     }
 
+    /* Publish the allocation statistics on the config entries and in cn=monitor */
+    slapi_config_register_callback_plugin(SLAPI_OPERATION_SEARCH, DSE_FLAG_PREOP | DSE_FLAG_PLUGIN,
+                                          getPluginDN(), LDAP_SCOPE_SUBTREE, "(objectclass=*)",
+                                          dna_config_search, NULL, pb);
+    dna_monitor_add();
+    slapi_config_register_callback_plugin(SLAPI_OPERATION_SEARCH, DSE_FLAG_PREOP | DSE_FLAG_PLUGIN,
+                                          DNA_MONITOR_DN, LDAP_SCOPE_BASE, "(objectclass=*)",
+                                          dna_monitor_search, NULL, pb);
+
     /*
      * Load all shared server configs
      */
@@ -691,6 +735,10 @@ dna_close(Slapi_PBlock *pb __attribute__((unused)))
                   "--> dna_close\n");
 
     slapi_eq_cancel_rel(eq_ctx);
+    slapi_config_remove_callback(SLAPI_OPERATION_SEARCH, DSE_FLAG_PREOP, getPluginDN(),
+                                 LDAP_SCOPE_SUBTREE, "(objectclass=*)", dna_config_search);
+    slapi_config_remove_callback(SLAPI_OPERATION_SEARCH, DSE_FLAG_PREOP, DNA_MONITOR_DN,
+                                 LDAP_SCOPE_BASE, "(objectclass=*)", dna_monitor_search);
     dna_delete_config(NULL);
     slapi_ch_free((void **)&dna_global_config);
     slapi_destroy_rwlock(g_dna_cache_lock);
@@ -1288,6 +1336,26 @@ dna_parse_config_entry(Slapi_PBlock *pb, Slapi_Entry *e, int apply)
                   "dna_parse_config_entry - %s [%" PRIu64 "]\n", DNA_RANGE_REQUEST_TIMEOUT,
                   entry->timeout);
 
+    /* A reservation of 1 writes dnaNextValue on every allocation */
+    entry->reservation = 1;
+
+    value = slapi_entry_attr_get_charptr(e, DNA_RESERVATION);
+    if (value) {
+        errno = 0;
+        entry->reservation = strtoull(value, 0, 0);
+        if (entry->reservation == 0 || errno == ERANGE) {
+            slapi_log_err(SLAPI_LOG_WARNING, DNA_PLUGIN_SUBSYSTEM,
+                          "dna_parse_config_entry - Invalid value for %s (%s), "
+                          "Using default value of 1\n", DNA_RESERVATION, value);
+            entry->reservation = 1;
+        }
+        slapi_ch_free_string(&value);
+    }
+
+    slapi_log_err(SLAPI_LOG_CONFIG, DNA_PLUGIN_SUBSYSTEM,
+                  "dna_parse_config_entry - %s [%" PRIu64 "]\n", DNA_RESERVATION,
+                  entry->reservation);
+
     value = slapi_entry_attr_get_charptr(e, DNA_NEXT_RANGE);
     if (value) {
         char *p = NULL;
@@ -1357,6 +1425,10 @@ dna_parse_config_entry(Slapi_PBlock *pb, Slapi_Entry *e, int apply)
                             entry->interval);
     }
 
+    /* Everything below the stored next value may already have been
+     * handed out, so that is where our first reservation ends. */
+    entry->reserved = entry->nextval;
+
     /* create the new value lock for this range */
     entry->lock = slapi_new_mutex();
     if (!entry->lock) {
@@ -1368,6 +1440,12 @@ dna_parse_config_entry(Slapi_PBlock *pb, Slapi_Entry *e, int apply)
         goto bail;
     }
 
+    entry->stats_start = slapi_current_rel_time_t();
+    entry->alloc_count = slapi_counter_new();
+    entry->alloc_time = slapi_counter_new();
+    entry->alloc_max_time = slapi_counter_new();
+    entry->reserve_count = slapi_counter_new();
+
     /* Check if the shared config base matches the config scope and filter */
     if (entry->scope && slapi_dn_issuffix(entry->shared_cfg_base, entry->scope)) {
         if (entry->slapi_filter) {
@@ -1482,6 +1560,10 @@ dna_free_config_entry(struct configEntry **entry)
     slapi_ch_free_string(&e->remote_conn_prot);
 
     slapi_destroy_mutex(e->lock);
+    slapi_counter_destroy(&e->alloc_count);
+    slapi_counter_destroy(&e->alloc_time);
+    slapi_counter_destroy(&e->alloc_max_time);
+    slapi_counter_destroy(&e->reserve_count);
 
     slapi_ch_free((void **)entry);
 }
@@ -1806,13 +1888,40 @@ dna_notice_allocation(struct configEntry *config_entry, PRUint64 new, PRUint64 l
                                        config_entry->interval);
         }
 
-        /* update the shared configuration */
-        dna_update_shared_config(config_entry);
+        /* update the shared configuration.  Range changes are always
+         * published, single allocations only once the published count
+         * is out of date. */
+        if ((last == 0) || dna_shared_config_is_stale(config_entry)) {
+            dna_update_shared_config(config_entry);
+        }
     }
 
     return;
 }
 
+/* dna_shared_config_is_stale()
+ *
+ * Checks if the remaining value count published in the shared
+ * config entry needs to be refreshed.  Without a reservation we
+ * publish after every allocation.  With one we wait until the count
+ * drifted by a whole reservation, unless we are getting close to
+ * the threshold where the other servers need an accurate count.
+ *
+ * The lock for configEntry should be obtained before calling
+ * this function. */
+static int
+dna_shared_config_is_stale(struct configEntry *config_entry)
+{
+    if ((config_entry->reservation <= 1) ||
+        (config_entry->remaining <= config_entry->threshold) ||
+        (config_entry->shared_remaining < config_entry->remaining)) {
+        return 1;
+    }
+
+    return (config_entry->shared_remaining - config_entry->remaining) >=
+           config_entry->reservation;
+}
+
 static int
 dna_get_shared_servers(struct configEntry *config_entry, PRCList **servers, int get_all)
 {
@@ -2490,12 +2599,7 @@ static int
 dna_get_next_value(struct configEntry *config_entry,
                    char **next_value_ret)
 {
-    Slapi_PBlock *pb = NULL;
-    LDAPMod mod_replace;
-    LDAPMod *mods[2];
-    char *replace_val[2];
-    /* 16 for max 64-bit unsigned plus the trailing '\0' */
-    char next_value[22] = {0};
+    struct timespec start;
     PRUint64 setval = 0;
     PRUint64 nextval = 0;
     int ret;
@@ -2503,6 +2607,8 @@ dna_get_next_value(struct configEntry *config_entry,
     slapi_log_err(SLAPI_LOG_TRACE, DNA_PLUGIN_SUBSYSTEM,
                   "--> dna_get_next_value\n");
 
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
     /* get the lock to prevent contention with other threads over
      * the next new value for this range. */
     slapi_lock_mutex(config_entry->lock);
@@ -2538,33 +2644,14 @@ dna_get_next_value(struct configEntry *config_entry,
 
     nextval = setval + config_entry->interval;
     /* update nextval if we have not reached the end
-     * of our current range */
-    if ((config_entry->maxval == -1) ||
-        (nextval <= (config_entry->maxval + config_entry->interval))) {
-        /* try to set the new next value in the config entry */
-        snprintf(next_value, sizeof(next_value), "%" PRIu64, nextval);
-
-        /* set up our replace modify operation */
-        replace_val[0] = next_value;
-        replace_val[1] = 0;
-        mod_replace.mod_op = LDAP_MOD_REPLACE;
-        mod_replace.mod_type = DNA_NEXTVAL;
-        mod_replace.mod_values = replace_val;
-        mods[0] = &mod_replace;
-        mods[1] = 0;
-
-        pb = slapi_pblock_new();
-        if (NULL == pb) {
-            ret = LDAP_OPERATIONS_ERROR;
-            goto done;
-        }
-
-        slapi_modify_internal_set_pb(pb, config_entry->dn,
-                                     mods, 0, 0, getPluginID(), 0);
-
-        slapi_modify_internal_pb(pb);
-
-        slapi_pblock_get(pb, SLAPI_PLUGIN_INTOP_RESULT, &ret);
+     * of our current range.  The config entry only needs
+     * to be written once the values reserved by the last
+     * write are used up. */
+    if (((config_entry->maxval == -1) ||
+         (nextval <= (config_entry->maxval + config_entry->interval))) &&
+        (nextval > config_entry->reserved)) {
+        ret = dna_persist_nextval(config_entry,
+                                  dna_reservation_mark(config_entry, nextval));
     }
 
     if (LDAP_SUCCESS == ret) {
@@ -2577,21 +2664,132 @@ dna_get_next_value(struct configEntry *config_entry,
 
         /* update our cached config */
         dna_notice_allocation(config_entry, nextval, setval);
+        dna_record_allocation(config_entry, &start);
     }
 
 done:
     slapi_unlock_mutex(config_entry->lock);
 
-    if (pb) {
-        slapi_pblock_destroy(pb);
-    }
-
     slapi_log_err(SLAPI_LOG_TRACE, DNA_PLUGIN_SUBSYSTEM,
                   "<-- dna_get_next_value\n");
 
     return ret;
 }
 
+/*
+ * dna_reservation_mark()
+ *
+ * Returns the value to store as dnaNextValue when nextval is the
+ * next value we are about to hand out.  We reserve the configured
+ * number of values at once, but never past the end of the active
+ * range, so the stored value never points into a range that we
+ * might give away to another server.
+ *
+ * The lock for configEntry should be obtained before calling
+ * this function.
+ */
+static PRUint64
+dna_reservation_mark(struct configEntry *config_entry, PRUint64 nextval)
+{
+    PRUint64 count = config_entry->reservation - 1;
+    PRUint64 left;
+
+    if ((count == 0) || (nextval > config_entry->maxval)) {
+        return nextval;
+    }
+
+    /* number of values past nextval before we leave the range */
+    left = ((config_entry->maxval - nextval) / config_entry->interval) + 1;
+    if (left < count) {
+        count = left;
+    }
+
+    return nextval + (count * config_entry->interval);
+}
+
+/*
+ * dna_persist_nextval()
+ *
+ * Writes value as dnaNextValue to the config entry.  Every value
+ * below it may have been handed out, so after a restart we continue
+ * from there: a crash can skip at most one reservation worth of
+ * values, but never hands out a value twice.  Anything handed out
+ * in between is still checked against the database by
+ * dna_first_free_value().
+ *
+ * The lock for configEntry should be obtained before calling
+ * this function.
+ */
+static int
+dna_persist_nextval(struct configEntry *config_entry, PRUint64 value)
+{
+    Slapi_PBlock *pb = NULL;
+    LDAPMod mod_replace;
+    LDAPMod *mods[2];
+    char *replace_val[2];
+    /* 16 for max 64-bit unsigned plus the trailing '\0' */
+    char next_value[22] = {0};
+    int ret = LDAP_OPERATIONS_ERROR;
+
+    snprintf(next_value, sizeof(next_value), "%" PRIu64, value);
+
+    /* set up our replace modify operation */
+    replace_val[0] = next_value;
+    replace_val[1] = 0;
+    mod_replace.mod_op = LDAP_MOD_REPLACE;
+    mod_replace.mod_type = DNA_NEXTVAL;
+    mod_replace.mod_values = replace_val;
+    mods[0] = &mod_replace;
+    mods[1] = 0;
+
+    pb = slapi_pblock_new();
+    if (NULL == pb) {
+        return ret;
+    }
+
+    slapi_modify_internal_set_pb(pb, config_entry->dn,
+                                 mods, 0, 0, getPluginID(), 0);
+
+    slapi_modify_internal_pb(pb);
+
+    slapi_pblock_get(pb, SLAPI_PLUGIN_INTOP_RESULT, &ret);
+    slapi_pblock_destroy(pb);
+
+    if (LDAP_SUCCESS == ret) {
+        config_entry->reserved = value;
+        slapi_counter_increment(config_entry->reserve_count);
+    }
+
+    return ret;
+}
+
+/*
+ * dna_record_allocation()
+ *
+ * Updates the allocation statistics of a range with an allocation
+ * that started at start.
+ *
+ * The lock for configEntry should be obtained before calling
+ * this function.
+ */
+static void
+dna_record_allocation(struct configEntry *config_entry, struct timespec *start)
+{
+    struct timespec now;
+    struct timespec diff;
+    uint64_t usec;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    slapi_timespec_diff(&now, start, &diff);
+    usec = (uint64_t)diff.tv_sec * 1000000 + diff.tv_nsec / 1000;
+
+    slapi_counter_increment(config_entry->alloc_count);
+    slapi_counter_add(config_entry->alloc_time, usec);
+    if (usec > slapi_counter_get_value(config_entry->alloc_max_time)) {
+        slapi_counter_set_value(config_entry->alloc_max_time, usec);
+    }
+}
+
 /*
  * Get a value from the global server list.  The dna_server_read_lock()
  * should be held prior to calling this function.
@@ -2722,6 +2920,8 @@ dna_update_shared_config(struct configEntry *config_entry)
                 slapi_log_err(SLAPI_LOG_ERR, DNA_PLUGIN_SUBSYSTEM,
                               "dna_update_shared_config - Unable to update shared config entry: %s [error %d]\n",
                               config_entry->shared_cfg_dn, ret);
+            } else {
+                config_entry->shared_remaining = config_entry->remaining;
             }
 
             slapi_pblock_destroy(pb);
@@ -2875,6 +3075,7 @@ dna_activate_next_range(struct configEntry *config_entry)
         /* Update the in-memory config info */
         config_entry->maxval = config_entry->next_range_upper;
         config_entry->nextval = config_entry->next_range_lower;
+        config_entry->reserved = config_entry->nextval;
         config_entry->next_range_upper = 0;
         config_entry->next_range_lower = 0;
         config_entry->remaining = ((config_entry->maxval - config_entry->nextval + 1) /
@@ -4362,6 +4563,164 @@ bail:
     return ret;
 }
 
+static const char *dna_stat_names[DNA_STAT_COUNT] = {
+    DNA_STAT_ALLOCATIONS,
+    DNA_STAT_RATE,
+    DNA_STAT_AVG_TIME,
+    DNA_STAT_MAX_TIME,
+    DNA_STAT_RESERVATIONS,
+    DNA_STAT_RESERVED};
+
+/*
+ * dna_get_stats()
+ *
+ * Reads the allocation statistics of a range, in the order of
+ * dna_stat_names.  The caller holds the config read lock.
+ */
+static void
+dna_get_stats(struct configEntry *config_entry, uint64_t *stats)
+{
+    uint64_t count = slapi_counter_get_value(config_entry->alloc_count);
+    uint64_t elapsed = slapi_current_rel_time_t() - config_entry->stats_start;
+
+    stats[0] = count;
+    stats[1] = elapsed ? count / elapsed : count;
+    stats[2] = count ? slapi_counter_get_value(config_entry->alloc_time) / count : 0;
+    stats[3] = slapi_counter_get_value(config_entry->alloc_max_time);
+    stats[4] = slapi_counter_get_value(config_entry->reserve_count);
+
+    slapi_lock_mutex(config_entry->lock);
+    stats[5] = config_entry->reserved;
+    slapi_unlock_mutex(config_entry->lock);
+}
+
+/*
+ * dna_config_search()
+ *
+ * DSE search callback that adds the allocation statistics of a
+ * range to its config entry.  Internal searches are skipped, as
+ * the config is reloaded through one while holding the write lock.
+ */
+static int
+dna_config_search(Slapi_PBlock *pb,
+                  Slapi_Entry *e,
+                  Slapi_Entry *entryAfter __attribute__((unused)),
+                  int *returncode __attribute__((unused)),
+                  char *returntext __attribute__((unused)),
+                  void *arg __attribute__((unused)))
+{
+    struct configEntry *config_entry = NULL;
+    PRCList *list = NULL;
+    const char *ndn = slapi_entry_get_ndn(e);
+    uint64_t stats[DNA_STAT_COUNT];
+
+    if (slapi_op_internal(pb) || (ndn == NULL)) {
+        return SLAPI_DSE_CALLBACK_OK;
+    }
+
+    dna_read_lock();
+
+    if (!PR_CLIST_IS_EMPTY(dna_global_config)) {
+        list = PR_LIST_HEAD(dna_global_config);
+        while (list != dna_global_config) {
+            config_entry = (struct configEntry *)list;
+            if (strcasecmp(config_entry->dn, ndn) == 0) {
+                dna_get_stats(config_entry, stats);
+                for (size_t i = 0; i < DNA_STAT_COUNT; i++) {
+                    slapi_entry_attr_set_ulong(e, dna_stat_names[i], stats[i]);
+                }
+                break;
+            }
+            list = PR_NEXT_LINK(list);
+        }
+    }
+
+    dna_unlock();
+
+    return SLAPI_DSE_CALLBACK_OK;
+}
+
+/*
+ * dna_monitor_search()
+ *
+ * DSE search callback of the monitor entry: one dnaRangeStatistics
+ * value per range, the statistics as name=value followed by the DN
+ * of the range config entry.
+ */
+static int
+dna_monitor_search(Slapi_PBlock *pb,
+                   Slapi_Entry *e,
+                   Slapi_Entry *entryAfter __attribute__((unused)),
+                   int *returncode __attribute__((unused)),
+                   char *returntext __attribute__((unused)),
+                   void *arg __attribute__((unused)))
+{
+    struct configEntry *config_entry = NULL;
+    PRCList *list = NULL;
+    uint64_t stats[DNA_STAT_COUNT];
+
+    if (slapi_op_internal(pb)) {
+        return SLAPI_DSE_CALLBACK_OK;
+    }
+
+    slapi_entry_attr_delete(e, DNA_MONITOR_STATS);
+
+    dna_read_lock();
+
+    if (!PR_CLIST_IS_EMPTY(dna_global_config)) {
+        list = PR_LIST_HEAD(dna_global_config);
+        while (list != dna_global_config) {
+            char *value = NULL;
+
+            config_entry = (struct configEntry *)list;
+            dna_get_stats(config_entry, stats);
+            value = slapi_ch_smprintf("%s=%" PRIu64 " %s=%" PRIu64 " %s=%" PRIu64 " %s=%" PRIu64
+                                      " %s=%" PRIu64 " %s=%" PRIu64 " %s",
+                                      dna_stat_names[0], stats[0], dna_stat_names[1], stats[1],
+                                      dna_stat_names[2], stats[2], dna_stat_names[3], stats[3],
+                                      dna_stat_names[4], stats[4], dna_stat_names[5], stats[5],
+                                      config_entry->dn);
+            slapi_entry_add_string(e, DNA_MONITOR_STATS, value);
+            slapi_ch_free_string(&value);
+            list = PR_NEXT_LINK(list);
+        }
+    }
+
+    dna_unlock();
+
+    return SLAPI_DSE_CALLBACK_OK;
+}
+
+/*
+ * dna_monitor_add()
+ *
+ * Creates the monitor entry the statistics are published on, unless
+ * it was created by a previous start.
+ */
+static void
+dna_monitor_add(void)
+{
+    Slapi_PBlock *pb = slapi_pblock_new();
+    Slapi_Entry *e = slapi_entry_alloc();
+    int ret = LDAP_SUCCESS;
+
+    slapi_entry_init(e, slapi_ch_strdup(DNA_MONITOR_DN), NULL);
+    slapi_entry_add_string(e, SLAPI_ATTR_OBJECTCLASS, "top");
+    slapi_entry_add_string(e, SLAPI_ATTR_OBJECTCLASS, "extensibleObject");
+    slapi_entry_add_string(e, "cn", "Distributed Numeric Assignment Plugin");
+
+    /* e will be consumed by slapi_add_internal() */
+    slapi_add_entry_internal_set_pb(pb, e, NULL, getPluginID(), 0);
+    slapi_add_internal_pb(pb);
+    slapi_pblock_get(pb, SLAPI_PLUGIN_INTOP_RESULT, &ret);
+    if (ret != LDAP_SUCCESS && ret != LDAP_ALREADY_EXISTS) {
+        slapi_log_err(SLAPI_LOG_ERR, DNA_PLUGIN_SUBSYSTEM,
+                      "dna_monitor_add - Unable to add %s [error %d]\n",
+                      DNA_MONITOR_DN, ret);
+    }
+    slapi_pblock_destroy(pb);
+}
+
 static int
 dna_config_check_post_op(Slapi_PBlock *pb)
 {
@@ -4681,6 +5040,16 @@ dna_release_range(char *range_dn, PRUint64 *lower, PRUint64 *upper)
                 if (ret == LDAP_SUCCESS) {
                     /* Adjust maxval in our cached config and shared config */
                     config_entry->maxval = *lower - 1;
+                    /* Our reservation must not reach into the values we
+                     * just gave away, so shrink it to what we handed out. */
+                    if ((config_entry->reserved > config_entry->maxval) &&
+                        (config_entry->reserved > config_entry->nextval) &&
+                        (dna_persist_nextval(config_entry, config_entry->nextval) != LDAP_SUCCESS)) {
+                        slapi_log_err(SLAPI_LOG_ERR, DNA_PLUGIN_SUBSYSTEM,
+                                      "dna_release_range - Unable to shrink the "
+                                      "reservation for range %s\n",
+                                      config_entry->dn);
+                    }
                     /* This is within the dna_lock, so okay */
                     dna_notice_allocation(config_entry, config_entry->nextval, 0);
                 }
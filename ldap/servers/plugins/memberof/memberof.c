@@ -154,6 +154,7 @@ static int memberof_get_groups_callback(Slapi_Entry *e, void *callback_data);
 static int memberof_test_membership(Slapi_PBlock *pb, MemberOfConfig *config, Slapi_DN *group_sdn);
 static int memberof_test_membership_callback(Slapi_Entry *e, void *callback_data);
 static int memberof_del_dn_type_callback(Slapi_Entry *e, void *callback_data);
+static int memberof_entry_found_callback(Slapi_Entry *e, void *callback_data);
 static int memberof_replace_dn_type_callback(Slapi_Entry *e, void *callback_data);
 static int memberof_replace_dn_from_groups(Slapi_PBlock *pb, MemberOfConfig *config, Slapi_DN *pre_sdn, Slapi_DN *post_sdn);
 static int memberof_modop_one_replace_r(Slapi_PBlock *pb, MemberOfConfig *config, int mod_op, Slapi_DN *group_sdn, Slapi_DN *op_this_sdn, Slapi_DN *replace_with_sdn, Slapi_DN *op_to_sdn, memberofstringll *stack);
@@ -1470,6 +1471,13 @@ memberof_del_dn_from_groups(Slapi_PBlock *pb, MemberOfConfig *config, Slapi_DN *
     return rc;
 }
 
+/* Stop the search at the first matching entry */
+int
+memberof_entry_found_callback(Slapi_Entry *e __attribute__((unused)), void *callback_data __attribute__((unused)))
+{
+    return -1;
+}
+
 int
 memberof_del_dn_type_callback(Slapi_Entry *e, void *callback_data)
 {
@@ -2615,11 +2623,12 @@ memberof_modop_one_replace_r(Slapi_PBlock *pb, MemberOfConfig *config, int mod_o
                     }
                 }
                 if (filter_str) {
+                    /* We only need to know whether such an entry exists */
                     slapi_search_internal_set_pb(search_pb, slapi_sdn_get_dn(base_sdn),
                                                  LDAP_SCOPE_SUBTREE, filter_str, 0, 0, 0, 0,
                                                  memberof_get_plugin_id(), 0);
 
-                    if (slapi_search_internal_pb(search_pb)) {
+                    if (slapi_search_internal_stream_pb(search_pb, NULL, memberof_entry_found_callback)) {
                         /* get result and log an error */
                         int res = 0;
                         slapi_pblock_get(search_pb, SLAPI_PLUGIN_INTOP_RESULT, &res);
@@ -2636,7 +2645,6 @@ memberof_modop_one_replace_r(Slapi_PBlock *pb, MemberOfConfig *config, int mod_o
                             memberof_test_membership(pb, config, op_to_sdn);
                         }
                     }
-                    slapi_free_search_results_internal(search_pb);
                 }
                 slapi_pblock_init(search_pb);
                 if (!all_backends) {
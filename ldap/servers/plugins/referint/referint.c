@@ -29,6 +29,11 @@
 #define REFERINT_ATTR_DELAY       "referint-update-delay"
 #define REFERINT_ATTR_LOGFILE     "referint-logfile"
 #define REFERINT_ATTR_MEMBERSHIP  "referint-membership-attr"
+#define REFERINT_ATTR_QUEUE_DEPTH "referint-queue-depth"
+#define REFERINT_ATTR_QUEUE_LAG   "referint-queue-lag"
+#define REFERINT_ATTR_PROCESSED   "referint-processed-updates"
+#define REFERINT_BATCH_SUFFIX     ".batch"
+#define REFERINT_BATCH_SIZE       100 /* deleted DNs looked up per search */
 #define MAX_LINE     2048
 #define READ_BUFSIZE 4096
 #define MY_EOF  0
@@ -50,6 +55,7 @@ int referint_postop_modrdn(Slapi_PBlock *pb);
 int referint_postop_start(Slapi_PBlock *pb);
 int referint_postop_close(Slapi_PBlock *pb);
 int update_integrity(Slapi_DN *sDN, char *newrDN, Slapi_DN *newsuperior, Slapi_PBlock *pb);
+int update_integrity_batch(Slapi_DN **sdns, size_t count);
 int GetNextLine(char *dest, int size_dest, PRFileDesc *stream);
 int my_fgetc(PRFileDesc *stream);
 void referint_thread_func(void *arg);
@@ -67,6 +73,7 @@ void referint_set_plugin_area(Slapi_DN *sdn);
 Slapi_DN *referint_get_plugin_area(void);
 int referint_sdn_config_cmp(Slapi_DN *sdn);
 void referint_get_config(int *delay, char **logfile);
+static int referint_queue_search(Slapi_PBlock *pb, Slapi_Entry *e, Slapi_Entry *entryAfter, int *returncode, char *returntext, void *arg);
 
 /* global thread control stuff */
 static PRLock *referint_mutex = NULL;
@@ -76,6 +83,19 @@ static pthread_cond_t keeprunning_cv;
 
 static int keeprunning = 0;
 static uint64_t batch_thread_running = 0;
+
+/*
+ * Delayed updates are queued in the log file.  The batch thread renames
+ * it to <logfile>.batch before processing it, so the writers can keep
+ * appending to a new log file.  queue_written and queue_oldest describe
+ * the log file and are protected by referint_lock(), batch_pending and
+ * batch_oldest describe the batch being processed.
+ */
+static uint64_t queue_written = 0;
+static time_t queue_oldest = 0;
+static uint64_t batch_pending = 0;
+static time_t batch_oldest = 0;
+static uint64_t queue_processed = 0;
 static referint_config *config = NULL;
 static Slapi_DN *_ConfigAreaDN = NULL;
 static Slapi_DN *_pluginDN = NULL;
@@ -90,12 +110,14 @@ static int use_txn = 0;
 static int premodfn = SLAPI_PLUGIN_PRE_MODIFY_FN;
 
 
+/*
+ * Protects the integrity log file.  It is only held while a record is
+ * appended or the file is handed over to the batch thread, never while
+ * the references are updated, so it is also safe to use with betxn.
+ */
 static void
 referint_lock(void)
 {
-    if (use_txn) { /* no lock if betxn is enabled */
-        return;
-    }
     if (NULL == referint_mutex) {
         referint_mutex = PR_NewLock();
     }
@@ -107,9 +129,6 @@ referint_lock(void)
 static void
 referint_unlock(void)
 {
-    if (use_txn) { /* no lock if betxn is enabled */
-        return;
-    }
     if (referint_mutex) {
         PR_Unlock(referint_mutex);
     }
@@ -1125,13 +1144,17 @@ update_integrity(Slapi_DN *origSDN,
                 attrs[0] = membership_attrs[i];
                 attrs[1] = NULL;
 
-                /* Use new search API */
+                /*
+                 * Use new search API, only copying the membership attribute
+                 * out of the referencing entries.  The entries can't be
+                 * streamed as they are modified while we walk the results.
+                 */
                 slapi_pblock_init(search_result_pb);
                 slapi_pblock_set(search_result_pb, SLAPI_BACKEND, be);
                 slapi_search_internal_set_pb(search_result_pb, search_base,
                                              LDAP_SCOPE_SUBTREE, filter, attrs, 0 /* attrs only */,
                                              NULL, NULL, referint_plugin_identity, 0);
-                slapi_search_internal_pb(search_result_pb);
+                slapi_search_internal_projected_pb(search_result_pb);
 
                 slapi_pblock_get(search_result_pb, SLAPI_PLUGIN_INTOP_RESULT, &search_result);
 
@@ -1241,6 +1264,250 @@ free_and_return:
     return (rc);
 }
 
+/*
+ * Build "(|(attr=dn1)(attr=dn2)...)" over all the membership attributes
+ * and all the deleted DNs of a batch.
+ */
+static char *
+_batch_filter(char **membership_attrs, Slapi_DN **sdns, size_t count)
+{
+    char **parts = NULL;
+    char *filter = NULL;
+    char *p = NULL;
+    size_t nparts = 0;
+    size_t len = 4; /* "(|" + ")" + '\0' */
+    size_t i, j, k = 0;
+
+    for (i = 0; membership_attrs[i] != NULL; i++)
+        ;
+    nparts = i * count;
+    parts = (char **)slapi_ch_calloc(nparts + 1, sizeof(char *));
+
+    for (i = 0; membership_attrs[i] != NULL; i++) {
+        for (j = 0; j < count; j++) {
+            parts[k] = slapi_filter_sprintf("(%s=%s%s)", membership_attrs[i], ESC_NEXT_VAL,
+                                            slapi_sdn_get_dn(sdns[j]));
+            if (parts[k]) {
+                len += strlen(parts[k]);
+                k++;
+            }
+        }
+    }
+
+    if (k > 0) {
+        filter = p = slapi_ch_malloc(len);
+        p = stpcpy(p, "(|");
+        for (i = 0; i < k; i++) {
+            p = stpcpy(p, parts[i]);
+        }
+        stpcpy(p, ")");
+    }
+    slapi_ch_array_free(parts);
+
+    return filter;
+}
+
+/*
+ * Remove all the references to the DNs of a batch from one entry,
+ * using a single modify.  If that fails, e.g. because a value went
+ * away in the meantime, fall back to one modify per value.
+ */
+static int
+_update_batch_entry(Slapi_Entry *e, char **membership_attrs, PLHashTable *targets, Slapi_PBlock *mod_pb)
+{
+    Slapi_Mods *smods = slapi_mods_new();
+    Slapi_Attr *attr = NULL;
+    Slapi_Value *v = NULL;
+    char *attrName = NULL;
+    int result = LDAP_SUCCESS;
+    int nval;
+    int i;
+
+    for (slapi_entry_first_attr(e, &attr); attr; slapi_entry_next_attr(e, attr, &attr)) {
+        slapi_attr_get_type(attr, &attrName);
+        for (i = 0; membership_attrs[i] != NULL; i++) {
+            if (slapi_attr_type_cmp(membership_attrs[i], attrName, SLAPI_TYPE_CMP_SUBTYPE) == 0) {
+                break;
+            }
+        }
+        if (membership_attrs[i] == NULL) {
+            continue;
+        }
+        for (nval = slapi_attr_first_value(attr, &v); nval != -1;
+             nval = slapi_attr_next_value(attr, nval, &v)) {
+            Slapi_DN *vsdn = slapi_sdn_new_dn_byref(slapi_value_get_string(v));
+
+            if (PL_HashTableLookupConst(targets, slapi_sdn_get_ndn(vsdn))) {
+                slapi_mods_add_string(smods, LDAP_MOD_DELETE, attrName, slapi_value_get_string(v));
+            }
+            slapi_sdn_free(&vsdn);
+        }
+    }
+
+    if (slapi_mods_get_num_mods(smods) > 0) {
+        slapi_pblock_init(mod_pb);
+        slapi_modify_internal_set_pb_ext(mod_pb, slapi_entry_get_sdn(e),
+                                         slapi_mods_get_ldapmods_byref(smods), NULL, NULL,
+                                         referint_plugin_identity, allow_repl ? OP_FLAG_REPLICATED : 0);
+        slapi_modify_internal_pb(mod_pb);
+        slapi_pblock_get(mod_pb, SLAPI_PLUGIN_INTOP_RESULT, &result);
+        if (result != LDAP_SUCCESS) {
+            result = _do_modify(mod_pb, (Slapi_DN *)slapi_entry_get_sdn(e),
+                                slapi_mods_get_ldapmods_byref(smods));
+        }
+        if (result != LDAP_SUCCESS) {
+            slapi_log_err(SLAPI_LOG_ERR, REFERINT_PLUGIN_SUBSYSTEM,
+                          "_update_batch_entry - Entry %s: removing %d references failed (%d)\n",
+                          slapi_entry_get_dn_const(e), slapi_mods_get_num_mods(smods), result);
+        }
+    }
+    slapi_mods_free(&smods);
+
+    return result;
+}
+
+/*
+ * Remove the references to a batch of deleted entries.  Instead of one
+ * search per deleted DN and membership attribute, all of them are looked
+ * up with a single search per suffix, and every referencing entry is
+ * updated with a single modify.  Only used by the delayed update thread.
+ */
+int
+update_integrity_batch(Slapi_DN **sdns, size_t count)
+{
+    Slapi_PBlock *search_result_pb = NULL;
+    Slapi_PBlock *mod_pb = NULL;
+    Slapi_Entry **search_entries = NULL;
+    PLHashTable *targets = NULL;
+    Slapi_DN *sdn = NULL;
+    void *node = NULL;
+    char **membership_attrs = NULL;
+    char *filter = NULL;
+    int search_result;
+    size_t i;
+    int rc = SLAPI_PLUGIN_SUCCESS;
+
+    if (count == 0) {
+        return rc;
+    }
+    if (count == 1) {
+        return update_integrity(sdns[0], NULL, NULL, NULL);
+    }
+
+    membership_attrs = referint_get_attrs();
+    filter = _batch_filter(membership_attrs, sdns, count);
+    if (filter == NULL) {
+        slapi_ch_array_free(membership_attrs);
+        return rc;
+    }
+
+    targets = PL_NewHashTable(count * 2, PL_HashString, PL_CompareStrings,
+                              PL_CompareValues, NULL, NULL);
+    for (i = 0; i < count; i++) {
+        PL_HashTableAdd(targets, slapi_sdn_get_ndn(sdns[i]), sdns[i]);
+    }
+
+    search_result_pb = slapi_pblock_new();
+    mod_pb = slapi_pblock_new();
+
+    if (plugin_ContainerScope) {
+        sdn = plugin_ContainerScope;
+    } else {
+        sdn = slapi_get_first_suffix(&node, 0);
+    }
+    while (sdn) {
+        slapi_pblock_init(search_result_pb);
+        slapi_pblock_set(search_result_pb, SLAPI_BACKEND, slapi_be_select(sdn));
+        slapi_search_internal_set_pb(search_result_pb, slapi_sdn_get_dn(sdn),
+                                     LDAP_SCOPE_SUBTREE, filter, membership_attrs, 0,
+                                     NULL, NULL, referint_plugin_identity, 0);
+        slapi_search_internal_projected_pb(search_result_pb);
+        slapi_pblock_get(search_result_pb, SLAPI_PLUGIN_INTOP_RESULT, &search_result);
+
+        if (search_result == LDAP_SUCCESS) {
+            slapi_pblock_get(search_result_pb, SLAPI_PLUGIN_INTOP_SEARCH_ENTRIES, &search_entries);
+            for (i = 0; search_entries && search_entries[i] != NULL; i++) {
+                _update_batch_entry(search_entries[i], membership_attrs, targets, mod_pb);
+            }
+        } else if (isFatalSearchError(search_result)) {
+            slapi_log_err(SLAPI_LOG_ERR, REFERINT_PLUGIN_SUBSYSTEM,
+                          "update_integrity_batch - Search (base=%s filter=%s) returned "
+                          "error %d\n",
+                          slapi_sdn_get_dn(sdn), filter, search_result);
+            rc = SLAPI_PLUGIN_FAILURE;
+        }
+        slapi_free_search_results_internal(search_result_pb);
+
+        if (plugin_ContainerScope) {
+            sdn = NULL;
+        } else {
+            sdn = slapi_get_next_suffix(&node, 0);
+        }
+    }
+
+    PL_HashTableDestroy(targets);
+    slapi_ch_free_string(&filter);
+    slapi_ch_array_free(membership_attrs);
+    slapi_pblock_destroy(mod_pb);
+    slapi_pblock_destroy(search_result_pb);
+
+    return rc;
+}
+
+/*
+ * Count the records of a log or batch file.
+ */
+static uint64_t
+referint_count_records(const char *filename)
+{
+    PRFileDesc *prfd = NULL;
+    char buf[READ_BUFSIZE];
+    uint64_t records = 0;
+    int32_t len;
+
+    if ((prfd = PR_Open(filename, PR_RDONLY, REFERINT_DEFAULT_FILE_MODE)) == NULL) {
+        return 0;
+    }
+    while ((len = PR_Read(prfd, buf, sizeof(buf))) > 0) {
+        for (int32_t i = 0; i < len; i++) {
+            if (buf[i] == '\n') {
+                records++;
+            }
+        }
+    }
+    PR_Close(prfd);
+
+    return records;
+}
+
+/*
+ * Seed the queue state with the log and batch files left over by a
+ * previous run.  Their records are not dated, so they are considered
+ * queued since the startup.
+ */
+static void
+referint_seed_queue(void)
+{
+    char *logfilename = NULL;
+    char *batchfilename = NULL;
+    uint64_t pending;
+
+    referint_get_config(NULL, &logfilename);
+    batchfilename = slapi_ch_smprintf("%s%s", logfilename, REFERINT_BATCH_SUFFIX);
+
+    referint_lock();
+    queue_written = referint_count_records(logfilename);
+    queue_oldest = queue_written ? slapi_current_rel_time_t() : 0;
+    referint_unlock();
+
+    pending = referint_count_records(batchfilename);
+    batch_oldest = pending ? slapi_current_rel_time_t() : 0;
+    slapi_atomic_store_64(&batch_pending, pending, __ATOMIC_RELEASE);
+
+    slapi_ch_free_string(&logfilename);
+    slapi_ch_free_string(&batchfilename);
+}
+
 int
 referint_postop_start(Slapi_PBlock *pb)
 {
@@ -1312,7 +1579,7 @@ referint_postop_start(Slapi_PBlock *pb)
         pthread_condattr_t condAttr;
 
         /* initialize the cv and lock */
-        if (!use_txn && (NULL == referint_mutex)) {
+        if (NULL == referint_mutex) {
             referint_mutex = PR_NewLock();
         }
         if ((rc = pthread_mutex_init(&keeprunning_mutex, NULL)) != 0) {
@@ -1343,6 +1610,15 @@ referint_postop_start(Slapi_PBlock *pb)
 
         keeprunning = 1;
 
+        /* Account for the updates a previous run left queued */
+        referint_seed_queue();
+
+        /* Publish the queue statistics on the plugin entry */
+        slapi_config_register_callback_plugin(SLAPI_OPERATION_SEARCH, DSE_FLAG_PREOP | DSE_FLAG_PLUGIN,
+                                              slapi_sdn_get_ndn(referint_get_plugin_area()),
+                                              LDAP_SCOPE_BASE, "(objectclass=*)",
+                                              referint_queue_search, NULL, pb);
+
         referint_tid = PR_CreateThread(PR_USER_THREAD,
                                        referint_thread_func,
                                        NULL,
@@ -1371,6 +1647,9 @@ referint_postop_close(Slapi_PBlock *pb __attribute__((unused)))
 {
     /* signal the batch thread to exit */
     if (referint_get_delay() > 0) {
+        slapi_config_remove_callback(SLAPI_OPERATION_SEARCH, DSE_FLAG_PREOP,
+                                     slapi_sdn_get_ndn(referint_get_plugin_area()),
+                                     LDAP_SCOPE_BASE, "(objectclass=*)", referint_queue_search);
         pthread_mutex_lock(&keeprunning_mutex);
         keeprunning = 0;
         pthread_cond_signal(&keeprunning_cv);
@@ -1400,151 +1679,211 @@ referint_postop_close(Slapi_PBlock *pb __attribute__((unused)))
     return (0);
 }
 
-void
-referint_thread_func(void *arg __attribute__((unused)))
+static int
+referint_keeprunning(void)
+{
+    int running;
+
+    pthread_mutex_lock(&keeprunning_mutex);
+    running = keeprunning;
+    pthread_mutex_unlock(&keeprunning_mutex);
+
+    return running;
+}
+
+static void
+referint_wait(int delay)
+{
+    struct timespec current_time = {0};
+
+    pthread_mutex_lock(&keeprunning_mutex);
+    if (keeprunning) {
+        clock_gettime(CLOCK_MONOTONIC, &current_time);
+        current_time.tv_sec += delay;
+        pthread_cond_timedwait(&keeprunning_cv, &keeprunning_mutex, &current_time);
+    }
+    pthread_mutex_unlock(&keeprunning_mutex);
+}
+
+/* Account for records of the current batch that have been processed */
+static void
+referint_batch_done(uint64_t count)
+{
+    uint64_t pending = slapi_atomic_load_64(&batch_pending, __ATOMIC_ACQUIRE);
+
+    /* Only the batch thread updates these */
+    slapi_atomic_store_64(&batch_pending, pending > count ? pending - count : 0, __ATOMIC_RELEASE);
+    slapi_atomic_store_64(&queue_processed,
+                          slapi_atomic_load_64(&queue_processed, __ATOMIC_ACQUIRE) + count,
+                          __ATOMIC_RELEASE);
+}
+
+static void
+referint_flush_deleted(Slapi_DN **deleted, size_t *ndeleted)
+{
+    size_t i;
+
+    if (*ndeleted == 0) {
+        return;
+    }
+    update_integrity_batch(deleted, *ndeleted);
+    for (i = 0; i < *ndeleted; i++) {
+        slapi_sdn_free(&deleted[i]);
+    }
+    referint_batch_done(*ndeleted);
+    *ndeleted = 0;
+}
+
+/*
+ * Process the records of a batch file in order.  Consecutive deletes
+ * are collected and handed to update_integrity_batch() together.
+ *
+ * Returns 0 when the whole file was processed, 1 if we were asked to
+ * stop first.  The records are idempotent, so a partially processed
+ * file is simply processed again on the next run.
+ */
+static int
+referint_process_batch(PRFileDesc *prfd)
 {
-    PRFileDesc *prfd = NULL;
-    char *logfilename = NULL;
     char thisline[MAX_LINE];
     char delimiter[] = "\t\n";
     char *ptoken;
-    char *tmprdn;
+    char *tmprdn = NULL;
     char *iter = NULL;
     Slapi_DN *sdn = NULL;
     Slapi_DN *tmpsuperior = NULL;
-    struct timespec current_time = {0};
+    Slapi_DN *deleted[REFERINT_BATCH_SIZE];
+    size_t ndeleted = 0;
+    int stopped = 0;
+
+    my_fgetc(NULL);
+    while (GetNextLine(thisline, MAX_LINE, prfd)) {
+        if (!referint_keeprunning()) {
+            stopped = 1;
+            break;
+        }
+
+        ptoken = ldap_utf8strtok_r(thisline, delimiter, &iter);
+        sdn = slapi_sdn_new_normdn_byval(ptoken);
+        ptoken = ldap_utf8strtok_r(NULL, delimiter, &iter);
+        if (ptoken == NULL) {
+            goto invalid;
+        }
+        if (strcasecmp(ptoken, "NULL") != 0) {
+            tmprdn = slapi_ch_smprintf("%s", ptoken);
+        }
+
+        ptoken = ldap_utf8strtok_r(NULL, delimiter, &iter);
+        if (ptoken == NULL) {
+            goto invalid;
+        }
+        if (strcasecmp(ptoken, "NULL") != 0) {
+            tmpsuperior = slapi_sdn_new_normdn_byval(ptoken);
+        }
+
+        ptoken = ldap_utf8strtok_r(NULL, delimiter, &iter);
+        if (ptoken == NULL) {
+            goto invalid;
+        }
+        if (strcasecmp(ptoken, "NULL") != 0) {
+            /* The pending deletes were requested by the previous requestor */
+            referint_flush_deleted(deleted, &ndeleted);
+            /* Set the bind DN in the thread data */
+            if (slapi_td_set_dn(slapi_ch_strdup(ptoken))) {
+                slapi_log_err(SLAPI_LOG_ERR, REFERINT_PLUGIN_SUBSYSTEM, "referint_process_batch - "
+                                                                        "Failed to set thread data\n");
+            }
+        }
+
+        if (tmprdn == NULL && tmpsuperior == NULL) {
+            deleted[ndeleted++] = sdn;
+            sdn = NULL;
+            if (ndeleted == REFERINT_BATCH_SIZE) {
+                referint_flush_deleted(deleted, &ndeleted);
+            }
+        } else {
+            /* A rename has to see the deletes that were queued before it */
+            referint_flush_deleted(deleted, &ndeleted);
+            update_integrity(sdn, tmprdn, tmpsuperior, NULL);
+            referint_batch_done(1);
+        }
+        goto next;
+
+    invalid:
+        /* Invalid line in referint log, skip it */
+        slapi_log_err(SLAPI_LOG_ERR, REFERINT_PLUGIN_SUBSYSTEM,
+                      "Skipping invalid referint log line: (%s)\n", thisline);
+        referint_batch_done(1);
+    next:
+        slapi_sdn_free(&sdn);
+        slapi_ch_free_string(&tmprdn);
+        slapi_sdn_free(&tmpsuperior);
+    }
+    referint_flush_deleted(deleted, &ndeleted);
+
+    return stopped;
+}
+
+void
+referint_thread_func(void *arg __attribute__((unused)))
+{
+    PRFileDesc *prfd = NULL;
+    char *logfilename = NULL;
+    char *batchfilename = NULL;
     int delay;
-    int no_changes;
 
     slapi_atomic_store_64(&batch_thread_running, 1, __ATOMIC_RELEASE);
 
     /*
      * keep running this thread until plugin is signaled to close
      */
-    while (1) {
-        /*
-         * In case of shutdown, plugin close function (referint_postop_close)
-         * is waiting for the end of that thread to do the cleanup
-         */
-        pthread_mutex_lock(&keeprunning_mutex);
-        if (keeprunning == 0) {
-            pthread_mutex_unlock(&keeprunning_mutex);
-            break;
-        }
-        pthread_mutex_unlock(&keeprunning_mutex);
-
+    while (referint_keeprunning()) {
         /* refresh the config */
         slapi_ch_free_string(&logfilename);
+        slapi_ch_free_string(&batchfilename);
         referint_get_config(&delay, &logfilename);
+        batchfilename = slapi_ch_smprintf("%s%s", logfilename, REFERINT_BATCH_SUFFIX);
 
-        no_changes = 1;
-        while (no_changes) {
-
-            pthread_mutex_lock(&keeprunning_mutex);
-            if (keeprunning == 0) {
-                pthread_mutex_unlock(&keeprunning_mutex);
-                break;
-            }
-            pthread_mutex_unlock(&keeprunning_mutex);
-
-            referint_lock();
-            if ((prfd = PR_Open(logfilename, PR_RDONLY, REFERINT_DEFAULT_FILE_MODE)) == NULL) {
-                referint_unlock();
-                /* go back to sleep and wait for this file */
-                pthread_mutex_lock(&keeprunning_mutex);
-                clock_gettime(CLOCK_MONOTONIC, &current_time);
-                current_time.tv_sec += delay;
-                pthread_cond_timedwait(&keeprunning_cv, &keeprunning_mutex, &current_time);
-                pthread_mutex_unlock(&keeprunning_mutex);
-            } else {
-                no_changes = 0;
-            }
-        }
         /*
-         *  Check keep running here, because after break out of no
-         *  changes loop on shutdown, also need to break out of this
-         *  loop before trying to do the changes. The server
-         *  will pick them up on next startup as file still exists
+         * A batch file left over by a shutdown or a crash is processed
+         * before anything else.  Otherwise take over the current log
+         * file, the writers will start a new one.
          */
-        pthread_mutex_lock(&keeprunning_mutex);
-        if (keeprunning == 0) {
-            pthread_mutex_unlock(&keeprunning_mutex);
-            break;
-        }
-        pthread_mutex_unlock(&keeprunning_mutex);
-
-        while (GetNextLine(thisline, MAX_LINE, prfd)) {
-            ptoken = ldap_utf8strtok_r(thisline, delimiter, &iter);
-            sdn = slapi_sdn_new_normdn_byref(ptoken);
-            ptoken = ldap_utf8strtok_r(NULL, delimiter, &iter);
-
-            if (ptoken == NULL) {
-                /* Invalid line in referint log, skip it */
-                slapi_log_err(SLAPI_LOG_ERR, REFERINT_PLUGIN_SUBSYSTEM,
-                        "Skipping invalid referint log line: (%s)\n", thisline);
-                slapi_sdn_free(&sdn);
-                continue;
-            }
-            if (!strcasecmp(ptoken, "NULL")) {
-                tmprdn = NULL;
-            } else {
-                tmprdn = slapi_ch_smprintf("%s", ptoken);
-            }
-
-            ptoken = ldap_utf8strtok_r(NULL, delimiter, &iter);
-            if (ptoken == NULL) {
-                /* Invalid line in referint log, skip it */
-                slapi_log_err(SLAPI_LOG_ERR, REFERINT_PLUGIN_SUBSYSTEM,
-                        "Skipping invalid referint log line: (%s)\n", thisline);
-                slapi_sdn_free(&sdn);
-                continue;
+        referint_lock();
+        if (PR_Access(batchfilename, PR_ACCESS_EXISTS) == PR_SUCCESS) {
+            if (slapi_atomic_load_64(&batch_pending, __ATOMIC_ACQUIRE) == 0) {
+                batch_oldest = slapi_current_rel_time_t();
             }
-            if (!strcasecmp(ptoken, "NULL")) {
-                tmpsuperior = NULL;
-            } else {
-                tmpsuperior = slapi_sdn_new_normdn_byref(ptoken);
-            }
-
-            ptoken = ldap_utf8strtok_r(NULL, delimiter, &iter);
-            if (ptoken == NULL) {
-                /* Invalid line in referint log, skip it */
-                slapi_log_err(SLAPI_LOG_ERR, REFERINT_PLUGIN_SUBSYSTEM,
-                        "Skipping invalid referint log line: (%s)\n", thisline);
-                slapi_sdn_free(&sdn);
-                continue;
-            }
-            if (strcasecmp(ptoken, "NULL") != 0) {
-                /* Set the bind DN in the thread data */
-                if (slapi_td_set_dn(slapi_ch_strdup(ptoken))) {
-                    slapi_log_err(SLAPI_LOG_ERR, REFERINT_PLUGIN_SUBSYSTEM, "referint_thread_func - "
-                                                                            "Failed to set thread data\n");
-                }
-            }
-
-            update_integrity(sdn, tmprdn, tmpsuperior, NULL);
+        } else if (PR_Rename(logfilename, batchfilename) == PR_SUCCESS) {
+            slapi_atomic_store_64(&batch_pending, queue_written, __ATOMIC_RELEASE);
+            batch_oldest = queue_oldest ? queue_oldest : slapi_current_rel_time_t();
+            queue_written = 0;
+            queue_oldest = 0;
+        }
+        referint_unlock();
 
-            slapi_sdn_free(&sdn);
-            slapi_ch_free_string(&tmprdn);
-            slapi_sdn_free(&tmpsuperior);
+        if ((prfd = PR_Open(batchfilename, PR_RDONLY, REFERINT_DEFAULT_FILE_MODE)) == NULL) {
+            /* nothing queued, go back to sleep and wait for the log file */
+            referint_wait(delay);
+            continue;
         }
 
+        if (referint_process_batch(prfd)) {
+            /* Asked to stop, the rest is done on the next startup */
+            PR_Close(prfd);
+            break;
+        }
         PR_Close(prfd);
 
-        /* remove the original file */
-        if (PR_SUCCESS != PR_Delete(logfilename)) {
+        /* remove the processed batch */
+        if (PR_SUCCESS != PR_Delete(batchfilename)) {
             slapi_log_err(SLAPI_LOG_ERR, REFERINT_PLUGIN_SUBSYSTEM,
-                          "referint_thread_func - Could not delete \"%s\"\n", logfilename);
+                          "referint_thread_func - Could not delete \"%s\"\n", batchfilename);
         }
-
-        /* unlock and let other writers back at the file */
-        referint_unlock();
+        slapi_atomic_store_64(&batch_pending, 0, __ATOMIC_RELEASE);
 
         /* wait on condition here */
-        pthread_mutex_lock(&keeprunning_mutex);
-        clock_gettime(CLOCK_MONOTONIC, &current_time);
-        current_time.tv_sec += delay;
-        pthread_cond_timedwait(&keeprunning_cv, &keeprunning_mutex, &current_time);
-        pthread_mutex_unlock(&keeprunning_mutex);
+        referint_wait(delay);
     }
 
     slapi_atomic_store_64(&batch_thread_running, 0, __ATOMIC_RELEASE);
@@ -1553,6 +1892,7 @@ referint_thread_func(void *arg __attribute__((unused)))
     pthread_mutex_destroy(&keeprunning_mutex);
     pthread_cond_destroy(&keeprunning_cv);
     slapi_ch_free_string(&logfilename);
+    slapi_ch_free_string(&batchfilename);
 }
 
 int
@@ -1560,26 +1900,32 @@ my_fgetc(PRFileDesc *stream)
 {
     /* This is equivalent to memset of 0, but statically defined. */
     static char buf[READ_BUFSIZE] = {0};
-    static int position = READ_BUFSIZE;
+    static int position = 0;
+    static int count = 0;
     int retval;
-    int err;
+
+    /* A NULL stream drops what is left over from the previous file */
+    if (NULL == stream) {
+        position = count = 0;
+        return MY_EOF;
+    }
 
     /* check if we need to load the buffer */
-    if (READ_BUFSIZE == position) {
-        if ((err = PR_Read(stream, buf, READ_BUFSIZE)) >= 0) {
-            /* it read some data */;
-            position = 0;
-        } else {
+    if (count == position) {
+        if ((count = PR_Read(stream, buf, READ_BUFSIZE)) < 0) {
             /* an error occurred */
-            return err;
+            slapi_log_err(SLAPI_LOG_ERR, REFERINT_PLUGIN_SUBSYSTEM,
+                          "my_fgetc - PR_Read failed: NSPR error - %d\n", PR_GetError());
+            count = 0;
         }
+        position = 0;
     }
 
     /* try to read some data */
-    if ('\0' == buf[position]) {
+    if (position == count || '\0' == buf[position]) {
         /* out of data, return eof */
         retval = MY_EOF;
-        position = READ_BUFSIZE;
+        position = count = 0;
     } else {
         retval = buf[position];
         position++;
@@ -1639,9 +1985,8 @@ writeintegritylog(Slapi_PBlock *pb, char *logfilename, Slapi_DN *sdn, char *newr
         return;
     }
     /*
-     * Use this lock to protect file data when update integrity is occuring.
-     * If betxn is enabled, this mutex is ignored; transaction itself takes
-     * the role.
+     * Use this lock to protect the file while the batch thread takes
+     * it over.
      */
     referint_lock();
     if ((prfd = PR_Open(logfilename, PR_WRONLY | PR_CREATE_FILE | PR_APPEND,
@@ -1703,6 +2048,8 @@ writeintegritylog(Slapi_PBlock *pb, char *logfilename, Slapi_DN *sdn, char *newr
                           " writeintegritylog - PR_Write failed : The disk"
                           " may be full or the file is unwritable :: NSPR error - %d\n",
                           PR_GetError());
+        } else if (queue_written++ == 0) {
+            queue_oldest = slapi_current_rel_time_t();
         }
     }
 
@@ -1716,6 +2063,41 @@ writeintegritylog(Slapi_PBlock *pb, char *logfilename, Slapi_DN *sdn, char *newr
     referint_unlock();
 }
 
+/*
+ * DSE search callback adding the state of the delayed update queue to
+ * the plugin entry: the number of queued updates, the age in seconds of
+ * the oldest one, and the number of updates processed since startup.
+ */
+static int
+referint_queue_search(Slapi_PBlock *pb __attribute__((unused)),
+                      Slapi_Entry *e,
+                      Slapi_Entry *entryAfter __attribute__((unused)),
+                      int *returncode __attribute__((unused)),
+                      char *returntext __attribute__((unused)),
+                      void *arg __attribute__((unused)))
+{
+    uint64_t pending = slapi_atomic_load_64(&batch_pending, __ATOMIC_ACQUIRE);
+    time_t now = slapi_current_rel_time_t();
+    time_t oldest = now;
+    uint64_t depth;
+
+    referint_lock();
+    depth = queue_written + pending;
+    if (pending && batch_oldest) {
+        oldest = batch_oldest;
+    } else if (queue_written) {
+        oldest = queue_oldest;
+    }
+    referint_unlock();
+
+    slapi_entry_attr_set_ulong(e, REFERINT_ATTR_QUEUE_DEPTH, depth);
+    slapi_entry_attr_set_ulong(e, REFERINT_ATTR_QUEUE_LAG, now - oldest);
+    slapi_entry_attr_set_ulong(e, REFERINT_ATTR_PROCESSED,
+                               slapi_atomic_load_64(&queue_processed, __ATOMIC_ACQUIRE));
+
+    return SLAPI_DSE_CALLBACK_OK;
+}
+
 static int
 referint_preop_init(Slapi_PBlock *pb)
 {
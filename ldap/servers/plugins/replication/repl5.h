@@ -67,6 +67,9 @@
  * new set of start and response extops. */
 #define REPL_START_NSDS90_REPLICATION_REQUEST_OID "2.16.840.1.113730.3.5.12"
 #define REPL_NSDS90_REPLICATION_RESPONSE_OID      "2.16.840.1.113730.3.5.13"
+/* Total update entries sent by batches: a compressed run of NSDS50ReplicationEntry
+ * payloads per extended operation. Only sent when the consumer lists it. */
+#define REPL_NSDS_REPLICATION_ENTRY_BATCH_REQUEST_OID "2.16.840.1.113730.3.5.17"
 /* cleanallruv extended ops */
 #define REPL_CLEANRUV_OID              "2.16.840.1.113730.3.6.5"
 #define REPL_ABORT_CLEANRUV_OID        "2.16.840.1.113730.3.6.6"
@@ -159,6 +162,7 @@ extern const char *type_nsds5ReplicaEnabled;
 extern const char *type_nsds5ReplicaStripAttrs;
 extern const char *type_nsds5ReplicaFlowControlWindow;
 extern const char *type_nsds5ReplicaFlowControlPause;
+extern const char *type_nsds5ReplicaTotalUpdateBatchSize;
 extern const char *type_replicaProtocolTimeout;
 extern const char *type_replicaReleaseTimeout;
 extern const char *type_replicaBackoffMin;
@@ -394,6 +398,7 @@ long agmt_get_busywaittime(const Repl_Agmt *ra);
 long agmt_get_pausetime(const Repl_Agmt *ra);
 long agmt_get_flowcontrolwindow(const Repl_Agmt *ra);
 long agmt_get_flowcontrolpause(const Repl_Agmt *ra);
+long agmt_get_totalupdatebatchsize(const Repl_Agmt *ra);
 long agmt_get_ignoremissing(const Repl_Agmt *ra);
 int agmt_start(Repl_Agmt *ra);
 int windows_agmt_start(Repl_Agmt *ra);
@@ -421,6 +426,7 @@ int agmt_set_schedule_from_entry(Repl_Agmt *ra, const Slapi_Entry *e);
 int agmt_set_timeout_from_entry(Repl_Agmt *ra, const Slapi_Entry *e);
 int agmt_set_flowcontrolwindow_from_entry(Repl_Agmt *ra, const Slapi_Entry *e);
 int agmt_set_flowcontrolpause_from_entry(Repl_Agmt *ra, const Slapi_Entry *e);
+int agmt_set_totalupdatebatchsize_from_entry(Repl_Agmt *ra, const Slapi_Entry *e);
 int agmt_set_ignoremissing_from_entry(Repl_Agmt *ra, const Slapi_Entry *e);
 int agmt_set_busywaittime_from_entry(Repl_Agmt *ra, const Slapi_Entry *e);
 int agmt_set_pausetime_from_entry(Repl_Agmt *ra, const Slapi_Entry *e);
@@ -605,7 +611,9 @@ typedef enum {
     CONN_IS_WIN2K3,
     CONN_NOT_WIN2K3,
     CONN_SUPPORTS_DS90_REPL,
-    CONN_DOES_NOT_SUPPORT_DS90_REPL
+    CONN_DOES_NOT_SUPPORT_DS90_REPL,
+    CONN_SUPPORTS_ENTRY_BATCH,
+    CONN_DOES_NOT_SUPPORT_ENTRY_BATCH
 } ConnResult;
 
 char *conn_result2string(int result);
@@ -626,6 +634,7 @@ void conn_cancel_linger(Repl_Connection *conn);
 ConnResult conn_replica_supports_ds5_repl(Repl_Connection *conn);
 ConnResult conn_replica_supports_ds71_repl(Repl_Connection *conn);
 ConnResult conn_replica_supports_ds90_repl(Repl_Connection *conn);
+ConnResult conn_replica_supports_entry_batch(Repl_Connection *conn);
 ConnResult conn_replica_is_readonly(Repl_Connection *conn);
 
 ConnResult conn_read_entry_attribute(Repl_Connection *conn, const char *dn, char *type, struct berval ***returned_bvals);
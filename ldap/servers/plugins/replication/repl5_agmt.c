@@ -67,6 +67,7 @@
 #define DEFAULT_FLOWCONTROL_PAUSE       2000 /* msec of pause when #entries sent witout acknowledgment (bdb) */
 #define LMDB_DEFAULT_FLOWCONTROL_WINDOW 50   /* #entries sent without acknowledgment (lmdb) */
 #define LMDB_DEFAULT_FLOWCONTROL_PAUSE  200  /* msec of pause when #entries sent witout acknowledgment (lmdb) */
+#define MAX_TOTALUPDATE_BATCHSIZE       10000 /* #entries per total update batch */
 
 #define STATUS_LEN 2048
 #define STATUS_GOOD "green"
@@ -145,6 +146,7 @@ typedef struct repl5agmt
     int64_t flowControlWindow;         /* This is the maximum number of entries sent without acknowledgment */
     int64_t flowControlPause;          /* When nb of not acknowledged entries overpass totalUpdateWindow
                                         * This is the duration (in msec) that the RA will pause before sending the next entry */
+    int64_t totalUpdateBatchSize;      /* #entries per total update extended operation, 0 sends them one by one */
     int64_t ignoreMissingChange;       /* if set replication will try to continue even if change cannot be found in changelog */
     Slapi_RWLock *attr_lock;           /* RW lock for all the stripped attrs */
     int64_t WaitForAsyncResults;       /* Pass to DS_Sleep(PR_MillisecondsToInterval(WaitForAsyncResults))
@@ -497,6 +499,16 @@ agmt_new_from_entry(Slapi_Entry *e)
         ra->flowControlPause = pause;
     }
 
+    /* total update batches */
+    ra->totalUpdateBatchSize = 0;
+    if ((val = slapi_entry_attr_get_ref(e, type_nsds5ReplicaTotalUpdateBatchSize))){
+        int64_t batchsize;
+        if (repl_config_valid_num(type_nsds5ReplicaTotalUpdateBatchSize, (char *)val, 0, MAX_TOTALUPDATE_BATCHSIZE, &rc, errormsg, &batchsize) != 0) {
+            goto loser;
+        }
+        ra->totalUpdateBatchSize = batchsize;
+    }
+
     /* continue on missing change ? */
     ra->ignoreMissingChange = 0;
     tmpstr = (char *)slapi_entry_attr_get_ref(e, type_replicaIgnoreMissingChange);
@@ -1359,6 +1371,16 @@ agmt_get_flowcontrolpause(const Repl_Agmt *ra)
     return return_value;
 }
 long
+agmt_get_totalupdatebatchsize(const Repl_Agmt *ra)
+{
+    long return_value;
+    PR_ASSERT(NULL != ra);
+    PR_Lock(ra->lock);
+    return_value = ra->totalUpdateBatchSize;
+    PR_Unlock(ra->lock);
+    return return_value;
+}
+long
 agmt_get_ignoremissing(const Repl_Agmt *ra)
 {
     long return_value;
@@ -2265,6 +2287,44 @@ agmt_set_flowcontrolpause_from_entry(Repl_Agmt *ra, const Slapi_Entry *e)
     }
     return return_value;
 }
+
+/*
+ * Set or reset the number of entries sent per total update extended operation
+ *
+ * Returns 0 if the size is set, or -1 if an error occurred.
+ */
+int
+agmt_set_totalupdatebatchsize_from_entry(Repl_Agmt *ra, const Slapi_Entry *e)
+{
+    Slapi_Attr *sattr = NULL;
+    int return_value = -1;
+
+    PR_ASSERT(NULL != ra);
+    PR_Lock(ra->lock);
+    if (ra->stop_in_progress) {
+        PR_Unlock(ra->lock);
+        return return_value;
+    }
+
+    slapi_entry_attr_find(e, type_nsds5ReplicaTotalUpdateBatchSize, &sattr);
+    if (NULL != sattr) {
+        Slapi_Value *sval = NULL;
+        slapi_attr_first_value(sattr, &sval);
+        if (NULL != sval) {
+            long tmpval = slapi_value_get_long(sval);
+            if (tmpval >= 0 && tmpval <= MAX_TOTALUPDATE_BATCHSIZE) {
+                ra->totalUpdateBatchSize = tmpval;
+                return_value = 0; /* success! */
+            }
+        }
+    } else {
+        /* attribute removed */
+        ra->totalUpdateBatchSize = 0;
+        return_value = 0;
+    }
+    PR_Unlock(ra->lock);
+    return return_value;
+}
 /* add comment here */
 int
 agmt_set_ignoremissing_from_entry(Repl_Agmt *ra, const Slapi_Entry *e)
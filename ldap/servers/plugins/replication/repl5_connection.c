@@ -48,6 +48,7 @@ typedef struct repl_connection
     int supports_ds40_repl; /* 1 if does, 0 if doesn't, -1 if not determined */
     int supports_ds71_repl; /* 1 if does, 0 if doesn't, -1 if not determined */
     int supports_ds90_repl; /* 1 if does, 0 if doesn't, -1 if not determined */
+    int supports_entry_batch; /* 1 if does, 0 if doesn't, -1 if not determined */
     int linger_time;        /* time in seconds to leave an idle connection open */
     PRBool linger_active;
     Slapi_Eq_Context *linger_event;
@@ -162,6 +163,10 @@ conn_result2string(int result)
         return "consumer supports all DS90 extop";
     case CONN_DOES_NOT_SUPPORT_DS90_REPL:
         return "consumer does not support all DS90 extop";
+    case CONN_SUPPORTS_ENTRY_BATCH:
+        return "consumer supports total update entry batches";
+    case CONN_DOES_NOT_SUPPORT_ENTRY_BATCH:
+        return "consumer does not support total update entry batches";
     default:
         return NULL;
     }
@@ -194,6 +199,7 @@ conn_new(Repl_Agmt *agmt)
     rpc->supports_ds50_repl = -1;
     rpc->supports_ds71_repl = -1;
     rpc->supports_ds90_repl = -1;
+    rpc->supports_entry_batch = -1;
 
     rpc->linger_active = PR_FALSE;
     rpc->delete_after_linger = PR_FALSE;
@@ -604,7 +610,9 @@ check_flow_control_tot_init(Repl_Connection *conn, int optype, const char *extop
     int rcv_msgid;
     int once;
 
-    if ((sent_msgid != 0) && (optype == CONN_EXTENDED_OPERATION) && (strcmp(extop_oid, REPL_NSDS50_REPLICATION_ENTRY_REQUEST_OID) == 0)) {
+    if ((sent_msgid != 0) && (optype == CONN_EXTENDED_OPERATION) &&
+        ((strcmp(extop_oid, REPL_NSDS50_REPLICATION_ENTRY_REQUEST_OID) == 0) ||
+         (strcmp(extop_oid, REPL_NSDS_REPLICATION_ENTRY_BATCH_REQUEST_OID) == 0))) {
         /* We are sending entries part of the total update of a consumer
          * Wait a bit if the consumer needs to catchup from the current sent entries
          */
@@ -1281,6 +1289,7 @@ close_connection_internal(Repl_Connection *conn)
     conn->supports_ds50_repl = -1;
     conn->supports_ds71_repl = -1;
     conn->supports_ds90_repl = -1;
+    conn->supports_entry_batch = -1;
     /* do this last, to minimize the chance that another thread
        might read conn->state as not disconnected and attempt
        to use conn->ld */
@@ -1490,6 +1499,66 @@ conn_replica_supports_ds90_repl(Repl_Connection *conn)
     return return_value;
 }
 
+/*
+ * Determine if the remote replica accepts the total update entries by batches.
+ * Return codes:
+ * CONN_SUPPORTS_ENTRY_BATCH - the remote replica accepts the batches
+ * CONN_DOES_NOT_SUPPORT_ENTRY_BATCH - the remote replica only accepts
+ * one entry per extended operation.
+ * CONN_OPERATION_FAILED - it could not be determined if the remote
+ * replica accepts the batches.
+ * CONN_NOT_CONNECTED - no connection was active.
+ */
+ConnResult
+conn_replica_supports_entry_batch(Repl_Connection *conn)
+{
+    ConnResult return_value;
+    int ldap_rc;
+
+    PR_Lock(conn->lock);
+    if (conn_connected(conn)) {
+        if (conn->supports_entry_batch == -1) {
+            LDAPMessage *res = NULL;
+            LDAPMessage *entry = NULL;
+            char *attrs[] = {"supportedextension", NULL};
+
+            conn->status = STATUS_SEARCHING;
+            ldap_rc = ldap_search_ext_s(conn->ld, "", LDAP_SCOPE_BASE,
+                                        "(objectclass=*)", attrs, 0 /* attrsonly */,
+                                        NULL /* server controls */, NULL /* client controls */,
+                                        &conn->timeout, LDAP_NO_LIMIT, &res);
+            if (LDAP_SUCCESS == ldap_rc) {
+                conn->supports_entry_batch = 0;
+                entry = ldap_first_entry(conn->ld, res);
+                if (!attribute_string_value_present(conn->ld, entry, "supportedextension", REPL_NSDS_REPLICATION_ENTRY_BATCH_REQUEST_OID)) {
+                    return_value = CONN_DOES_NOT_SUPPORT_ENTRY_BATCH;
+                } else {
+                    conn->supports_entry_batch = 1;
+                    return_value = CONN_SUPPORTS_ENTRY_BATCH;
+                }
+            } else {
+                if (IS_DISCONNECT_ERROR(ldap_rc)) {
+                    conn->last_ldap_error = ldap_rc; /* specific reason */
+                    close_connection_internal(conn);
+                    return_value = CONN_NOT_CONNECTED;
+                } else {
+                    return_value = CONN_OPERATION_FAILED;
+                }
+            }
+            if (NULL != res)
+                ldap_msgfree(res);
+        } else {
+            return_value = conn->supports_entry_batch ? CONN_SUPPORTS_ENTRY_BATCH : CONN_DOES_NOT_SUPPORT_ENTRY_BATCH;
+        }
+    } else {
+        /* Not connected */
+        return_value = CONN_NOT_CONNECTED;
+    }
+    PR_Unlock(conn->lock);
+
+    return return_value;
+}
+
 /* Determine if the replica is read-only */
 ConnResult
 conn_replica_is_readonly(Repl_Connection *conn)
@@ -3193,7 +3193,8 @@ process_reap_entry(Slapi_Entry *entry, void *cb_data)
                           csn_as_string(deletion_csn, PR_FALSE, deletion_csn_str),
                           csn_as_string(purge_csn, PR_FALSE, purge_csn_str));
         }
-        if (slapi_entry_attr_get_ulong(entry, "tombstonenumsubordinates") < 1) {
+        /* The backend may hold the tombstone children count in memory */
+        if (slapi_entry_has_children_ext(entry, 1) < 1) {
             _delete_tombstone(slapi_entry_get_dn(entry),
                               slapi_entry_get_uniqueid(entry), 0);
             (*num_purged_entriesp)++;
@@ -3279,11 +3280,13 @@ _replica_reap_tombstones(void *arg)
         /* we just need the objectclass - for the deletion csn
            and the dn and nsuniqueid - for possible deletion
            and tombstonenumsubordinates to check if it has numsubordinates
-           saves time to return only 3 attrs
+           (entryid to get the count from the backend)
+           saves time to return only a few attrs
         */
         charray_add(&attrs, slapi_ch_strdup("objectclass"));
         charray_add(&attrs, slapi_ch_strdup("nsuniqueid"));
         charray_add(&attrs, slapi_ch_strdup("tombstonenumsubordinates"));
+        charray_add(&attrs, slapi_ch_strdup("entryid"));
         charray_add(&attrs, slapi_ch_strdup(SLAPI_ATTR_TOMBSTONE_CSN));
 
         ctrls = (LDAPControl **)slapi_ch_calloc(3, sizeof(LDAPControl *));
@@ -22,6 +22,7 @@
 
 #include "repl5.h"
 #include "repl5_prot_private.h"
+#include <zlib.h>
 
 /* Private data structures */
 typedef struct repl5_tot_private
@@ -53,8 +54,20 @@ typedef struct callback_data
     int last_message_id_sent;
     int last_message_id_received;
     int flowcontrol_detection;
+    long batch_size;                         /* Entries per batch, 0 if they are sent one by one */
+    char *batch;                             /* Encoded entries of the current batch */
+    size_t batch_len;
+    size_t batch_capacity;
+    int batch_count;                         /* Entries in the current batch */
+    int batch_number;                        /* Batches sent so far */
 } callback_data;
 
+/*
+ * A batch is sent when it holds batch_size entries or this many bytes, so that
+ * the compressed batches stay well below the default maxbersize of the consumer.
+ */
+#define TOT_BATCH_MAX_BYTES (1024 * 1024)
+
 /*
  * Number of window seconds to wait until we programmatically decide
  * that the replica has got out of BUSY state
@@ -64,6 +77,7 @@ typedef struct callback_data
 /* Helper functions */
 static void get_result(int rc, void *cb_data);
 static int send_entry(Slapi_Entry *e, void *callback_data);
+static int send_entry_batch(callback_data *cb_data);
 static void repl5_tot_delete(Private_Repl_Protocol **prp);
 
 #define LOST_CONN_ERR(xx) ((xx == -2) || (xx == LDAP_SERVER_DOWN) || (xx == LDAP_CONNECT_ERROR))
@@ -481,6 +495,18 @@ retry:
     cb_data.flowcontrol_detection = 0;
     pthread_mutex_init(&(cb_data.lock), NULL);
 
+    /* Send the entries by compressed batches if the agreement asks for it
+     * and the consumer knows about them */
+    cb_data.batch_size = agmt_get_totalupdatebatchsize(prp->agmt);
+    if (cb_data.batch_size > 0 &&
+        (prp->repl50consumer || conn_replica_supports_entry_batch(prp->conn) != CONN_SUPPORTS_ENTRY_BATCH)) {
+        slapi_log_err(SLAPI_LOG_INFO, repl_plugin_name,
+                      "repl5_tot_run - %s - The consumer does not support total update batches, "
+                      "sending the entries one by one.\n",
+                      agmt_get_long_name(prp->agmt));
+        cb_data.batch_size = 0;
+    }
+
     /* This allows during perform_operation to check the callback data
      * especially to do flow contol on delta send msgid / recv msgid
      */
@@ -539,6 +565,11 @@ retry:
                                       send_entry /* entry callback */,
                                       NULL /* referral callback*/);
 
+    /* Send the last partial batch */
+    if (cb_data.batch_size > 0 && cb_data.rc == CONN_OPERATION_SUCCESS) {
+        send_entry_batch(&cb_data);
+    }
+
     /*
      * After completing the sending operation (or optionally failing), we need to clean up
      * the async propagation stuff:
@@ -579,6 +610,11 @@ retry:
         slapi_log_err(SLAPI_LOG_INFO, repl_plugin_name,
                       "repl5_tot_run - Finished total update of replica \"%s\". Sent %lu entries.\n",
                       agmt_get_long_name(prp->agmt), cb_data.num_entries);
+        if (cb_data.batch_size > 0) {
+            slapi_log_err(SLAPI_LOG_INFO, repl_plugin_name,
+                          "repl5_tot_run - %s - The entries were sent in %d batches.\n",
+                          agmt_get_long_name(prp->agmt), cb_data.batch_number);
+        }
         agmt_set_last_init_status(prp->agmt, 0, 0, 0, "Total update succeeded");
         agmt_set_last_update_status(prp->agmt, 0, 0, NULL);
     }
@@ -598,6 +634,7 @@ done:
     }
     conn_set_tot_update_cb(prp->conn, NULL);
     pthread_mutex_destroy(&(cb_data.lock));
+    slapi_ch_free_string(&cb_data.batch);
     prp->stopped = 1;
 }
 
@@ -759,6 +796,133 @@ repl5_tot_flowcontrol_detection(Repl_Connection *conn, int increment)
     }
 }
 
+/*
+ * Push a total update extended operation to the consumer, waiting while it is busy.
+ * Returns 0 on success, -1 otherwise with the error in cb_data->rc.
+ */
+static int
+send_total_update_extop(callback_data *cb_data, const char *extop_oid, struct berval *bv)
+{
+    Private_Repl_Protocol *prp = cb_data->prp;
+    int message_id = 0;
+    int rc;
+
+    do {
+        /* push the entry to the consumer */
+        rc = conn_send_extended_operation(prp->conn, extop_oid,
+                                          bv /* payload */, NULL /* update_control */, &message_id);
+
+        if (message_id) {
+            cb_data->last_message_id_sent = message_id;
+        }
+
+        /* If we are talking to a 5.0 type consumer, we need to wait here and retrieve the
+         * response. Reason is that it can return LDAP_BUSY, indicating that its queue has
+         * filled up. This completely breaks pipelineing, and so we need to fall back to
+         * sync transmission for those consumers, in case they pull the LDAP_BUSY stunt on us :( */
+
+        if (prp->repl50consumer) {
+            /* Get the response here */
+            rc = repl5_tot_get_next_result(cb_data);
+        }
+
+        if (rc == CONN_BUSY) {
+            time_t now = slapi_current_rel_time_t();
+            if ((now - cb_data->last_busy) < (cb_data->sleep_on_busy + 10)) {
+                cb_data->sleep_on_busy += 5;
+            } else {
+                cb_data->sleep_on_busy = 5;
+            }
+            cb_data->last_busy = now;
+
+            slapi_log_err(SLAPI_LOG_ERR, repl_plugin_name,
+                          "send_entry - Replica \"%s\" is busy. Waiting %ds while"
+                          " it finishes processing its current import queue\n",
+                          agmt_get_long_name(prp->agmt), cb_data->sleep_on_busy);
+            DS_Sleep(PR_SecondsToInterval(cb_data->sleep_on_busy));
+        }
+    } while (rc == CONN_BUSY);
+
+    /* if the connection has been closed, we need to stop
+       sending entries and set a special rc value to let
+       the result reading thread know the connection has been
+       closed - do not attempt to read any more results */
+    if (CONN_NOT_CONNECTED == rc) {
+        cb_data->rc = -2;
+        return -1;
+    }
+    cb_data->rc = rc;
+    return (CONN_OPERATION_SUCCESS == rc) ? 0 : -1;
+}
+
+/*
+ * Compress the queued entries and send them as one extended operation
+ * (see decode_total_update_batch for the encoding).
+ */
+static int
+send_entry_batch(callback_data *cb_data)
+{
+    BerElement *bere = NULL;
+    struct berval *bv = NULL;
+    char *zbatch = NULL;
+    uLongf zlen;
+    int retval = -1;
+
+    if (cb_data->batch_count == 0) {
+        return 0;
+    }
+
+    zlen = compressBound(cb_data->batch_len);
+    zbatch = slapi_ch_malloc(zlen);
+    if (compress2((Bytef *)zbatch, &zlen, (Bytef *)cb_data->batch, cb_data->batch_len, Z_BEST_SPEED) != Z_OK) {
+        slapi_log_err(SLAPI_LOG_ERR, repl_plugin_name, "%s: send_entry_batch: Compression Error\n",
+                      agmt_get_long_name(cb_data->prp->agmt));
+        cb_data->rc = -1;
+        goto done;
+    }
+    if ((bere = ber_alloc()) == NULL ||
+        ber_printf(bere, "{iiio}", cb_data->batch_number, cb_data->batch_count,
+                   (ber_int_t)cb_data->batch_len, zbatch, (ber_len_t)zlen) == -1 ||
+        ber_flatten(bere, &bv) != 0) {
+        slapi_log_err(SLAPI_LOG_REPL, repl_plugin_name, "%s: send_entry_batch: Encoding Error\n",
+                      agmt_get_long_name(cb_data->prp->agmt));
+        cb_data->rc = -1;
+        goto done;
+    }
+
+    retval = send_total_update_extop(cb_data, REPL_NSDS_REPLICATION_ENTRY_BATCH_REQUEST_OID, bv);
+    cb_data->batch_number++;
+    cb_data->batch_count = 0;
+    cb_data->batch_len = 0;
+
+done:
+    if (bere) {
+        ber_free(bere, 1);
+    }
+    ber_bvfree(bv);
+    slapi_ch_free_string(&zbatch);
+    return retval;
+}
+
+/* Append an encoded entry to the current batch, and send the batch once it is full */
+static int
+queue_entry(callback_data *cb_data, struct berval *bv)
+{
+    if (cb_data->batch_len + bv->bv_len > cb_data->batch_capacity) {
+        cb_data->batch_capacity = cb_data->batch_len + bv->bv_len + TOT_BATCH_MAX_BYTES / 4;
+        cb_data->batch = slapi_ch_realloc(cb_data->batch, cb_data->batch_capacity);
+    }
+    memcpy(cb_data->batch + cb_data->batch_len, bv->bv_val, bv->bv_len);
+    cb_data->batch_len += bv->bv_len;
+    cb_data->batch_count++;
+
+    if (cb_data->batch_count >= cb_data->batch_size || cb_data->batch_len >= TOT_BATCH_MAX_BYTES) {
+        return send_entry_batch(cb_data);
+    }
+    cb_data->rc = CONN_OPERATION_SUCCESS;
+    return 0;
+}
+
 static int
 send_entry(Slapi_Entry *e, void *cb_data)
 {
@@ -767,9 +931,6 @@ send_entry(Slapi_Entry *e, void *cb_data)
     BerElement *bere;
     struct berval *bv;
     unsigned long *num_entriesp;
-    uint32_t *sleep_on_busyp;
-    time_t *last_busyp;
-    int message_id = 0;
     int retval = 0;
     char **frac_excluded_attrs = NULL;
 
@@ -777,8 +938,6 @@ send_entry(Slapi_Entry *e, void *cb_data)
 
     prp = ((callback_data *)cb_data)->prp;
     num_entriesp = &((callback_data *)cb_data)->num_entries;
-    sleep_on_busyp = &((callback_data *)cb_data)->sleep_on_busy;
-    last_busyp = &((callback_data *)cb_data)->last_busy;
     PR_ASSERT(prp);
 
     if (prp->terminate) {
@@ -834,60 +993,18 @@ send_entry(Slapi_Entry *e, void *cb_data)
         goto error;
     }
 
-    do {
-        /* push the entry to the consumer */
-        rc = conn_send_extended_operation(prp->conn, REPL_NSDS50_REPLICATION_ENTRY_REQUEST_OID,
-                                          bv /* payload */, NULL /* update_control */, &message_id);
-
-        if (message_id) {
-            ((callback_data *)cb_data)->last_message_id_sent = message_id;
-        }
-
-        /* If we are talking to a 5.0 type consumer, we need to wait here and retrieve the
-         * response. Reason is that it can return LDAP_BUSY, indicating that its queue has
-         * filled up. This completely breaks pipelineing, and so we need to fall back to
-         * sync transmission for those consumers, in case they pull the LDAP_BUSY stunt on us :( */
-
-        if (prp->repl50consumer) {
-            /* Get the response here */
-            rc = repl5_tot_get_next_result((callback_data *)cb_data);
-        }
-
-        if (rc == CONN_BUSY) {
-            time_t now = slapi_current_rel_time_t();
-            if ((now - *last_busyp) < (*sleep_on_busyp + 10)) {
-                *sleep_on_busyp += 5;
-            } else {
-                *sleep_on_busyp = 5;
-            }
-            *last_busyp = now;
-
-            slapi_log_err(SLAPI_LOG_ERR, repl_plugin_name,
-                          "send_entry - Replica \"%s\" is busy. Waiting %ds while"
-                          " it finishes processing its current import queue\n",
-                          agmt_get_long_name(prp->agmt), *sleep_on_busyp);
-            DS_Sleep(PR_SecondsToInterval(*sleep_on_busyp));
-        }
-    } while (rc == CONN_BUSY);
+    if (((callback_data *)cb_data)->batch_size > 0) {
+        /* queue the entry, the batch goes when it is full */
+        retval = queue_entry((callback_data *)cb_data, bv);
+        ber_bvfree(bv);
+        (*num_entriesp)++;
+        goto error;
+    }
 
+    retval = send_total_update_extop((callback_data *)cb_data, REPL_NSDS50_REPLICATION_ENTRY_REQUEST_OID, bv);
     ber_bvfree(bv);
     (*num_entriesp)++;
 
-    /* if the connection has been closed, we need to stop
-       sending entries and set a special rc value to let
-       the result reading thread know the connection has been
-       closed - do not attempt to read any more results */
-    if (CONN_NOT_CONNECTED == rc) {
-        ((callback_data *)cb_data)->rc = -2;
-        retval = -1;
-    } else {
-        ((callback_data *)cb_data)->rc = rc;
-        if (CONN_OPERATION_SUCCESS == rc) {
-            retval = 0;
-        } else {
-            retval = -1;
-        }
-    }
 error:
     return retval;
 }
@@ -47,6 +47,7 @@
 */
 
 #include "repl5.h"
+#include <zlib.h>
 
 #define CSN_TYPE_VALUE_UPDATED_ON_WIRE 1
 #define CSN_TYPE_VALUE_DELETED_ON_WIRE 2
@@ -616,43 +617,20 @@ loser:
 }
 
 /*
- * Extract the payload from a total update extended operation,
- * decode it, and produce a Slapi_Entry structure representing a new
- * entry to be added to the local database.
+ * Decode the next entry of a total update stream and produce a Slapi_Entry
+ * structure representing a new entry to be added to the local database.
  */
 static int
-decode_total_update_extop(Slapi_PBlock *pb, Slapi_Entry **ep)
+decode_total_update_entry(BerElement *tmp_bere, Slapi_Entry **ep)
 {
-    BerElement *tmp_bere = NULL;
     Slapi_Entry *e = NULL;
     Slapi_Attr *attr = NULL;
     char *str = NULL;
-    struct berval *extop_value = NULL;
-    char *extop_oid = NULL;
     ber_len_t len;
     char *lasto;
     ber_tag_t tag;
-    int rc;
     PRBool deleted;
 
-    PR_ASSERT(NULL != pb);
-    PR_ASSERT(NULL != ep);
-
-    slapi_pblock_get(pb, SLAPI_EXT_OP_REQ_OID, &extop_oid);
-    slapi_pblock_get(pb, SLAPI_EXT_OP_REQ_VALUE, &extop_value);
-
-    if ((NULL == extop_oid) ||
-        ((strcmp(extop_oid, REPL_NSDS50_REPLICATION_ENTRY_REQUEST_OID) != 0) &&
-         (strcmp(extop_oid, REPL_NSDS71_REPLICATION_ENTRY_REQUEST_OID) != 0)) ||
-        !BV_HAS_DATA(extop_value)) {
-        /* Bogus */
-        goto loser;
-    }
-
-    if ((tmp_bere = ber_init(extop_value)) == NULL) {
-        goto loser;
-    }
-
     if ((e = slapi_entry_alloc()) == NULL) {
         goto loser;
     }
@@ -715,13 +693,10 @@ decode_total_update_extop(Slapi_PBlock *pb, Slapi_Entry **ep)
     }
 
     /* If we get here, the entry is properly constructed. Return it. */
-
-    rc = 0;
     *ep = e;
-    goto free_and_return;
+    return 0;
 
 loser:
-    rc = -1;
     /* slapi_ch_free accepts NULL pointer */
     slapi_ch_free((void **)&str);
 
@@ -733,20 +708,179 @@ loser:
         slapi_entry_free(e);
     }
     *ep = NULL;
-    slapi_log_err(SLAPI_LOG_ERR, repl_plugin_name, "decode_total_update_extop - Could not decode extended "
-                                                   "operation containing entry for total update.\n");
+    return -1;
+}
 
-free_and_return:
-    if (NULL != tmp_bere) {
+/*
+ * Extract the payload from a total update extended operation,
+ * decode it, and produce a Slapi_Entry structure representing a new
+ * entry to be added to the local database.
+ */
+static int
+decode_total_update_extop(Slapi_PBlock *pb, Slapi_Entry **ep)
+{
+    BerElement *tmp_bere = NULL;
+    struct berval *extop_value = NULL;
+    char *extop_oid = NULL;
+    int rc = -1;
+
+    PR_ASSERT(NULL != pb);
+    PR_ASSERT(NULL != ep);
+
+    *ep = NULL;
+    slapi_pblock_get(pb, SLAPI_EXT_OP_REQ_OID, &extop_oid);
+    slapi_pblock_get(pb, SLAPI_EXT_OP_REQ_VALUE, &extop_value);
+
+    if ((NULL != extop_oid) &&
+        ((strcmp(extop_oid, REPL_NSDS50_REPLICATION_ENTRY_REQUEST_OID) == 0) ||
+         (strcmp(extop_oid, REPL_NSDS71_REPLICATION_ENTRY_REQUEST_OID) == 0)) &&
+        BV_HAS_DATA(extop_value) &&
+        (tmp_bere = ber_init(extop_value)) != NULL) {
+        rc = decode_total_update_entry(tmp_bere, ep);
         ber_free(tmp_bere, 1);
-        tmp_bere = NULL;
+    }
+
+    if (rc) {
+        slapi_log_err(SLAPI_LOG_ERR, repl_plugin_name, "decode_total_update_extop - Could not decode extended "
+                                                       "operation containing entry for total update.\n");
     }
     return rc;
 }
 
+/*
+ * The requestValue of a batch of total update entries looks like this:
+ *
+ *     requestValue ::= SEQUENCE {
+ *         batchNumber INTEGER,
+ *         entryCount INTEGER,
+ *         entriesLength INTEGER,
+ *         entries OCTET STRING
+ *     }
+ *
+ * entries is the zlib compressed concatenation of entryCount NSDS50ReplicationEntry
+ * requestValues, entriesLength long once uncompressed. The entries are in the
+ * order they must be imported (parents first).
+ */
+#define REPL_TOT_BATCH_MAX_LENGTH (256 * 1024 * 1024)
+
+static int
+decode_total_update_batch(Slapi_PBlock *pb, int *batch_number, int *count, char **entries, ber_len_t *entries_len)
+{
+    BerElement *tmp_bere = NULL;
+    struct berval *extop_value = NULL;
+    struct berval zentries = {0};
+    ber_int_t number = 0;
+    ber_int_t nentries = 0;
+    ber_int_t length = 0;
+    uLongf destlen;
+    int rc = -1;
+
+    *entries = NULL;
+    slapi_pblock_get(pb, SLAPI_EXT_OP_REQ_VALUE, &extop_value);
+    if (!BV_HAS_DATA(extop_value) || (tmp_bere = ber_init(extop_value)) == NULL) {
+        goto done;
+    }
+    if (ber_scanf(tmp_bere, "{iiio}", &number, &nentries, &length, &zentries) == LBER_ERROR) {
+        goto done;
+    }
+    if (nentries < 0 || length <= 0 || length > REPL_TOT_BATCH_MAX_LENGTH) {
+        goto done;
+    }
+    *entries = slapi_ch_malloc(length);
+    destlen = length;
+    if (uncompress((Bytef *)*entries, &destlen, (Bytef *)zentries.bv_val, zentries.bv_len) != Z_OK ||
+        destlen != (uLongf)length) {
+        slapi_ch_free_string(entries);
+        goto done;
+    }
+    *batch_number = number;
+    *count = nentries;
+    *entries_len = length;
+    rc = 0;
+
+done:
+    if (zentries.bv_val) {
+        ldap_memfree(zentries.bv_val);
+    }
+    if (tmp_bere) {
+        ber_free(tmp_bere, 1);
+    }
+    return rc;
+}
+
+/*
+ * Import the entries of a batch, in the order they were sent. The batch is
+ * rejected as a whole if it can not be decoded, an entry that fails to
+ * import stops the batch like it stops the entry by entry total update.
+ */
+static int
+import_total_update_batch(Slapi_PBlock *pb, uint64_t connid, int opid)
+{
+    BerElement *tmp_bere = NULL;
+    struct berval bv = {0};
+    char *entries = NULL;
+    ber_len_t entries_len = 0;
+    ber_len_t len;
+    int batch_number = 0;
+    int count = 0;
+    int imported = 0;
+    int rc;
+
+    rc = decode_total_update_batch(pb, &batch_number, &count, &entries, &entries_len);
+    if (rc) {
+        slapi_log_err(SLAPI_LOG_REPL, repl_plugin_name,
+                      "import_total_update_batch - "
+                      "Could not decode the total update batch conn=%" PRIu64 " op=%d\n",
+                      connid, opid);
+        return -1;
+    }
+
+    bv.bv_val = entries;
+    bv.bv_len = entries_len;
+    if ((tmp_bere = ber_init(&bv)) == NULL) {
+        slapi_ch_free_string(&entries);
+        return -1;
+    }
+
+    while (rc == 0 && ber_peek_tag(tmp_bere, &len) != LBER_DEFAULT) {
+        Slapi_Entry *e = NULL;
+
+        if (decode_total_update_entry(tmp_bere, &e) != 0) {
+            slapi_log_err(SLAPI_LOG_REPL, repl_plugin_name,
+                          "import_total_update_batch - "
+                          "Could not decode entry %d of total update batch %d conn=%" PRIu64 " op=%d\n",
+                          imported, batch_number, connid, opid);
+            rc = -1;
+            break;
+        }
+        rc = slapi_import_entry(pb, e);
+        if (rc != LDAP_SUCCESS) {
+            slapi_log_err(SLAPI_LOG_REPL, repl_plugin_name,
+                          "import_total_update_batch - "
+                          "Error %d: could not import entry dn %s of total update batch %d conn=%" PRIu64 " op=%d\n",
+                          rc, slapi_entry_get_dn_const(e), batch_number, connid, opid);
+            /* on failure the entry is still ours */
+            slapi_entry_free(e);
+            rc = -1;
+            break;
+        }
+        imported++;
+    }
+    if (rc == 0 && imported != count) {
+        slapi_log_err(SLAPI_LOG_REPL, repl_plugin_name,
+                      "import_total_update_batch - "
+                      "Total update batch %d has %d entries, expected %d conn=%" PRIu64 " op=%d\n",
+                      batch_number, imported, count, connid, opid);
+        rc = -1;
+    }
+    ber_free(tmp_bere, 1);
+    slapi_ch_free_string(&entries);
+    return rc;
+}
+
 /*
  * This plugin entry point is called whenever an NSDS50ReplicationEntry
- * extended operation is received.
+ * extended operation, or a batch of them, is received.
  */
 int
 multisupplier_extop_NSDS50ReplicationEntry(Slapi_PBlock *pb)
@@ -754,11 +888,18 @@ multisupplier_extop_NSDS50ReplicationEntry(Slapi_PBlock *pb)
     int rc;
     Slapi_Entry *e = NULL;
     Slapi_Connection *conn = NULL;
+    char *extop_oid = NULL;
     PRUint64 connid = 0;
     int opid = 0;
 
     slapi_pblock_get(pb, SLAPI_CONN_ID, &connid);
     slapi_pblock_get(pb, SLAPI_OPERATION_ID, &opid);
+    slapi_pblock_get(pb, SLAPI_EXT_OP_REQ_OID, &extop_oid);
+
+    if (extop_oid && strcmp(extop_oid, REPL_NSDS_REPLICATION_ENTRY_BATCH_REQUEST_OID) == 0) {
+        rc = import_total_update_batch(pb, connid, opid);
+        goto done;
+    }
 
     /* Decode the extended operation */
     rc = decode_total_update_extop(pb, &e);
@@ -797,6 +938,7 @@ multisupplier_extop_NSDS50ReplicationEntry(Slapi_PBlock *pb)
                       rc, connid, opid);
     }
 
+done:
     if (LDAP_SUCCESS != rc) {
         /* just disconnect from the supplier. bulk import is stopped when
            connection object is destroyed */
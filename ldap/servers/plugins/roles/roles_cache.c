@@ -28,6 +28,7 @@
 #include "prcvar.h"
 #include "prio.h"
 #include "avl.h"
+#include "plhash.h"
 #include "vattr_spi.h"
 #include "roles_cache.h"
 #include "views.h"
@@ -61,8 +62,18 @@ typedef struct _role_object
     int type;              /* ROLE_TYPE_MANAGED|ROLE_TYPE_FILTERED|ROLE_TYPE_NESTED */
     Slapi_Filter *filter;  /* if ROLE_TYPE_FILTERED */
     Avlnode *avl_tree;     /* if ROLE_TYPE_NESTED: tree of nested DNs (avl_data is a role_object_nested struct) */
+    char **index_keys;     /* keys this role is registered under in the roles index, NULL if unindexed */
 } role_object;
 
+/* Roles registered under the same key of the roles index */
+typedef struct _roles_index_list
+{
+    char *key;
+    role_object **roles;
+    size_t count;
+    size_t size;
+} roles_index_list;
+
 /* Structure containing the roles definitions for a given suffix */
 typedef struct _roles_cache_def
 {
@@ -89,6 +100,15 @@ typedef struct _roles_cache_def
      */
     Avlnode *avl_tree;
 
+    /* Inverted index of the roles definitions, so that computing nsrole
+       only evaluates the roles an entry can possibly be a member of
+     */
+    PLHashTable *managed_index; /* role ndn -> role_object of the managed roles */
+    PLHashTable *filter_index;  /* "type:key" of a filter equality term -> roles_index_list */
+    PLHashTable *nested_index;  /* member role ndn -> roles_index_list of the nested roles */
+    char **filter_index_types;  /* attribute types used by the filter_index keys */
+    roles_index_list unindexed; /* roles that must be evaluated for every entry */
+
     /* Next roles suffix definitions */
     struct _roles_cache_def *next;
 
@@ -123,6 +143,14 @@ typedef struct _roles_cache_search_in_nested
     int hint;    /* to check the depth of the nested */
 } roles_cache_search_in_nested;
 
+/* Structure used to collect the members of a nested role in the roles index */
+typedef struct _roles_index_nested_arg
+{
+    roles_cache_def *role_def;
+    char **keys;
+    int outside; /* a member belongs to another suffix */
+} roles_index_nested_arg;
+
 /* Structure used to handle roles searches */
 typedef struct _roles_cache_search_roles
 {
@@ -144,7 +172,6 @@ static int roles_cache_insert_object(Avlnode **tree, role_object *object);
 static int roles_cache_node_nested_cmp(caddr_t d1, caddr_t d2);
 static int roles_cache_insert_object_nested(Avlnode **tree, role_object_nested *object);
 static int roles_cache_object_nested_from_dn(Slapi_DN *role_dn, role_object_nested **result);
-static int roles_cache_build_nsrole(caddr_t data, caddr_t arg);
 static int roles_cache_find_node(caddr_t d1, caddr_t d2);
 static int roles_cache_find_roles_in_suffix(Slapi_DN *target_entry_dn, roles_cache_def **list_of_roles);
 static int roles_is_entry_member_of_object(caddr_t data, caddr_t arg);
@@ -162,6 +189,10 @@ static int roles_cache_dump(caddr_t data, caddr_t arg);
 static int roles_cache_add_entry_cb(Slapi_Entry *e, void *callback_data);
 static void roles_cache_result_cb(int rc, void *callback_data);
 static Slapi_DN *roles_cache_get_top_suffix(Slapi_DN *suffix);
+static void roles_index_add(roles_cache_def *role_def, role_object *role);
+static void roles_index_remove(roles_cache_def *role_def, role_object *role);
+static void roles_index_free(roles_cache_def *role_def);
+static int roles_cache_build_nsrole_indexed(roles_cache_def *role_def, roles_cache_build_result *result);
 
 /*     ============== FUNCTIONS ================ */
 
@@ -285,6 +316,13 @@ roles_cache_create_suffix(Slapi_DN *sdn)
         return (NULL);
     }
 
+    new_suffix->managed_index = PL_NewHashTable(0, PL_HashString, PL_CompareStrings,
+                                                PL_CompareValues, NULL, NULL);
+    new_suffix->filter_index = PL_NewHashTable(0, PL_HashString, PL_CompareStrings,
+                                               PL_CompareValues, NULL, NULL);
+    new_suffix->nested_index = PL_NewHashTable(0, PL_HashString, PL_CompareStrings,
+                                               PL_CompareValues, NULL, NULL);
+
     new_suffix->something_changed = slapi_new_condvar(new_suffix->change_lock);
     if (new_suffix->something_changed == NULL) {
         slapi_log_err(SLAPI_LOG_ERR, ROLES_PLUGIN_SUBSYSTEM,
@@ -579,6 +617,9 @@ roles_cache_update(roles_cache_def *suffix_to_update)
             (operation == SLAPI_OPERATION_DELETE)) {
 
             to_delete = (role_object *)avl_delete(&(suffix_to_update->avl_tree), (caddr_t)dn, roles_cache_find_node);
+            if (to_delete) {
+                roles_index_remove(suffix_to_update, to_delete);
+            }
             roles_cache_role_object_free((caddr_t)to_delete);
             to_delete = NULL;
             if (slapi_is_loglevel_set(SLAPI_LOG_PLUGIN)) {
@@ -1004,6 +1045,9 @@ roles_cache_create_role_under(roles_cache_def **roles_cache_suffix, Slapi_Entry
     if ((rc == 0) && new_role) {
         /* Add to the tree where avl_data is a role_object struct */
         rc = roles_cache_insert_object(&((*roles_cache_suffix)->avl_tree), new_role);
+        if (rc == 0) {
+            roles_index_add(*roles_cache_suffix, new_role);
+        }
         slapi_log_err(SLAPI_LOG_PLUGIN,
                       ROLES_PLUGIN_SUBSYSTEM, "roles_cache_create_role_under - %s in tree %p rc: %d\n",
                       (char *)slapi_sdn_get_ndn(new_role->dn),
@@ -1455,6 +1499,458 @@ roles_cache_object_nested_from_dn(Slapi_DN *role_dn, role_object_nested **result
     return 0;
 }
 
+/* roles_index_keys_add
+   --------------------
+   Add a key to a list of keys, takes the ownership of the key
+ */
+static void
+roles_index_keys_add(char ***keys, char *key)
+{
+    size_t i;
+
+    for (i = 0; *keys && (*keys)[i]; i++) {
+        if (strcmp((*keys)[i], key) == 0) {
+            slapi_ch_free_string(&key);
+            return;
+        }
+    }
+    charray_add(keys, key);
+}
+
+/* roles_index_make_keys
+   ---------------------
+   Build the "type:key" index keys of either the values of an entry or an
+   assertion value, with the equality keys of the attribute syntax, the same
+   way the backend indexes the entries and the search filters
+ */
+static char **
+roles_index_make_keys(const char *type, Slapi_Value **vals, Slapi_Value *assertion)
+{
+    Slapi_Attr attr;
+    Slapi_Value **ivals = NULL;
+    const struct berval *bv = NULL;
+    char **keys = NULL;
+    size_t i;
+
+    slapi_attr_init(&attr, type);
+    if (assertion) {
+        slapi_attr_assertion2keys_ava_sv(&attr, assertion, &ivals, LDAP_FILTER_EQUALITY);
+    } else {
+        slapi_attr_values2keys_sv(&attr, vals, &ivals, LDAP_FILTER_EQUALITY);
+    }
+    for (i = 0; ivals && ivals[i]; i++) {
+        bv = slapi_value_get_berval(ivals[i]);
+        roles_index_keys_add(&keys, slapi_ch_smprintf("%s:%.*s", type, (int)bv->bv_len, bv->bv_val));
+    }
+    valuearray_free(&ivals);
+    attr_done(&attr);
+
+    return keys;
+}
+
+/* roles_index_filter_terms
+   ------------------------
+   Extract from a role filter the equality terms an entry must match at
+   least one of to be a member of the role
+    Return NULL if the filter has no such terms
+ */
+static char **
+roles_index_filter_terms(Slapi_Filter *f)
+{
+    Slapi_Filter *child = NULL;
+    Slapi_Value *value = NULL;
+    struct berval *bval = NULL;
+    char **child_terms = NULL;
+    char **terms = NULL;
+    char *normtype = NULL;
+    char *type = NULL;
+    size_t i;
+
+    switch (slapi_filter_get_choice(f)) {
+    case LDAP_FILTER_EQUALITY:
+        if (slapi_filter_get_ava(f, &type, &bval) == 0) {
+            normtype = slapi_attr_syntax_normalize(type);
+            value = slapi_value_new_berval(bval);
+            terms = roles_index_make_keys(normtype, NULL, value);
+            slapi_value_free(&value);
+            slapi_ch_free_string(&normtype);
+        }
+        break;
+    case LDAP_FILTER_AND:
+        /* Any component selects a superset of the members */
+        for (child = slapi_filter_list_first(f); child && (terms == NULL); child = slapi_filter_list_next(f, child)) {
+            terms = roles_index_filter_terms(child);
+        }
+        break;
+    case LDAP_FILTER_OR:
+        /* Every component needs terms, the members match one of them */
+        for (child = slapi_filter_list_first(f); child; child = slapi_filter_list_next(f, child)) {
+            if ((child_terms = roles_index_filter_terms(child)) == NULL) {
+                charray_free(terms);
+                return NULL;
+            }
+            for (i = 0; child_terms[i]; i++) {
+                roles_index_keys_add(&terms, child_terms[i]);
+            }
+            slapi_ch_free((void **)&child_terms);
+        }
+        break;
+    default:
+        break;
+    }
+
+    return terms;
+}
+
+/* roles_index_nested_keys
+   -----------------------
+   avl_apply callback collecting the members of a nested role
+ */
+static int
+roles_index_nested_keys(caddr_t data, caddr_t arg)
+{
+    role_object_nested *member = (role_object_nested *)data;
+    roles_index_nested_arg *nested_arg = (roles_index_nested_arg *)arg;
+
+    if (!slapi_sdn_issuffix(member->dn, nested_arg->role_def->suffix_dn)) {
+        /* The member is evaluated with the roles of its own suffix */
+        nested_arg->outside = 1;
+        return -1;
+    }
+    roles_index_keys_add(&nested_arg->keys, slapi_ch_strdup(slapi_sdn_get_ndn(member->dn)));
+
+    return 0;
+}
+
+static PLHashTable *
+roles_index_table(roles_cache_def *role_def, role_object *role)
+{
+    switch (role->type) {
+    case ROLE_TYPE_MANAGED:
+        return role_def->managed_index;
+    case ROLE_TYPE_FILTERED:
+        return role_def->filter_index;
+    case ROLE_TYPE_NESTED:
+        return role_def->nested_index;
+    default:
+        return NULL;
+    }
+}
+
+static void
+roles_index_list_add(roles_index_list *list, role_object *role)
+{
+    if (list->count == list->size) {
+        list->size = list->size ? list->size * 2 : 4;
+        list->roles = (role_object **)slapi_ch_realloc((char *)list->roles,
+                                                       list->size * sizeof(role_object *));
+    }
+    list->roles[list->count++] = role;
+}
+
+static void
+roles_index_list_remove(roles_index_list *list, role_object *role)
+{
+    size_t i;
+
+    for (i = 0; i < list->count; i++) {
+        if (list->roles[i] == role) {
+            list->roles[i] = list->roles[--list->count];
+            return;
+        }
+    }
+}
+
+static void
+roles_index_list_free(roles_index_list *list)
+{
+    slapi_ch_free_string(&list->key);
+    slapi_ch_free((void **)&list->roles);
+    slapi_ch_free((void **)&list);
+}
+
+/* roles_index_add
+   ---------------
+   Register a role in the roles index of its suffix:
+   - a managed role under its DN, as named by the nsRoleDN of its members
+   - a filtered role under the equality terms of its filter
+   - a nested role under the DNs of the roles it contains, when they all
+     belong to the suffix
+   The other roles are kept in the unindexed list.
+ */
+static void
+roles_index_add(roles_cache_def *role_def, role_object *role)
+{
+    PLHashTable *table = roles_index_table(role_def, role);
+    roles_index_list *list = NULL;
+    roles_index_nested_arg nested_arg = {0};
+    char *type = NULL;
+    size_t i;
+
+    switch (role->type) {
+    case ROLE_TYPE_MANAGED:
+        charray_add(&role->index_keys, slapi_ch_strdup(slapi_sdn_get_ndn(role->dn)));
+        break;
+    case ROLE_TYPE_FILTERED:
+        role->index_keys = roles_index_filter_terms(role->filter);
+        break;
+    case ROLE_TYPE_NESTED:
+        nested_arg.role_def = role_def;
+        avl_apply(role->avl_tree, roles_index_nested_keys, &nested_arg, -1, AVL_INORDER);
+        if (nested_arg.outside) {
+            charray_free(nested_arg.keys);
+        } else {
+            role->index_keys = nested_arg.keys;
+        }
+        break;
+    }
+
+    if ((table == NULL) || (role->index_keys == NULL)) {
+        roles_index_list_add(&role_def->unindexed, role);
+        return;
+    }
+
+    for (i = 0; role->index_keys[i]; i++) {
+        list = (roles_index_list *)PL_HashTableLookup(table, role->index_keys[i]);
+        if (list == NULL) {
+            list = (roles_index_list *)slapi_ch_calloc(1, sizeof(roles_index_list));
+            list->key = slapi_ch_strdup(role->index_keys[i]);
+            PL_HashTableAdd(table, list->key, list);
+        }
+        roles_index_list_add(list, role);
+
+        if (role->type == ROLE_TYPE_FILTERED) {
+            /* The types are never removed, a stale one only costs a lookup */
+            type = slapi_ch_strdup(role->index_keys[i]);
+            *strchr(type, ':') = '\0';
+            if (charray_inlist(role_def->filter_index_types, type)) {
+                slapi_ch_free_string(&type);
+            } else {
+                charray_add(&role_def->filter_index_types, type);
+            }
+        }
+    }
+}
+
+/* roles_index_remove
+   ------------------
+   Unregister a role from the roles index of its suffix
+ */
+static void
+roles_index_remove(roles_cache_def *role_def, role_object *role)
+{
+    PLHashTable *table = roles_index_table(role_def, role);
+    roles_index_list *list = NULL;
+    size_t i;
+
+    if ((table == NULL) || (role->index_keys == NULL)) {
+        roles_index_list_remove(&role_def->unindexed, role);
+        return;
+    }
+
+    for (i = 0; role->index_keys[i]; i++) {
+        list = (roles_index_list *)PL_HashTableLookup(table, role->index_keys[i]);
+        if (list == NULL) {
+            continue;
+        }
+        roles_index_list_remove(list, role);
+        if (list->count == 0) {
+            PL_HashTableRemove(table, list->key);
+            roles_index_list_free(list);
+        }
+    }
+    charray_free(role->index_keys);
+    role->index_keys = NULL;
+}
+
+static PRIntn
+roles_index_free_entry(PLHashEntry *he, PRIntn i __attribute__((unused)), void *arg __attribute__((unused)))
+{
+    roles_index_list_free((roles_index_list *)he->value);
+    return HT_ENUMERATE_NEXT;
+}
+
+static void
+roles_index_destroy(PLHashTable **table)
+{
+    if (*table) {
+        PL_HashTableEnumerateEntries(*table, roles_index_free_entry, NULL);
+        PL_HashTableDestroy(*table);
+        *table = NULL;
+    }
+}
+
+/* roles_index_free
+   ----------------
+   Free the roles index of a suffix, the roles themselves are freed with the avl tree
+ */
+static void
+roles_index_free(roles_cache_def *role_def)
+{
+    roles_index_destroy(&role_def->managed_index);
+    roles_index_destroy(&role_def->filter_index);
+    roles_index_destroy(&role_def->nested_index);
+    charray_free(role_def->filter_index_types);
+    role_def->filter_index_types = NULL;
+    slapi_ch_free((void **)&role_def->unindexed.roles);
+}
+
+/* roles_index_lookup
+   ------------------
+   Append to the candidates the roles registered under a key
+ */
+static void
+roles_index_lookup(PLHashTable *table, const char *key, roles_index_list *candidates)
+{
+    roles_index_list *list = (roles_index_list *)PL_HashTableLookup(table, key);
+    size_t i;
+
+    for (i = 0; list && (i < list->count); i++) {
+        roles_index_list_add(candidates, list->roles[i]);
+    }
+}
+
+/* roles_index_entry_keys
+   ----------------------
+   Build the index keys of the values of an entry, subtypes and virtual
+   attributes included, as the filter test would see them
+ */
+static char **
+roles_index_entry_keys(vattr_context *c, Slapi_Entry *e, char *type)
+{
+    Slapi_ValueSet **values = NULL;
+    int *type_name_disposition = NULL;
+    char **actual_type_name = NULL;
+    char **subtype_keys = NULL;
+    char **keys = NULL;
+    int free_flags = 0;
+    int count = 0;
+    int i, j;
+
+    slapi_vattr_values_get_sp_ex(c, e, type, &values, &type_name_disposition, &actual_type_name,
+                                 SLAPI_VIRTUALATTRS_REQUEST_POINTERS, &free_flags, &count);
+    for (i = 0; values && (i < count); i++) {
+        if (values[i]) {
+            subtype_keys = roles_index_make_keys(type, valueset_get_valuearray(values[i]), NULL);
+            for (j = 0; subtype_keys && subtype_keys[j]; j++) {
+                roles_index_keys_add(&keys, subtype_keys[j]);
+            }
+            slapi_ch_free((void **)&subtype_keys);
+        }
+        slapi_vattr_values_free(&values[i], &actual_type_name[i], free_flags);
+    }
+    slapi_ch_free((void **)&values);
+    slapi_ch_free((void **)&actual_type_name);
+    slapi_ch_free((void **)&type_name_disposition);
+
+    return keys;
+}
+
+static int
+roles_index_role_cmp(const void *r1, const void *r2)
+{
+    uintptr_t p1 = (uintptr_t) * (role_object *const *)r1;
+    uintptr_t p2 = (uintptr_t) * (role_object *const *)r2;
+
+    return (p1 > p2) - (p1 < p2);
+}
+
+/* roles_cache_build_nsrole_indexed
+   --------------------------------
+   Compute the nsrole values of an entry from the roles index of its suffix:
+   the candidate roles are selected by a few hash lookups, then checked for
+   real, and the nested roles are reached from the roles the entry is a
+   member of.
+    Return 0
+ */
+static int
+roles_cache_build_nsrole_indexed(roles_cache_def *role_def, roles_cache_build_result *result)
+{
+    Slapi_Entry *entry = result->requested_entry;
+    roles_index_list candidates = {0};
+    roles_index_list matched = {0};
+    roles_index_list *list = NULL;
+    roles_cache_search_in_nested get_nsrole;
+    Slapi_Attr *attr = NULL;
+    Slapi_Value *v = NULL;
+    Slapi_Value *value = NULL;
+    Slapi_DN *sdn = NULL;
+    role_object *this_role = NULL;
+    char **keys = NULL;
+    size_t i, j, k;
+    int hint;
+
+    /* Managed roles are named by the nsRoleDN values of the entry */
+    if (slapi_entry_attr_find(entry, ROLE_MANAGED_ATTR_NAME, &attr) == 0) {
+        for (hint = slapi_attr_first_value(attr, &v); hint != -1; hint = slapi_attr_next_value(attr, hint, &v)) {
+            sdn = slapi_sdn_new_dn_byref(slapi_value_get_string(v));
+            roles_index_lookup(role_def->managed_index, slapi_sdn_get_ndn(sdn), &candidates);
+            slapi_sdn_free(&sdn);
+        }
+    }
+
+    /* Filtered roles are selected by the equality terms of their filter */
+    for (i = 0; role_def->filter_index_types && role_def->filter_index_types[i]; i++) {
+        keys = roles_index_entry_keys(result->context, entry, role_def->filter_index_types[i]);
+        for (j = 0; keys && keys[j]; j++) {
+            roles_index_lookup(role_def->filter_index, keys[j], &candidates);
+        }
+        charray_free(keys);
+    }
+
+    for (i = 0; i < role_def->unindexed.count; i++) {
+        roles_index_list_add(&candidates, role_def->unindexed.roles[i]);
+    }
+
+    /* A role can be selected by several terms */
+    if (candidates.count > 1) {
+        qsort(candidates.roles, candidates.count, sizeof(role_object *), roles_index_role_cmp);
+    }
+
+    for (i = 0; i < candidates.count; i++) {
+        this_role = candidates.roles[i];
+        if ((i > 0) && (this_role == candidates.roles[i - 1])) {
+            continue;
+        }
+        get_nsrole.is_entry_member_of = entry;
+        get_nsrole.present = 0;
+        get_nsrole.hint = 0;
+        roles_is_entry_member_of_object_ext(result->context, (caddr_t)this_role, (caddr_t)&get_nsrole);
+        if (get_nsrole.present) {
+            roles_index_list_add(&matched, this_role);
+        }
+    }
+
+    /* Walk up from the roles of the entry to the nested roles containing them */
+    value = slapi_value_new_string("");
+    for (i = 0; i < matched.count; i++) {
+        list = (roles_index_list *)PL_HashTableLookup(role_def->nested_index,
+                                                      slapi_sdn_get_ndn(matched.roles[i]->dn));
+        for (j = 0; list && (j < list->count); j++) {
+            this_role = list->roles[j];
+            for (k = 0; (k < matched.count) && (matched.roles[k] != this_role); k++)
+                ;
+            if ((k == matched.count) && roles_is_inscope(entry, this_role)) {
+                roles_index_list_add(&matched, this_role);
+            }
+        }
+
+        result->has_value = 1;
+        if (!result->need_value) {
+            /* we don't need the value but we already know there is one nsrole */
+            break;
+        }
+        slapi_value_set_string(value, (char *)slapi_sdn_get_ndn(matched.roles[i]->dn));
+        slapi_valueset_add_value(*(result->nsrole_values), value);
+    }
+    slapi_value_free(&value);
+
+    slapi_ch_free((void **)&candidates.roles);
+    slapi_ch_free((void **)&matched.roles);
+
+    return 0;
+}
+
 /* roles_cache_listroles
    --------------------
    Lists all the roles an entry posesses
@@ -1511,7 +2007,7 @@ roles_cache_listroles_ext(vattr_context *c, Slapi_Entry *entry, int return_value
             /* XXX really need a mutex for this read operation ? */
             slapi_rwlock_rdlock(roles_cache->cache_lock);
 
-            avl_apply(roles_cache->avl_tree, roles_cache_build_nsrole, &arg, -1, AVL_INORDER);
+            roles_cache_build_nsrole_indexed(roles_cache, &arg);
 
             slapi_rwlock_unlock(roles_cache->cache_lock);
 
@@ -1539,64 +2035,6 @@ roles_cache_listroles_ext(vattr_context *c, Slapi_Entry *entry, int return_value
     return rc;
 }
 
-/* roles_cache_build_nsrole
-   ------------------------
-   Traverse the tree containing roles definitions for a suffix and for each
-   one of them, check wether the entry is a member of it or not
-   For ones which check out positive, we add their DN to the value
-   always return 0 to allow to trverse all the tree
- */
-static int
-roles_cache_build_nsrole(caddr_t data, caddr_t arg)
-{
-    Slapi_Value *value = NULL;
-    roles_cache_build_result *result = (roles_cache_build_result *)arg;
-    role_object *this_role = (role_object *)data;
-    roles_cache_search_in_nested get_nsrole;
-    /* Return a value different from the stop flag to be able
-       to go through all the tree */
-    int rc = 0;
-    int tmprc = 0;
-
-    slapi_log_err(SLAPI_LOG_PLUGIN,
-                  ROLES_PLUGIN_SUBSYSTEM, "--> roles_cache_build_nsrole: role %s\n",
-                  (char *)slapi_sdn_get_ndn(this_role->dn));
-
-    value = slapi_value_new_string("");
-
-    get_nsrole.is_entry_member_of = result->requested_entry;
-    get_nsrole.present = 0;
-    get_nsrole.hint = 0;
-
-    tmprc = roles_is_entry_member_of_object_ext(result->context, (caddr_t)this_role, (caddr_t)&get_nsrole);
-    if (SLAPI_VIRTUALATTRS_LOOP_DETECTED == tmprc) {
-        /* all we want to detect and return is loop/stack overflow */
-        rc = tmprc;
-    }
-
-    /* If so, add its DN to the attribute */
-    if (get_nsrole.present) {
-        result->has_value = 1;
-        if (result->need_value) {
-            slapi_value_set_string(value, (char *)slapi_sdn_get_ndn(this_role->dn));
-            slapi_valueset_add_value(*(result->nsrole_values), value);
-        } else {
-            /* we don't need the value but we already know there is one nsrole.
-               stop the traversal
-             */
-            rc = -1;
-        }
-    }
-
-    slapi_value_free(&value);
-
-    slapi_log_err(SLAPI_LOG_PLUGIN,
-                  ROLES_PLUGIN_SUBSYSTEM, "<-- roles_cache_build_nsrole\n");
-
-    return rc;
-}
-
-
 /* roles_check
    -----------
    Checks if an entry has a presented role, assuming that we've already verified
@@ -2027,6 +2465,7 @@ roles_cache_role_def_free(roles_cache_def *role_def)
 
     slapi_lock_mutex(role_def->stop_lock);
 
+    roles_index_free(role_def);
     avl_free(role_def->avl_tree, roles_cache_role_object_free);
     slapi_sdn_free(&(role_def->suffix_dn));
     slapi_destroy_rwlock(role_def->cache_lock);
@@ -2091,6 +2530,7 @@ roles_cache_role_object_free(caddr_t tr)
 
     slapi_sdn_free(&this_role->dn);
     slapi_sdn_free(&this_role->rolescopedn);
+    charray_free(this_role->index_keys);
 
     /* Free the object */
     slapi_ch_free((void **)&this_role);
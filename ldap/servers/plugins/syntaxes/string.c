@@ -23,10 +23,14 @@
 
 #define MAX_VAL(x, y) ((x) > (y) ? (x) : (y))
 
+/* room for the position of a positional key: SEP + hash + 2 numbers */
+#define SUBSTRPOS_SUFFIX_MAX 40
+
 static int string_filter_approx(struct berval *bvfilter,
                                 Slapi_Value **bvals,
                                 Slapi_Value **retVal);
 static void substring_comp_keys(Slapi_Value ***ivals, int *nsubs, char *str, int lenstring, int prepost, int syntax, char *comp_buf, int *substrlens);
+static int substring_pos_assertion2keys(char *initial, char **any, char * final, Slapi_Value ***ivals, int syntax, int *substrlens);
 
 int
 string_filter_ava(struct berval *bvfilter, Slapi_Value **bvals, int syntax, int ftype, Slapi_Value **retVal)
@@ -403,6 +407,19 @@ bailout:
     return (rc);
 }
 
+/* FNV-1a, tells apart the values of an entry in the positional keys */
+static uint64_t
+substring_value_hash(const struct berval *bvp)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (size_t i = 0; i < bvp->bv_len; i++) {
+        hash ^= (unsigned char)bvp->bv_val[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
 int
 string_values2keys(Slapi_PBlock *pb, Slapi_Value **bvals, Slapi_Value ***ivals, int syntax, int ftype)
 {
@@ -492,8 +509,9 @@ string_values2keys(Slapi_PBlock *pb, Slapi_Value **bvals, Slapi_Value ***ivals,
         char *buf;
         int i;
         int *substrlens = NULL;
-        int localsublens[3] = {SUBBEGIN, SUBMIDDLE, SUBEND}; /* default values */
+        int localsublens[INDEX_SUBSTRLEN] = {SUBBEGIN, SUBMIDDLE, SUBEND, 0}; /* default values */
         int maxsublen;
+        char *posbuf = NULL;
         /*
           * Substring key has 3 types:
          * begin (e.g., *^a)
@@ -554,6 +572,11 @@ string_values2keys(Slapi_PBlock *pb, Slapi_Value **bvals, Slapi_Value ***ivals,
             nsubs += slapi_value_get_length(*bvlp) - substrlens[INDEX_SUBSTRMIDDLE] + 3;
         }
         nsubs += substrlens[INDEX_SUBSTRMIDDLE] * 2 - substrlens[INDEX_SUBSTRBEGIN] - substrlens[INDEX_SUBSTREND];
+        if (substrlens[INDEX_SUBSTRPOS] == INDEX_SUBSTRPOS_INDEX) {
+            /* each middle key is also indexed with its position */
+            posbuf = (char *)slapi_ch_malloc(substrlens[INDEX_SUBSTRMIDDLE] + SUBSTRPOS_SUFFIX_MAX);
+            nsubs *= 2;
+        }
         *ivals = (Slapi_Value **)slapi_ch_calloc((nsubs + 1), sizeof(Slapi_Value *));
 
         n = 0;
@@ -615,6 +638,23 @@ string_values2keys(Slapi_PBlock *pb, Slapi_Value **bvals, Slapi_Value ***ivals,
                 n++;
             }
 
+            /* positional */
+            if (posbuf && bvp->bv_len >= (ber_len_t)substrlens[INDEX_SUBSTRMIDDLE]) {
+                uint64_t hash = substring_value_hash(bvp);
+
+                for (p = bvp->bv_val;
+                     p < (bvp->bv_val + bvp->bv_len - substrlens[INDEX_SUBSTRMIDDLE] + 1);
+                     p++) {
+                    memcpy(posbuf, p, substrlens[INDEX_SUBSTRMIDDLE]);
+                    snprintf(posbuf + substrlens[INDEX_SUBSTRMIDDLE], SUBSTRPOS_SUFFIX_MAX,
+                             "%c%016" PRIx64 ":%x:%x", INDEX_SUBSTRPOS_SEP, hash,
+                             (unsigned int)(p - bvp->bv_val), (unsigned int)bvp->bv_len);
+                    (*ivals)[n] = slapi_value_new_string(posbuf);
+                    slapi_value_set_flags((*ivals)[n], value_flags);
+                    n++;
+                }
+            }
+
             /* trailing */
             if (bvp->bv_len > substrlens[INDEX_SUBSTREND] - 2) {
                 p = bvp->bv_val + bvp->bv_len - substrlens[INDEX_SUBSTREND] + 1;
@@ -630,6 +670,7 @@ string_values2keys(Slapi_PBlock *pb, Slapi_Value **bvals, Slapi_Value ***ivals,
         }
         slapi_value_free(&bvdup);
         slapi_ch_free_string(&buf);
+        slapi_ch_free_string(&posbuf);
     } break;
     }
 
@@ -759,7 +800,7 @@ string_assertion2keys_sub(
     int nsubs, i, len;
     int initiallen = 0, finallen = 0;
     int *substrlens = NULL;
-    int localsublens[3] = {SUBBEGIN, SUBMIDDLE, SUBEND}; /* default values */
+    int localsublens[INDEX_SUBSTRLEN] = {SUBBEGIN, SUBMIDDLE, SUBEND, 0}; /* default values */
     int maxsublen;
     char *comp_buf = NULL;
     /* altinit|any|final: store alt string from value_normalize_ext if any,
@@ -791,6 +832,10 @@ string_assertion2keys_sub(
         substrlens[INDEX_SUBSTREND] = SUBEND;
     }
 
+    if (substrlens[INDEX_SUBSTRPOS] == INDEX_SUBSTRPOS_QUERY) {
+        return substring_pos_assertion2keys(initial, any, final, ivals, syntax, substrlens);
+    }
+
     *ivals = NULL;
 
     /*
@@ -957,3 +1002,80 @@ substring_comp_keys(
 
     slapi_log_err(SLAPI_LOG_TRACE, SYNTAX_PLUGIN_SUBSYSTEM, "<= substring_comp_keys\n");
 }
+
+/*
+ * Positional substring index: returns one descriptor per middle n-gram of
+ * each assertion component (see INDEX_SUBSTRPOS_QUERY in slap.h). The
+ * components shorter than an n-gram have no descriptor.
+ */
+static int
+substring_pos_assertion2keys(char *initial, char **any, char * final, Slapi_Value ***ivals, int syntax, int *substrlens)
+{
+    int ngramlen = substrlens[INDEX_SUBSTRMIDDLE];
+    size_t ncomps = 0;
+    size_t nkeys = 0;
+    size_t n = 0;
+    char **comps = NULL;
+    char *kinds = NULL;
+    char *posbuf = NULL;
+    char *alt = NULL;
+    int i;
+
+    *ivals = NULL;
+    for (i = 0; any != NULL && any[i] != NULL; i++)
+        ;
+    comps = (char **)slapi_ch_calloc(i + 3, sizeof(char *));
+    kinds = (char *)slapi_ch_calloc(i + 3, sizeof(char));
+
+    /* 3rd arg: 0 - DO NOT trim leading blanks, as string_assertion2keys_sub */
+    if (initial != NULL) {
+        value_normalize_ext(initial, syntax, 0, &alt);
+        comps[ncomps] = alt ? alt : slapi_ch_strdup(initial);
+        kinds[ncomps++] = '^';
+        alt = NULL;
+    }
+    for (i = 0; any != NULL && any[i] != NULL; i++) {
+        value_normalize_ext(any[i], syntax, 0, &alt);
+        comps[ncomps] = alt ? alt : slapi_ch_strdup(any[i]);
+        kinds[ncomps++] = '*';
+        alt = NULL;
+    }
+    if (final != NULL) {
+        value_normalize_ext(final, syntax, 0, &alt);
+        comps[ncomps] = alt ? alt : slapi_ch_strdup(final);
+        kinds[ncomps++] = '$';
+        alt = NULL;
+    }
+
+    for (size_t c = 0; c < ncomps; c++) {
+        int len = strlen(comps[c]);
+        if (len >= ngramlen) {
+            nkeys += len - ngramlen + 1;
+        }
+    }
+    if (nkeys == 0) {
+        goto done;
+    }
+
+    *ivals = (Slapi_Value **)slapi_ch_malloc((nkeys + 1) * sizeof(Slapi_Value *));
+    posbuf = (char *)slapi_ch_malloc(ngramlen + SUBSTRPOS_SUFFIX_MAX);
+    for (size_t c = 0; c < ncomps; c++) {
+        int len = strlen(comps[c]);
+        for (int off = 0; off + ngramlen <= len; off++) {
+            memcpy(posbuf, comps[c] + off, ngramlen);
+            snprintf(posbuf + ngramlen, SUBSTRPOS_SUFFIX_MAX, "%c%x:%c:%x:%x",
+                     INDEX_SUBSTRPOS_SEP, (unsigned int)c, kinds[c], off, len);
+            (*ivals)[n++] = slapi_value_new_string(posbuf);
+        }
+    }
+    (*ivals)[n] = NULL;
+
+done:
+    for (size_t c = 0; c < ncomps; c++) {
+        slapi_ch_free_string(&comps[c]);
+    }
+    slapi_ch_free((void **)&comps);
+    slapi_ch_free_string(&kinds);
+    slapi_ch_free_string(&posbuf);
+    return (0);
+}
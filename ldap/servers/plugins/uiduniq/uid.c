@@ -83,18 +83,57 @@ typedef struct attr_uniqueness_config
     PRBool unique_in_all_subtrees;
     char *top_entry_oc;
     char *subtree_entries_oc;
+    struct uniqueness_cache *cache;
+    struct attr_uniqueness_config *cache_next; /* in the list of the configs having a cache */
     struct attr_uniqueness_config *next;
 } attr_uniqueness_config_t;
 
+/*
+ * In-memory count of the entries holding each value of the unique attributes.
+ *
+ * The counts never underestimate what is stored in the database: a value is
+ * counted before the operation adding it is committed, and uncounted only
+ * once the operation removing it is.  A value that is not in the table can't
+ * conflict, so the internal searches are only needed on a hit.
+ */
+typedef struct uniqueness_cache
+{
+    Slapi_RWLock *lock;         /* protects values and loading */
+    PLHashTable *values;        /* "<attr index>:<equality key>" -> number of entries */
+    PLHashTable *loading;       /* counts of the running load, or NULL */
+    Slapi_Attr **sattrs;        /* one per unique attribute, to generate the keys */
+    PRLock *build_lock;         /* protects the fields below */
+    PRThread *builder;
+    Slapi_Eq_Context eq_ctx;
+    int32_t valid;              /* the set can be trusted for misses */
+    int32_t rebuild;            /* (re)load the set from the database */
+    int32_t running;            /* the builder thread is running */
+    int32_t stopping;           /* the plugin is closing */
+    char *dn;                   /* plugin entry the statistics are published on */
+    uint64_t hits;              /* checks that had to search */
+    uint64_t misses;            /* checks answered without a search */
+} uniqueness_cache_t;
+
 #define ATTR_UNIQUENESS_ATTRIBUTE_NAME      "uniqueness-attribute-name"
 #define ATTR_UNIQUENESS_SUBTREES            "uniqueness-subtrees"
 #define ATTR_UNIQUENESS_EXCLUDE_SUBTREES    "uniqueness-exclude-subtrees"
 #define ATTR_UNIQUENESS_ACROSS_ALL_SUBTREES "uniqueness-across-all-subtrees"
 #define ATTR_UNIQUENESS_TOP_ENTRY_OC        "uniqueness-top-entry-oc"
 #define ATTR_UNIQUENESS_SUBTREE_ENTRIES_OC  "uniqueness-subtree-entries-oc"
+#define ATTR_UNIQUENESS_CACHE               "uniqueness-cache"
+#define ATTR_UNIQUENESS_CACHE_HITS          "uniqueness-cache-hits"
+#define ATTR_UNIQUENESS_CACHE_MISSES        "uniqueness-cache-misses"
+#define ATTR_UNIQUENESS_CACHE_VALUES        "uniqueness-cache-values"
+
+#define UNIQUENESS_CACHE_BETXN_POSTOP_DESC "Attribute uniqueness cache betxn postop plugin"
+#define UNIQUENESS_CACHE_POSTOP_DESC       "Attribute uniqueness cache postop plugin"
+#define UNIQUENESS_CACHE_INT_POSTOP_DESC   "Attribute uniqueness cache internal postop plugin"
 
 static int getArguments(Slapi_PBlock *pb, char **attrName, char **markerObjectClass, char **requiredObjectClass);
 static struct attr_uniqueness_config *uniqueness_entry_to_config(Slapi_PBlock *pb, Slapi_Entry *config_entry);
+static uniqueness_cache_t *uniqueness_cache_new(const char **attrs);
+static void uniqueness_cache_free(attr_uniqueness_config_t *config);
+static int uniqueness_cache_search(Slapi_PBlock *pb, Slapi_Entry *e, Slapi_Entry *entryAfter, int *returncode, char *returntext, void *arg);
 
 /*
  * More information about constraint failure
@@ -122,6 +161,7 @@ free_uniqueness_config(struct attr_uniqueness_config *config)
     slapi_ch_free_string(&config->attr_friendly);
     slapi_ch_free_string((char **)&config->top_entry_oc);
     slapi_ch_free_string((char **)&config->subtree_entries_oc);
+    uniqueness_cache_free(config);
 }
 
 /*
@@ -277,6 +317,17 @@ uniqueness_entry_to_config(Slapi_PBlock *pb, Slapi_Entry *config_entry)
         /* enforce uniqueness, in the modified entry subtree, only to entries having this objectclass */
         tmp_config->subtree_entries_oc = slapi_entry_attr_get_charptr(config_entry, ATTR_UNIQUENESS_SUBTREE_ENTRIES_OC);
 
+        /* keep the known values in memory to skip most of the searches, off by default */
+        if (slapi_entry_attr_get_bool(config_entry, ATTR_UNIQUENESS_CACHE)) {
+            if (tmp_config->attrs && tmp_config->subtrees && tmp_config->top_entry_oc == NULL) {
+                tmp_config->cache = uniqueness_cache_new(tmp_config->attrs);
+            } else {
+                slapi_log_err(SLAPI_LOG_ERR, plugin_name, "uniqueness_entry_to_config - "
+                                                          "%s requires %s, ignored\n",
+                              ATTR_UNIQUENESS_CACHE, ATTR_UNIQUENESS_SUBTREES);
+            }
+        }
+
     } else {
         int result;
         char *attrName = NULL;
@@ -640,6 +691,45 @@ search(Slapi_DN *baseDN, const char **attrNames, Slapi_Attr *attr, struct berval
 }
 
 
+/* Context of the conflict check run for each entry of search_one_berval */
+typedef struct search_one_berval_data
+{
+    Slapi_DN *target;
+    Slapi_DN **excludes;
+    int result;
+} search_one_berval_data;
+
+static int
+search_one_berval_entry(Slapi_Entry *e, void *callback_data)
+{
+    search_one_berval_data *sobd = (search_one_berval_data *)callback_data;
+    Slapi_DN *entry_dn = slapi_entry_get_sdn(e);
+
+#ifdef DEBUG
+    slapi_log_err(SLAPI_LOG_PLUGIN, plugin_name,
+                  "search_one_berval_entry - SEARCH entry dn=%s\n", slapi_entry_get_dn(e));
+#endif
+
+    /*
+     * It is a Constraint Violation if any entry is found, unless
+     * the entry is the target entry (if any).
+     */
+    if (sobd->target && slapi_sdn_compare(entry_dn, sobd->target) == 0) {
+        return 0;
+    }
+
+    /* Do the same check for excluded subtrees as resulted entries may have matched them */
+    for (size_t i = 0; sobd->excludes && sobd->excludes[i]; i++) {
+        if (slapi_sdn_issuffix(entry_dn, sobd->excludes[i])) {
+            return 0;
+        }
+    }
+
+    /* One conflict is enough, stop the search */
+    sobd->result = LDAP_CONSTRAINT_VIOLATION;
+    return -1;
+}
+
 static int
 search_one_berval(Slapi_DN *baseDN, const char **attrNames, const struct berval *value, const char *requiredObjectClass, Slapi_DN *target, Slapi_DN **excludes)
 {
@@ -659,7 +749,7 @@ search_one_berval(Slapi_DN *baseDN, const char **attrNames, const struct berval
     BEGIN
     int err;
     int sres;
-    Slapi_Entry **entries;
+    search_one_berval_data sobd = {target, excludes, LDAP_SUCCESS};
     static char *attrs[] = {"1.1", 0};
 
     /* Create the filter - this needs to be freed */
@@ -677,9 +767,13 @@ search_one_berval(Slapi_DN *baseDN, const char **attrNames, const struct berval
         break;
     }
 
+    /*
+     * Look at entries as they are found, without copying them.  Any entry
+     * found must be the target entry or the constraint fails.
+     */
     slapi_search_internal_set_pb_ext(spb, baseDN, LDAP_SCOPE_SUBTREE,
                                      filter, attrs, 0 /* attrs only */, NULL, NULL, plugin_identity, 0 /* actions */);
-    slapi_search_internal_pb(spb);
+    slapi_search_internal_stream_pb(spb, &sobd, search_one_berval_entry);
 
     err = slapi_pblock_get(spb, SLAPI_PLUGIN_INTOP_RESULT, &sres);
     if (err) {
@@ -697,65 +791,666 @@ search_one_berval(Slapi_DN *baseDN, const char **attrNames, const struct berval
         break;
     }
 
-    err = slapi_pblock_get(spb, SLAPI_PLUGIN_INTOP_SEARCH_ENTRIES,
-                           &entries);
-    if (err) {
-        result = uid_op_error(4);
-        break;
-    }
+    result = sobd.result;
 
-    /*
-       * Look at entries returned.  Any entry found must be the
-       * target entry or the constraint fails.
-       */
-    for (; *entries; entries++) {
 #ifdef DEBUG
-        slapi_log_err(SLAPI_LOG_PLUGIN, plugin_name,
-                      "search_one_berval - SEARCH entry dn=%s\n", slapi_entry_get_dn(*entries));
+    slapi_log_err(SLAPI_LOG_PLUGIN, plugin_name,
+                  "search_one_berval - SEARCH complete result=%d\n", result);
 #endif
+    END
 
-        /*
-         * It is a Constraint Violation if any entry is found, unless
-         * the entry is the target entry (if any).
-         */
-        if (!target || slapi_sdn_compare(slapi_entry_get_sdn(*entries), target) != 0) {
-            int i;
-            result = LDAP_CONSTRAINT_VIOLATION;
-            if (excludes == NULL || *excludes == NULL) {
+    /* Clean-up */
+    slapi_pblock_destroy(spb);
+
+    slapi_ch_free((void **)&filter);
+
+    return result;
+}
+
+/* ------------------------------------------------------------ */
+/*
+ * Uniqueness cache
+ */
+
+/* The configurations having a cache, seen by the post-op callbacks */
+static Slapi_RWLock *uniqueness_caches_lock = NULL;
+static attr_uniqueness_config_t *uniqueness_caches = NULL;
+static int uniqueness_cache_postops_registered = 0;
+
+static PRIntn
+uniqueness_cache_free_key(PLHashEntry *he, PRIntn i __attribute__((unused)), void *arg __attribute__((unused)))
+{
+    slapi_ch_free((void **)&he->key);
+    return HT_ENUMERATE_REMOVE;
+}
+
+static void
+uniqueness_cache_free_values(Slapi_Value ***vals)
+{
+    for (size_t k = 0; *vals && (*vals)[k]; k++) {
+        slapi_value_free(&(*vals)[k]);
+    }
+    slapi_ch_free((void **)vals);
+}
+
+static void
+uniqueness_cache_free_table(PLHashTable **table)
+{
+    if (*table) {
+        PL_HashTableEnumerateEntries(*table, uniqueness_cache_free_key, NULL);
+        PL_HashTableDestroy(*table);
+        *table = NULL;
+    }
+}
+
+static uniqueness_cache_t *
+uniqueness_cache_new(const char **attrs)
+{
+    uniqueness_cache_t *cache;
+    size_t nattrs;
+
+    for (nattrs = 0; attrs[nattrs]; nattrs++)
+        ;
+
+    cache = (uniqueness_cache_t *)slapi_ch_calloc(1, sizeof(uniqueness_cache_t));
+    cache->lock = slapi_new_rwlock();
+    cache->build_lock = PR_NewLock();
+    cache->values = PL_NewHashTable(4096, PL_HashString, PL_CompareStrings,
+                                    PL_CompareValues, NULL, NULL);
+    cache->sattrs = (Slapi_Attr **)slapi_ch_calloc(nattrs + 1, sizeof(Slapi_Attr *));
+    for (size_t i = 0; i < nattrs; i++) {
+        cache->sattrs[i] = slapi_attr_new();
+        slapi_attr_init(cache->sattrs[i], attrs[i]);
+    }
+
+    return cache;
+}
+
+/* Make the cache of config visible to the post-op callbacks */
+static void
+uniqueness_cache_register(attr_uniqueness_config_t *config)
+{
+    slapi_rwlock_wrlock(uniqueness_caches_lock);
+    config->cache_next = uniqueness_caches;
+    uniqueness_caches = config;
+    slapi_rwlock_unlock(uniqueness_caches_lock);
+}
+
+static void
+uniqueness_cache_unregister(attr_uniqueness_config_t *config)
+{
+    attr_uniqueness_config_t **p;
+
+    if (uniqueness_caches_lock == NULL) {
+        return;
+    }
+    slapi_rwlock_wrlock(uniqueness_caches_lock);
+    for (p = &uniqueness_caches; *p; p = &(*p)->cache_next) {
+        if (*p == config) {
+            *p = config->cache_next;
+            break;
+        }
+    }
+    config->cache_next = NULL;
+    slapi_rwlock_unlock(uniqueness_caches_lock);
+}
+
+static void
+uniqueness_cache_free(attr_uniqueness_config_t *config)
+{
+    uniqueness_cache_t *cache = config->cache;
+
+    if (cache == NULL) {
+        return;
+    }
+
+    uniqueness_cache_unregister(config);
+    if (cache->dn) {
+        slapi_config_remove_callback(SLAPI_OPERATION_SEARCH, DSE_FLAG_PREOP, cache->dn,
+                                     LDAP_SCOPE_BASE, "(objectclass=*)", uniqueness_cache_search);
+        slapi_ch_free_string(&cache->dn);
+    }
+    slapi_unregister_backend_state_change((void *)config);
+    PR_Lock(cache->build_lock);
+    slapi_atomic_store_32(&cache->stopping, 1, __ATOMIC_RELEASE);
+    while (cache->eq_ctx && !slapi_eq_cancel_rel(cache->eq_ctx)) {
+        /* the event is running, wait until it is done with the cache */
+        PR_Unlock(cache->build_lock);
+        DS_Sleep(PR_MillisecondsToInterval(10));
+        PR_Lock(cache->build_lock);
+    }
+    cache->eq_ctx = NULL;
+    PR_Unlock(cache->build_lock);
+    if (cache->builder) {
+        /* the builder checks stopping between two entries */
+        PR_JoinThread(cache->builder);
+    }
+
+    uniqueness_cache_free_table(&cache->loading);
+    uniqueness_cache_free_table(&cache->values);
+    for (size_t i = 0; cache->sattrs[i]; i++) {
+        slapi_attr_free(&cache->sattrs[i]);
+    }
+    slapi_ch_free((void **)&cache->sattrs);
+    PR_DestroyLock(cache->build_lock);
+    slapi_destroy_rwlock(cache->lock);
+    slapi_ch_free((void **)&config->cache);
+}
+
+/*
+ * Build the hash keys of vals as stored by the equality index of the
+ * i-th unique attribute.  The returned array must be freed.
+ */
+static char **
+uniqueness_cache_keys(uniqueness_cache_t *cache, size_t i, Slapi_Value **vals)
+{
+    Slapi_Value **ivals = NULL;
+    char **keys = NULL;
+
+    slapi_attr_values2keys_sv(cache->sattrs[i], vals, &ivals, LDAP_FILTER_EQUALITY);
+    for (size_t k = 0; ivals && ivals[k]; k++) {
+        const struct berval *bv = slapi_value_get_berval(ivals[k]);
+        charray_add(&keys, slapi_ch_smprintf("%lu:%.*s", (unsigned long)i, (int)bv->bv_len, bv->bv_val));
+    }
+    uniqueness_cache_free_values(&ivals);
+
+    return keys;
+}
+
+/*
+ * Add delta to the number of entries holding key in table.  The key is
+ * dropped when no entry holds it anymore, a count never goes below zero.
+ */
+static void
+uniqueness_cache_count(PLHashTable *table, const char *key, intptr_t delta)
+{
+    PLHashNumber hash = PL_HashString(key);
+    PLHashEntry **hep = PL_HashTableRawLookup(table, hash, key);
+    PLHashEntry *he = *hep;
+    intptr_t count = (he ? (intptr_t)he->value : 0) + delta;
+
+    if (he && count <= 0) {
+        char *stored = (char *)he->key;
+        PL_HashTableRawRemove(table, hep, he);
+        slapi_ch_free_string(&stored);
+    } else if (he) {
+        he->value = (void *)count;
+    } else if (count > 0) {
+        PL_HashTableRawAdd(table, hep, hash, slapi_ch_strdup(key), (void *)count);
+    }
+}
+
+/*
+ * Count vals, held by the i-th unique attribute, delta more times.  The
+ * builder only counts the entries it reads in the table being loaded, the
+ * operations are counted in both tables.
+ */
+static void
+uniqueness_cache_update(uniqueness_cache_t *cache, size_t i, Slapi_Value **vals, intptr_t delta, PRBool loader)
+{
+    char **keys = uniqueness_cache_keys(cache, i, vals);
+
+    slapi_rwlock_wrlock(cache->lock);
+    for (size_t k = 0; keys && keys[k]; k++) {
+        if (!loader) {
+            uniqueness_cache_count(cache->values, keys[k], delta);
+        }
+        if (cache->loading) {
+            uniqueness_cache_count(cache->loading, keys[k], delta);
+        }
+    }
+    slapi_rwlock_unlock(cache->lock);
+    slapi_ch_array_free(keys);
+}
+
+/* Return a copy of the values of attr or, if attr is NULL, of values */
+static Slapi_Value **
+uniqueness_cache_get_values(Slapi_Attr *attr, struct berval **values)
+{
+    Slapi_Value **vals = NULL;
+    size_t nvals = 0;
+
+    if (attr) {
+        Slapi_Value *v = NULL;
+        int numvalues = 0;
+
+        slapi_attr_get_numvalues(attr, &numvalues);
+        vals = (Slapi_Value **)slapi_ch_calloc(numvalues + 1, sizeof(Slapi_Value *));
+        for (int hint = slapi_attr_first_value(attr, &v); hint != -1 && nvals < (size_t)numvalues;
+             hint = slapi_attr_next_value(attr, hint, &v)) {
+            vals[nvals++] = slapi_value_dup(v);
+        }
+    } else {
+        for (; values && values[nvals]; nvals++)
+            ;
+        vals = (Slapi_Value **)slapi_ch_calloc(nvals + 1, sizeof(Slapi_Value *));
+        for (size_t k = 0; k < nvals; k++) {
+            vals[k] = slapi_value_new_berval(values[k]);
+        }
+    }
+    return vals;
+}
+
+/*
+ * Tell whether a value of attr (or values) may already be held by an entry,
+ * under any of the unique attributes.  Only a PR_FALSE answer is
+ * authoritative, a PR_TRUE means the database has to be searched.
+ */
+static PRBool
+uniqueness_cache_may_exist(attr_uniqueness_config_t *config, Slapi_Attr *attr, struct berval **values)
+{
+    uniqueness_cache_t *cache = config->cache;
+    Slapi_Value **vals = NULL;
+    PRBool found = PR_FALSE;
+
+    if (cache == NULL || !slapi_atomic_load_32(&cache->valid, __ATOMIC_ACQUIRE)) {
+        return PR_TRUE;
+    }
+
+    vals = uniqueness_cache_get_values(attr, values);
+    for (size_t i = 0; !found && cache->sattrs[i]; i++) {
+        char **keys = uniqueness_cache_keys(cache, i, vals);
+
+        slapi_rwlock_rdlock(cache->lock);
+        for (size_t k = 0; keys && keys[k]; k++) {
+            if (PL_HashTableLookup(cache->values, keys[k])) {
+                found = PR_TRUE;
                 break;
             }
+        }
+        slapi_rwlock_unlock(cache->lock);
+        slapi_ch_array_free(keys);
+    }
+    uniqueness_cache_free_values(&vals);
+    slapi_atomic_incr_64(found ? &cache->hits : &cache->misses, __ATOMIC_RELAXED);
 
-            /* Do the same check for excluded subtrees as resulted entries may have matched them */
-            for (i = 0; excludes && excludes[i]; i++) {
-                Slapi_DN *entry_dn = slapi_entry_get_sdn(*entries);
-                if (slapi_sdn_issuffix(entry_dn, excludes[i])) {
-                    result = LDAP_SUCCESS;
-                    break;
-                }
-            }
+    return found;
+}
 
-            if (result == LDAP_CONSTRAINT_VIOLATION) {
-                break;
+/* DSE search callback adding the cache statistics to the plugin entry */
+static int
+uniqueness_cache_search(Slapi_PBlock *pb __attribute__((unused)),
+                        Slapi_Entry *e,
+                        Slapi_Entry *entryAfter __attribute__((unused)),
+                        int *returncode __attribute__((unused)),
+                        char *returntext __attribute__((unused)),
+                        void *arg)
+{
+    uniqueness_cache_t *cache = (uniqueness_cache_t *)arg;
+    uint64_t values;
+
+    slapi_rwlock_rdlock(cache->lock);
+    values = cache->values->nentries;
+    slapi_rwlock_unlock(cache->lock);
+
+    slapi_entry_attr_set_ulong(e, ATTR_UNIQUENESS_CACHE_HITS,
+                               slapi_atomic_load_64(&cache->hits, __ATOMIC_RELAXED));
+    slapi_entry_attr_set_ulong(e, ATTR_UNIQUENESS_CACHE_MISSES,
+                               slapi_atomic_load_64(&cache->misses, __ATOMIC_RELAXED));
+    slapi_entry_attr_set_ulong(e, ATTR_UNIQUENESS_CACHE_VALUES, values);
+
+    return SLAPI_DSE_CALLBACK_OK;
+}
+
+/* Only the entries of the configured subtrees are counted */
+static PRBool
+uniqueness_cache_in_scope(attr_uniqueness_config_t *config, Slapi_Entry *e)
+{
+    const Slapi_DN *sdn = slapi_entry_get_sdn_const(e);
+
+    for (size_t i = 0; config->subtrees[i]; i++) {
+        if (slapi_sdn_issuffix(sdn, config->subtrees[i])) {
+            return PR_TRUE;
+        }
+    }
+    return PR_FALSE;
+}
+
+/*
+ * Count delta more times the values of the unique attributes that e
+ * holds and that other (the entry before or after the operation, if any)
+ * does not.
+ */
+static void
+uniqueness_cache_count_entry(attr_uniqueness_config_t *config, Slapi_Entry *e, Slapi_Entry *other, intptr_t delta, PRBool loader)
+{
+    if (e == NULL || !uniqueness_cache_in_scope(config, e)) {
+        return;
+    }
+    if (other && !uniqueness_cache_in_scope(config, other)) {
+        other = NULL;
+    }
+    for (size_t i = 0; config->attrs[i]; i++) {
+        Slapi_Attr *attr = NULL;
+        Slapi_Attr *other_attr = NULL;
+        Slapi_Value **vals = NULL;
+        size_t n = 0;
+
+        if (slapi_entry_attr_find(e, config->attrs[i], &attr) != 0) {
+            continue;
+        }
+        if (other) {
+            slapi_entry_attr_find(other, config->attrs[i], &other_attr);
+        }
+        vals = uniqueness_cache_get_values(attr, NULL);
+        for (size_t k = 0; vals[k]; k++) {
+            if (other_attr && slapi_attr_value_find(other_attr, slapi_value_get_berval(vals[k])) == 0) {
+                slapi_value_free(&vals[k]);
+            } else {
+                vals[n++] = vals[k];
             }
         }
+        vals[n] = NULL;
+        if (n) {
+            uniqueness_cache_update(config->cache, i, vals, delta, loader);
+        }
+        uniqueness_cache_free_values(&vals);
     }
+}
 
-#ifdef DEBUG
-    slapi_log_err(SLAPI_LOG_PLUGIN, plugin_name,
-                  "search_one_berval - SEARCH complete result=%d\n", result);
-#endif
-    END
+static int
+uniqueness_cache_load_entry(Slapi_Entry *e, void *callback_data)
+{
+    attr_uniqueness_config_t *config = (attr_uniqueness_config_t *)callback_data;
 
-        /* Clean-up */
-        if (spb)
-    {
-        slapi_free_search_results_internal(spb);
-        slapi_pblock_destroy(spb);
+    if (slapi_atomic_load_32(&config->cache->stopping, __ATOMIC_ACQUIRE)) {
+        return -1;
     }
+    uniqueness_cache_count_entry(config, e, NULL, 1, PR_TRUE);
+    return 0;
+}
 
-    slapi_ch_free((void **)&filter);
+/*
+ * A loaded count replaces the current one when it is larger: an
+ * operation counted before the load started may not be committed
+ * yet, so the load could have missed it.
+ */
+static PRIntn
+uniqueness_cache_merge_key(PLHashEntry *he, PRIntn i __attribute__((unused)), void *arg)
+{
+    PLHashTable *values = (PLHashTable *)arg;
+    PLHashEntry **hep = PL_HashTableRawLookup(values, he->keyHash, he->key);
 
-    return result;
+    if (*hep == NULL) {
+        PL_HashTableRawAdd(values, hep, he->keyHash, slapi_ch_strdup(he->key), he->value);
+    } else if ((intptr_t)(*hep)->value < (intptr_t)he->value) {
+        (*hep)->value = he->value;
+    }
+    return HT_ENUMERATE_NEXT;
+}
+
+/*
+ * Count the values found in the configured subtrees.  They are counted
+ * in a new table, that the operations running meanwhile update as well,
+ * which is then merged into the cache.
+ */
+static int
+uniqueness_cache_load(attr_uniqueness_config_t *config)
+{
+    uniqueness_cache_t *cache = config->cache;
+    Slapi_PBlock *search_pb = NULL;
+    char *filter = NULL;
+    char *tmp = NULL;
+    int rc = LDAP_SUCCESS;
+
+    for (size_t i = 0; config->attrs[i]; i++) {
+        tmp = slapi_ch_smprintf("%s(%s=*)", filter ? filter : "", config->attrs[i]);
+        slapi_ch_free_string(&filter);
+        filter = tmp;
+    }
+    tmp = slapi_ch_smprintf("(|%s)", filter);
+    slapi_ch_free_string(&filter);
+    filter = tmp;
+
+    slapi_rwlock_wrlock(cache->lock);
+    cache->loading = PL_NewHashTable(4096, PL_HashString, PL_CompareStrings,
+                                     PL_CompareValues, NULL, NULL);
+    slapi_rwlock_unlock(cache->lock);
+
+    search_pb = slapi_pblock_new();
+    for (size_t i = 0; config->subtrees[i] && rc == LDAP_SUCCESS; i++) {
+        slapi_pblock_init(search_pb);
+        slapi_search_internal_set_pb_ext(search_pb, config->subtrees[i], LDAP_SCOPE_SUBTREE, filter,
+                                         (char **)config->attrs, 0, NULL, NULL, plugin_identity, 0);
+        slapi_search_internal_stream_pb(search_pb, config, uniqueness_cache_load_entry);
+        slapi_pblock_get(search_pb, SLAPI_PLUGIN_INTOP_RESULT, &rc);
+        if (rc == LDAP_NO_SUCH_OBJECT) {
+            rc = LDAP_SUCCESS;
+        }
+    }
+    slapi_pblock_destroy(search_pb);
+    slapi_ch_free_string(&filter);
+
+    slapi_rwlock_wrlock(cache->lock);
+    if (rc == LDAP_SUCCESS) {
+        PL_HashTableEnumerateEntries(cache->loading, uniqueness_cache_merge_key, cache->values);
+    }
+    uniqueness_cache_free_table(&cache->loading);
+    slapi_rwlock_unlock(cache->lock);
+
+    return rc;
+}
+
+static void
+uniqueness_cache_build_thread(void *arg)
+{
+    attr_uniqueness_config_t *config = (attr_uniqueness_config_t *)arg;
+    uniqueness_cache_t *cache = config->cache;
+    int rc = LDAP_SUCCESS;
+
+    PR_Lock(cache->build_lock);
+    while (cache->rebuild && !cache->stopping) {
+        cache->rebuild = 0;
+        PR_Unlock(cache->build_lock);
+        rc = uniqueness_cache_load(config);
+        PR_Lock(cache->build_lock);
+    }
+    if (rc == LDAP_SUCCESS && !cache->stopping) {
+        slapi_atomic_store_32(&cache->valid, 1, __ATOMIC_RELEASE);
+        slapi_log_err(SLAPI_LOG_PLUGIN, plugin_name,
+                      "uniqueness_cache_build_thread - %s cache loaded (%d values)\n",
+                      config->attr_friendly, cache->values->nentries);
+    } else if (rc != LDAP_SUCCESS) {
+        slapi_log_err(SLAPI_LOG_ERR, plugin_name,
+                      "uniqueness_cache_build_thread - Failed to load the %s cache (%d), "
+                      "uniqueness is checked with searches\n",
+                      config->attr_friendly, rc);
+    }
+    cache->running = 0;
+    PR_Unlock(cache->build_lock);
+}
+
+/*
+ * Stop trusting the cache until the database has been scanned again, for
+ * instance because entries were imported without going through the plugin.
+ * The build lock must be held.
+ */
+static void
+uniqueness_cache_request_build_nolock(attr_uniqueness_config_t *config)
+{
+    uniqueness_cache_t *cache = config->cache;
+
+    slapi_atomic_store_32(&cache->valid, 0, __ATOMIC_RELEASE);
+    cache->rebuild = 1;
+    if (!cache->running && !cache->stopping) {
+        if (cache->builder) {
+            /* previous run is over, reap it */
+            PR_JoinThread(cache->builder);
+        }
+        cache->running = 1;
+        cache->builder = PR_CreateThread(PR_USER_THREAD, uniqueness_cache_build_thread,
+                                         (void *)config, PR_PRIORITY_NORMAL, PR_GLOBAL_THREAD,
+                                         PR_JOINABLE_THREAD, SLAPD_DEFAULT_THREAD_STACKSIZE);
+        if (cache->builder == NULL) {
+            slapi_log_err(SLAPI_LOG_ERR, plugin_name,
+                          "uniqueness_cache_request_build - Failed to create the builder thread\n");
+            cache->running = 0;
+        }
+    }
+}
+
+static void
+uniqueness_cache_request_build(attr_uniqueness_config_t *config)
+{
+    PR_Lock(config->cache->build_lock);
+    uniqueness_cache_request_build_nolock(config);
+    PR_Unlock(config->cache->build_lock);
+}
+
+static void
+uniqueness_cache_build_event(time_t when __attribute__((unused)), void *arg)
+{
+    attr_uniqueness_config_t *config = (attr_uniqueness_config_t *)arg;
+
+    /* uniqueness_cache_free waits for eq_ctx to be cleared */
+    PR_Lock(config->cache->build_lock);
+    config->cache->eq_ctx = NULL;
+    uniqueness_cache_request_build_nolock(config);
+    PR_Unlock(config->cache->build_lock);
+}
+
+static void
+uniqueness_cache_be_state_change(void *handle, char *be_name __attribute__((unused)), int old_be_state, int new_be_state)
+{
+    attr_uniqueness_config_t *config = (attr_uniqueness_config_t *)handle;
+
+    /* An import or a restore may have added entries behind our back */
+    if (new_be_state == SLAPI_BE_STATE_ON && old_be_state != SLAPI_BE_STATE_ON) {
+        uniqueness_cache_request_build(config);
+    }
+}
+
+/*
+ * uniqueness_cache_add_postop - count the values an operation added
+ *
+ * This runs before the commit so that the operations checked afterwards
+ * find them.  If the transaction is aborted, they only cost a search.
+ */
+static int
+uniqueness_cache_add_postop(Slapi_PBlock *pb)
+{
+    attr_uniqueness_config_t *config = NULL;
+    Slapi_Entry *pre_entry = NULL;
+    Slapi_Entry *post_entry = NULL;
+    int oprc = 0;
+
+    slapi_pblock_get(pb, SLAPI_PLUGIN_OPRETURN, &oprc);
+    if (oprc) {
+        return SLAPI_PLUGIN_SUCCESS;
+    }
+    slapi_pblock_get(pb, SLAPI_ENTRY_PRE_OP, &pre_entry);
+    slapi_pblock_get(pb, SLAPI_ENTRY_POST_OP, &post_entry);
+
+    slapi_rwlock_rdlock(uniqueness_caches_lock);
+    for (config = uniqueness_caches; config; config = config->cache_next) {
+        uniqueness_cache_count_entry(config, post_entry, pre_entry, 1, PR_FALSE);
+    }
+    slapi_rwlock_unlock(uniqueness_caches_lock);
+
+    return SLAPI_PLUGIN_SUCCESS;
+}
+
+/*
+ * uniqueness_cache_remove_postop - forget the values an operation removed
+ *
+ * This only runs once the operation is committed: a value must stay
+ * counted as long as the database may still hold it.
+ */
+static int
+uniqueness_cache_remove_postop(Slapi_PBlock *pb)
+{
+    attr_uniqueness_config_t *config = NULL;
+    Slapi_Entry *pre_entry = NULL;
+    Slapi_Entry *post_entry = NULL;
+    int oprc = 0;
+
+    slapi_pblock_get(pb, SLAPI_PLUGIN_OPRETURN, &oprc);
+    if (oprc) {
+        return SLAPI_PLUGIN_SUCCESS;
+    }
+    slapi_pblock_get(pb, SLAPI_ENTRY_PRE_OP, &pre_entry);
+    slapi_pblock_get(pb, SLAPI_ENTRY_POST_OP, &post_entry);
+
+    slapi_rwlock_rdlock(uniqueness_caches_lock);
+    for (config = uniqueness_caches; config; config = config->cache_next) {
+        uniqueness_cache_count_entry(config, pre_entry, post_entry, -1, PR_FALSE);
+    }
+    slapi_rwlock_unlock(uniqueness_caches_lock);
+
+    return SLAPI_PLUGIN_SUCCESS;
+}
+
+static int
+uniqueness_cache_betxn_postop_init(Slapi_PBlock *pb)
+{
+    if (slapi_pblock_set(pb, SLAPI_PLUGIN_VERSION, SLAPI_PLUGIN_VERSION_01) != 0 ||
+        slapi_pblock_set(pb, SLAPI_PLUGIN_DESCRIPTION, (void *)&pluginDesc) != 0 ||
+        slapi_pblock_set(pb, SLAPI_PLUGIN_BE_TXN_POST_ADD_FN, (void *)uniqueness_cache_add_postop) != 0 ||
+        slapi_pblock_set(pb, SLAPI_PLUGIN_BE_TXN_POST_MODIFY_FN, (void *)uniqueness_cache_add_postop) != 0 ||
+        slapi_pblock_set(pb, SLAPI_PLUGIN_BE_TXN_POST_MODRDN_FN, (void *)uniqueness_cache_add_postop) != 0) {
+        slapi_log_err(SLAPI_LOG_ERR, plugin_name, "uniqueness_cache_betxn_postop_init - Failed to register plugin\n");
+        return -1;
+    }
+    return 0;
+}
+
+static int
+uniqueness_cache_postop_init(Slapi_PBlock *pb)
+{
+    if (slapi_pblock_set(pb, SLAPI_PLUGIN_VERSION, SLAPI_PLUGIN_VERSION_01) != 0 ||
+        slapi_pblock_set(pb, SLAPI_PLUGIN_DESCRIPTION, (void *)&pluginDesc) != 0 ||
+        slapi_pblock_set(pb, SLAPI_PLUGIN_POST_DELETE_FN, (void *)uniqueness_cache_remove_postop) != 0 ||
+        slapi_pblock_set(pb, SLAPI_PLUGIN_POST_MODIFY_FN, (void *)uniqueness_cache_remove_postop) != 0 ||
+        slapi_pblock_set(pb, SLAPI_PLUGIN_POST_MODRDN_FN, (void *)uniqueness_cache_remove_postop) != 0) {
+        slapi_log_err(SLAPI_LOG_ERR, plugin_name, "uniqueness_cache_postop_init - Failed to register plugin\n");
+        return -1;
+    }
+    return 0;
+}
+
+static int
+uniqueness_cache_internal_postop_init(Slapi_PBlock *pb)
+{
+    if (slapi_pblock_set(pb, SLAPI_PLUGIN_VERSION, SLAPI_PLUGIN_VERSION_01) != 0 ||
+        slapi_pblock_set(pb, SLAPI_PLUGIN_DESCRIPTION, (void *)&pluginDesc) != 0 ||
+        slapi_pblock_set(pb, SLAPI_PLUGIN_INTERNAL_POST_DELETE_FN, (void *)uniqueness_cache_remove_postop) != 0 ||
+        slapi_pblock_set(pb, SLAPI_PLUGIN_INTERNAL_POST_MODIFY_FN, (void *)uniqueness_cache_remove_postop) != 0 ||
+        slapi_pblock_set(pb, SLAPI_PLUGIN_INTERNAL_POST_MODRDN_FN, (void *)uniqueness_cache_remove_postop) != 0) {
+        slapi_log_err(SLAPI_LOG_ERR, plugin_name, "uniqueness_cache_internal_postop_init - Failed to register plugin\n");
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * The cache is maintained by separate post-op plugins, shared by all the
+ * instances having a cache.  The values are counted before the commit and
+ * uncounted after it, so that the cache never misses a stored value.
+ */
+static int
+uniqueness_cache_register_postops(void)
+{
+    if (uniqueness_cache_postops_registered) {
+        return 0;
+    }
+    if (uniqueness_caches_lock == NULL) {
+        uniqueness_caches_lock = slapi_new_rwlock();
+    }
+    if (slapi_register_plugin("betxnpostoperation", 1, "uniqueness_cache_betxn_postop_init",
+                              uniqueness_cache_betxn_postop_init, UNIQUENESS_CACHE_BETXN_POSTOP_DESC,
+                              NULL, plugin_identity) ||
+        slapi_register_plugin("postoperation", 1, "uniqueness_cache_postop_init",
+                              uniqueness_cache_postop_init, UNIQUENESS_CACHE_POSTOP_DESC,
+                              NULL, plugin_identity) ||
+        slapi_register_plugin("internalpostoperation", 1, "uniqueness_cache_internal_postop_init",
+                              uniqueness_cache_internal_postop_init, UNIQUENESS_CACHE_INT_POSTOP_DESC,
+                              NULL, plugin_identity)) {
+        slapi_log_err(SLAPI_LOG_ERR, plugin_name,
+                      "uniqueness_cache_register_postops - Failed to register the cache post-op plugins\n");
+        return -1;
+    }
+    uniqueness_cache_postops_registered = 1;
+    return 0;
 }
 
 /* ------------------------------------------------------------ */
@@ -1042,6 +1737,9 @@ preop_add(Slapi_PBlock *pb)
                 result = findSubtreeAndSearch(targetSDN, attrNames, attr, NULL,
                                               requiredObjectClass, targetSDN,
                                               markerObjectClass, config->exclude_subtrees);
+            } else if (!uniqueness_cache_may_exist(config, attr, NULL)) {
+                /* None of these values is held by any entry */
+                result = LDAP_SUCCESS;
             } else {
                 /* Subtrees listed on invocation line */
                 result = searchAllSubtrees(config->subtrees, config->exclude_subtrees, attrNames, attr, NULL,
@@ -1215,6 +1913,9 @@ preop_modify(Slapi_PBlock *pb)
             result = findSubtreeAndSearch(targetSDN, attrNames, NULL,
                                           mod->mod_bvalues, requiredObjectClass,
                                           targetSDN, markerObjectClass, config->exclude_subtrees);
+        } else if (!uniqueness_cache_may_exist(config, NULL, mod->mod_bvalues)) {
+            /* None of these values is held by any entry */
+            result = LDAP_SUCCESS;
         } else {
             /* Subtrees listed on invocation line */
             result = searchAllSubtrees(config->subtrees, config->exclude_subtrees, attrNames, NULL,
@@ -1394,6 +2095,9 @@ preop_modrdn(Slapi_PBlock *pb)
                 result = findSubtreeAndSearch(destinationSDN, attrNames, attr, NULL,
                                               requiredObjectClass, sourceSDN,
                                               markerObjectClass, config->exclude_subtrees);
+            } else if (!uniqueness_cache_may_exist(config, attr, NULL)) {
+                /* None of these values is held by any entry */
+                result = LDAP_SUCCESS;
             } else {
                 /* Subtrees listed on invocation line */
                 result = searchAllSubtrees(config->subtrees, config->exclude_subtrees, attrNames, attr, NULL,
@@ -1440,6 +2144,23 @@ uiduniq_start(Slapi_PBlock *pb)
             return SLAPI_PLUGIN_FAILURE;
         }
         slapi_pblock_set(pb, SLAPI_PLUGIN_PRIVATE, (void *)config);
+        if (config->cache && !uniqueness_cache_postops_registered) {
+            slapi_log_err(SLAPI_LOG_ERR, plugin_name, "uiduniq_start - "
+                                                      "The cache post-op plugins are not registered, %s ignored\n",
+                          ATTR_UNIQUENESS_CACHE);
+            uniqueness_cache_free(config);
+        }
+        if (config->cache) {
+            /* Count the values once the server is up, and again after an import */
+            uniqueness_cache_register(config);
+            slapi_register_backend_state_change((void *)config, uniqueness_cache_be_state_change);
+            config->cache->dn = slapi_ch_strdup(slapi_entry_get_dn_const(plugin_entry));
+            slapi_config_register_callback_plugin(SLAPI_OPERATION_SEARCH, DSE_FLAG_PREOP | DSE_FLAG_PLUGIN,
+                                                  config->cache->dn, LDAP_SCOPE_BASE, "(objectclass=*)",
+                                                  uniqueness_cache_search, (void *)config->cache, pb);
+            config->cache->eq_ctx = slapi_eq_once_rel(uniqueness_cache_build_event, (void *)config,
+                                                      slapi_current_rel_time_t() + 1);
+        }
     }
 
     return 0;
@@ -1527,6 +2248,13 @@ NSUniqueAttr_Init(Slapi_PBlock *pb)
     if (err)
         break;
 
+    /* The cache is kept up to date by post-op plugins */
+    if (plugin_entry && slapi_entry_attr_get_bool(plugin_entry, ATTR_UNIQUENESS_CACHE)) {
+        err = uniqueness_cache_register_postops();
+        if (err)
+            break;
+    }
+
 
     END
 
@@ -700,7 +700,7 @@ slapd_log_access_result(slapd_log_pblock *logpb)
                 json_object_object_add(note, "base_dn", json_obj_add_str(base_dn));
                 json_object_object_add(note, "filter", json_obj_add_str(filter_str));
                 json_object_object_add(note, "scope", json_object_new_int(scope));
-            } else if (strcmp("F", notes[i]) == 0 && logpb->pb) {
+            } else if ((strcmp("F", notes[i]) == 0 || strcmp("C", notes[i]) == 0) && logpb->pb) {
                 slapi_pblock_get(logpb->pb, SLAPI_SEARCH_STRFILTER, &filter_str);
                 json_object_object_add(note, "filter", json_obj_add_str(filter_str));
             }
@@ -24,16 +24,16 @@ get_ava(
     BerElement *ber,
     struct ava *ava)
 {
-    char *type = NULL;
+    struct berval type = {0};
 
-    if (ber_scanf(ber, "{ao}", &type, &ava->ava_value) == LBER_ERROR) {
-        slapi_ch_free_string(&type);
+    /* The type is only normalized, read it in place from the request */
+    if (ber_scanf(ber, "{mo}", &type, &ava->ava_value) == LBER_ERROR) {
+        ava->ava_type = NULL;
         ava_done(ava);
         slapi_log_err(SLAPI_LOG_ERR, "get_ava", "ber_scanf\n");
         return (LDAP_PROTOCOL_ERROR);
     }
-    ava->ava_type = slapi_attr_syntax_normalize(type);
-    slapi_ch_free_string(&type);
+    ava->ava_type = slapi_attr_syntax_normalize(type.bv_val);
     ava->ava_private = NULL;
 
     return (0);
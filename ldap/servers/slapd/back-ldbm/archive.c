@@ -265,6 +265,8 @@ ldbm_back_ldbm2archive(Slapi_PBlock *pb)
     char *rawdirectory = NULL; /* -a <directory> */
     char *directory = NULL;    /* normalized */
     char *dir_bak = NULL;
+    char *rawbase = NULL;      /* incremental backup base */
+    char *base = NULL;         /* normalized */
     int return_value = -1;
     int task_flags = 0;
     int run_from_cmdline = 0;
@@ -274,6 +276,7 @@ ldbm_back_ldbm2archive(Slapi_PBlock *pb)
 
     slapi_pblock_get(pb, SLAPI_PLUGIN_PRIVATE, &li);
     slapi_pblock_get(pb, SLAPI_SEQ_VAL, &rawdirectory);
+    slapi_pblock_get(pb, SLAPI_BACKUP_INCREMENTAL_BASE, &rawbase);
     slapi_pblock_get(pb, SLAPI_TASK_FLAGS, &task_flags);
     li->li_flags = run_from_cmdline = (task_flags & SLAPI_TASK_RUNNING_FROM_COMMANDLINE);
 
@@ -310,6 +313,19 @@ ldbm_back_ldbm2archive(Slapi_PBlock *pb)
 
     /* Initialize directory */
     directory = rel2abspath(rawdirectory);
+    if (rawbase && *rawbase) {
+        base = rel2abspath(rawbase);
+        if (slapd_comp_path(directory, base) == 0) {
+            slapi_log_err(SLAPI_LOG_ERR,
+                          "ldbm_back_ldbm2archive", "The incremental backup base can not be the archive directory.\n");
+            if (task) {
+                slapi_task_log_notice(task,
+                                      "The incremental backup base can not be the archive directory.");
+            }
+            return_value = -1;
+            goto out;
+        }
+    }
 
     if (stat(directory, &sbuf) == 0) {
         if (slapd_comp_path(directory, li->li_directory) == 0) {
@@ -406,7 +422,7 @@ ldbm_back_ldbm2archive(Slapi_PBlock *pb)
     }
 
     /* tell it to archive */
-    return_value = dblayer_backup(li, directory, task);
+    return_value = dblayer_backup(li, directory, base, task);
     if (return_value) {
         slapi_log_err(SLAPI_LOG_BACKLDBM,
                       "ldbm_back_ldbm2archive", "dblayer_backup failed (%d).\n", return_value);
@@ -482,6 +498,7 @@ out:
 
     slapi_ch_free_string(&dir_bak);
     slapi_ch_free_string(&directory);
+    slapi_ch_free_string(&base);
     return return_value;
 }
 
@@ -103,6 +103,7 @@ typedef unsigned short u_int16_t;
  * Starting from DS7.2
  */
 #define BE_CHANGELOG_FILE     "replication_changelog"
+#define ID2VALUES             "id2values"  /* out of line values of the large attributes */
 
 #define BDB_IMPL              "bdb"
 #define BDB_BACKEND           "libback-ldbm" /* This backend plugin */
@@ -388,6 +389,12 @@ struct cache
 typedef struct dblayer_private     dblayer_private;
 typedef struct idl_private         idl_private;
 typedef struct attrcrypt_private   attrcrypt_private;
+typedef struct index_stats_private index_stats_private;
+
+/* index_stats estimates (in number of IDs) */
+#define INDEX_STATS_UNKNOWN        UINT64_MAX                 /* no statistics */
+#define INDEX_STATS_ALLIDS_COST    ((uint64_t)UINT32_MAX)     /* key is allids */
+#define INDEX_STATS_UNINDEXED_COST ((uint64_t)UINT32_MAX + 1) /* attribute is not indexed */
 
 /*
  * Special attributes for an index entry to change the substring index width.
@@ -420,10 +427,18 @@ typedef struct attrcrypt_private   attrcrypt_private;
  * 1) stop the server,
  * 2) run db2index -t <attr>,
  * 3) start the server.
+ *
+ * "nsSubStrPositional: on" additionally indexes every middle key with its
+ * position in the value (see INDEX_SUBSTRPOS in slap.h). The substring
+ * searches then check that the keys are adjacent while building the
+ * candidate list, and skip the filter test when every component of the
+ * assertion could be checked. The index is about twice as large and needs
+ * to be regenerated the same way.
  */
 #define INDEX_ATTR_SUBSTRBEGIN  "nsSubStrBegin"
 #define INDEX_ATTR_SUBSTRMIDDLE "nsSubStrMiddle"
 #define INDEX_ATTR_SUBSTREND    "nsSubStrEnd"
+#define INDEX_ATTR_SUBSTRPOSITIONAL "nsSubStrPositional"
 
 #define INDEX_SUBSTRBEGIN  0
 #define INDEX_SUBSTRMIDDLE 1
@@ -464,6 +479,7 @@ struct attrinfo
     uint64_t ai_dblayer_count;           /* used by the dblayer code */
     idl_private *ai_idl;                 /* private data used by the IDL code (eg locking the IDLs) */
     attrcrypt_private *ai_attrcrypt;     /* private data used by the attribute encryption code (eg is it enabled or not) */
+    index_stats_private *ai_stats;       /* index key cardinality statistics used by the filter planner */
     value_compare_fn_type ai_key_cmp_fn; /* function used to compare two index keys -
                                             The function is the compare function provided by
                                             attr_get_value_cmp_fn - this function is used to order
@@ -564,6 +580,7 @@ struct ldbminfo
     uint64_t li_import_cachesize;       /* size of the mpool for imports */
     int li_shutdown;                     /* flag to tell any BE threads to end */
     PRLock *li_shutdown_mutex;           /* protect shutdown flag */
+    Slapi_Eq_Context li_subcount_flush_ctx; /* event flushing the subordinate counts */
     dblayer_private *li_dblayer_private; /* session ptr for databases */
     void *li_dblayer_config;             /* pointer to specific backend implementation */
     char *li_backend_implement;          /* low layer backend implementation */
@@ -591,6 +608,7 @@ struct ldbminfo
     int li_filter_bypass;       /* bypass filter testing, when possible */
     int li_filter_bypass_check; /* check that filter bypass is doing the right thing */
     int li_use_vlv;             /* use vlv indexes to short-circuit matches when possible */
+    int li_filter_planning;     /* order the AND filter components by estimated cost */
     void *li_identity;          /* The ldbm plugin needs to keep track of its identity so it can
                                  * perform internal ops.  Its identity is given to it when
                                  * its init function is called. */
@@ -699,6 +717,9 @@ struct _modify_context
     struct backentry *new_entry;
     Slapi_Mods *smods;
     int attr_encrypt;
+    int subcount_deferred;    /* 1: subordinate count change pending, 2: applied */
+    int32_t subcount_delta;   /* numsubordinates change of old_entry */
+    int32_t tombstone_delta;  /* tombstonenumsubordinates change of old_entry */
 };
 typedef struct _modify_context modify_context;
 
@@ -726,6 +747,7 @@ struct _perfctrs_private
     void *memory;
 };
 typedef struct _perfctrs_private perfctrs_private;
+typedef struct id2values_detached id2values_detached; /* id2values.c */
 
 typedef struct _attrcrypt_state_private attrcrypt_state_private;
 
@@ -762,6 +784,7 @@ typedef struct ldbm_instance
 
     dbi_db_t *inst_id2entry; /* id2entry for this instance. */
     dbi_db_t *inst_changelog; /* changelog for this instance. */
+    dbi_db_t *inst_id2values; /* out of line attribute values for this instance. */
 
     perfctrs_private inst_perf_private; /* Private data for the performance counters specific to this instance */
     attrcrypt_state_private *inst_attrcrypt_state_private;
@@ -784,6 +807,11 @@ typedef struct ldbm_instance
     void *inst_db;                   /* implementation specific instance data */
     int require_index;               /* set to 1 to require an index be used in search */
     int require_internalop_index;    /* set to 1 to require an index be used in an internal search */
+    int inst_outofline_threshold;    /* attributes with more values are stored in id2values, 0: disabled */
+    int32_t inst_id2values_active;   /* id2values may have records: read and update it */
+    int inst_subcount_flush_interval; /* seconds between subordinate count flushes, 0: parents rewritten inline */
+    struct _subcount_table *inst_subcount; /* subordinate counts kept in memory (parents.c) */
+    PRLock *inst_subcount_mutex;     /* protects inst_subcount creation, flush and destruction */
     struct cache inst_dncache;       /* The dn cache for this instance. */
 } ldbm_instance;
 
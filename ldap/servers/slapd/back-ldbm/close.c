@@ -28,6 +28,11 @@ ldbm_back_close(Slapi_PBlock *pb)
     li->li_shutdown = 1;
     PR_Unlock(li->li_shutdown_mutex);
 
+    if (li->li_subcount_flush_ctx) {
+        slapi_eq_cancel_rel(li->li_subcount_flush_ctx);
+        li->li_subcount_flush_ctx = NULL;
+    }
+
     /* close down all the ldbm instances */
     dblayer_close(li, DBLAYER_NORMAL_MODE);
 
@@ -21,6 +21,7 @@
 
 #include "bdb_layer.h"
 #include "../vlv_srch.h"
+#include <zlib.h>
 
 #define indextype_EQUALITY "eq"
 
@@ -115,6 +116,7 @@ typedef struct
     char *b;       /* buffer */
     size_t size;   /* how full the buffer is */
     size_t offset; /* where the current entry starts */
+    gzFile gz;     /* reader of the current file (gzip or plain) */
 } ldif_context;
 
 static void
@@ -122,6 +124,28 @@ bdb_import_init_ldif(ldif_context *c)
 {
     c->size = c->offset = 0;
     c->b = NULL;
+    c->gz = NULL;
+}
+
+/* gzread transparently reads the files that are not gzip compressed, so
+ * both plain and compressed LDIF files are read through it.  If zlib cannot
+ * allocate its state the file is read directly.
+ */
+static void
+bdb_import_open_ldif(ldif_context *c, int fd)
+{
+    c->gz = gzdopen(fd, "rb");
+}
+
+static void
+bdb_import_close_ldif(ldif_context *c, int fd)
+{
+    if (c->gz) {
+        gzclose(c->gz); /* closes fd */
+        c->gz = NULL;
+    } else {
+        close(fd);
+    }
 }
 
 static void
@@ -150,7 +174,11 @@ bdb_import_get_entry(ldif_context *c, int fd, int *lineno)
                 if (!c->b)
                     return NULL;
             }
-            ret = read(fd, c->b, LDIF_BUFFER_SIZE);
+            if (c->gz) {
+                ret = gzread(c->gz, c->b, LDIF_BUFFER_SIZE);
+            } else {
+                ret = read(fd, c->b, LDIF_BUFFER_SIZE);
+            }
             if (ret < 0) {
                 /* Must be error */
                 goto error;
@@ -355,7 +383,7 @@ bdb_import_producer(void *param)
     int str2entry_flags = 0;
     int finished = 0;
     int detected_eof = 0;
-    int fd, curr_file, curr_lineno = 0;
+    int fd = -1, curr_file, curr_lineno = 0;
     char *curr_filename = NULL;
     int idx;
     ldif_context c = {0};
@@ -420,7 +448,7 @@ bdb_import_producer(void *param)
                                                                           "entries)",
                                   curr_filename, (u_long)(id - id_filestart));
             }
-            close(fd);
+            bdb_import_close_ldif(&c, fd);
             fd = -1;
             detected_eof = 0;
             id_filestart = id;
@@ -460,6 +488,7 @@ bdb_import_producer(void *param)
                 import_log_notice(job, SLAPI_LOG_INFO, "bdb_import_producer",
                                   "Processing file \"%s\"", curr_filename);
             }
+            bdb_import_open_ldif(&c, fd);
         }
         if (job->flags & FLAG_ABORT) {
             goto error;
@@ -742,7 +771,7 @@ bdb_import_producer(void *param)
         }
         if (info->command == STOP) {
             if (fd >= 0)
-                close(fd);
+                bdb_import_close_ldif(&c, fd);
             finished = 1;
         }
     }
@@ -758,6 +787,8 @@ bdb_import_producer(void *param)
     return;
 
 error:
+    if (fd >= 0)
+        bdb_import_close_ldif(&c, fd);
     slapi_value_free(&(job->usn_value));
     info->state = ABORTED;
     bdb_import_free_ldif(&c);
@@ -995,6 +1026,22 @@ bdb_index_producer(void *param)
         /* call post-entry plugin */
         plugin_call_entryfetch_plugins((char **)&data.dptr, &data.dsize);
 
+        /* add the values stored out of the entry */
+        char *merged = id2values_merge(inst->inst_be, temp_id, data.dptr, NULL, &rc);
+        if (rc) {
+            import_log_notice(job, SLAPI_LOG_ERR, "bdb_index_producer",
+                              "%s: Failed to read the values of entry %lu, err %d (%s)",
+                              inst->inst_name, (u_long)temp_id, rc, dblayer_strerror(rc));
+            slapi_ch_free(&(key.data));
+            slapi_ch_free(&(data.data));
+            goto error;
+        }
+        if (merged) {
+            slapi_ch_free(&(data.data));
+            data.dptr = merged;
+            data.dsize = strlen(merged) + 1;
+        }
+
         char *rdn = NULL;
 
         /* rdn is allocated in get_value_from_string */
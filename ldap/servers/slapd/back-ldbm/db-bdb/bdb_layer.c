@@ -5119,7 +5119,7 @@ out:
 
 /* Destination Directory is an absolute pathname */
 int
-bdb_backup(struct ldbminfo *li, char *dest_dir, Slapi_Task *task)
+bdb_backup(struct ldbminfo *li, char *dest_dir, const char *base_dir, Slapi_Task *task)
 {
     dblayer_private *priv = NULL;
     bdb_config *conf = NULL;
@@ -5141,6 +5141,15 @@ bdb_backup(struct ldbminfo *li, char *dest_dir, Slapi_Task *task)
     priv = li->li_dblayer_private;
     PR_ASSERT(NULL != priv);
 
+    if (base_dir) {
+        slapi_log_err(SLAPI_LOG_ERR, "bdb_backup",
+                      "Incremental backups are not supported by the bdb database\n");
+        if (task) {
+            slapi_task_log_notice(task, "Incremental backups are not supported by the bdb database");
+        }
+        return return_value;
+    }
+
     db_dir = bdb_get_db_dir(li);
 
     home_dir = bdb_get_home_dir(li, NULL);
@@ -101,7 +101,7 @@ int bdb_init(struct ldbminfo *li, config_info *config_array);
 int bdb_close(struct ldbminfo *li, int flags);
 int bdb_start(struct ldbminfo *li, int flags);
 int bdb_instance_start(backend *be, int flags);
-int bdb_backup(struct ldbminfo *li, char *dest_dir, Slapi_Task *task);
+int bdb_backup(struct ldbminfo *li, char *dest_dir, const char *base_dir, Slapi_Task *task);
 int bdb_verify(Slapi_PBlock *pb);
 int bdb_db2ldif(Slapi_PBlock *pb);
 int bdb_db2index(Slapi_PBlock *pb);
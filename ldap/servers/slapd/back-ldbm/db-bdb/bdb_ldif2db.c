@@ -656,6 +656,7 @@ bdb_db2ldif(Slapi_PBlock *pb)
     int nobase64 = 0;
     NIDS idindex = 0;
     ID temp_id;
+    char *merged = NULL;
     char **exclude_suffix = NULL;
     char **include_suffix = NULL;
     int decrypt = 0;
@@ -789,6 +790,14 @@ bdb_db2ldif(Slapi_PBlock *pb)
     noversion = (printkey & EXPORT_NOVERSION);
     printkey &= ~EXPORT_NOVERSION;
 
+    if (printkey & EXPORT_GZIP) {
+        slapi_task_log_notice(task, "%s: gzip compressed export is only supported with lmdb.", inst->inst_name);
+        slapi_log_err(SLAPI_LOG_ERR, "bdb_db2ldif", "db2ldif: %s: gzip compressed export is only supported with lmdb\n",
+                      inst->inst_name);
+        return_value = -1;
+        goto bye;
+    }
+
     /* decide whether to dump uniqueid */
     if (dump_uniqueid)
         options |= SLAPI_DUMP_UNIQUEID;
@@ -1050,6 +1059,24 @@ bdb_db2ldif(Slapi_PBlock *pb)
         /* call post-entry plugin */
         plugin_call_entryfetch_plugins((char **)&data.dptr, &data.dsize);
 
+        /* add the values stored out of the entry */
+        merged = id2values_merge(inst->inst_be, temp_id, data.dptr, NULL, &rc);
+        if (rc) {
+            slapi_task_log_notice(task, "Backend %s: Failed to read the values of entry %lu, err %d\n",
+                    inst->inst_name, (u_long)temp_id, rc);
+            slapi_log_err(SLAPI_LOG_ERR, "bdb_db2ldif",
+                    "db2ldif: Backend %s: failed to read the values of entry %lu, err %d\n",
+                    inst->inst_name, (u_long)temp_id, rc);
+            slapi_ch_free(&(data.data));
+            return_value = -1;
+            break;
+        }
+        if (merged) {
+            slapi_ch_free(&(data.data));
+            data.dptr = merged;
+            data.dsize = strlen(merged) + 1;
+        }
+
         ep = backentry_alloc();
 
         char *rdn = NULL;
@@ -1622,6 +1649,24 @@ bdb_db2index(Slapi_PBlock *pb)
         /* call post-entry plugin */
         plugin_call_entryfetch_plugins((char **)&data.dptr, &data.dsize);
 
+        /* add the values stored out of the entry */
+        char *merged = id2values_merge(be, temp_id, data.dptr, NULL, &rc);
+        if (rc) {
+            slapi_log_err(SLAPI_LOG_ERR, "bdb_db2index",
+                          "%s: Failed to read the values of entry %lu (err %d: %s)\n",
+                          inst->inst_name, (u_long)temp_id, rc, dblayer_strerror(rc));
+            slapi_task_log_notice(task, "%s: ERROR: failed to read the values of entry %lu (err %d: %s)",
+                                  inst->inst_name, (u_long)temp_id, rc, dblayer_strerror(rc));
+            slapi_ch_free(&(data.data));
+            return_value = -2;
+            goto err_out;
+        }
+        if (merged) {
+            slapi_ch_free(&(data.data));
+            data.dptr = merged;
+            data.dsize = strlen(merged) + 1;
+        }
+
         ep = backentry_alloc();
         char *rdn = NULL;
         int rc = 0;
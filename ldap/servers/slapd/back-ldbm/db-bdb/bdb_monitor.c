@@ -273,6 +273,8 @@ bdb_monitor_search(Slapi_PBlock *pb, Slapi_Entry *e, Slapi_Entry *entryAfter, in
         sprintf(buf, "%" PRIu64, count);
         MSET("currentNormalizedDnCacheCount");
     }
+    sprintf(buf, "%" PRIu64, dn_intern_get_count());
+    MSET("currentInternedDnCount");
 
     slapi_ch_free((void **)&mpstat);
 
@@ -0,0 +1,619 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+/* mdb_backup.c - copy of the map file for the backups, full or incremental
+ *
+ * The map is copied by mdb_env_copyfd2 (without compaction) through a pipe,
+ * so the copy only holds a read txn and does not block the writers. The
+ * copy is split in blocks of DBMDB_BACKUP_BLOCKSIZE bytes and the digest of
+ * every block is stored in data.mdb.blocks.
+ *
+ * A full backup contains data.mdb.
+ * An incremental backup contains, instead of data.mdb, data.mdb.delta: the
+ * blocks whose digest differs from the one in the data.mdb.blocks of its
+ * base backup (full or incremental), and the path of the base backup.
+ *
+ * Without compaction mdb_env_copyfd2 writes the pages at their offset in
+ * the map, so a block only differs when lmdb wrote in it since the base
+ * backup. lmdb does not track the dirty pages across txns, so the whole
+ * map is still read, but only the changed blocks are written.
+ *
+ * The restore copies data.mdb of the full backup, applies the deltas from
+ * the oldest to the newest, then checks the result against the digests of
+ * the restored backup.
+ */
+
+#include "mdb_layer.h"
+#include <pk11func.h>
+
+#define DBMDB_BACKUP_BLOCKSIZE (64 * 1024)
+#define DBMDB_BACKUP_DIGESTLEN 16      /* truncated SHA-256 */
+#define DBMDB_BACKUP_MAXCHAIN  1024
+#define DBMDB_BLOCKS_MAGIC "MDBBLK1"
+#define DBMDB_DELTA_MAGIC  "MDBDLT1"
+
+typedef struct
+{
+    char magic[8];
+    uint32_t blocksize;
+    uint32_t digestlen;
+    uint64_t size;                         /* size of the copy of the map */
+    uint64_t nblocks;
+    uint8_t id[DBMDB_BACKUP_DIGESTLEN];    /* digest of the block digests */
+} dbmdb_blocks_hdr;
+
+typedef struct
+{
+    dbmdb_blocks_hdr hdr;
+    uint8_t *digests;
+    uint64_t ndigests;                     /* allocated */
+} dbmdb_blocks;
+
+/* followed by the path of the base backup, then by the changed blocks:
+ * the block number (uint64_t) and the block data */
+typedef struct
+{
+    char magic[8];
+    uint32_t blocksize;
+    uint32_t baselen;
+    uint64_t size;
+    uint64_t nchanged;
+    uint8_t base_id[DBMDB_BACKUP_DIGESTLEN];
+    uint8_t id[DBMDB_BACKUP_DIGESTLEN];
+} dbmdb_delta_hdr;
+
+typedef struct
+{
+    MDB_env *env;
+    int fd;
+    int rc;
+} dbmdb_copy_ctx;
+
+static int
+dbmdb_backup_digest(const void *buf, size_t len, uint8_t *digest)
+{
+    unsigned char sha[SHA256_LENGTH];
+
+    if (PK11_HashBuf(SEC_OID_SHA256, sha, (unsigned char *)buf, len) != SECSuccess) {
+        return -1;
+    }
+    memcpy(digest, sha, DBMDB_BACKUP_DIGESTLEN);
+    return 0;
+}
+
+static ssize_t
+dbmdb_backup_read(int fd, void *buf, size_t len)
+{
+    size_t done = 0;
+
+    while (done < len) {
+        ssize_t rc = read(fd, (char *)buf + done, len - done);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (rc == 0) {
+            break;
+        }
+        done += rc;
+    }
+    return done;
+}
+
+static int
+dbmdb_backup_write(int fd, const void *buf, size_t len)
+{
+    while (len > 0) {
+        ssize_t rc = write(fd, buf, len);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        buf = (const char *)buf + rc;
+        len -= rc;
+    }
+    return 0;
+}
+
+static void
+dbmdb_backup_error(Slapi_Task *task, const char *fmt, const char *path, int err)
+{
+    slapi_log_err(SLAPI_LOG_ERR, "dbmdb_backup", fmt, path, err, slapi_system_strerror(err));
+    if (task) {
+        slapi_task_log_notice(task, fmt, path, err, slapi_system_strerror(err));
+    }
+}
+
+static int
+dbmdb_blocks_read(const char *dir, dbmdb_blocks *blocks)
+{
+    char *path = slapi_ch_smprintf("%s/%s", dir, DBMDB_BLOCKSFILE);
+    size_t len = 0;
+    int fd = open(path, O_RDONLY);
+    int rc = -1;
+
+    memset(blocks, 0, sizeof(*blocks));
+    if (fd < 0) {
+        goto done;
+    }
+    if (dbmdb_backup_read(fd, &blocks->hdr, sizeof(blocks->hdr)) != sizeof(blocks->hdr) ||
+        memcmp(blocks->hdr.magic, DBMDB_BLOCKS_MAGIC, sizeof(DBMDB_BLOCKS_MAGIC)) ||
+        blocks->hdr.blocksize != DBMDB_BACKUP_BLOCKSIZE ||
+        blocks->hdr.digestlen != DBMDB_BACKUP_DIGESTLEN ||
+        blocks->hdr.nblocks != (blocks->hdr.size + DBMDB_BACKUP_BLOCKSIZE - 1) / DBMDB_BACKUP_BLOCKSIZE) {
+        goto done;
+    }
+    len = blocks->hdr.nblocks * DBMDB_BACKUP_DIGESTLEN;
+    blocks->ndigests = blocks->hdr.nblocks;
+    blocks->digests = (uint8_t *)slapi_ch_malloc(len ? len : 1);
+    if (dbmdb_backup_read(fd, blocks->digests, len) != (ssize_t)len) {
+        slapi_ch_free((void **)&blocks->digests);
+        goto done;
+    }
+    rc = 0;
+done:
+    if (fd >= 0) {
+        close(fd);
+    }
+    slapi_ch_free_string(&path);
+    return rc;
+}
+
+static int
+dbmdb_blocks_write(const char *dir, dbmdb_blocks *blocks, int mode)
+{
+    char *path = slapi_ch_smprintf("%s/%s", dir, DBMDB_BLOCKSFILE);
+    int fd = open(path, O_CREAT | O_WRONLY | O_TRUNC, mode);
+    int rc = -1;
+
+    if (fd >= 0 &&
+        dbmdb_backup_write(fd, &blocks->hdr, sizeof(blocks->hdr)) == 0 &&
+        dbmdb_backup_write(fd, blocks->digests, blocks->hdr.nblocks * DBMDB_BACKUP_DIGESTLEN) == 0 &&
+        fsync(fd) == 0) {
+        rc = 0;
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    slapi_ch_free_string(&path);
+    return rc;
+}
+
+static void *
+dbmdb_backup_copy_thread(void *arg)
+{
+    dbmdb_copy_ctx *ctx = arg;
+
+    ctx->rc = mdb_env_copyfd2(ctx->env, ctx->fd, 0);
+    close(ctx->fd);
+    return NULL;
+}
+
+/* Returns true if dir contains an incremental backup */
+int
+dbmdb_backup_is_incremental(const char *dir)
+{
+    char *path = slapi_ch_smprintf("%s/%s", dir, DBMDB_DELTAFILE);
+    int rc = (access(path, F_OK) == 0);
+
+    slapi_ch_free_string(&path);
+    return rc;
+}
+
+/*
+ * Copy the map in dest_dir, entirely or, if base_dir is not NULL, only the
+ * blocks that changed since the backup in base_dir.
+ */
+int
+dbmdb_backup_map(dbmdb_ctx_t *conf, const char *dest_dir, const char *base_dir, int mode, Slapi_Task *task)
+{
+    dbmdb_blocks base = {0};
+    dbmdb_blocks blocks = {0};
+    dbmdb_delta_hdr dhdr = {0};
+    dbmdb_copy_ctx copy = {0};
+    pthread_t copy_tid;
+    int pfd[2] = {-1, -1};
+    int outfd = -1;
+    int copying = 0;
+    char *path = NULL;
+    char *buf = NULL;
+    int rc = -1;
+
+    if (base_dir && dbmdb_blocks_read(base_dir, &base)) {
+        slapi_log_err(SLAPI_LOG_ERR, "dbmdb_backup",
+                      "Can not read the block digests of the backup %s. "
+                      "An incremental backup must be based on a backup of this version.\n", base_dir);
+        if (task) {
+            slapi_task_log_notice(task, "Can not read the block digests of the backup %s.", base_dir);
+        }
+        return -1;
+    }
+
+    buf = slapi_ch_malloc(DBMDB_BACKUP_BLOCKSIZE);
+    path = slapi_ch_smprintf("%s/%s", dest_dir, base_dir ? DBMDB_DELTAFILE : DBMAPFILE);
+    outfd = open(path, O_CREAT | O_WRONLY | O_TRUNC, mode);
+    if (outfd < 0) {
+        dbmdb_backup_error(task, "Failed to create %s: error %d (%s)\n", path, errno);
+        goto done;
+    }
+    if (base_dir) {
+        /* The header is rewritten once the changed blocks are known */
+        memcpy(dhdr.magic, DBMDB_DELTA_MAGIC, sizeof(DBMDB_DELTA_MAGIC));
+        dhdr.blocksize = DBMDB_BACKUP_BLOCKSIZE;
+        dhdr.baselen = strlen(base_dir);
+        memcpy(dhdr.base_id, base.hdr.id, DBMDB_BACKUP_DIGESTLEN);
+        if (dbmdb_backup_write(outfd, &dhdr, sizeof(dhdr)) ||
+            dbmdb_backup_write(outfd, base_dir, dhdr.baselen)) {
+            dbmdb_backup_error(task, "Failed to write %s: error %d (%s)\n", path, errno);
+            goto done;
+        }
+    }
+
+    if (pipe(pfd)) {
+        dbmdb_backup_error(task, "Failed to create a pipe for %s: error %d (%s)\n", path, errno);
+        goto done;
+    }
+    copy.env = conf->env;
+    copy.fd = pfd[1];
+    if (pthread_create(&copy_tid, NULL, dbmdb_backup_copy_thread, &copy)) {
+        dbmdb_backup_error(task, "Failed to start the copy of %s: error %d (%s)\n", path, errno);
+        close(pfd[1]);
+        goto done;
+    }
+    copying = 1;
+
+    memcpy(blocks.hdr.magic, DBMDB_BLOCKS_MAGIC, sizeof(DBMDB_BLOCKS_MAGIC));
+    blocks.hdr.blocksize = DBMDB_BACKUP_BLOCKSIZE;
+    blocks.hdr.digestlen = DBMDB_BACKUP_DIGESTLEN;
+    for (;;) {
+        uint64_t blockno = blocks.hdr.nblocks;
+        ssize_t len = dbmdb_backup_read(pfd[0], buf, DBMDB_BACKUP_BLOCKSIZE);
+        uint8_t *digest = NULL;
+
+        if (len < 0) {
+            dbmdb_backup_error(task, "Failed to read the copy of %s: error %d (%s)\n", path, errno);
+            goto done;
+        }
+        if (len == 0) {
+            break;
+        }
+        if (blockno == blocks.ndigests) {
+            blocks.ndigests = blocks.ndigests ? blocks.ndigests * 2 : 4096;
+            blocks.digests = (uint8_t *)slapi_ch_realloc((char *)blocks.digests,
+                                                         blocks.ndigests * DBMDB_BACKUP_DIGESTLEN);
+        }
+        digest = blocks.digests + blockno * DBMDB_BACKUP_DIGESTLEN;
+        if (dbmdb_backup_digest(buf, len, digest)) {
+            slapi_log_err(SLAPI_LOG_ERR, "dbmdb_backup", "Failed to compute the digest of block %" PRIu64 "\n", blockno);
+            goto done;
+        }
+        if (base_dir == NULL) {
+            if (dbmdb_backup_write(outfd, buf, len)) {
+                dbmdb_backup_error(task, "Failed to write %s: error %d (%s)\n", path, errno);
+                goto done;
+            }
+        } else if (blockno >= base.hdr.nblocks ||
+                   memcmp(digest, base.digests + blockno * DBMDB_BACKUP_DIGESTLEN, DBMDB_BACKUP_DIGESTLEN)) {
+            if (dbmdb_backup_write(outfd, &blockno, sizeof(blockno)) ||
+                dbmdb_backup_write(outfd, buf, len)) {
+                dbmdb_backup_error(task, "Failed to write %s: error %d (%s)\n", path, errno);
+                goto done;
+            }
+            dhdr.nchanged++;
+        }
+        blocks.hdr.size += len;
+        blocks.hdr.nblocks++;
+    }
+
+    close(pfd[0]);
+    pfd[0] = -1;
+    pthread_join(copy_tid, NULL);
+    copying = 0;
+    if (copy.rc) {
+        slapi_log_err(SLAPI_LOG_ERR, "dbmdb_backup", "Failed to copy the database: %s (%d)\n",
+                      dblayer_strerror(copy.rc), copy.rc);
+        if (task) {
+            slapi_task_log_notice(task, "Failed to copy the database: %s (%d)", dblayer_strerror(copy.rc), copy.rc);
+        }
+        goto done;
+    }
+
+    if (dbmdb_backup_digest(blocks.digests, blocks.hdr.nblocks * DBMDB_BACKUP_DIGESTLEN, blocks.hdr.id)) {
+        goto done;
+    }
+    if (base_dir) {
+        dhdr.size = blocks.hdr.size;
+        memcpy(dhdr.id, blocks.hdr.id, DBMDB_BACKUP_DIGESTLEN);
+        if (pwrite(outfd, &dhdr, sizeof(dhdr), 0) != sizeof(dhdr)) {
+            dbmdb_backup_error(task, "Failed to write %s: error %d (%s)\n", path, errno);
+            goto done;
+        }
+        slapi_log_err(SLAPI_LOG_INFO, "dbmdb_backup",
+                      "Incremental backup: %" PRIu64 " of %" PRIu64 " blocks changed since %s\n",
+                      dhdr.nchanged, blocks.hdr.nblocks, base_dir);
+        if (task) {
+            slapi_task_log_notice(task, "Incremental backup: %" PRIu64 " of %" PRIu64 " blocks changed since %s",
+                                  dhdr.nchanged, blocks.hdr.nblocks, base_dir);
+        }
+    }
+    if (fsync(outfd)) {
+        dbmdb_backup_error(task, "Failed to write %s: error %d (%s)\n", path, errno);
+        goto done;
+    }
+    if (dbmdb_blocks_write(dest_dir, &blocks, mode)) {
+        dbmdb_backup_error(task, "Failed to write the block digests in %s: error %d (%s)\n", dest_dir, errno);
+        goto done;
+    }
+    rc = 0;
+
+done:
+    if (copying) {
+        /* let the copy end */
+        while (dbmdb_backup_read(pfd[0], buf, DBMDB_BACKUP_BLOCKSIZE) > 0)
+            ;
+        pthread_join(copy_tid, NULL);
+    }
+    if (pfd[0] >= 0) {
+        close(pfd[0]);
+    }
+    if (outfd >= 0) {
+        close(outfd);
+    }
+    slapi_ch_free_string(&buf);
+    slapi_ch_free_string(&path);
+    slapi_ch_free((void **)&blocks.digests);
+    slapi_ch_free((void **)&base.digests);
+    return rc;
+}
+
+/* Apply the delta of dir on the map file fd, returns the id of the result in id */
+static int
+dbmdb_restore_delta(int fd, const char *dir, const uint8_t *base_id, uint8_t *id, Slapi_Task *task)
+{
+    char *path = slapi_ch_smprintf("%s/%s", dir, DBMDB_DELTAFILE);
+    char *buf = slapi_ch_malloc(DBMDB_BACKUP_BLOCKSIZE);
+    dbmdb_delta_hdr dhdr = {0};
+    int dfd = open(path, O_RDONLY);
+    int rc = -1;
+
+    if (dfd < 0 ||
+        dbmdb_backup_read(dfd, &dhdr, sizeof(dhdr)) != sizeof(dhdr) ||
+        memcmp(dhdr.magic, DBMDB_DELTA_MAGIC, sizeof(DBMDB_DELTA_MAGIC)) ||
+        dhdr.blocksize != DBMDB_BACKUP_BLOCKSIZE ||
+        lseek(dfd, dhdr.baselen, SEEK_CUR) < 0) {
+        dbmdb_backup_error(task, "Restore: failed to read %s: error %d (%s)\n", path, errno);
+        goto done;
+    }
+    if (memcmp(dhdr.base_id, base_id, DBMDB_BACKUP_DIGESTLEN)) {
+        slapi_log_err(SLAPI_LOG_ERR, "dbmdb_restore",
+                      "Incremental backup %s is not based on the content of its base backup.\n", dir);
+        if (task) {
+            slapi_task_log_notice(task, "Restore: incremental backup %s is not based on the content of its base backup.", dir);
+        }
+        goto done;
+    }
+    for (uint64_t i = 0; i < dhdr.nchanged; i++) {
+        uint64_t blockno = 0;
+        size_t len = 0;
+
+        if (dbmdb_backup_read(dfd, &blockno, sizeof(blockno)) != sizeof(blockno) ||
+            (uint64_t)blockno * DBMDB_BACKUP_BLOCKSIZE >= dhdr.size) {
+            dbmdb_backup_error(task, "Restore: %s is truncated or corrupted (error %d: %s)\n", path, errno);
+            goto done;
+        }
+        len = dhdr.size - blockno * DBMDB_BACKUP_BLOCKSIZE;
+        if (len > DBMDB_BACKUP_BLOCKSIZE) {
+            len = DBMDB_BACKUP_BLOCKSIZE;
+        }
+        if (dbmdb_backup_read(dfd, buf, len) != (ssize_t)len) {
+            dbmdb_backup_error(task, "Restore: %s is truncated or corrupted (error %d: %s)\n", path, errno);
+            goto done;
+        }
+        if (pwrite(fd, buf, len, blockno * DBMDB_BACKUP_BLOCKSIZE) != (ssize_t)len) {
+            dbmdb_backup_error(task, "Restore: failed to apply %s: error %d (%s)\n", path, errno);
+            goto done;
+        }
+    }
+    if (ftruncate(fd, dhdr.size)) {
+        dbmdb_backup_error(task, "Restore: failed to apply %s: error %d (%s)\n", path, errno);
+        goto done;
+    }
+    memcpy(id, dhdr.id, DBMDB_BACKUP_DIGESTLEN);
+    rc = 0;
+done:
+    if (dfd >= 0) {
+        close(dfd);
+    }
+    slapi_ch_free_string(&buf);
+    slapi_ch_free_string(&path);
+    return rc;
+}
+
+/* Check the map file against the block digests of the backup */
+static int
+dbmdb_restore_verify(int fd, dbmdb_blocks *blocks, const char *src_dir, Slapi_Task *task)
+{
+    char *buf = slapi_ch_malloc(DBMDB_BACKUP_BLOCKSIZE);
+    uint64_t size = 0;
+    int rc = -1;
+
+    for (uint64_t blockno = 0;; blockno++) {
+        uint8_t digest[DBMDB_BACKUP_DIGESTLEN];
+        ssize_t len = pread(fd, buf, DBMDB_BACKUP_BLOCKSIZE, blockno * DBMDB_BACKUP_BLOCKSIZE);
+
+        if (len < 0) {
+            dbmdb_backup_error(task, "Restore: failed to read the restored database of %s: error %d (%s)\n", src_dir, errno);
+            goto done;
+        }
+        if (len == 0) {
+            break;
+        }
+        if (blockno >= blocks->hdr.nblocks ||
+            dbmdb_backup_digest(buf, len, digest) ||
+            memcmp(digest, blocks->digests + blockno * DBMDB_BACKUP_DIGESTLEN, DBMDB_BACKUP_DIGESTLEN)) {
+            slapi_log_err(SLAPI_LOG_ERR, "dbmdb_restore",
+                          "The restored database does not match the backup %s (block %" PRIu64 ").\n",
+                          src_dir, blockno);
+            if (task) {
+                slapi_task_log_notice(task, "Restore: the restored database does not match the backup %s (block %" PRIu64 ").",
+                                      src_dir, blockno);
+            }
+            goto done;
+        }
+        size += len;
+    }
+    if (size != blocks->hdr.size) {
+        slapi_log_err(SLAPI_LOG_ERR, "dbmdb_restore",
+                      "The restored database does not match the backup %s (size %" PRIu64 " instead of %" PRIu64 ").\n",
+                      src_dir, size, blocks->hdr.size);
+        if (task) {
+            slapi_task_log_notice(task, "Restore: the restored database does not match the backup %s.", src_dir);
+        }
+        goto done;
+    }
+    rc = 0;
+done:
+    slapi_ch_free_string(&buf);
+    return rc;
+}
+
+/* Returns the base backup directory of the incremental backup in dir */
+static char *
+dbmdb_backup_get_base(const char *dir)
+{
+    char *path = slapi_ch_smprintf("%s/%s", dir, DBMDB_DELTAFILE);
+    dbmdb_delta_hdr dhdr = {0};
+    char *base = NULL;
+    int fd = open(path, O_RDONLY);
+
+    if (fd >= 0 &&
+        dbmdb_backup_read(fd, &dhdr, sizeof(dhdr)) == sizeof(dhdr) &&
+        memcmp(dhdr.magic, DBMDB_DELTA_MAGIC, sizeof(DBMDB_DELTA_MAGIC)) == 0 &&
+        dhdr.baselen > 0 && dhdr.baselen < MAXPATHLEN) {
+        base = slapi_ch_malloc(dhdr.baselen + 1);
+        if (dbmdb_backup_read(fd, base, dhdr.baselen) != (ssize_t)dhdr.baselen) {
+            slapi_ch_free_string(&base);
+        } else {
+            base[dhdr.baselen] = '\0';
+        }
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    slapi_ch_free_string(&path);
+    return base;
+}
+
+/*
+ * Rebuild the map file in the db home directory from the backup in src_dir:
+ * data.mdb of the full backup the chain of incremental backups starts from,
+ * then the deltas.
+ */
+int
+dbmdb_restore_map(struct ldbminfo *li, const char *src_dir, Slapi_Task *task)
+{
+    dbmdb_blocks full = {0};
+    dbmdb_blocks blocks = {0};
+    char **chain = NULL;
+    char *dir = slapi_ch_strdup(src_dir);
+    char *src = NULL;
+    char *dest = slapi_ch_smprintf("%s/%s", MDB_CONFIG(li)->home, DBMAPFILE);
+    uint8_t id[DBMDB_BACKUP_DIGESTLEN];
+    int nchain = 0;
+    int fd = -1;
+    int rc = -1;
+
+    /* Walk back to the full backup */
+    while (dbmdb_backup_is_incremental(dir)) {
+        char *base = dbmdb_backup_get_base(dir);
+
+        if (base == NULL || nchain >= DBMDB_BACKUP_MAXCHAIN) {
+            slapi_log_err(SLAPI_LOG_ERR, "dbmdb_restore", "Can not find the base of the incremental backup %s.\n", dir);
+            if (task) {
+                slapi_task_log_notice(task, "Restore: can not find the base of the incremental backup %s.", dir);
+            }
+            slapi_ch_free_string(&base);
+            goto done;
+        }
+        charray_add(&chain, dir);
+        nchain++;
+        dir = base;
+    }
+
+    src = slapi_ch_smprintf("%s/%s", dir, DBMAPFILE);
+    if (dbmdb_copyfile(src, dest, PR_TRUE, li->li_mode)) {
+        slapi_log_err(SLAPI_LOG_ERR,
+                      "dbmdb_restore", "Failed to copy database map file to %s.\n", dest);
+        if (task) {
+            slapi_task_log_notice(task, "Restore: Failed to copy database map file to %s.\n", dest);
+        }
+        goto done;
+    }
+    if (dbmdb_blocks_read(dir, &full)) {
+        if (nchain == 0) {
+            /* A backup done without the block digests */
+            rc = 0;
+            goto done;
+        }
+        slapi_log_err(SLAPI_LOG_ERR, "dbmdb_restore", "Can not read the block digests of the backup %s.\n", dir);
+        if (task) {
+            slapi_task_log_notice(task, "Restore: can not read the block digests of the backup %s.", dir);
+        }
+        goto done;
+    }
+    memcpy(id, full.hdr.id, DBMDB_BACKUP_DIGESTLEN);
+
+    fd = open(dest, O_RDWR);
+    if (fd < 0) {
+        dbmdb_backup_error(task, "Restore: failed to open %s: error %d (%s)\n", dest, errno);
+        goto done;
+    }
+    for (int i = nchain - 1; i >= 0; i--) {
+        slapi_log_err(SLAPI_LOG_INFO, "dbmdb_restore", "Applying the incremental backup %s\n", chain[i]);
+        if (task) {
+            slapi_task_log_notice(task, "Restore: applying the incremental backup %s", chain[i]);
+        }
+        if (dbmdb_restore_delta(fd, chain[i], id, id, task)) {
+            goto done;
+        }
+    }
+
+    if (dbmdb_blocks_read(src_dir, &blocks) ||
+        memcmp(blocks.hdr.id, id, DBMDB_BACKUP_DIGESTLEN)) {
+        slapi_log_err(SLAPI_LOG_ERR, "dbmdb_restore", "The block digests of the backup %s do not match its content.\n", src_dir);
+        if (task) {
+            slapi_task_log_notice(task, "Restore: the block digests of the backup %s do not match its content.", src_dir);
+        }
+        goto done;
+    }
+    rc = dbmdb_restore_verify(fd, &blocks, src_dir, task);
+    if (rc == 0 && fsync(fd)) {
+        dbmdb_backup_error(task, "Restore: failed to write %s: error %d (%s)\n", dest, errno);
+        rc = -1;
+    }
+
+done:
+    if (fd >= 0) {
+        close(fd);
+    }
+    charray_free(chain);
+    slapi_ch_free_string(&dir);
+    slapi_ch_free_string(&src);
+    slapi_ch_free_string(&dest);
+    slapi_ch_free((void **)&full.digests);
+    slapi_ch_free((void **)&blocks.digests);
+    return rc;
+}
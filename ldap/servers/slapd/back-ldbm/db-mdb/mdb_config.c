@@ -425,6 +425,72 @@ dbmdb_ctx_t_db_max_dbs_set(void *arg, void *value, char *errorbuf __attribute__(
 
     return retval;
 }
+static void *
+dbmdb_ctx_t_db_reindex_throttle_get(void *arg)
+{
+    struct ldbminfo *li = (struct ldbminfo *)arg;
+    dbmdb_ctx_t *conf = li->li_dblayer_config;
+
+    return  (void *)((uintptr_t)(conf->dsecfg.reindex_throttle));
+}
+
+static int
+dbmdb_ctx_t_db_reindex_throttle_set(void *arg, void *value, char *errorbuf, int phase __attribute__((unused)), int apply)
+{
+    struct ldbminfo *li = (struct ldbminfo *)arg;
+    dbmdb_ctx_t *conf = li->li_dblayer_config;
+    int val = (int)((uintptr_t)value);
+
+    if (val < 0 || val > MAX_REINDEX_THROTTLE) {
+        slapi_create_errormsg(errorbuf, SLAPI_DSE_RETURNTEXT_SIZE,
+                "Error: Invalid value for %s (%d). Must be between 0 and %d\n",
+                CONFIG_MDB_REINDEX_THROTTLE, val, MAX_REINDEX_THROTTLE);
+        slapi_log_err(SLAPI_LOG_ERR, "dbmdb_ctx_t_db_reindex_throttle_set",
+                "Invalid value for %s (%d). Must be between 0 and %d\n",
+                CONFIG_MDB_REINDEX_THROTTLE, val, MAX_REINDEX_THROTTLE);
+        return LDAP_UNWILLING_TO_PERFORM;
+    }
+    if (apply) {
+        /* Read by the writer thread of running reindex tasks */
+        slapi_atomic_store_32(&conf->dsecfg.reindex_throttle, val, __ATOMIC_RELAXED);
+    }
+
+    return LDAP_SUCCESS;
+}
+
+static void *
+dbmdb_ctx_t_db_export_threads_get(void *arg)
+{
+    struct ldbminfo *li = (struct ldbminfo *)arg;
+    dbmdb_ctx_t *conf = li->li_dblayer_config;
+
+    return  (void *)((uintptr_t)(conf->dsecfg.export_threads));
+}
+
+static int
+dbmdb_ctx_t_db_export_threads_set(void *arg, void *value, char *errorbuf, int phase __attribute__((unused)), int apply)
+{
+    struct ldbminfo *li = (struct ldbminfo *)arg;
+    dbmdb_ctx_t *conf = li->li_dblayer_config;
+    int val = (int)((uintptr_t)value);
+
+    if (val < 0 || val > MAX_EXPORT_THREADS) {
+        slapi_create_errormsg(errorbuf, SLAPI_DSE_RETURNTEXT_SIZE,
+                "Error: Invalid value for %s (%d). Must be between 0 and %d\n",
+                CONFIG_MDB_EXPORT_THREADS, val, MAX_EXPORT_THREADS);
+        slapi_log_err(SLAPI_LOG_ERR, "dbmdb_ctx_t_db_export_threads_set",
+                "Invalid value for %s (%d). Must be between 0 and %d\n",
+                CONFIG_MDB_EXPORT_THREADS, val, MAX_EXPORT_THREADS);
+        return LDAP_UNWILLING_TO_PERFORM;
+    }
+    if (apply) {
+        /* Only read when an export starts */
+        conf->dsecfg.export_threads = val;
+    }
+
+    return LDAP_SUCCESS;
+}
+
 static void *
 dbmdb_ctx_t_maxpassbeforemerge_get(void *arg)
 {
@@ -554,6 +620,8 @@ static config_info dbmdb_ctx_t_param[] = {
     {CONFIG_MDB_MAX_SIZE, CONFIG_TYPE_UINT64, "0", &dbmdb_ctx_t_db_max_size_get, &dbmdb_ctx_t_db_max_size_set, CONFIG_FLAG_ALWAYS_SHOW | CONFIG_FLAG_ALLOW_RUNNING_CHANGE},
     {CONFIG_MDB_MAX_READERS, CONFIG_TYPE_INT, "0", &dbmdb_ctx_t_db_max_readers_get, &dbmdb_ctx_t_db_max_readers_set, CONFIG_FLAG_ALWAYS_SHOW | CONFIG_FLAG_ALLOW_RUNNING_CHANGE},
     {CONFIG_MDB_MAX_DBS, CONFIG_TYPE_INT, "512", &dbmdb_ctx_t_db_max_dbs_get, &dbmdb_ctx_t_db_max_dbs_set, CONFIG_FLAG_ALWAYS_SHOW | CONFIG_FLAG_ALLOW_RUNNING_CHANGE},
+    {CONFIG_MDB_REINDEX_THROTTLE, CONFIG_TYPE_INT, "0", &dbmdb_ctx_t_db_reindex_throttle_get, &dbmdb_ctx_t_db_reindex_throttle_set, CONFIG_FLAG_ALWAYS_SHOW | CONFIG_FLAG_ALLOW_RUNNING_CHANGE},
+    {CONFIG_MDB_EXPORT_THREADS, CONFIG_TYPE_INT, "0", &dbmdb_ctx_t_db_export_threads_get, &dbmdb_ctx_t_db_export_threads_set, CONFIG_FLAG_ALWAYS_SHOW | CONFIG_FLAG_ALLOW_RUNNING_CHANGE},
     {CONFIG_MAXPASSBEFOREMERGE, CONFIG_TYPE_INT, "100", &dbmdb_ctx_t_maxpassbeforemerge_get, &dbmdb_ctx_t_maxpassbeforemerge_set, 0},
     {CONFIG_DB_DURABLE_TRANSACTIONS, CONFIG_TYPE_ONOFF, "on", &dbmdb_ctx_t_db_durable_transactions_get, &dbmdb_ctx_t_db_durable_transactions_set, CONFIG_FLAG_ALWAYS_SHOW},
     {CONFIG_BYPASS_FILTER_TEST, CONFIG_TYPE_STRING, "on", &dbmdb_ctx_t_get_bypass_filter_test, &dbmdb_ctx_t_set_bypass_filter_test, CONFIG_FLAG_ALWAYS_SHOW | CONFIG_FLAG_ALLOW_RUNNING_CHANGE},
@@ -16,6 +16,7 @@
 #define ELEMRDN(elem)          (&elem->nrdn[elem->nrdnlen])
 #define WRITER_SLOTS           2000
 #define WRITER_MAX_OPS_IN_TXN  2000
+#define REINDEX_READ_BATCH     512  /* entries read from id2entry per read txn */
 #define NB_EXTRA_THREAD        3    /* monitoring, producer and writer */
 #define MIN_WORKER_SLOTS       4
 #define MAX_WORKER_SLOTS       64
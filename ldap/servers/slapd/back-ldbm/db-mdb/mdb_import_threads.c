@@ -27,6 +27,7 @@
 #include <assert.h>
 #include "mdb_import.h"
 #include "../vlv_srch.h"
+#include <zlib.h>
 #include <sys/time.h>
 #include <time.h>
 
@@ -445,6 +446,7 @@ typedef struct
     char *b;       /* buffer */
     size_t size;   /* how full the buffer is */
     size_t offset; /* where the current entry starts */
+    gzFile gz;     /* reader of the current file (gzip or plain) */
 } ldif_context;
 
 static void
@@ -452,6 +454,28 @@ dbmdb_import_init_ldif(ldif_context *c)
 {
     c->size = c->offset = 0;
     c->b = NULL;
+    c->gz = NULL;
+}
+
+/* gzread transparently reads the files that are not gzip compressed, so
+ * both plain and compressed LDIF files are read through it.  If zlib cannot
+ * allocate its state the file is read directly.
+ */
+static void
+dbmdb_import_open_ldif(ldif_context *c, int fd)
+{
+    c->gz = gzdopen(fd, "rb");
+}
+
+static void
+dbmdb_import_close_ldif(ldif_context *c, int fd)
+{
+    if (c->gz) {
+        gzclose(c->gz); /* closes fd */
+        c->gz = NULL;
+    } else {
+        close(fd);
+    }
 }
 
 static void
@@ -479,7 +503,11 @@ dbmdb_import_get_entry(ldif_context *c, int fd, int *lineno)
                 if (!c->b)
                     return NULL;
             }
-            ret = read(fd, c->b, LDIF_BUFFER_SIZE);
+            if (c->gz) {
+                ret = gzread(c->gz, c->b, LDIF_BUFFER_SIZE);
+            } else {
+                ret = read(fd, c->b, LDIF_BUFFER_SIZE);
+            }
             if (ret < 0) {
                 /* Must be error */
                 goto error;
@@ -1193,7 +1221,7 @@ dbmdb_import_producer(void *param)
                                  "Finished scanning file \"%s\" (%lu entries)",
                                   curr_filename, (u_long)(id - id_filestart));
             }
-            close(fd);
+            dbmdb_import_close_ldif(&c, fd);
             fd = -1;
             detected_eof = 0;
             id_filestart = id;
@@ -1234,6 +1262,7 @@ dbmdb_import_producer(void *param)
                 import_log_notice(job, SLAPI_LOG_INFO, "dbmdb_import_producer",
                                   "Processing file \"%s\"", curr_filename);
             }
+            dbmdb_import_open_ldif(&c, fd);
         }
         wait_for_starting(info);
         wqelmt.winfo.job = job;
@@ -1357,7 +1386,7 @@ dbmdb_import_producer(void *param)
     }
 
     if (fd >= 0)
-        close(fd);
+        dbmdb_import_close_ldif(&c, fd);
     slapi_value_free(&(job->usn_value));
     dbmdb_import_free_ldif(&c);
     info_set_state(info);
@@ -1622,7 +1651,7 @@ fill_processingq(ImportJob *job, MDB_dbi dbi, wait4id_queue_t **processingq, cha
     MDB_val data = {0};
     MDB_val key = {0};
     char zero[sizeof (ID)] = {0};
-    int count = 64;
+    int count = REINDEX_READ_BATCH;
     int rc = 0;
 
     key.mv_data = lastid;
@@ -1838,11 +1867,26 @@ dbmdb_import_index_prepare_worker_entry(WorkerQueueData_t *wqelmnt)
     ID id = wqelmnt->wait_id;
     Slapi_Entry *e = NULL;
     char *normdn = NULL;
+    char *merged = NULL;
     char *rdn = NULL;
+    int rc = 0;
 
     /* call post-entry plugin */
     plugin_call_entryfetch_plugins(&entry_str, &entry_len);
 
+    /* add the values stored out of the entry */
+    merged = id2values_merge(info->job->inst->inst_be, id, entry_str, NULL, &rc);
+    if (rc) {
+        slapi_log_err(SLAPI_LOG_ERR, "dbmdb_import_index_prepare_worker_entry",
+                "Failed to read the values of entry %d, err %d\n", id, rc);
+        slapi_ch_free(&wqelmnt->data);
+        thread_abort(info);
+        return NULL;
+    }
+    if (merged) {
+        entry_str = merged;
+    }
+
     /*
      * dn is yet unknown so lets use the rdn instead.
      * but slapi_str2entry_ext needs that entry is in the suffix
@@ -1854,6 +1898,7 @@ dbmdb_import_index_prepare_worker_entry(WorkerQueueData_t *wqelmnt)
         slapi_log_err(SLAPI_LOG_ERR, "dbmdb_import_index_prepare_worker_entry",
                 "Invalid entry (no rdn) in database for id %d entry: %s\n",
                 id, entry_str);
+        slapi_ch_free_string(&merged);
         slapi_ch_free(&wqelmnt->data);
         thread_abort(info);
         return NULL;
@@ -1871,6 +1916,7 @@ dbmdb_import_index_prepare_worker_entry(WorkerQueueData_t *wqelmnt)
                 "Invalid entry (Conversion failed) in database for id %d entry: %s\n",
                 id, entry_str);
     }
+    slapi_ch_free_string(&merged);
     slapi_ch_free(&wqelmnt->data);
     ep = dbmdb_import_make_backentry(e, id);
     if ((ep == NULL) || (ep->ep_entry == NULL)) {
@@ -3500,6 +3546,11 @@ dbmdb_build_import_index_list(ImportCtx_t *ctx)
         dbmdb_open_dbi_from_filename(&ctx->id2entry->dbi, job->inst->inst_be, ctx->id2entry->name,
                                  NULL, MDB_CREATE|MDB_MARK_DIRTY_DBI|MDB_OPEN_DIRTY_DBI|MDB_TRUNCATE_DBI);
     }
+    if (ctx->role == IM_IMPORT || ctx->role == IM_BULKIMPORT) {
+        /* The imported entries are stored whole: drop the out of line values */
+        dbmdb_dbi_t *dbi = NULL;
+        dbmdb_open_dbi_from_filename(&dbi, job->inst->inst_be, ID2VALUES, NULL, MDB_TRUNCATE_DBI);
+    }
 
 }
 
@@ -3870,12 +3921,89 @@ _get_import_entryusn(ImportJob *job, Slapi_Value **usn_value)
 
 /* writer thread */
 
-int
-cmp_key_addr(const void *i1, const void *i2)
+typedef struct {
+    WriterQueueData_t *slot;
+    size_t seq;         /* position in the writer queue */
+} WriterSortElmt_t;
+
+static int
+cmp_mdb_val(const MDB_val *v1, const MDB_val *v2)
 {
-    const WriterQueueData_t *e1 = i1;
-    const WriterQueueData_t *e2 = i2;
-    return e2->key.mv_data - e1->key.mv_data;
+    size_t len = v1->mv_size < v2->mv_size ? v1->mv_size : v2->mv_size;
+    int rc = memcmp(v1->mv_data, v2->mv_data, len);
+
+    if (rc == 0 && v1->mv_size != v2->mv_size) {
+        rc = v1->mv_size < v2->mv_size ? -1 : 1;
+    }
+    return rc;
+}
+
+/*
+ * Order the writer queue elements by dbi then by key so that consecutive
+ * puts hit the same btree pages. Elements having the same key are kept in
+ * queue order (the last put must still win on non dupsort databases).
+ */
+static int
+cmp_writer_slot(const void *i1, const void *i2)
+{
+    const WriterSortElmt_t *e1 = i1;
+    const WriterSortElmt_t *e2 = i2;
+    int rc = 0;
+
+    if (e1->slot->dbi->dbi != e2->slot->dbi->dbi) {
+        return e1->slot->dbi->dbi < e2->slot->dbi->dbi ? -1 : 1;
+    }
+    rc = cmp_mdb_val(&e1->slot->key, &e2->slot->key);
+    if (rc == 0) {
+        rc = e1->seq < e2->seq ? -1 : 1;
+    }
+    return rc;
+}
+
+/* Sort the slots returned by dbmdb_import_q_getall (and returns their number) */
+static size_t
+writer_sort_slots(WriterQueueData_t *slot, WriterSortElmt_t **array, size_t *arraysize)
+{
+    size_t nbslots = 0;
+
+    for (; slot; slot = slot->next) {
+        if (nbslots >= *arraysize) {
+            *arraysize = *arraysize ? 2 * *arraysize : WRITER_SLOTS;
+            *array = (WriterSortElmt_t *)slapi_ch_realloc((char *)*array, *arraysize * sizeof (WriterSortElmt_t));
+        }
+        (*array)[nbslots].slot = slot;
+        (*array)[nbslots].seq = nbslots;
+        nbslots++;
+    }
+    if (nbslots > 1) {
+        qsort(*array, nbslots, sizeof (WriterSortElmt_t), cmp_writer_slot);
+    }
+    return nbslots;
+}
+
+/*
+ * Online reindex: let the live operations get the write txn.
+ * The writer sleeps throttle% of the time (relative to the time spent
+ * in its last write txn)
+ */
+static void
+writer_throttle(ImportCtx_t *ctx, struct timespec *txnstart)
+{
+    int32_t throttle = slapi_atomic_load_32(&ctx->ctx->dsecfg.reindex_throttle, __ATOMIC_RELAXED);
+    struct timespec now = {0};
+    struct timespec busy = {0};
+    uint64_t busyms = 0;
+
+    if (throttle <= 0 || throttle > MAX_REINDEX_THROTTLE) {
+        return;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    slapi_timespec_diff(&now, txnstart, &busy);
+    busyms = busy.tv_sec * 1000 + busy.tv_nsec / 1000000;
+    busyms = busyms * throttle / (100 - throttle);
+    if (busyms > 0) {
+        DS_Sleep(PR_MillisecondsToInterval(busyms));
+    }
 }
 
 /* writer.thread:
@@ -3883,6 +4011,9 @@ cmp_key_addr(const void *i1, const void *i2)
  * i'm responsible to write data in mdb database as I am the only
  * import thread allowed to start a read-write transaction.
  * (The other threads open read-only txn)
+ * Slots are written sorted by database and key.
+ * When reindexing online, nsslapd-mdb-reindex-throttle may slow down the
+ * writer after each commit to keep some room for the live write operations.
  */
 void
 dbmdb_import_writer(void*param)
@@ -3890,8 +4021,13 @@ dbmdb_import_writer(void*param)
     ImportWorkerInfo *info = (ImportWorkerInfo*)param;
     ImportJob *job = info->job;
     ImportCtx_t *ctx = job->writer_ctx;
-    WriterQueueData_t *nextslot = NULL;
     WriterQueueData_t *slot = NULL;
+    WriterSortElmt_t *sorted = NULL;
+    size_t sortedsize = 0;
+    size_t nbslots = 0;
+    size_t i = 0;
+    int online = (ctx->role == IM_INDEX) && (job->flags & FLAG_ONLINE);
+    struct timespec txnstart = {0};
     MDB_txn *txn = NULL;
     int count = 0;
     int rc = 0;
@@ -3912,9 +4048,12 @@ dbmdb_import_writer(void*param)
             break;
         }
 
-        for (; slot; slot = nextslot) {
+        nbslots = writer_sort_slots(slot, &sorted, &sortedsize);
+        for (i = 0; i < nbslots; i++) {
+            slot = sorted[i].slot;
             if (!txn) {
                 MDB_STAT_STEP(stats, MDB_STAT_TXNSTART);
+                clock_gettime(CLOCK_MONOTONIC, &txnstart);
                 rc = TXN_BEGIN(ctx->ctx->env, NULL, 0, &txn);
             }
             if (!rc) {
@@ -3922,13 +4061,12 @@ dbmdb_import_writer(void*param)
                 rc = MDB_PUT(txn, slot->dbi->dbi, &slot->key, &slot->data, 0);
             }
             MDB_STAT_STEP(stats, MDB_STAT_RUN);
-            nextslot = slot->next;
             slapi_ch_free((void**)&slot);
         }
         if (rc) {
             break;
         }
-        if  (count++ >= WRITER_MAX_OPS_IN_TXN) {
+        if (txn && count++ >= WRITER_MAX_OPS_IN_TXN) {
             MDB_STAT_STEP(stats, MDB_STAT_TXNSTOP);
             rc = TXN_COMMIT(txn);
             MDB_STAT_STEP(stats, MDB_STAT_RUN);
@@ -3937,6 +4075,11 @@ dbmdb_import_writer(void*param)
             }
             count = 0;
             txn = NULL;
+            if (online) {
+                MDB_STAT_STEP(stats, MDB_STAT_PAUSE);
+                writer_throttle(ctx, &txnstart);
+                MDB_STAT_STEP(stats, MDB_STAT_RUN);
+            }
         }
     }
     if (txn && !rc) {
@@ -3973,6 +4116,7 @@ dbmdb_import_writer(void*param)
                               "Import writer thread usage: %s", summary);
         }
     }
+    slapi_ch_free((void**)&sorted);
     info_set_state(info);
 }
 
@@ -884,9 +884,13 @@ error:
     return return_value;
 }
 
-/* Destination Directory is an absolute pathname */
+/*
+ * Destination Directory is an absolute pathname
+ * With base_dir, only the blocks of the map that changed since the backup
+ * in base_dir are stored (see mdb_backup.c)
+ */
 int
-dbmdb_backup(struct ldbminfo *li, char *dest_dir, Slapi_Task *task)
+dbmdb_backup(struct ldbminfo *li, char *dest_dir, const char *base_dir, Slapi_Task *task)
 {
     int return_value = LDAP_UNWILLING_TO_PERFORM;
     PRDirEntry *direntry = NULL;
@@ -914,7 +918,8 @@ dbmdb_backup(struct ldbminfo *li, char *dest_dir, Slapi_Task *task)
      * What are we doing here ?
      * check that destinantion is OK
      * We want to copy into the backup directory:
-     * The mdb database
+     * The mdb database (or the blocks changed since base_dir)
+     * The digests of its blocks
      * The info file
      */
 
@@ -944,7 +949,7 @@ dbmdb_backup(struct ldbminfo *li, char *dest_dir, Slapi_Task *task)
         goto error_out;
     }
     /* Copy the mdb database */
-    return_value = mdb_env_copy(conf->env, dest_dir);
+    return_value = dbmdb_backup_map(conf, dest_dir, base_dir, li->li_mode | 0400, task);
     if (return_value) {
         slapi_log_err(SLAPI_LOG_ERR, "dbmdb_backup", "Failed to backup mdb database to %s.\n", dest_dir);
         if (task) {
@@ -1001,6 +1006,12 @@ error_out:
         unlink(pathname2);
         slapi_ch_free_string(&pathname2);
     }
+    pathname2 = slapi_ch_smprintf("%s/%s", dest_dir, DBMDB_BLOCKSFILE);
+    unlink(pathname2);
+    slapi_ch_free_string(&pathname2);
+    pathname2 = slapi_ch_smprintf("%s/%s", dest_dir, DBMDB_DELTAFILE);
+    unlink(pathname2);
+    slapi_ch_free_string(&pathname2);
     rmdir(dest_dir);
     return_value = LDAP_UNWILLING_TO_PERFORM;
 bail:
@@ -1077,6 +1088,10 @@ dbmdb_restore(struct ldbminfo *li, char *src_dir, Slapi_Task *task)
 
     /* Check that all files are present and not empty */
     for (pt=backupfilelists; *pt; pt++) {
+        if (strcmp(*pt, DBMAPFILE) == 0 && dbmdb_backup_is_incremental(src_dir)) {
+            /* rebuilt from the full backup and the deltas */
+            continue;
+        }
         pathname = slapi_ch_smprintf("%s/%s", src_dir, *pt);
         if (stat(pathname, &sbuf) < 0 || sbuf.st_size == 0) {
             slapi_log_err(SLAPI_LOG_ERR, "dbmdb_restore",
@@ -1109,7 +1124,7 @@ dbmdb_restore(struct ldbminfo *li, char *src_dir, Slapi_Task *task)
     dbmdb_delete_db(li);
 
     /* Copy db and info files */
-    if (dbmdb_restore_file(li, task, src_dir, DBMAPFILE) ||
+    if (dbmdb_restore_map(li, src_dir, task) ||
         dbmdb_restore_file(li, task, src_dir, INFOFILE)) {
         return_value = -1;
         goto error_out;
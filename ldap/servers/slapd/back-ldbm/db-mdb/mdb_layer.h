@@ -41,6 +41,11 @@
 #define CONFIG_MDB_MAX_SIZE       "nsslapd-mdb-max-size"
 #define CONFIG_MDB_MAX_READERS    "nsslapd-mdb-max-readers"
 #define CONFIG_MDB_MAX_DBS        "nsslapd-mdb-max-dbs"
+#define CONFIG_MDB_REINDEX_THROTTLE "nsslapd-mdb-reindex-throttle"
+#define CONFIG_MDB_EXPORT_THREADS "nsslapd-mdb-export-threads"
+
+#define MAX_REINDEX_THROTTLE         90   /* Max % of idle time of the online reindex writer */
+#define MAX_EXPORT_THREADS           64   /* Max number of db2ldif serialization threads */
 
 #define DBMDB_DB_MINSIZE             ( 4LL * MEGABYTE )
 #define DBMDB_DISK_RESERVE(disksize) ((disksize)*2ULL/1000ULL)
@@ -63,6 +68,8 @@
 #define DSE_INDEX           "dse_index.ldif"        /* dse file in backup */
 #define DBMAPFILE           "data.mdb"
 #define INFOFILE            "INFO.mdb"
+#define DBMDB_BLOCKSFILE    DBMAPFILE ".blocks"   /* backup: digests of the blocks of the map */
+#define DBMDB_DELTAFILE     DBMAPFILE ".delta"    /* incremental backup: changed blocks */
 #define DBNAMES             "__DBNAMES"
 #define CHANGELOG_PATTERN   "changelog"   /* pattern in changelog dbi name */
 #define RECNOCACHE_PREFIX   "~recno-cache/"
@@ -76,6 +83,8 @@ typedef struct
     int max_readers;
     int max_dbs;
     uint64_t max_size;
+    int32_t reindex_throttle;     /* % of time online reindex writer stays idle */
+    int32_t export_threads;       /* db2ldif serialization threads (0: serial export) */
 } dbmdb_cfg_t;
 
 /* config parameters limits */
@@ -286,7 +295,10 @@ int mdb_init(struct ldbminfo *li, config_info *config_array);
 int dbmdb_close(struct ldbminfo *li, int flags);
 int dbmdb_start(struct ldbminfo *li, int flags);
 int dbmdb_instance_start(backend *be, int flags);
-int dbmdb_backup(struct ldbminfo *li, char *dest_dir, Slapi_Task *task);
+int dbmdb_backup(struct ldbminfo *li, char *dest_dir, const char *base_dir, Slapi_Task *task);
+int dbmdb_backup_map(dbmdb_ctx_t *conf, const char *dest_dir, const char *base_dir, int mode, Slapi_Task *task);
+int dbmdb_backup_is_incremental(const char *dir);
+int dbmdb_restore_map(struct ldbminfo *li, const char *src_dir, Slapi_Task *task);
 int dbmdb_verify(Slapi_PBlock *pb);
 int dbmdb_db2ldif(Slapi_PBlock *pb);
 int dbmdb_db2index(Slapi_PBlock *pb);
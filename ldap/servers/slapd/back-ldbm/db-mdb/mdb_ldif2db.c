@@ -19,6 +19,7 @@
 
 #include "mdb_import.h"
 #include "../vlv_srch.h"
+#include <zlib.h>
 
 #define DB2INDEX_ANCESTORID 0x1   /* index ancestorid */
 #define DB2INDEX_ENTRYRDN 0x2     /* index entryrdn */
@@ -28,6 +29,8 @@
 
 #define LDIF2LDBM_EXTBITS(x) ((x)&0xf)
 
+typedef struct _export_pipeline export_pipeline;
+
 typedef struct _export_args
 {
     struct backentry *ep;
@@ -47,6 +50,7 @@ typedef struct _export_args
                                  its children's ID.  It happens when an entry
                                  is added and existing entries are moved under
                                  the newly added entry. */
+    export_pipeline *pipeline;    /* parallel export, or NULL */
 } export_args;
 
 /* static functions */
@@ -408,52 +412,54 @@ dbmdb_fetch_subtrees(backend *be, char **include, int *err)
 }
 
 
-static int
-dbmdb_export_one_entry(struct ldbminfo *li,
-                 ldbm_instance *inst,
-                 export_args *expargs)
+/*
+ * Prepare an entry for the export: returns its ldif, or NULL if it is not
+ * exported. Only reads expargs, so it can run in the export threads.
+ */
+static char *
+dbmdb_export_entry2ldif(struct ldbminfo *li,
+                        ldbm_instance *inst,
+                        export_args *expargs,
+                        struct backentry *ep,
+                        int *len)
 {
     backend *be = inst->inst_be;
     int rc = 0;
-    int wrc = 0;
     Slapi_Attr *this_attr = NULL, *next_attr = NULL;
     char *type = NULL;
-    MDB_val data = {0};
-    int len = 0;
 
-    if (!dbmdb_back_ok_to_dump(backentry_get_ndn(expargs->ep),
+    if (!dbmdb_back_ok_to_dump(backentry_get_ndn(ep),
                               expargs->include_suffix,
                               expargs->exclude_suffix)) {
-        goto bail; /* go to next loop */
+        return NULL;
     }
     if (!(expargs->options & SLAPI_DUMP_STATEINFO) &&
-        slapi_entry_flag_is_set(expargs->ep->ep_entry,
+        slapi_entry_flag_is_set(ep->ep_entry,
                                 SLAPI_ENTRY_FLAG_TOMBSTONE)) {
         /* We only dump the tombstones if the user needs to create
          * a replica from the ldif */
-        goto bail; /* go to next loop */
+        return NULL;
     }
-    (*expargs->cnt)++;
 
     /* do not output attributes that are in the "exclude" list */
     /* Also, decrypt any encrypted attributes, if we're asked to */
-    rc = slapi_entry_first_attr(expargs->ep->ep_entry, &this_attr);
+    rc = slapi_entry_first_attr(ep->ep_entry, &this_attr);
     while (0 == rc) {
         int dump_uniqueid = (expargs->options & SLAPI_DUMP_UNIQUEID) ? 1 : 0;
-        rc = slapi_entry_next_attr(expargs->ep->ep_entry,
+        rc = slapi_entry_next_attr(ep->ep_entry,
                                    this_attr, &next_attr);
         slapi_attr_get_type(this_attr, &type);
         if (dbmdb_ldbm_exclude_attr_from_export(li, type, dump_uniqueid)) {
-            slapi_entry_delete_values(expargs->ep->ep_entry, type, NULL);
+            slapi_entry_delete_values(ep->ep_entry, type, NULL);
         }
         this_attr = next_attr;
     }
     if (expargs->decrypt) {
         /* Decrypt in place */
-        rc = attrcrypt_decrypt_entry(be, expargs->ep);
+        rc = attrcrypt_decrypt_entry(be, ep);
         if (rc) {
-            slapi_log_err(SLAPI_LOG_ERR, "dbmdb_export_one_entry", "Failed to decrypt entry [%s] : %d\n",
-                          slapi_sdn_get_dn(&expargs->ep->ep_entry->e_sdn), rc);
+            slapi_log_err(SLAPI_LOG_ERR, "dbmdb_export_entry2ldif", "Failed to decrypt entry [%s] : %d\n",
+                          slapi_sdn_get_dn(&ep->ep_entry->e_sdn), rc);
         }
     }
     /*
@@ -461,7 +467,7 @@ dbmdb_export_one_entry(struct ldbminfo *li,
      * If it is not, put "{CLEAR}" in front of the password value.
      */
     {
-        char *pw = slapi_entry_attr_get_charptr(expargs->ep->ep_entry,
+        char *pw = slapi_entry_attr_get_charptr(ep->ep_entry,
                                                 "userpassword");
         if (pw && !slapi_is_encoded(pw)) {
             /* clear password does not have {CLEAR} storage scheme */
@@ -471,20 +477,77 @@ dbmdb_export_one_entry(struct ldbminfo *li,
             val.bv_len = strlen(val.bv_val);
             vals[0] = &val;
             vals[1] = NULL;
-            rc = slapi_entry_attr_replace(expargs->ep->ep_entry,
+            rc = slapi_entry_attr_replace(ep->ep_entry,
                                           "userpassword", vals);
             if (rc) {
                 slapi_log_err(SLAPI_LOG_ERR,
-                              "dbmdb_export_one_entry", "%s: Failed to add clear password storage scheme: %d\n",
-                              slapi_sdn_get_dn(&expargs->ep->ep_entry->e_sdn), rc);
+                              "dbmdb_export_entry2ldif", "%s: Failed to add clear password storage scheme: %d\n",
+                              slapi_sdn_get_dn(&ep->ep_entry->e_sdn), rc);
             }
             slapi_ch_free_string(&val.bv_val);
         }
         slapi_ch_free_string(&pw);
     }
-    data.mv_data = slapi_entry2str_with_options(expargs->ep->ep_entry,
-                                             &len, expargs->options);
-    data.mv_size = len + 1;
+    return slapi_entry2str_with_options(ep->ep_entry, len, expargs->options);
+}
+
+/* write() the whole buffer */
+static int
+dbmdb_export_write(int fd, const char *buf, size_t len)
+{
+    while (len > 0) {
+        ssize_t wrc = write(fd, buf, len);
+        if (wrc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        buf += wrc;
+        len -= wrc;
+    }
+    return 0;
+}
+
+static void
+dbmdb_export_log_progress(ldbm_instance *inst, export_args *expargs, int percent)
+{
+    if (expargs->task) {
+        slapi_task_log_status(expargs->task,
+                              "%s: Processed %d entries (%d%%).",
+                              inst->inst_name, *expargs->cnt, percent);
+        slapi_task_log_notice(expargs->task,
+                              "%s: Processed %d entries (%d%%).",
+                              inst->inst_name, *expargs->cnt, percent);
+    }
+    slapi_log_err(SLAPI_LOG_INFO, "dbmdb_export_one_entry", "export %s: Processed %d entries (%d%%).\n",
+                  inst->inst_name, *expargs->cnt, percent);
+    *expargs->lastcnt = *expargs->cnt;
+}
+
+static int dbmdb_export_pipeline_queue(export_pipeline *pl, ID id, const char *dn, const char *data, struct backentry *ep);
+
+static int
+dbmdb_export_one_entry(struct ldbminfo *li,
+                 ldbm_instance *inst,
+                 export_args *expargs)
+{
+    int rc = 0;
+    int wrc = 0;
+    char *ldif = NULL;
+    int len = 0;
+
+    if (expargs->pipeline) {
+        /* The caller frees its entry */
+        return dbmdb_export_pipeline_queue(expargs->pipeline, expargs->ep->ep_id, NULL, NULL,
+                                           backentry_dup(expargs->ep));
+    }
+
+    ldif = dbmdb_export_entry2ldif(li, inst, expargs, expargs->ep, &len);
+    if (ldif == NULL) {
+        goto bail; /* go to next loop */
+    }
+    (*expargs->cnt)++;
 
     if (expargs->printkey & EXPORT_PRINTKEY) {
         char idstr[32];
@@ -495,7 +558,7 @@ dbmdb_export_one_entry(struct ldbminfo *li,
             goto bail;
         }
     }
-    wrc = write(expargs->fd, data.mv_data, len);
+    wrc = write(expargs->fd, ldif, len);
     if (wrc < 0) {
         goto bail;
     }
@@ -503,8 +566,6 @@ dbmdb_export_one_entry(struct ldbminfo *li,
     if (wrc < 0) {
         goto bail;
     }
-    slapi_ch_free(&data.mv_data);
-    data.mv_size = 0;
     rc = 0;
     if ((*expargs->cnt) % 1000 == 0) {
         int percent;
@@ -514,19 +575,10 @@ dbmdb_export_one_entry(struct ldbminfo *li,
         } else {
             percent = (expargs->ep->ep_id * 100 / expargs->lastid);
         }
-        if (expargs->task) {
-            slapi_task_log_status(expargs->task,
-                                  "%s: Processed %d entries (%d%%).",
-                                  inst->inst_name, *expargs->cnt, percent);
-            slapi_task_log_notice(expargs->task,
-                                  "%s: Processed %d entries (%d%%).",
-                                  inst->inst_name, *expargs->cnt, percent);
-        }
-        slapi_log_err(SLAPI_LOG_INFO, "dbmdb_export_one_entry", "export %s: Processed %d entries (%d%%).\n",
-                      inst->inst_name, *expargs->cnt, percent);
-        *expargs->lastcnt = *expargs->cnt;
+        dbmdb_export_log_progress(inst, expargs, percent);
     }
 bail:
+    slapi_ch_free_string(&ldif);
     if (wrc < 0) {
         slapi_log_err(SLAPI_LOG_INFO, "dbmdb_export_one_entry", "export %s: Failed to write in export file. errno=%d\n", inst->inst_name, errno);
         rc = wrc;
@@ -534,6 +586,390 @@ bail:
     return rc;
 }
 
+/*
+ * Parallel export
+ *
+ * With nsslapd-mdb-export-threads > 0, or when a gzip compressed export is
+ * requested (EXPORT_GZIP), decoding the entries and converting them to ldif is done by a pool
+ * of threads. The main thread still walks id2entry, computes the dns and
+ * exports the parents having a higher id first, then queues the raw entries
+ * by batches. The batches are numbered and written in that order by the main
+ * thread, so the ldif is the same as the one of the serial export (parents
+ * before their children, the RUV after the suffix).
+ *
+ * When compressing, every batch is compressed by its thread as a separate
+ * gzip member: a sequence of gzip members is a valid gzip file.
+ */
+#define EXPORT_BATCH_SIZE 256
+#define EXPORT_BATCHES_PER_THREAD 4
+
+typedef struct _export_item
+{
+    ID id;
+    char *dn;               /* dn of data, or NULL if data contains it */
+    char *data;             /* copy of the id2entry record */
+    struct backentry *ep;   /* or the already decoded entry */
+} export_item;
+
+typedef struct _export_batch
+{
+    uint64_t seq;
+    int nitems;
+    export_item items[EXPORT_BATCH_SIZE];
+    NIDS idindex;           /* progress when the batch was queued */
+    ID lastid;
+    int nentries;           /* number of exported entries */
+    char *out;
+    size_t outlen;
+    size_t outsize;
+    int error;
+    int done;
+    struct _export_batch *next;
+} export_batch;
+
+struct _export_pipeline
+{
+    struct ldbminfo *li;
+    ldbm_instance *inst;
+    export_args *eargs;
+    int str2entry_options;
+    int compress;
+    pthread_mutex_t lock;
+    pthread_cond_t todo_cv;     /* a batch is queued */
+    pthread_cond_t done_cv;     /* a batch is converted */
+    export_batch *todo_head;
+    export_batch *todo_tail;
+    export_batch **ring;        /* batches in flight, by seq % max_inflight */
+    int max_inflight;
+    int inflight;
+    uint64_t next_seq;          /* seq of the next queued batch */
+    uint64_t write_seq;         /* seq of the next written batch */
+    export_batch *current;      /* batch being filled */
+    pthread_t *threads;
+    int nthreads;
+    int stopping;
+    int error;
+};
+
+static void
+dbmdb_export_batch_append(export_batch *b, const char *buf, size_t len)
+{
+    if (b->outlen + len > b->outsize) {
+        b->outsize = (b->outlen + len) * 2;
+        b->out = slapi_ch_realloc(b->out, b->outsize);
+    }
+    memcpy(b->out + b->outlen, buf, len);
+    b->outlen += len;
+}
+
+/* Compress buf as a gzip member */
+static int
+dbmdb_export_gzip(const char *buf, size_t len, char **out, size_t *outlen)
+{
+    z_stream zs = {0};
+    int rc;
+
+    if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return -1;
+    }
+    *outlen = deflateBound(&zs, len);
+    *out = slapi_ch_malloc(*outlen);
+    zs.next_in = (Bytef *)buf;
+    zs.avail_in = len;
+    zs.next_out = (Bytef *)*out;
+    zs.avail_out = *outlen;
+    rc = deflate(&zs, Z_FINISH);
+    *outlen = zs.total_out;
+    deflateEnd(&zs);
+    if (rc != Z_STREAM_END) {
+        slapi_ch_free_string(out);
+        return -1;
+    }
+    return 0;
+}
+
+static void
+dbmdb_export_batch_free(export_batch **b)
+{
+    for (int i = 0; i < (*b)->nitems; i++) {
+        slapi_ch_free_string(&(*b)->items[i].dn);
+        slapi_ch_free_string(&(*b)->items[i].data);
+        backentry_free(&(*b)->items[i].ep);
+    }
+    slapi_ch_free_string(&(*b)->out);
+    slapi_ch_free((void **)b);
+}
+
+/* Runs in the export threads */
+static void
+dbmdb_export_batch_convert(export_pipeline *pl, export_batch *b)
+{
+    export_args *eargs = pl->eargs;
+
+    for (int i = 0; i < b->nitems; i++) {
+        export_item *item = &b->items[i];
+        struct backentry *ep = item->ep;
+        char *ldif = NULL;
+        int len = 0;
+
+        if (ep == NULL) {
+            ep = backentry_alloc();
+            if (item->dn) {
+                ep->ep_entry = slapi_str2entry_ext(item->dn, NULL, item->data,
+                                                   pl->str2entry_options | SLAPI_STR2ENTRY_NO_ENTRYDN);
+            } else {
+                ep->ep_entry = slapi_str2entry(item->data, pl->str2entry_options | SLAPI_STR2ENTRY_NO_ENTRYDN);
+            }
+            if (ep->ep_entry == NULL) {
+                slapi_log_err(SLAPI_LOG_WARNING, "dbmdb_db2ldif",
+                              "Skipping badly formatted entry with id %lu\n",
+                              (u_long)item->id);
+                backentry_free(&ep);
+                continue;
+            }
+            ep->ep_id = item->id;
+        }
+        ldif = dbmdb_export_entry2ldif(pl->li, pl->inst, eargs, ep, &len);
+        if (ldif) {
+            if (eargs->printkey & EXPORT_PRINTKEY) {
+                char idstr[32];
+
+                sprintf(idstr, "# entry-id: %lu\n", (u_long)ep->ep_id);
+                dbmdb_export_batch_append(b, idstr, strlen(idstr));
+            }
+            dbmdb_export_batch_append(b, ldif, len);
+            dbmdb_export_batch_append(b, "\n", 1);
+            b->nentries++;
+            slapi_ch_free_string(&ldif);
+        }
+        if (ep != item->ep) {
+            backentry_free(&ep);
+        }
+    }
+    if (pl->compress && b->outlen) {
+        char *gz = NULL;
+        size_t gzlen = 0;
+
+        if (dbmdb_export_gzip(b->out, b->outlen, &gz, &gzlen)) {
+            b->error = 1;
+        } else {
+            slapi_ch_free_string(&b->out);
+            b->out = gz;
+            b->outlen = b->outsize = gzlen;
+        }
+    }
+}
+
+static void *
+dbmdb_export_threadmain(void *arg)
+{
+    export_pipeline *pl = arg;
+
+    pthread_mutex_lock(&pl->lock);
+    for (;;) {
+        export_batch *b = NULL;
+
+        while (pl->todo_head == NULL && !pl->stopping) {
+            pthread_cond_wait(&pl->todo_cv, &pl->lock);
+        }
+        if (pl->todo_head == NULL) {
+            break;
+        }
+        b = pl->todo_head;
+        pl->todo_head = b->next;
+        if (pl->todo_head == NULL) {
+            pl->todo_tail = NULL;
+        }
+        pthread_mutex_unlock(&pl->lock);
+
+        dbmdb_export_batch_convert(pl, b);
+
+        pthread_mutex_lock(&pl->lock);
+        b->done = 1;
+        pthread_cond_broadcast(&pl->done_cv);
+    }
+    pthread_mutex_unlock(&pl->lock);
+    return NULL;
+}
+
+/*
+ * Write the converted batches in order. Waits until less than max_inflight
+ * batches are in flight, or until none is if all is set.
+ */
+static int
+dbmdb_export_pipeline_drain(export_pipeline *pl, int all)
+{
+    export_args *eargs = pl->eargs;
+
+    pthread_mutex_lock(&pl->lock);
+    for (;;) {
+        export_batch *b = pl->ring[pl->write_seq % pl->max_inflight];
+
+        if (b && b->done) {
+            int before = *eargs->cnt;
+
+            pl->ring[pl->write_seq % pl->max_inflight] = NULL;
+            pthread_mutex_unlock(&pl->lock);
+
+            if (b->error) {
+                slapi_log_err(SLAPI_LOG_ERR, "dbmdb_db2ldif", "export %s: Failed to compress the entries\n",
+                              pl->inst->inst_name);
+                pl->error = -1;
+            } else if (pl->error == 0 && dbmdb_export_write(eargs->fd, b->out, b->outlen)) {
+                slapi_log_err(SLAPI_LOG_INFO, "dbmdb_export_one_entry", "export %s: Failed to write in export file. errno=%d\n",
+                              pl->inst->inst_name, errno);
+                pl->error = -1;
+            }
+            *eargs->cnt += b->nentries;
+            if (*eargs->cnt / 1000 != before / 1000) {
+                int percent;
+
+                if (eargs->idl) {
+                    percent = (b->idindex * 100 / eargs->idl->b_nids);
+                } else {
+                    percent = (b->lastid * 100 / eargs->lastid);
+                }
+                dbmdb_export_log_progress(pl->inst, eargs, percent);
+            }
+            dbmdb_export_batch_free(&b);
+
+            pthread_mutex_lock(&pl->lock);
+            pl->write_seq++;
+            pl->inflight--;
+        } else if (all ? pl->inflight > 0 : pl->inflight >= pl->max_inflight) {
+            pthread_cond_wait(&pl->done_cv, &pl->lock);
+        } else {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&pl->lock);
+    return pl->error;
+}
+
+static int
+dbmdb_export_pipeline_submit(export_pipeline *pl)
+{
+    export_batch *b = pl->current;
+
+    pl->current = NULL;
+    if (b == NULL) {
+        return pl->error;
+    }
+    b->idindex = pl->eargs->idindex;
+    pthread_mutex_lock(&pl->lock);
+    b->seq = pl->next_seq++;
+    pl->ring[b->seq % pl->max_inflight] = b;
+    pl->inflight++;
+    if (pl->todo_tail) {
+        pl->todo_tail->next = b;
+    } else {
+        pl->todo_head = b;
+    }
+    pl->todo_tail = b;
+    pthread_cond_signal(&pl->todo_cv);
+    pthread_mutex_unlock(&pl->lock);
+
+    return dbmdb_export_pipeline_drain(pl, 0);
+}
+
+/*
+ * Queue an entry for the export: either its id2entry record (and its dn if
+ * the record only contains the rdn), copied, or a decoded entry that is
+ * then owned by the pipeline.
+ */
+static int
+dbmdb_export_pipeline_queue(export_pipeline *pl, ID id, const char *dn, const char *data, struct backentry *ep)
+{
+    export_item *item = NULL;
+
+    if (pl->current == NULL) {
+        pl->current = (export_batch *)slapi_ch_calloc(1, sizeof(export_batch));
+    }
+    item = &pl->current->items[pl->current->nitems++];
+    item->id = id;
+    item->ep = ep;
+    if (ep == NULL) {
+        /* the record is only valid in the read txn */
+        item->dn = slapi_ch_strdup(dn);
+        item->data = slapi_ch_strdup(data);
+    }
+    pl->current->lastid = id;
+    if (pl->current->nitems == EXPORT_BATCH_SIZE) {
+        return dbmdb_export_pipeline_submit(pl);
+    }
+    return pl->error;
+}
+
+static export_pipeline *
+dbmdb_export_pipeline_start(struct ldbminfo *li, ldbm_instance *inst, export_args *eargs,
+                            int nthreads, int str2entry_options, int compress)
+{
+    export_pipeline *pl = (export_pipeline *)slapi_ch_calloc(1, sizeof(export_pipeline));
+
+    pl->li = li;
+    pl->inst = inst;
+    pl->eargs = eargs;
+    pl->str2entry_options = str2entry_options;
+    pl->compress = compress;
+    pthread_mutex_init(&pl->lock, NULL);
+    pthread_cond_init(&pl->todo_cv, NULL);
+    pthread_cond_init(&pl->done_cv, NULL);
+    pl->max_inflight = nthreads * EXPORT_BATCHES_PER_THREAD;
+    pl->ring = (export_batch **)slapi_ch_calloc(pl->max_inflight, sizeof(export_batch *));
+    pl->threads = (pthread_t *)slapi_ch_calloc(nthreads, sizeof(pthread_t));
+    for (int i = 0; i < nthreads; i++) {
+        int rc = pthread_create(&pl->threads[i], NULL, dbmdb_export_threadmain, pl);
+        if (rc) {
+            slapi_log_err(SLAPI_LOG_ERR, "dbmdb_db2ldif",
+                          "Unable to create an export thread, error %d (%s)\n",
+                          rc, strerror(rc));
+            break;
+        }
+        pl->nthreads++;
+    }
+    if (pl->nthreads == 0) {
+        pthread_cond_destroy(&pl->done_cv);
+        pthread_cond_destroy(&pl->todo_cv);
+        pthread_mutex_destroy(&pl->lock);
+        slapi_ch_free((void **)&pl->threads);
+        slapi_ch_free((void **)&pl->ring);
+        slapi_ch_free((void **)&pl);
+        return NULL;
+    }
+    slapi_log_err(SLAPI_LOG_INFO, "dbmdb_db2ldif", "export %s: Converting the entries with %d threads%s\n",
+                  inst->inst_name, pl->nthreads, compress ? ", gzip compressed" : "");
+    return pl;
+}
+
+/* Write the remaining entries and release the pipeline */
+static int
+dbmdb_export_pipeline_finish(export_pipeline **ppl)
+{
+    export_pipeline *pl = *ppl;
+    int rc = 0;
+
+    if (pl == NULL) {
+        return 0;
+    }
+    dbmdb_export_pipeline_submit(pl);
+    rc = dbmdb_export_pipeline_drain(pl, 1);
+
+    pthread_mutex_lock(&pl->lock);
+    pl->stopping = 1;
+    pthread_cond_broadcast(&pl->todo_cv);
+    pthread_mutex_unlock(&pl->lock);
+    for (int i = 0; i < pl->nthreads; i++) {
+        pthread_join(pl->threads[i], NULL);
+    }
+    pthread_cond_destroy(&pl->done_cv);
+    pthread_cond_destroy(&pl->todo_cv);
+    pthread_mutex_destroy(&pl->lock);
+    slapi_ch_free((void **)&pl->threads);
+    slapi_ch_free((void **)&pl->ring);
+    slapi_ch_free((void **)ppl);
+    return rc;
+}
+
 /*
  * dbmdb_db2ldif - backend routine to convert database to an
  * ldif file.
@@ -588,6 +1024,9 @@ dbmdb_db2ldif(Slapi_PBlock *pb)
     dbmdb_cursor_t cur = {0};
     uint size = 0;
     int wrc = 0;
+    int export_threads = 0;
+    int compress = 0;
+    char *merged = NULL;
 
     slapi_log_err(SLAPI_LOG_TRACE, "dbmdb_db2ldif", "=>\n");
 
@@ -692,6 +1131,8 @@ dbmdb_db2ldif(Slapi_PBlock *pb)
     printkey &= ~EXPORT_APPENDMODE_1;
     noversion = (printkey & EXPORT_NOVERSION);
     printkey &= ~EXPORT_NOVERSION;
+    compress = (printkey & EXPORT_GZIP);
+    printkey &= ~EXPORT_GZIP;
 
     /* decide whether to dump uniqueid */
     if (dump_uniqueid)
@@ -844,7 +1285,18 @@ dbmdb_db2ldif(Slapi_PBlock *pb)
                  */
 
         sprintf(vstr, "version: %d\n\n", myversion);
-        wrc = write(fd, vstr, strlen(vstr));
+        if (compress) {
+            char *gz = NULL;
+            size_t gzlen = 0;
+
+            wrc = dbmdb_export_gzip(vstr, strlen(vstr), &gz, &gzlen);
+            if (wrc == 0) {
+                wrc = dbmdb_export_write(fd, gz, gzlen);
+            }
+            slapi_ch_free_string(&gz);
+        } else {
+            wrc = write(fd, vstr, strlen(vstr));
+        }
         if (wrc < 0) {
             goto bye;
         } else {
@@ -861,6 +1313,20 @@ dbmdb_db2ldif(Slapi_PBlock *pb)
     eargs.task = task;
     eargs.include_suffix = include_suffix;
     eargs.exclude_suffix = exclude_suffix;
+    eargs.cnt = &cnt;
+    eargs.lastcnt = &lastcnt;
+
+    export_threads = MDB_CONFIG(li)->dsecfg.export_threads;
+    if (export_threads > 0 || compress) {
+        /* compressing is only done by the export threads */
+        eargs.pipeline = dbmdb_export_pipeline_start(li, inst, &eargs, export_threads > 0 ? export_threads : 1,
+                                                     str2entry_options, compress);
+        if (eargs.pipeline == NULL && compress) {
+            slapi_task_log_notice(task, "Backend %s: Failed to start the export threads", inst->inst_name);
+            return_value = -1;
+            goto bye;
+        }
+    }
 
     while (keepgoing) {
         /*
@@ -938,12 +1404,37 @@ dbmdb_db2ldif(Slapi_PBlock *pb)
         plugin_call_entryfetch_plugins((char **)&data.mv_data, &size);
         data.mv_size = size;
 
+        /* add the values stored out of the entry */
+        slapi_ch_free_string(&merged);
+        merged = id2values_merge(inst->inst_be, temp_id, data.mv_data, NULL, &rc);
+        if (rc) {
+            slapi_task_log_notice(task, "Backend %s: Failed to read the values of entry %lu, err %d\n",
+                    inst->inst_name, (u_long)temp_id, rc);
+            slapi_log_err(SLAPI_LOG_ERR, "dbmdb_db2ldif",
+                    "db2ldif: Backend %s: failed to read the values of entry %lu, err %d\n",
+                    inst->inst_name, (u_long)temp_id, rc);
+            return_value = -1;
+            break;
+        }
+        if (merged) {
+            data.mv_data = merged;
+            data.mv_size = strlen(merged) + 1;
+        }
+
         ep = backentry_alloc();
         char *rdn = NULL;
 
         /* rdn is allocated in get_value_from_string */
         rc = get_value_from_string((const char *)data.mv_data, "rdn", &rdn);
-        if (rc) {
+        if (rc && eargs.pipeline) {
+            /* decoded by the export threads */
+            eargs.idindex = idindex;
+            backentry_free(&ep);
+            if (dbmdb_export_pipeline_queue(eargs.pipeline, temp_id, NULL, data.mv_data, NULL)) {
+                break;
+            }
+            continue;
+        } else if (rc) {
             /* data.mv_data may not include rdn: ..., try "dn: ..." */
             ep->ep_entry = slapi_str2entry(data.mv_data,
                                            str2entry_options | SLAPI_STR2ENTRY_NO_ENTRYDN);
@@ -1073,6 +1564,16 @@ dbmdb_db2ldif(Slapi_PBlock *pb)
                                   dn);
                 }
             }
+            if (eargs.pipeline && !skip_ruv) {
+                /* decoded by the export threads */
+                eargs.idindex = idindex;
+                slapi_ch_free_string(&rdn);
+                backentry_free(&ep);
+                if (dbmdb_export_pipeline_queue(eargs.pipeline, temp_id, dn, data.mv_data, NULL)) {
+                    break;
+                }
+                continue;
+            }
             ep->ep_entry = slapi_str2entry_ext(dn, NULL, data.mv_data,
                                             str2entry_options | SLAPI_STR2ENTRY_NO_ENTRYDN);
             slapi_ch_free_string(&rdn);
@@ -1108,9 +1609,14 @@ dbmdb_db2ldif(Slapi_PBlock *pb)
             return_value = rc;
         }
     }
+    slapi_ch_free_string(&merged);
     /* MDB_NOTFOUND -> successful end */
     if (return_value == MDB_NOTFOUND)
         return_value = 0;
+    rc = dbmdb_export_pipeline_finish(&eargs.pipeline);
+    if (rc && !return_value) {
+        return_value = rc;
+    }
 
     /* done cycling thru entries to write */
     if (lastcnt != cnt) {
@@ -1133,6 +1639,8 @@ dbmdb_db2ldif(Slapi_PBlock *pb)
     }
 
 bye:
+    slapi_ch_free_string(&merged);
+    dbmdb_export_pipeline_finish(&eargs.pipeline);
     if (idl) {
         idl_free(&idl);
     }
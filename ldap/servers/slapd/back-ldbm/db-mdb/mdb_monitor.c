@@ -242,6 +242,8 @@ dbmdb_monitor_search(Slapi_PBlock *pb, Slapi_Entry *e, Slapi_Entry *entryAfter,
         sprintf(buf, "%" PRIu64, count);
         MSET("currentNormalizedDnCacheCount");
     }
+    sprintf(buf, "%" PRIu64, dn_intern_get_count());
+    MSET("currentInternedDnCount");
 
     *returncode = LDAP_SUCCESS;
     return SLAPI_DSE_CALLBACK_OK;
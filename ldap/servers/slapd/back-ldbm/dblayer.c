@@ -333,8 +333,12 @@ dblayer_instance_start(backend *be, int mode)
 {
     struct ldbminfo *li = (struct ldbminfo *)be->be_database->plg_private;
     dblayer_private *priv = (dblayer_private *)li->li_dblayer_private;
+    int rc = priv->dblayer_instance_start_fn(be, mode);
 
-    return priv->dblayer_instance_start_fn(be, mode);
+    if (rc == 0) {
+        id2values_instance_start(be);
+    }
+    return rc;
 }
 
 
@@ -384,6 +388,25 @@ dblayer_close_changelog(backend *be)
     return return_value;
 }
 
+int
+dblayer_close_id2values(backend *be)
+{
+    ldbm_instance *inst;
+    dbi_db_t *pDB = NULL;
+    int return_value = 0;
+
+    PR_ASSERT(NULL != be);
+    inst = (ldbm_instance *) be->be_instance_info;
+    PR_ASSERT(NULL != inst);
+
+    pDB = inst->inst_id2values;
+    if (pDB) {
+        return_value = dblayer_db_op(be, pDB,  NULL, DBI_OP_CLOSE, NULL, NULL);
+        inst->inst_id2values = NULL;
+    }
+    return return_value;
+}
+
 int
 dblayer_erase_changelog_file(backend *be, struct attrinfo *a, PRBool use_lock, int no_force_chkpt)
 {
@@ -442,6 +465,8 @@ dblayer_instance_close(backend *be)
     if (!inst->inst_db) {
         be->be_state = BE_STATE_STOPPING;
     }
+    /* Write the in-memory subordinate counts back to the parents */
+    parent_subcount_flush(be, 1);
     if (getenv("USE_VALGRIND") || slapi_is_loglevel_set(SLAPI_LOG_CACHE)) {
         /*
          * if any string is set to an environment variable USE_VALGRIND,
@@ -464,6 +489,7 @@ dblayer_instance_close(backend *be)
 
     return_value = dblayer_close_indexes(be);
     return_value |= dblayer_close_changelog(be);
+    return_value |= dblayer_close_id2values(be);
 
     /* Now close id2entry if it's open */
     pDB = inst->inst_id2entry;
@@ -654,6 +680,37 @@ int dblayer_get_changelog(backend *be, dbi_db_t ** ppDB, int open_flags)
     return return_value;
 }
 
+/* Same as dblayer_get_changelog for the out of line values (see id2values.c) */
+int dblayer_get_id2values(backend *be, dbi_db_t ** ppDB, int open_flags)
+{
+    ldbm_instance *inst = (ldbm_instance *) be->be_instance_info;
+    int return_value = -1;
+    dbi_db_t *pDB = NULL;
+
+    *ppDB = NULL;
+
+    if (inst->inst_id2values) {
+        *ppDB = inst->inst_id2values;
+        return 0;
+    }
+
+    PR_Lock(inst->inst_handle_list_mutex);
+    if (inst->inst_id2values) {
+        /* another thread set the handle while we were waiting on the lock */
+        *ppDB = inst->inst_id2values;
+        PR_Unlock(inst->inst_handle_list_mutex);
+        return 0;
+    }
+    return_value = dblayer_open_file(be, ID2VALUES, open_flags, NULL, &pDB);
+    if (0 == return_value) {
+        inst->inst_id2values = pDB;
+        *ppDB = pDB;
+    }
+    PR_Unlock(inst->inst_handle_list_mutex);
+
+    return return_value;
+}
+
 /*
  * Unlock the db lib mutex here if we need to.
  */
@@ -1202,13 +1259,16 @@ dblayer_plugin_abort(Slapi_PBlock *pb)
 
 
 
-/* Destination Directory is an absolute pathname */
+/*
+ * Destination Directory is an absolute pathname
+ * base_dir, if not NULL, is the previous backup of an incremental backup
+ */
 int
-dblayer_backup(struct ldbminfo *li, char *dest_dir, Slapi_Task *task)
+dblayer_backup(struct ldbminfo *li, char *dest_dir, const char *base_dir, Slapi_Task *task)
 {
     dblayer_private *priv = (dblayer_private *)li->li_dblayer_private;
 
-    return priv->dblayer_backup_fn(li, dest_dir, task);
+    return priv->dblayer_backup_fn(li, dest_dir, base_dir, task);
 }
 
 
@@ -1315,6 +1375,10 @@ ldbm_back_get_info(Slapi_Backend *be, int cmd, void **info)
     }
     dblayer_private *prv = (dblayer_private *)li->li_dblayer_private;
 
+    /* The subordinate counts do not depend on the db implementation */
+    if (BACK_INFO_SUBORDINATE_COUNTS == cmd) {
+        return parent_subcount_get_info(be, (struct _back_info_subordinates *)info);
+    }
     return  prv->dblayer_get_info_fn(be, cmd, info);
 }
 
@@ -62,7 +62,7 @@
 typedef int dblayer_start_fn_t(struct ldbminfo *li, int flags);
 typedef int dblayer_close_fn_t(struct ldbminfo *li, int flags);
 typedef int dblayer_instance_start_fn_t(backend *be, int flags);
-typedef int dblayer_backup_fn_t(struct ldbminfo *li, char *dest_dir, Slapi_Task *task);
+typedef int dblayer_backup_fn_t(struct ldbminfo *li, char *dest_dir, const char *base_dir, Slapi_Task *task);
 typedef int dblayer_verify_fn_t(Slapi_PBlock *pb);
 typedef int dblayer_db_size_fn_t(Slapi_PBlock *pb);
 typedef int dblayer_ldif2db_fn_t(Slapi_PBlock *pb);
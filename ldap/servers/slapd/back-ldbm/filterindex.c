@@ -719,6 +719,234 @@ filter_is_subtype(Slapi_Filter *f)
     return issubtype;
 }
 
+/*
+ * Cost based planning of the AND filters
+ *
+ * The components of an AND filter are evaluated by increasing estimated
+ * number of candidates (from the index statistics, see index_stats.c) so
+ * that the small IDLs are read first and the intersection shortcut
+ * triggers before the large IDLs get fetched. When the candidate list is
+ * small enough compared to the IDLs of the remaining components, these
+ * components are not read at all: the candidates get filter tested instead.
+ */
+#define FILTER_PLAN_DEFAULT_COST 1000 /* estimate of a component without statistics */
+#define FILTER_PLAN_TEST_RATIO   64   /* cost of filter testing an entry vs reading an ID */
+
+typedef struct
+{
+    Slapi_Filter *f;
+    uint64_t cost;  /* estimated number of candidates */
+    int known;      /* cost is based on the key statistics */
+} filter_plan_elmt;
+
+static uint64_t
+filter_plan_eq_estimate(backend *be, char *type, struct berval *bval, int *known)
+{
+    uint64_t estimate = INDEX_STATS_UNKNOWN;
+    Slapi_Value **ivals = NULL;
+    Slapi_Value sv;
+    Slapi_Attr sattr;
+
+    *known = 0;
+    slapi_attr_init(&sattr, type);
+    slapi_value_init_berval(&sv, bval);
+    slapi_attr_assertion2keys_ava_sv(&sattr, &sv, &ivals, LDAP_FILTER_EQUALITY);
+    for (size_t i = 0; ivals && ivals[i]; i++) {
+        int key_known = 0;
+        uint64_t e = index_read_estimate(be, type, indextype_EQUALITY,
+                                         slapi_value_get_berval(ivals[i]), &key_known);
+        /* keys2idl intersects the keys IDLs */
+        if (e != INDEX_STATS_UNKNOWN && (estimate == INDEX_STATS_UNKNOWN || e < estimate)) {
+            estimate = e;
+            *known = key_known;
+        }
+    }
+    valuearray_free(&ivals);
+    value_done(&sv);
+    attr_done(&sattr);
+    return estimate;
+}
+
+/* Estimate the number of candidates of a filter component */
+static uint64_t
+filter_plan_estimate(backend *be, Slapi_Filter *f, int *known)
+{
+    uint64_t estimate = INDEX_STATS_UNKNOWN;
+    struct berval *bval = NULL;
+    char *type = NULL;
+    Slapi_Filter *fc = NULL;
+    int fc_known = 0;
+    uint64_t e = 0;
+
+    *known = 0;
+    switch (slapi_filter_get_choice(f)) {
+    case LDAP_FILTER_EQUALITY:
+        if (slapi_filter_get_ava(f, &type, &bval) == 0) {
+            estimate = filter_plan_eq_estimate(be, type, bval, known);
+        }
+        break;
+    case LDAP_FILTER_PRESENT:
+        if (slapi_filter_get_type(f, &type) == 0) {
+            estimate = index_read_estimate(be, type, indextype_PRESENCE, NULL, known);
+        }
+        break;
+    case LDAP_FILTER_SUBSTRINGS:
+        if (slapi_filter_get_attribute_type(f, &type) == 0) {
+            estimate = index_read_estimate(be, type, indextype_SUB, NULL, known);
+            /* Only tells if the attribute is not indexed */
+            *known = (*known && estimate == INDEX_STATS_UNINDEXED_COST);
+        }
+        break;
+    case LDAP_FILTER_APPROX:
+        if (slapi_filter_get_ava(f, &type, &bval) == 0) {
+            estimate = index_read_estimate(be, type, indextype_APPROX, NULL, known);
+            *known = (*known && estimate == INDEX_STATS_UNINDEXED_COST);
+        }
+        break;
+    case LDAP_FILTER_AND:
+        /* The smallest component bounds the intersection */
+        for (fc = slapi_filter_list_first(f); fc != NULL; fc = slapi_filter_list_next(f, fc)) {
+            e = filter_plan_estimate(be, fc, &fc_known);
+            if (e != INDEX_STATS_UNKNOWN && (estimate == INDEX_STATS_UNKNOWN || e < estimate)) {
+                estimate = e;
+                *known = fc_known;
+            }
+        }
+        break;
+    case LDAP_FILTER_OR:
+        /* The union is bounded by the sum of the components */
+        *known = 1;
+        estimate = 0;
+        for (fc = slapi_filter_list_first(f); fc != NULL; fc = slapi_filter_list_next(f, fc)) {
+            e = filter_plan_estimate(be, fc, &fc_known);
+            if (e == INDEX_STATS_UNKNOWN) {
+                *known = 0;
+                return INDEX_STATS_UNKNOWN;
+            }
+            *known = *known && fc_known;
+            if (e == INDEX_STATS_UNINDEXED_COST) {
+                return INDEX_STATS_UNINDEXED_COST;
+            }
+            estimate = (e >= INDEX_STATS_ALLIDS_COST - estimate) ? INDEX_STATS_ALLIDS_COST : estimate + e;
+        }
+        break;
+    case LDAP_FILTER_NOT:
+        /* Complements are applied on the intersection: evaluate them last */
+        e = filter_plan_estimate(be, slapi_filter_list_first(f), &fc_known);
+        *known = 1;
+        estimate = (e == INDEX_STATS_UNINDEXED_COST) ? INDEX_STATS_UNINDEXED_COST : INDEX_STATS_ALLIDS_COST;
+        break;
+    default:
+        /* ranges and extensible filters */
+        break;
+    }
+    return estimate;
+}
+
+/*
+ * Sort the components of an AND filter by increasing estimated cost.
+ * The filter itself is shared with the rest of the operation and is left
+ * untouched: list_candidates walks the returned plan instead.
+ * Returns NULL if planning is disabled (nsslapd-search-filter-planning)
+ * or if there is no statistics for the components.
+ */
+static filter_plan_elmt *
+filter_plan_and(Slapi_PBlock *pb, backend *be, Slapi_Filter *flist, size_t *nbelmts)
+{
+    struct ldbminfo *li = (struct ldbminfo *)be->be_database->plg_private;
+    filter_plan_elmt *plan = NULL;
+    Slapi_Filter *search_filter = NULL;
+    Slapi_Filter *f = NULL;
+    size_t nb = 0;
+    size_t i = 0;
+    int known = 0;
+
+    *nbelmts = 0;
+    if (!slapi_atomic_load_32(&li->li_filter_planning, __ATOMIC_RELAXED)) {
+        return NULL;
+    }
+    slapi_pblock_get(pb, SLAPI_SEARCH_FILTER, &search_filter);
+    if (search_filter && (search_filter->f_flags & SLAPI_FILTER_TOMBSTONE)) {
+        /* Tombstone searches rely on the filter ordering (see slapi_filter_optimise) */
+        return NULL;
+    }
+    for (f = slapi_filter_list_first(flist); f != NULL; f = slapi_filter_list_next(flist, f)) {
+        nb++;
+    }
+    if (nb < 2) {
+        return NULL;
+    }
+
+    plan = (filter_plan_elmt *)slapi_ch_calloc(nb, sizeof(filter_plan_elmt));
+    for (f = slapi_filter_list_first(flist); f != NULL; f = slapi_filter_list_next(flist, f), i++) {
+        plan[i].f = f;
+        plan[i].cost = filter_plan_estimate(be, f, &plan[i].known);
+        if (plan[i].cost == INDEX_STATS_UNKNOWN) {
+            plan[i].cost = FILTER_PLAN_DEFAULT_COST;
+        }
+        known |= plan[i].known;
+    }
+    if (!known) {
+        slapi_ch_free((void **)&plan);
+        return NULL;
+    }
+
+    /* Stable insertion sort (there are only a few components) */
+    for (i = 1; i < nb; i++) {
+        filter_plan_elmt elmt = plan[i];
+        size_t j = i;
+        while (j > 0 && plan[j - 1].cost > elmt.cost) {
+            plan[j] = plan[j - 1];
+            j--;
+        }
+        plan[j] = elmt;
+    }
+    if (slapi_is_loglevel_set(SLAPI_LOG_FILTER)) {
+        char buf[BUFSIZ];
+        for (i = 0; i < nb; i++) {
+            slapi_log_err(SLAPI_LOG_FILTER, "filter_plan_and", "%s %lu: %s%s\n",
+                          i ? "then" : "first", (u_long)plan[i].cost,
+                          slapi_filter_to_string(plan[i].f, buf, sizeof(buf)),
+                          plan[i].known ? "" : " (estimated)");
+        }
+    }
+    *nbelmts = nb;
+    return plan;
+}
+
+/* Next component of flist, in the plan order if there is one */
+static Slapi_Filter *
+filter_plan_next(filter_plan_elmt *plan, size_t nbelmts, size_t next, Slapi_Filter *flist, Slapi_Filter *f)
+{
+    if (plan) {
+        return (next < nbelmts) ? plan[next].f : NULL;
+    }
+    return slapi_filter_list_next(flist, f);
+}
+
+/*
+ * Tells whether it is cheaper to filter test the candidates than to read
+ * the IDLs of the remaining components of the plan
+ * *unindexed is set if some of these components are not indexed
+ */
+static int
+filter_plan_stop(filter_plan_elmt *plan, size_t nbelmts, size_t next, size_t nbcandidates, int *unindexed)
+{
+    *unindexed = 0;
+    if (plan == NULL || next >= nbelmts || nbcandidates == 0) {
+        return 0;
+    }
+    for (size_t i = next; i < nbelmts; i++) {
+        if (!plan[i].known || plan[i].cost <= (uint64_t)nbcandidates * FILTER_PLAN_TEST_RATIO) {
+            return 0;
+        }
+        if (plan[i].cost == INDEX_STATS_UNINDEXED_COST) {
+            *unindexed = 1;
+        }
+    }
+    return 1;
+}
+
 static IDList *
 list_candidates(
     Slapi_PBlock *pb,
@@ -743,11 +971,19 @@ list_candidates(
     int is_and = 0;
     IDListSet *idl_set = NULL;
     back_search_result_set *sr = NULL;
+    filter_plan_elmt *plan = NULL;
+    size_t plan_len = 0;
+    size_t plan_idx = 0;
+    int plan_unindexed = 0;
 
     slapi_pblock_get(pb, SLAPI_SEARCH_RESULT_SET, &sr);
 
     slapi_log_err(SLAPI_LOG_TRACE, "list_candidates", "=> 0x%x\n", ftype);
 
+    if (ftype == LDAP_FILTER_AND) {
+        plan = filter_plan_and(pb, be, flist, &plan_len);
+    }
+
     /*
      * Optimize bounded range queries such as (&(cn>=A)(cn<=B)).
      * Could be better by matching pairs in a longer list
@@ -844,8 +1080,8 @@ list_candidates(
 
     idl = NULL;
     nextf = NULL;
-    for (f_head = f = slapi_filter_list_first(flist); f != NULL;
-         f = slapi_filter_list_next(flist, f)) {
+    for (f_head = f = (plan ? plan[0].f : slapi_filter_list_first(flist)); f != NULL;
+         plan_idx++, f = filter_plan_next(plan, plan_len, plan_idx, flist, f)) {
 
         /* Look for NOT foo type filter elements where foo is simple equality */
         isnot = (LDAP_FILTER_NOT == slapi_filter_get_choice(f)) &&
@@ -948,6 +1184,30 @@ list_candidates(
             sr->sr_flags |= SR_FLAG_MUST_APPLY_FILTER_TEST;
             goto apply_set_op;
         }
+
+        if (ftype == LDAP_FILTER_AND &&
+            filter_plan_stop(plan, plan_len, plan_idx + 1, idl_set_minimum_nids(idl_set), &plan_unindexed)) {
+            /*
+             * The remaining components are expected to return far more IDs
+             * than the current candidates: filter test the candidates instead
+             */
+            slapi_log_err(SLAPI_LOG_FILTER, "list_candidates", "AND plan shortcut condition - must apply filter test\n");
+            slapi_pblock_set_flag_operation_notes(pb, SLAPI_OP_NOTE_FILTER_PLANNED);
+            if (plan_unindexed) {
+                /* Keep reporting the unindexed components that are skipped */
+                Operation *pb_op = NULL;
+                Connection *pb_conn = NULL;
+                int pr_idx = -1;
+
+                slapi_pblock_get(pb, SLAPI_OPERATION, &pb_op);
+                slapi_pblock_get(pb, SLAPI_CONNECTION, &pb_conn);
+                slapi_pblock_get(pb, SLAPI_PAGED_RESULTS_INDEX, &pr_idx);
+                slapi_pblock_set_flag_operation_notes(pb, SLAPI_OP_NOTE_UNINDEXED);
+                pagedresults_set_unindexed(pb_conn, pb_op, pr_idx);
+            }
+            sr->sr_flags |= SR_FLAG_MUST_APPLY_FILTER_TEST;
+            goto apply_set_op;
+        }
     }
 
     /*
@@ -977,6 +1237,7 @@ apply_set_op:
     slapi_log_err(SLAPI_LOG_TRACE, "list_candidates", "<= idl len %lu\n", (u_long)IDL_NIDS(idl));
 out:
     idl_set_destroy(idl_set);
+    slapi_ch_free((void **)&plan);
     if (is_and) {
         /*
          * Sets IS_AND back to 0 only when this function set 1.
@@ -1010,6 +1271,8 @@ substring_candidates(
     back_txn txn = {NULL};
     int pr_idx = -1;
     struct attrinfo *ai = NULL;
+    IDList *posidl = NULL;
+    int exact = 0;
 
     slapi_log_err(SLAPI_LOG_TRACE, "substring_candidates", "=>\n");
 
@@ -1022,6 +1285,7 @@ substring_candidates(
      * get the index keys corresponding to the substring
      * assertion values
      */
+    f->f_flags &= ~SLAPI_FILTER_INDEX_EXACT;
     slapi_attr_init(&sattr, type);
     ainfo_get(be, type, &ai);
     slapi_pblock_set(pb, SLAPI_SYNTAX_SUBSTRLENS, ai->ai_substr_lens);
@@ -1056,7 +1320,20 @@ substring_candidates(
         idl = idl_alloc(0);
     } else {
         slapi_pblock_get(pb, SLAPI_TXN, &txn.back_txn_txn);
-        idl = keys2idl(pb, be, type, indextype_SUB, ivals, err, &unindexed, &txn, allidslimit);
+        /* the positional keys, if any, check the adjacency of the keys */
+        posidl = substrpos_candidates(pb, be, ai, type, initial, any, final, &txn, allidslimit, &exact);
+        if (posidl && exact) {
+            idl = posidl;
+            f->f_flags |= SLAPI_FILTER_INDEX_EXACT;
+        } else {
+            idl = keys2idl(pb, be, type, indextype_SUB, ivals, err, &unindexed, &txn, allidslimit);
+            if (posidl) {
+                IDList *tmp = idl;
+                idl = idl_intersection(be, tmp, posidl);
+                idl_free(&tmp);
+                idl_free(&posidl);
+            }
+        }
     }
     if (unindexed) {
         Operation *pb_op;
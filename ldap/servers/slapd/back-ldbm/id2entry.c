@@ -97,7 +97,21 @@ id2entry_add_ext(backend *be, struct backentry *e, back_txn *txn, int encrypt, i
                       "id2entry_add_ext", "(dncache) ( %lu, \"%s\" )\n",
                       (u_long)e->ep_id, slapi_entry_get_dn_const(entry_to_use));
 
-        data.dptr = slapi_entry2str_with_options(entry_to_use, &len, options);
+        if (NULL == txn || NULL == txn->back_special_handling_fn) {
+            id2values_detached *detached = NULL;
+
+            /* the very large attributes are written apart */
+            rc = id2values_store(be, e->ep_id, entry_to_use, txn, &detached);
+            if (0 == rc) {
+                data.dptr = slapi_entry2str_with_options(entry_to_use, &len, options);
+            }
+            id2values_reattach(entry_to_use, &detached);
+            if (rc) {
+                goto done;
+            }
+        } else {
+            data.dptr = slapi_entry2str_with_options(entry_to_use, &len, options);
+        }
         data.dsize = len + 1;
     }
 
@@ -250,6 +264,9 @@ id2entry_delete(backend *be, struct backentry *e, back_txn *txn)
 
     rc = dblayer_db_op(be, db, db_txn, DBI_OP_DEL, &key, 0);
     dblayer_release_id2entry(be, db);
+    if (0 == rc) {
+        rc = id2values_delete(be, e->ep_id, txn);
+    }
 
     slapi_log_err(SLAPI_LOG_TRACE, "id2entry_delete", "<= %d\n", rc);
     return (rc);
@@ -266,6 +283,7 @@ id2entry(backend *be, ID id, back_txn *txn, int *err)
     struct backentry *e = NULL;
     Slapi_Entry *ee;
     char temp_id[sizeof(ID)];
+    char *merged = NULL;
     uint32_t esize;
 
     slapi_log_err(SLAPI_LOG_TRACE, ID2ENTRY,
@@ -331,6 +349,13 @@ id2entry(backend *be, ID id, back_txn *txn, int *err)
     plugin_call_entryfetch_plugins((char **)&data.dptr, &esize);
     data.dsize = esize;
 
+    /* add the values stored out of the entry */
+    merged = id2values_merge(be, id, (const char *)data.dptr, txn, err);
+    if (*err) {
+        /* an entry missing its values must not reach the cache */
+        goto bail;
+    }
+    char *estr = merged ? merged : (char *)data.dptr;
     char *rdn = NULL;
     int rc = 0;
 
@@ -338,7 +363,7 @@ id2entry(backend *be, ID id, back_txn *txn, int *err)
     rc = get_value_from_string((const char *)data.dptr, "rdn", &rdn);
     if (rc) {
         /* data.dptr may not include rdn: ..., try "dn: ..." */
-        ee = slapi_str2entry(data.dptr, SLAPI_STR2ENTRY_NO_ENTRYDN);
+        ee = slapi_str2entry(estr, SLAPI_STR2ENTRY_NO_ENTRYDN);
     } else {
         char *normdn = NULL;
         Slapi_RDN *srdn = NULL;
@@ -386,7 +411,7 @@ id2entry(backend *be, ID id, back_txn *txn, int *err)
                               normdn, id);
             }
         }
-        ee = slapi_str2entry_ext((const char *)normdn, (const Slapi_RDN *)srdn, data.dptr,
+        ee = slapi_str2entry_ext((const char *)normdn, (const Slapi_RDN *)srdn, estr,
                                  SLAPI_STR2ENTRY_NO_ENTRYDN);
         slapi_ch_free_string(&rdn);
         slapi_ch_free_string(&normdn);
@@ -464,6 +489,7 @@ id2entry(backend *be, ID id, back_txn *txn, int *err)
     }
 
 bail:
+    slapi_ch_free_string(&merged);
     dblayer_value_free(be, &data);
     dblayer_release_id2entry(be, db);
 
@@ -0,0 +1,674 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+/*
+ * id2values.c - out of line storage of the very large attributes
+ *
+ * With nsslapd-outofline-values-threshold > 0, the attributes of an entry
+ * having more values than the threshold (typically the member attribute of
+ * the large groups) are not written in the id2entry record but in the
+ * id2values database, one record per value:
+ *
+ *     <entry id><attribute type>\0             the attribute header
+ *     <entry id><attribute type>\0<digest>     one value
+ *
+ * The digest is the SHA-256 (truncated) of the normalized value, the data
+ * of a value record is its line in the entry2str format, with its CSNs.
+ * When the entry is written again, the records of the values that did not
+ * change are kept as is: adding a member to a group of 300k members writes
+ * one record plus the (then small) id2entry record instead of the whole
+ * group.
+ *
+ * The records are appended to the id2entry record when it is read (id2entry,
+ * export, reindex), so the rest of the backend and the entry cache still
+ * see the full entries.
+ *
+ * An attribute goes back in the entry when it has less than half the
+ * threshold values, when the threshold is set to 0, and while it has an
+ * attribute deletion CSN. The operational and the encrypted attributes are
+ * never stored out of line.
+ *
+ * id2values is only created when the threshold is set, and it is only read
+ * or written while inst_id2values_active is set: when the instance starts
+ * with a threshold or with records in id2values, or when the threshold is
+ * set while running. So the backends not using the feature do not pay for
+ * it on their reads, writes and deletes.
+ */
+
+#include "back-ldbm.h"
+#include <pk11func.h>
+
+#define ID2VALUES_DIGESTLEN 16
+#define ID2VALUES_HASHLEN 8
+#define ID2VALUES_DUMP_OPTIONS SLAPI_DUMP_STATEINFO
+
+/* A value record, either read from the db or built from the entry */
+typedef struct id2values_rec
+{
+    unsigned char digest[ID2VALUES_DIGESTLEN];
+    unsigned char hash[ID2VALUES_HASHLEN]; /* of the data */
+    char *line;                            /* new records only */
+    size_t len;
+} id2values_rec;
+
+typedef struct id2values_recs
+{
+    id2values_rec *recs;
+    size_t count;
+    size_t capacity;
+} id2values_recs;
+
+/* An attribute stored out of line, and its value records */
+typedef struct id2values_stored
+{
+    char *type;
+    id2values_recs values;
+    int handled;
+} id2values_stored;
+
+typedef struct id2values_scan
+{
+    char prefix[sizeof(ID)];
+    id2values_stored *attrs;
+    size_t count;
+    size_t capacity;
+    /* merge: the value lines */
+    char *buf;
+    size_t len;
+    size_t size;
+    int rc;
+} id2values_scan;
+
+struct id2values_detached
+{
+    Slapi_Attr **attrs; /* the attributes removed from the entry */
+    Slapi_Attr **prevs; /* and the attributes they followed */
+    size_t count;
+};
+
+static int
+id2values_hash(const void *buf, size_t len, unsigned char *out, size_t outlen)
+{
+    unsigned char sha[SHA256_LENGTH];
+
+    if (PK11_HashBuf(SEC_OID_SHA256, sha, (unsigned char *)buf, len) != SECSuccess) {
+        return -1;
+    }
+    memcpy(out, sha, outlen);
+    return 0;
+}
+
+/* The digest of the normalized value (the raw one for the binary values) */
+static int
+id2values_value_digest(const Slapi_Attr *a, const Slapi_Value *v, unsigned char *digest)
+{
+    const struct berval *bv = slapi_value_get_berval(v);
+    char *val = NULL;
+    char *norm = NULL;
+    int rc;
+
+    if (bv->bv_len == 0 || memchr(bv->bv_val, '\0', bv->bv_len)) {
+        return id2values_hash(bv->bv_val, bv->bv_len, digest, ID2VALUES_DIGESTLEN);
+    }
+    val = slapi_ch_malloc(bv->bv_len + 1);
+    memcpy(val, bv->bv_val, bv->bv_len);
+    val[bv->bv_len] = '\0';
+    slapi_attr_value_normalize_ext(NULL, a, NULL, val, 1, &norm, LDAP_FILTER_EQUALITY);
+    if (norm) {
+        rc = id2values_hash(norm, strlen(norm), digest, ID2VALUES_DIGESTLEN);
+        slapi_ch_free_string(&norm);
+    } else {
+        rc = id2values_hash(val, strlen(val), digest, ID2VALUES_DIGESTLEN);
+    }
+    slapi_ch_free_string(&val);
+    return rc;
+}
+
+static char *
+id2values_lower_type(const char *type)
+{
+    char *ltype = slapi_ch_strdup(type);
+
+    for (char *p = ltype; *p; p++) {
+        *p = TOLOWER(*p);
+    }
+    return ltype;
+}
+
+/* <id><type>\0[<digest>], the caller frees it */
+static char *
+id2values_key(const char *prefix, const char *type, const unsigned char *digest, size_t *len)
+{
+    size_t typelen = strlen(type) + 1;
+    char *key = slapi_ch_malloc(sizeof(ID) + typelen + ID2VALUES_DIGESTLEN);
+
+    memcpy(key, prefix, sizeof(ID));
+    memcpy(key + sizeof(ID), type, typelen);
+    *len = sizeof(ID) + typelen;
+    if (digest) {
+        memcpy(key + *len, digest, ID2VALUES_DIGESTLEN);
+        *len += ID2VALUES_DIGESTLEN;
+    }
+    return key;
+}
+
+static id2values_rec *
+id2values_recs_add(id2values_recs *recs)
+{
+    if (recs->count == recs->capacity) {
+        recs->capacity = recs->capacity ? recs->capacity * 2 : 64;
+        recs->recs = (id2values_rec *)slapi_ch_realloc((char *)recs->recs, recs->capacity * sizeof(id2values_rec));
+    }
+    memset(&recs->recs[recs->count], 0, sizeof(id2values_rec));
+    return &recs->recs[recs->count++];
+}
+
+static void
+id2values_recs_done(id2values_recs *recs)
+{
+    for (size_t i = 0; i < recs->count; i++) {
+        slapi_ch_free_string(&recs->recs[i].line);
+    }
+    slapi_ch_free((void **)&recs->recs);
+    recs->count = recs->capacity = 0;
+}
+
+static void
+id2values_scan_done(id2values_scan *scan)
+{
+    for (size_t i = 0; i < scan->count; i++) {
+        slapi_ch_free_string(&scan->attrs[i].type);
+        id2values_recs_done(&scan->attrs[i].values);
+    }
+    slapi_ch_free((void **)&scan->attrs);
+    slapi_ch_free_string(&scan->buf);
+    scan->count = scan->capacity = 0;
+}
+
+/*
+ * Splits a key of the entry: returns the type, and the digest or NULL for
+ * the attribute header. Returns NULL if the key is not a key of the entry.
+ */
+static const char *
+id2values_parse_key(id2values_scan *scan, dbi_val_t *key, const unsigned char **digest)
+{
+    const char *k = (const char *)key->data;
+    const char *end = NULL;
+    size_t rest;
+
+    if (k == NULL || key->size <= sizeof(ID) || memcmp(k, scan->prefix, sizeof(ID)) != 0) {
+        return NULL;
+    }
+    if ((end = memchr(k + sizeof(ID), '\0', key->size - sizeof(ID))) == NULL) {
+        return NULL;
+    }
+    rest = key->size - (end + 1 - k);
+    if (rest == 0) {
+        *digest = NULL;
+    } else if (rest == ID2VALUES_DIGESTLEN) {
+        *digest = (const unsigned char *)(end + 1);
+    } else {
+        return NULL;
+    }
+    return k + sizeof(ID);
+}
+
+/* Collects the attributes of the entry and the digests of their values */
+static int
+id2values_read_cb(dbi_val_t *key, dbi_val_t *data, void *ctx)
+{
+    id2values_scan *scan = ctx;
+    const unsigned char *digest = NULL;
+    const char *type = id2values_parse_key(scan, key, &digest);
+    id2values_stored *attr = NULL;
+    id2values_rec *rec = NULL;
+
+    if (type == NULL) {
+        /* past the records of the entry */
+        return DBI_RC_NOTFOUND;
+    }
+    if (digest == NULL) {
+        if (scan->count == scan->capacity) {
+            scan->capacity = scan->capacity ? scan->capacity * 2 : 4;
+            scan->attrs = (id2values_stored *)slapi_ch_realloc((char *)scan->attrs, scan->capacity * sizeof(id2values_stored));
+        }
+        attr = &scan->attrs[scan->count++];
+        memset(attr, 0, sizeof(*attr));
+        attr->type = slapi_ch_strdup(type);
+        return DBI_RC_SUCCESS;
+    }
+    attr = scan->count ? &scan->attrs[scan->count - 1] : NULL;
+    if (attr == NULL || strcmp(attr->type, type) != 0) {
+        /* a value without header: it will be deleted with the other ones
+         * of the entry, if the entry is deleted */
+        return DBI_RC_SUCCESS;
+    }
+    rec = id2values_recs_add(&attr->values);
+    memcpy(rec->digest, digest, ID2VALUES_DIGESTLEN);
+    if (id2values_hash(data->data, data->size, rec->hash, ID2VALUES_HASHLEN)) {
+        scan->rc = -1;
+        return DBI_RC_NOTFOUND;
+    }
+    return DBI_RC_SUCCESS;
+}
+
+/* Appends the value lines of the entry */
+static int
+id2values_merge_cb(dbi_val_t *key, dbi_val_t *data, void *ctx)
+{
+    id2values_scan *scan = ctx;
+    const unsigned char *digest = NULL;
+
+    if (id2values_parse_key(scan, key, &digest) == NULL) {
+        return DBI_RC_NOTFOUND;
+    }
+    if (digest == NULL || data->size == 0) {
+        return DBI_RC_SUCCESS;
+    }
+    if (scan->len + data->size + 1 > scan->size) {
+        scan->size = (scan->len + data->size + 1) * 2;
+        scan->buf = slapi_ch_realloc(scan->buf, scan->size);
+    }
+    memcpy(scan->buf + scan->len, data->data, data->size);
+    scan->len += data->size;
+    return DBI_RC_SUCCESS;
+}
+
+static int
+id2values_iterate(backend *be, dbi_db_t *db, dbi_txn_t *db_txn, dbi_iterate_cb_t *cb, id2values_scan *scan)
+{
+    dbi_cursor_t cursor = {0};
+    dbi_val_t startkey = {0};
+    int rc;
+
+    rc = dblayer_new_cursor(be, db, db_txn, &cursor);
+    if (rc) {
+        return rc;
+    }
+    dblayer_value_set_buffer(be, &startkey, scan->prefix, sizeof(ID));
+    rc = dblayer_cursor_iterate(&cursor, cb, &startkey, scan);
+    if (rc == DBI_RC_NOTFOUND) {
+        rc = 0;
+    }
+    dblayer_cursor_op(&cursor, DBI_OP_CLOSE, NULL, NULL);
+    return rc ? rc : scan->rc;
+}
+
+static int
+id2values_put(backend *be, dbi_db_t *db, dbi_txn_t *db_txn, const char *prefix, const char *type, const unsigned char *digest, void *line, size_t len)
+{
+    dbi_val_t key = {0};
+    dbi_val_t data = {0};
+    size_t keylen = 0;
+    char *k = id2values_key(prefix, type, digest, &keylen);
+    int rc;
+
+    dblayer_value_set_buffer(be, &key, k, keylen);
+    dblayer_value_set_buffer(be, &data, line, len);
+    rc = dblayer_db_op(be, db, db_txn, DBI_OP_PUT, &key, &data);
+    slapi_ch_free_string(&k);
+    return rc;
+}
+
+static int
+id2values_del(backend *be, dbi_db_t *db, dbi_txn_t *db_txn, const char *prefix, const char *type, const unsigned char *digest)
+{
+    dbi_val_t key = {0};
+    size_t keylen = 0;
+    char *k = id2values_key(prefix, type, digest, &keylen);
+    int rc;
+
+    dblayer_value_set_buffer(be, &key, k, keylen);
+    rc = dblayer_db_op(be, db, db_txn, DBI_OP_DEL, &key, NULL);
+    slapi_ch_free_string(&k);
+    return (rc == DBI_RC_NOTFOUND) ? 0 : rc;
+}
+
+/* Removes an attribute and all its values */
+static int
+id2values_del_attr(backend *be, dbi_db_t *db, dbi_txn_t *db_txn, const char *prefix, id2values_stored *attr)
+{
+    int rc = 0;
+
+    for (size_t i = 0; rc == 0 && i < attr->values.count; i++) {
+        rc = id2values_del(be, db, db_txn, prefix, attr->type, attr->values.recs[i].digest);
+    }
+    if (rc == 0) {
+        rc = id2values_del(be, db, db_txn, prefix, attr->type, NULL);
+    }
+    return rc;
+}
+
+static int
+id2values_rec_cmp(const void *a, const void *b)
+{
+    return memcmp(((const id2values_rec *)a)->digest, ((const id2values_rec *)b)->digest, ID2VALUES_DIGESTLEN);
+}
+
+static int
+id2values_eligible(backend *be, Slapi_Attr *a, int threshold, int stored)
+{
+    struct attrinfo *ai = NULL;
+    int count;
+
+    if (threshold <= 0 || a->a_deletioncsn ||
+        slapi_attr_flag_is_set(a, SLAPI_ATTR_FLAG_OPATTR) || is_type_protected(a->a_type)) {
+        return 0;
+    }
+    count = slapi_valueset_count(&a->a_present_values) + slapi_valueset_count(&a->a_deleted_values);
+    /* keep an attribute out of line until it really shrank */
+    if (count <= (stored ? threshold / 2 : threshold)) {
+        return 0;
+    }
+    ainfo_get(be, a->a_type, &ai);
+    if (ai && ai->ai_attrcrypt) {
+        return 0;
+    }
+    return 1;
+}
+
+/* Builds the sorted records of the values of an attribute, -1 if two values have the same digest */
+static int
+id2values_build(Slapi_Attr *a, id2values_recs *recs)
+{
+    Slapi_ValueSet *vs[2] = {&a->a_present_values, &a->a_deleted_values};
+
+    for (size_t s = 0; s < 2; s++) {
+        Slapi_Value **va = valueset_get_valuearray(vs[s]);
+        for (size_t i = 0; va && va[i]; i++) {
+            id2values_rec *rec = id2values_recs_add(recs);
+            rec->line = entry_value2str(a->a_type, va[i], s == 1, ID2VALUES_DUMP_OPTIONS, &rec->len);
+            if (rec->line == NULL ||
+                id2values_value_digest(a, va[i], rec->digest) ||
+                id2values_hash(rec->line, rec->len, rec->hash, ID2VALUES_HASHLEN)) {
+                return -1;
+            }
+        }
+    }
+    qsort(recs->recs, recs->count, sizeof(id2values_rec), id2values_rec_cmp);
+    for (size_t i = 1; i < recs->count; i++) {
+        if (id2values_rec_cmp(&recs->recs[i - 1], &recs->recs[i]) == 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Writes the differences between the new and the stored values */
+static int
+id2values_write_attr(backend *be, dbi_db_t *db, dbi_txn_t *db_txn, const char *prefix, const char *type, id2values_recs *recs, id2values_stored *stored)
+{
+    static char header[] = "";
+    id2values_rec *old = stored ? stored->values.recs : NULL;
+    size_t nold = stored ? stored->values.count : 0;
+    size_t i = 0, j = 0;
+    int rc = 0;
+
+    if (stored == NULL) {
+        rc = id2values_put(be, db, db_txn, prefix, type, NULL, header, 0);
+    }
+    while (rc == 0 && (i < recs->count || j < nold)) {
+        int cmp = (i == recs->count) ? 1 : (j == nold) ? -1 : id2values_rec_cmp(&recs->recs[i], &old[j]);
+        if (cmp < 0) {
+            rc = id2values_put(be, db, db_txn, prefix, type, recs->recs[i].digest, recs->recs[i].line, recs->recs[i].len);
+            i++;
+        } else if (cmp > 0) {
+            rc = id2values_del(be, db, db_txn, prefix, type, old[j].digest);
+            j++;
+        } else {
+            /* same value, its CSNs may have changed */
+            if (memcmp(recs->recs[i].hash, old[j].hash, ID2VALUES_HASHLEN) != 0) {
+                rc = id2values_put(be, db, db_txn, prefix, type, recs->recs[i].digest, recs->recs[i].line, recs->recs[i].len);
+            }
+            i++;
+            j++;
+        }
+    }
+    return rc;
+}
+
+static void
+id2values_detach(Slapi_Entry *e, Slapi_Attr **link, Slapi_Attr *prev, id2values_detached **detached)
+{
+    id2values_detached *d = *detached;
+    Slapi_Attr *a = *link;
+
+    if (d == NULL) {
+        d = *detached = (id2values_detached *)slapi_ch_calloc(1, sizeof(id2values_detached));
+    }
+    d->attrs = (Slapi_Attr **)slapi_ch_realloc((char *)d->attrs, (d->count + 1) * sizeof(Slapi_Attr *));
+    d->prevs = (Slapi_Attr **)slapi_ch_realloc((char *)d->prevs, (d->count + 1) * sizeof(Slapi_Attr *));
+    d->attrs[d->count] = a;
+    d->prevs[d->count] = prev;
+    d->count++;
+    *link = a->a_next;
+    a->a_next = NULL;
+    PR_ASSERT(prev == NULL || prev->a_next == *link);
+    PR_ASSERT(prev != NULL || e->e_attrs == *link);
+}
+
+static int
+id2values_active(ldbm_instance *inst)
+{
+    return slapi_atomic_load_32(&inst->inst_id2values_active, __ATOMIC_ACQUIRE);
+}
+
+/* Called when the threshold is set while running */
+void
+id2values_activate(ldbm_instance *inst)
+{
+    slapi_atomic_store_32(&inst->inst_id2values_active, 1, __ATOMIC_RELEASE);
+}
+
+/* Called when the instance is started: is there something to look for? */
+void
+id2values_instance_start(backend *be)
+{
+    ldbm_instance *inst = (ldbm_instance *)be->be_instance_info;
+    dbi_cursor_t cursor = {0};
+    dbi_val_t key = {0};
+    dbi_val_t data = {0};
+    dbi_db_t *db = NULL;
+    int active = 0;
+
+    if (inst->inst_outofline_threshold > 0) {
+        active = 1;
+    } else if (dblayer_get_id2values(be, &db, 0) == 0 &&
+               dblayer_new_cursor(be, db, NULL, &cursor) == 0) {
+        dblayer_value_init(be, &key);
+        dblayer_value_init(be, &data);
+        active = (dblayer_cursor_op(&cursor, DBI_OP_MOVE_TO_FIRST, &key, &data) == 0);
+        dblayer_cursor_op(&cursor, DBI_OP_CLOSE, NULL, NULL);
+        dblayer_value_free(be, &key);
+        dblayer_value_free(be, &data);
+    }
+    slapi_atomic_store_32(&inst->inst_id2values_active, active, __ATOMIC_RELEASE);
+}
+
+/*
+ * Stores the large attributes of the entry in id2values and removes them
+ * from the entry, so that entry2str does not write them in id2entry. The
+ * caller must put them back with id2values_reattach, even on error.
+ */
+int
+id2values_store(backend *be, ID id, Slapi_Entry *e, back_txn *txn, id2values_detached **detached)
+{
+    ldbm_instance *inst = (ldbm_instance *)be->be_instance_info;
+    int threshold = inst->inst_outofline_threshold;
+    dbi_txn_t *db_txn = txn ? txn->back_txn_txn : NULL;
+    id2values_scan scan = {0};
+    dbi_db_t *db = NULL;
+    Slapi_Attr **link = NULL;
+    Slapi_Attr *prev = NULL;
+    int rc;
+
+    *detached = NULL;
+    if (!id2values_active(inst)) {
+        return 0;
+    }
+    if ((rc = dblayer_get_id2values(be, &db, threshold > 0 ? DBOPEN_CREATE : 0)) != 0) {
+        if (threshold <= 0) {
+            /* never used */
+            return 0;
+        }
+        slapi_log_err(SLAPI_LOG_ERR, "id2values_store", "Could not open/create " ID2VALUES "\n");
+        return -1;
+    }
+    id_internal_to_stored(id, scan.prefix);
+    if ((rc = id2values_iterate(be, db, db_txn, id2values_read_cb, &scan)) != 0) {
+        goto done;
+    }
+    if (threshold <= 0 && scan.count == 0) {
+        goto done;
+    }
+
+    for (link = &e->e_attrs; rc == 0 && *link;) {
+        Slapi_Attr *a = *link;
+        char *type = id2values_lower_type(a->a_type);
+        id2values_stored *stored = NULL;
+        id2values_recs recs = {0};
+
+        for (size_t i = 0; i < scan.count; i++) {
+            if (strcmp(scan.attrs[i].type, type) == 0) {
+                stored = &scan.attrs[i];
+                break;
+            }
+        }
+        if (id2values_eligible(be, a, threshold, stored != NULL) && id2values_build(a, &recs) == 0) {
+            rc = id2values_write_attr(be, db, db_txn, scan.prefix, type, &recs, stored);
+            if (stored) {
+                stored->handled = 1;
+            }
+            id2values_detach(e, link, prev, detached);
+        } else {
+            prev = a;
+            link = &a->a_next;
+        }
+        id2values_recs_done(&recs);
+        slapi_ch_free_string(&type);
+    }
+
+    /* the attributes that are back in the entry, or gone */
+    for (size_t i = 0; rc == 0 && i < scan.count; i++) {
+        if (!scan.attrs[i].handled) {
+            rc = id2values_del_attr(be, db, db_txn, scan.prefix, &scan.attrs[i]);
+        }
+    }
+
+done:
+    if (rc && rc != DBI_RC_RETRY) {
+        slapi_log_err(SLAPI_LOG_ERR, "id2values_store",
+                      "Failed to store the values of entry %lu, error %d\n", (u_long)id, rc);
+    }
+    id2values_scan_done(&scan);
+    return rc;
+}
+
+/* Puts back the attributes removed by id2values_store, in their order */
+void
+id2values_reattach(Slapi_Entry *e, id2values_detached **detached)
+{
+    id2values_detached *d = *detached;
+
+    if (d == NULL) {
+        return;
+    }
+    for (size_t i = d->count; i-- > 0;) {
+        Slapi_Attr *a = d->attrs[i];
+        Slapi_Attr *prev = d->prevs[i];
+
+        if (prev) {
+            a->a_next = prev->a_next;
+            prev->a_next = a;
+        } else {
+            a->a_next = e->e_attrs;
+            e->e_attrs = a;
+        }
+    }
+    slapi_ch_free((void **)&d->attrs);
+    slapi_ch_free((void **)&d->prevs);
+    slapi_ch_free((void **)detached);
+}
+
+/* Removes the values of a deleted entry */
+int
+id2values_delete(backend *be, ID id, back_txn *txn)
+{
+    dbi_txn_t *db_txn = txn ? txn->back_txn_txn : NULL;
+    id2values_scan scan = {0};
+    dbi_db_t *db = NULL;
+    int rc;
+
+    if (!id2values_active((ldbm_instance *)be->be_instance_info) ||
+        dblayer_get_id2values(be, &db, 0) != 0) {
+        return 0;
+    }
+    id_internal_to_stored(id, scan.prefix);
+    rc = id2values_iterate(be, db, db_txn, id2values_read_cb, &scan);
+    for (size_t i = 0; rc == 0 && i < scan.count; i++) {
+        rc = id2values_del_attr(be, db, db_txn, scan.prefix, &scan.attrs[i]);
+    }
+    id2values_scan_done(&scan);
+    return rc;
+}
+
+/*
+ * Returns the id2entry record of an entry completed with its out of line
+ * values, or NULL if it has none. *err is set when they could not be read:
+ * the record alone is then not the whole entry. The caller frees the
+ * returned string.
+ */
+char *
+id2values_merge(backend *be, ID id, const char *entrystr, back_txn *txn, int *err)
+{
+    struct ldbminfo *li = (struct ldbminfo *)be->be_database->plg_private;
+    id2values_scan scan = {0};
+    dbi_db_t *db = NULL;
+    back_txn s_txn;
+    char *merged = NULL;
+    size_t elen;
+    int rc;
+
+    *err = 0;
+    if (entrystr == NULL || !id2values_active((ldbm_instance *)be->be_instance_info) ||
+        dblayer_get_id2values(be, &db, 0) != 0) {
+        return NULL;
+    }
+    id_internal_to_stored(id, scan.prefix);
+
+    dblayer_txn_init(li, &s_txn);
+    if (txn) {
+        dblayer_read_txn_begin(be, txn->back_txn_txn, &s_txn);
+    }
+    rc = id2values_iterate(be, db, s_txn.back_txn_txn, id2values_merge_cb, &scan);
+    if (rc) {
+        dblayer_read_txn_abort(be, &s_txn);
+    } else {
+        dblayer_read_txn_commit(be, &s_txn);
+    }
+    if (rc) {
+        slapi_log_err(SLAPI_LOG_ERR, "id2values_merge",
+                      "Failed to read the values of entry %lu, error %d\n", (u_long)id, rc);
+        *err = rc;
+    } else if (scan.len) {
+        elen = strlen(entrystr);
+        merged = slapi_ch_malloc(elen + scan.len + 2);
+        memcpy(merged, entrystr, elen);
+        if (elen && merged[elen - 1] != '\n') {
+            merged[elen++] = '\n';
+        }
+        memcpy(merged + elen, scan.buf, scan.len);
+        merged[elen + scan.len] = '\0';
+    }
+    id2values_scan_done(&scan);
+    return merged;
+}
@@ -245,6 +245,19 @@ idl_set_intersection_shortcut(IDListSet *idl_set)
     return 0;
 }
 
+/*
+ * Number of IDs of the smallest idl in the set
+ * (0 if the set does not contain any idl, allids ones excepted)
+ */
+size_t
+idl_set_minimum_nids(IDListSet *idl_set)
+{
+    if (idl_set->minimum == NULL) {
+        return 0;
+    }
+    return idl_set->minimum->b_nids;
+}
+
 IDList *
 idl_set_union(IDListSet *idl_set, backend *be)
 {
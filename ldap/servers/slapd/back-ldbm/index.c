@@ -1093,6 +1093,8 @@ index_read_ext_allids(
         ldbm_nasty("index_read_ext_allids", "index_read retry count exceeded", 1046, *err);
     } else if (*err != 0 && *err != DBI_RC_NOTFOUND) {
         ldbm_nasty("index_read_ext_allids", errmsg, 1050, *err);
+    } else {
+        index_stats_note_read(ai, &key, idl);
     }
     slapi_ch_free_string(&basetmp);
     dblayer_value_free(be, &key);
@@ -1113,6 +1115,66 @@ index_read_ext_allids(
     return (idl);
 }
 
+/*
+ * Estimate the number of IDs index_read_ext_allids would return, without
+ * reading the index (see index_stats.c)
+ * *known is set if the estimate comes from the key itself (or if the
+ * attribute is not indexed: INDEX_STATS_UNINDEXED_COST), else the estimate
+ * is the typical size of the keys of that index.
+ * Returns INDEX_STATS_UNKNOWN if there is no statistics at all.
+ */
+uint64_t
+index_read_estimate(backend *be, char *type, const char *indextype, const struct berval *val, int *known)
+{
+    struct ldbminfo *li = (struct ldbminfo *)be->be_database->plg_private;
+    char typebuf[SLAPD_TYPICAL_ATTRIBUTE_NAME_MAX_LENGTH];
+    char *basetmp, *basetype;
+    struct attrinfo *ai = NULL;
+    uint64_t estimate = INDEX_STATS_UNKNOWN;
+
+    *known = 0;
+    basetype = typebuf;
+    if ((basetmp = slapi_attr_basetype(type, typebuf, sizeof(typebuf))) != NULL) {
+        basetype = basetmp;
+    }
+    ainfo_get(be, basetype, &ai);
+    if (ai == NULL) {
+        slapi_ch_free_string(&basetmp);
+        return INDEX_STATS_UNKNOWN;
+    }
+
+    if (indextype == indextype_EQUALITY && 0 == PL_strcasecmp(basetype, LDBM_ENTRYDN_STR)) {
+        /* entryrdn index is used */
+        *known = 1;
+        estimate = 1;
+    } else if (!is_indexed(indextype, ai->ai_indexmask, ai->ai_index_rules)) {
+        *known = 1;
+        estimate = INDEX_STATS_UNINDEXED_COST;
+    } else if (val == NULL || (val->bv_len < li->li_max_key_len && ai->ai_attrcrypt == NULL)) {
+        /* Build the key as index_read_ext_allids does (no hashed nor encrypted keys) */
+        char *prefix = index_index2prefix(indextype);
+        dbi_val_t key = {0};
+        char buf[BUFSIZ];
+
+        if (val != NULL) {
+            dblayer_value_concat(be, &key, buf, sizeof(buf),
+                prefix, strlen(prefix), val->bv_val, val->bv_len, "", 1);
+        } else {
+            dblayer_value_concat(be, &key, buf, sizeof(buf), prefix, strlen(prefix),
+                "", 1, NULL, 0);
+        }
+        estimate = index_stats_key_estimate(ai, &key);
+        *known = (estimate != INDEX_STATS_UNKNOWN);
+        dblayer_value_free(be, &key);
+        index_free_prefix(prefix);
+    }
+    if (estimate == INDEX_STATS_UNKNOWN) {
+        estimate = index_stats_type_estimate(ai, indextype);
+    }
+    slapi_ch_free_string(&basetmp);
+    return estimate;
+}
+
 IDList *
 index_read_ext(
     backend *be,
@@ -1881,6 +1943,8 @@ addordel_values_sv(
 
         if (rc != 0) {
             ldbm_nasty(NASTY_MSG("addordel_values_sv"), index_id, 1120, rc);
+        } else {
+            index_stats_note_write(a, &key, (flags & BE_INDEX_ADD) ? 1 : -1);
         }
         dblayer_value_free(be, &key);
         index_free_prefix(prefix);
@@ -1981,6 +2045,7 @@ addordel_values_sv(
             ldbm_nasty(NASTY_MSG("addordel_values_sv"), index_id, 1130, rc);
             break;
         }
+        index_stats_note_write(a, &key, (flags & BE_INDEX_ADD) ? 1 : -1);
         if (NULL != key.dptr && realbuf != key.dptr) { /* realloc'ed */
             tmpbuf = key.dptr;
             tmpbuflen = key.size;
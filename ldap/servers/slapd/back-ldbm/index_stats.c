@@ -0,0 +1,258 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+/*
+ * Index key cardinality statistics
+ *
+ * Each attrinfo keeps a small sample of index keys with the number of IDs
+ * they had when they were last read, and a log2 histogram of the IDL sizes
+ * read from each index type. The sample is fed by the index reads and kept
+ * up to date by the index writes (add/delete of an ID for a sampled key).
+ *
+ * The filter planner (filterindex.c) uses these statistics to evaluate the
+ * most selective components of an AND filter first.
+ *
+ * The statistics are only estimates: updates are done without lock (a
+ * sample slot is a single 64 bits word holding the key hash and the ID
+ * count) and a sampled key may be evicted by another key having the same
+ * slot. Nothing is persisted: the statistics are rebuilt from the first
+ * index lookups after a restart.
+ */
+
+#include "back-ldbm.h"
+
+#define INDEX_STATS_SAMPLES    256                 /* sampled keys per attribute */
+#define INDEX_STATS_BUCKETS    33                  /* log2 histogram of the IDL sizes */
+#define INDEX_STATS_NIDS_MASK  0xffffffffULL
+#define INDEX_STATS_ALLIDS     0xffffffffULL       /* key is allids */
+
+/* index types having their own histogram */
+typedef enum {
+    INDEX_STATS_EQ = 0,
+    INDEX_STATS_PRES,
+    INDEX_STATS_SUB,
+    INDEX_STATS_APPROX,
+    INDEX_STATS_RULE,
+    INDEX_STATS_NBTYPES
+} index_stats_type_t;
+
+typedef struct {
+    uint64_t nreads;                          /* number of index reads */
+    uint64_t histogram[INDEX_STATS_BUCKETS];  /* reads per log2(nids) */
+} index_stats_hist;
+
+struct index_stats_private
+{
+    uint64_t samples[INDEX_STATS_SAMPLES];    /* hash << 32 | nids (0 if unused) */
+    index_stats_hist hist[INDEX_STATS_NBTYPES];
+};
+
+static index_stats_type_t
+index_stats_type_from_key(const dbi_val_t *key)
+{
+    switch (key->size ? *(char *)key->data : '\0') {
+    case '=':
+        return INDEX_STATS_EQ;
+    case '+':
+        return INDEX_STATS_PRES;
+    case '*':
+        return INDEX_STATS_SUB;
+    case '~':
+        return INDEX_STATS_APPROX;
+    default:
+        return INDEX_STATS_RULE;
+    }
+}
+
+static index_stats_type_t
+index_stats_type_from_indextype(const char *indextype)
+{
+    if (indextype == indextype_EQUALITY) {
+        return INDEX_STATS_EQ;
+    } else if (indextype == indextype_PRESENCE) {
+        return INDEX_STATS_PRES;
+    } else if (indextype == indextype_SUB) {
+        return INDEX_STATS_SUB;
+    } else if (indextype == indextype_APPROX) {
+        return INDEX_STATS_APPROX;
+    }
+    return INDEX_STATS_RULE;
+}
+
+/* FNV-1a hash of the key, never 0 so that 0 marks an unused slot */
+static uint32_t
+index_stats_hash(const dbi_val_t *key)
+{
+    const unsigned char *p = key->data;
+    uint32_t h = 2166136261U;
+
+    for (size_t i = 0; i < key->size; i++) {
+        h ^= p[i];
+        h *= 16777619U;
+    }
+    return h ? h : 1;
+}
+
+static uint64_t *
+index_stats_slot(index_stats_private *stats, uint32_t hash)
+{
+    return &stats->samples[hash % INDEX_STATS_SAMPLES];
+}
+
+void
+index_stats_init(struct attrinfo *ai)
+{
+    if (ai->ai_stats == NULL) {
+        ai->ai_stats = (index_stats_private *)slapi_ch_calloc(1, sizeof(index_stats_private));
+    }
+}
+
+void
+index_stats_free(struct attrinfo *ai)
+{
+    slapi_ch_free((void **)&ai->ai_stats);
+}
+
+/* Record the size of an IDL read from the index */
+void
+index_stats_note_read(struct attrinfo *ai, const dbi_val_t *key, IDList *idl)
+{
+    index_stats_private *stats = ai->ai_stats;
+    index_stats_hist *hist = NULL;
+    uint32_t hash = 0;
+    uint64_t nids = 0;
+    int bucket = 0;
+
+    if (stats == NULL || key == NULL || idl == NULL) {
+        return;
+    }
+    hash = index_stats_hash(key);
+    nids = ALLIDS(idl) ? INDEX_STATS_ALLIDS : (uint64_t)IDL_NIDS(idl);
+    slapi_atomic_store_64(index_stats_slot(stats, hash), ((uint64_t)hash << 32) | nids, __ATOMIC_RELAXED);
+
+    hist = &stats->hist[index_stats_type_from_key(key)];
+    if (nids != INDEX_STATS_ALLIDS) {
+        for (uint64_t n = nids; n > 1 && bucket < INDEX_STATS_BUCKETS - 1; n >>= 1) {
+            bucket++;
+        }
+        slapi_atomic_incr_64(&hist->histogram[bucket], __ATOMIC_RELAXED);
+        slapi_atomic_incr_64(&hist->nreads, __ATOMIC_RELAXED);
+    }
+}
+
+/* An ID has been added (delta > 0) or removed (delta < 0) for the key */
+void
+index_stats_note_write(struct attrinfo *ai, const dbi_val_t *key, int delta)
+{
+    index_stats_private *stats = ai->ai_stats;
+    uint64_t *slot = NULL;
+    uint64_t sample = 0;
+    uint64_t nids = 0;
+    uint32_t hash = 0;
+
+    if (stats == NULL || key == NULL) {
+        return;
+    }
+    hash = index_stats_hash(key);
+    slot = index_stats_slot(stats, hash);
+    sample = slapi_atomic_load_64(slot, __ATOMIC_RELAXED);
+    if ((sample >> 32) != hash) {
+        /* Key is not sampled */
+        return;
+    }
+    nids = sample & INDEX_STATS_NIDS_MASK;
+    if (nids == INDEX_STATS_ALLIDS) {
+        return;
+    }
+    if (delta < 0) {
+        nids = (nids > (uint64_t)-delta) ? nids + delta : 0;
+    } else if (nids + delta < INDEX_STATS_ALLIDS) {
+        nids += delta;
+    }
+    slapi_atomic_store_64(slot, ((uint64_t)hash << 32) | nids, __ATOMIC_RELAXED);
+}
+
+/*
+ * Estimate the number of IDs of an index key.
+ * Returns INDEX_STATS_UNKNOWN if the key is not sampled.
+ */
+uint64_t
+index_stats_key_estimate(struct attrinfo *ai, const dbi_val_t *key)
+{
+    index_stats_private *stats = ai->ai_stats;
+    uint64_t sample = 0;
+    uint32_t hash = 0;
+
+    if (stats == NULL || key == NULL) {
+        return INDEX_STATS_UNKNOWN;
+    }
+    hash = index_stats_hash(key);
+    sample = slapi_atomic_load_64(index_stats_slot(stats, hash), __ATOMIC_RELAXED);
+    if ((sample >> 32) != hash) {
+        return INDEX_STATS_UNKNOWN;
+    }
+    if ((sample & INDEX_STATS_NIDS_MASK) == INDEX_STATS_ALLIDS) {
+        return INDEX_STATS_ALLIDS_COST;
+    }
+    return sample & INDEX_STATS_NIDS_MASK;
+}
+
+/*
+ * Estimate the number of IDs of a key of the given index type
+ * (i.e the median size of the IDLs read so far from that index)
+ * Returns INDEX_STATS_UNKNOWN if the index has not been read yet.
+ */
+uint64_t
+index_stats_type_estimate(struct attrinfo *ai, const char *indextype)
+{
+    index_stats_private *stats = ai->ai_stats;
+    index_stats_hist *hist = NULL;
+    uint64_t nreads = 0;
+    uint64_t count = 0;
+
+    if (stats == NULL) {
+        return INDEX_STATS_UNKNOWN;
+    }
+    hist = &stats->hist[index_stats_type_from_indextype(indextype)];
+    nreads = slapi_atomic_load_64(&hist->nreads, __ATOMIC_RELAXED);
+    if (nreads == 0) {
+        return INDEX_STATS_UNKNOWN;
+    }
+    for (int bucket = 0; bucket < INDEX_STATS_BUCKETS; bucket++) {
+        count += slapi_atomic_load_64(&hist->histogram[bucket], __ATOMIC_RELAXED);
+        if (2 * count >= nreads) {
+            return 1ULL << bucket;
+        }
+    }
+    return 1ULL << (INDEX_STATS_BUCKETS - 1);
+}
+
+/* Forget the statistics of an attribute (i.e when it get reindexed) */
+void
+index_stats_reset(struct attrinfo *ai)
+{
+    index_stats_private *stats = ai->ai_stats;
+
+    if (stats == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < INDEX_STATS_SAMPLES; i++) {
+        slapi_atomic_store_64(&stats->samples[i], 0, __ATOMIC_RELAXED);
+    }
+    for (size_t t = 0; t < INDEX_STATS_NBTYPES; t++) {
+        index_stats_hist *hist = &stats->hist[t];
+        slapi_atomic_store_64(&hist->nreads, 0, __ATOMIC_RELAXED);
+        for (size_t i = 0; i < INDEX_STATS_BUCKETS; i++) {
+            slapi_atomic_store_64(&hist->histogram[i], 0, __ATOMIC_RELAXED);
+        }
+    }
+}
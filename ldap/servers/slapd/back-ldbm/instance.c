@@ -79,6 +79,12 @@ ldbm_instance_create(backend *be, char *name)
         goto error;
     }
 
+    if ((inst->inst_subcount_mutex = PR_NewLock()) == NULL) {
+        slapi_log_err(SLAPI_LOG_ERR, "ldbm_instance_create", "PR_NewLock failed\n");
+        rc = -1;
+        goto error;
+    }
+
     if ((inst->inst_nextid_mutex = PR_NewLock()) == NULL) {
         slapi_log_err(SLAPI_LOG_ERR, "ldbm_instance_create", "PR_NewLock failed\n");
         rc = -1;
@@ -387,6 +393,7 @@ ldbm_instance_destructor(void **arg)
     PR_DestroyMonitor(inst->inst_db_mutex);
     PR_DestroyLock(inst->inst_handle_list_mutex);
     PR_DestroyLock(inst->inst_nextid_mutex);
+    PR_DestroyLock(inst->inst_subcount_mutex);
     PR_DestroyCondVar(inst->inst_indexer_cv);
     attrinfo_deletetree(inst);
     slapi_ch_free((void **)&inst->inst_dataversion);
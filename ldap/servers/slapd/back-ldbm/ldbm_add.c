@@ -79,6 +79,7 @@ ldbm_back_add(Slapi_PBlock *pb)
     Slapi_DN *sdn = NULL;
     Slapi_DN parentsdn = {0};
     Slapi_Operation *operation;
+    struct timespec commit_start;
     int is_replicated_operation = 0;
     int is_resurect_operation = 0;
     int is_cenotaph_operation = 0;
@@ -876,7 +877,7 @@ ldbm_back_add(Slapi_PBlock *pb)
                      */
                     op |= PARENTUPDATE_CREATE_TOMBSTONE;
                 }
-                retval = parent_update_on_childchange(&parent_modify_c, op, NULL);
+                retval = parent_update_on_childchange(be, &parent_modify_c, op, NULL);
                 slapi_log_err(SLAPI_LOG_BACKLDBM, "ldbm_back_add",
                               "conn=%" PRIu64 " op=%d parent_update_on_childchange: old_entry=0x%p, new_entry=0x%p, rc=%d\n",
                               conn_id, op_id, parent_modify_c.old_entry, parent_modify_c.new_entry, retval);
@@ -1246,7 +1247,9 @@ ldbm_back_add(Slapi_PBlock *pb)
     }
 
     /* Release SERIAL LOCK */
+    clock_gettime(CLOCK_MONOTONIC, &commit_start);
     retval = dblayer_txn_commit(be, &txn);
+    latency_record(operation, LATENCY_PHASE_TXN_COMMIT, &commit_start);
     /* after commit - txn is no longer valid - replace SLAPI_TXN with parent */
     slapi_pblock_set(pb, SLAPI_TXN, parent_txn);
     if (0 != retval) {
@@ -35,6 +35,7 @@ struct attrinfo *
 attrinfo_new()
 {
     struct attrinfo *p = (struct attrinfo *)slapi_ch_calloc(1, sizeof(struct attrinfo));
+    index_stats_init(p);
     return p;
 }
 
@@ -56,6 +57,7 @@ attrinfo_delete(struct attrinfo **pp)
         slapi_ch_free((void **)&((*pp)->ai_type));
         charray_free((*pp)->ai_index_rules);
         slapi_ch_free((void **)&((*pp)->ai_attrcrypt));
+        index_stats_free(*pp);
         attr_done(&((*pp)->ai_sattr));
         attrinfo_delete_idlistinfo(&(*pp)->ai_idlistinfo);
         if ((*pp)->ai_dblayer) {
@@ -797,6 +799,12 @@ attr_index_config(
         }
         substrlens[INDEX_SUBSTREND] = substrval;
     }
+    if (slapi_entry_attr_get_bool(e, INDEX_ATTR_SUBSTRPOSITIONAL)) {
+        if (!substrlens) {
+            substrlens = (int *)slapi_ch_calloc(1, sizeof(int) * INDEX_SUBSTRLEN);
+        }
+        substrlens[INDEX_SUBSTRPOS] = INDEX_SUBSTRPOS_INDEX;
+    }
     a->ai_substr_lens = substrlens;
 
     if (0 == slapi_entry_attr_find(e, "nsMatchingRule", &attr)) {
@@ -982,13 +990,58 @@ attr_create_empty(backend *be, char *type, struct attrinfo **ai)
 extern char *hassubordinates;
 extern char *numsubordinates;
 
+/*
+ * When the subordinate counts are kept in memory (see parents.c) the values
+ * stored in the entry may be behind. Returns 0 and the count of e from the
+ * backend in that case, -1 if the stored values apply.
+ */
+static int
+ldbm_compute_subcount(computed_attr_context *c, Slapi_Entry *e, size_t *count)
+{
+    Slapi_PBlock *pb = compute_get_pblock(c);
+    Slapi_Backend *be = NULL;
+    back_search_result_set *sr = NULL;
+    ID id = NOID;
+
+    if (NULL == pb) {
+        return -1;
+    }
+    slapi_pblock_get(pb, SLAPI_BACKEND, &be);
+    if (NULL == be || NULL == be->be_database ||
+        be->be_database->plg_search != ldbm_back_search ||
+        NULL == ((ldbm_instance *)be->be_instance_info)->inst_subcount) {
+        return -1;
+    }
+    /* Usually the entry being returned by the search, otherwise look it up */
+    slapi_pblock_get(pb, SLAPI_SEARCH_RESULT_SET, &sr);
+    if (sr && sr->sr_entry && sr->sr_entry->ep_entry == e) {
+        id = sr->sr_entry->ep_id;
+    } else if (entryrdn_index_read(be, slapi_entry_get_sdn_const(e), &id, NULL)) {
+        return -1;
+    }
+    return parent_subcount_get(be, id, count, NULL);
+}
+
 static int
 ldbm_compute_evaluator(computed_attr_context *c, char *type, Slapi_Entry *e, slapi_compute_output_t outputfn)
 {
     int rc = 0;
+    size_t subcount = 0;
+    char value_buffer[22] = {0}; /* enough digits for 2^64 children */
 
     if (strcasecmp(type, numsubordinates) == 0) {
         Slapi_Attr *read_attr = NULL;
+        if (0 == ldbm_compute_subcount(c, e, &subcount)) {
+            /* The count is kept in memory, zero is returned as well */
+            Slapi_Attr our_attr;
+            slapi_attr_init(&our_attr, numsubordinates);
+            our_attr.a_flags = SLAPI_ATTR_FLAG_OPATTR;
+            sprintf(value_buffer, "%lu", (long unsigned int)subcount);
+            valueset_add_string(&our_attr, &our_attr.a_present_values, value_buffer, CSN_TYPE_UNKNOWN, NULL);
+            rc = (*outputfn)(c, &our_attr, e);
+            attr_done(&our_attr);
+            return (rc);
+        }
         /* Check to see whether this attribute is already present in the entry */
         if (0 != slapi_entry_attr_find(e, numsubordinates, &read_attr)) {
             /* If not, we return it as zero */
@@ -1008,8 +1061,12 @@ ldbm_compute_evaluator(computed_attr_context *c, char *type, Slapi_Entry *e, sla
         our_attr.a_flags = SLAPI_ATTR_FLAG_OPATTR;
         /* This attribute is always computed */
         /* Check to see whether the subordinate count attribute is already present in the entry */
-        rc = slapi_entry_attr_find(e, numsubordinates, &read_attr);
-        if ((0 != rc) || slapi_entry_attr_hasvalue(e, numsubordinates, "0")) {
+        if (0 == ldbm_compute_subcount(c, e, &subcount)) {
+            rc = subcount ? 0 : -1;
+        } else {
+            rc = slapi_entry_attr_find(e, numsubordinates, &read_attr);
+        }
+        if ((0 != rc) || (NULL != read_attr && slapi_entry_attr_hasvalue(e, numsubordinates, "0"))) {
             /* If not, or present and zero, we return FALSE, otherwise TRUE */
             valueset_add_string(&our_attr, &our_attr.a_present_values, "FALSE", CSN_TYPE_UNKNOWN, NULL);
         } else {
@@ -75,6 +75,7 @@ ldbm_back_bind(Slapi_PBlock *pb)
     switch (method) {
     case LDAP_AUTH_SIMPLE: {
         Slapi_Value cv;
+        int32_t result;
         if (slapi_entry_attr_find(e->ep_entry, "userpassword", &attr) != 0) {
             slapi_pblock_set(pb, SLAPI_PB_RESULT_TEXT, "Entry does not have userpassword set");
             slapi_send_ldap_result(pb, LDAP_INVALID_CREDENTIALS, NULL, NULL, 0, NULL);
@@ -84,7 +85,15 @@ ldbm_back_bind(Slapi_PBlock *pb)
         }
         bvals = attr_get_present_values(attr);
         slapi_value_init_berval(&cv, cred);
-        if (slapi_pw_find_sv(bvals, &cv) != 0) {
+        result = bind_crypto_pw_find_sv(bvals, &cv);
+        if (result == BIND_CRYPTO_BUSY) {
+            slapi_send_ldap_result(pb, LDAP_BUSY, NULL, "Too many pending password verifications", 0, NULL);
+            CACHE_RETURN(&inst->inst_cache, &e);
+            value_done(&cv);
+            rc = SLAPI_BIND_BUSY;
+            goto bail;
+        }
+        if (result != 0) {
             slapi_pblock_set(pb, SLAPI_PB_RESULT_TEXT, "Invalid credentials");
             slapi_send_ldap_result(pb, LDAP_INVALID_CREDENTIALS, NULL, NULL, 0, NULL);
             CACHE_RETURN(&inst->inst_cache, &e);
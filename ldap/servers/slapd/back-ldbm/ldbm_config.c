@@ -864,6 +864,30 @@ ldbm_config_get_use_vlv_index(void *arg)
     return (void *)((uintptr_t)li->li_use_vlv);
 }
 
+static int
+ldbm_config_set_filter_planning(void *arg,
+                                void *value,
+                                char *errorbuf __attribute__((unused)),
+                                int phase __attribute__((unused)),
+                                int apply)
+{
+    struct ldbminfo *li = (struct ldbminfo *)arg;
+    int val = (int)((uintptr_t)value);
+
+    if (apply) {
+        slapi_atomic_store_32(&li->li_filter_planning, val ? 1 : 0, __ATOMIC_RELAXED);
+    }
+    return LDAP_SUCCESS;
+}
+
+static void *
+ldbm_config_get_filter_planning(void *arg)
+{
+    struct ldbminfo *li = (struct ldbminfo *)arg;
+
+    return (void *)((uintptr_t)slapi_atomic_load_32(&li->li_filter_planning, __ATOMIC_RELAXED));
+}
+
 static int
 ldbm_config_exclude_from_export_set(void *arg,
                                     void *value,
@@ -939,6 +963,7 @@ static config_info ldbm_config[] = {
     {CONFIG_IDL_UPDATE, CONFIG_TYPE_ONOFF, "on", &ldbm_config_idl_get_update, &ldbm_config_idl_set_update, 0},
     {CONFIG_BYPASS_FILTER_TEST, CONFIG_TYPE_STRING, "on", &ldbm_config_get_bypass_filter_test, &ldbm_config_set_bypass_filter_test, CONFIG_FLAG_ALWAYS_SHOW | CONFIG_FLAG_ALLOW_RUNNING_CHANGE},
     {CONFIG_USE_VLV_INDEX, CONFIG_TYPE_ONOFF, "on", &ldbm_config_get_use_vlv_index, &ldbm_config_set_use_vlv_index, CONFIG_FLAG_ALWAYS_SHOW | CONFIG_FLAG_ALLOW_RUNNING_CHANGE},
+    {CONFIG_FILTER_PLANNING, CONFIG_TYPE_ONOFF, "off", &ldbm_config_get_filter_planning, &ldbm_config_set_filter_planning, CONFIG_FLAG_ALWAYS_SHOW | CONFIG_FLAG_ALLOW_RUNNING_CHANGE},
     {CONFIG_EXCLUDE_FROM_EXPORT, CONFIG_TYPE_STRING, CONFIG_EXCLUDE_FROM_EXPORT_DEFAULT_VALUE, &ldbm_config_exclude_from_export_get, &ldbm_config_exclude_from_export_set, CONFIG_FLAG_ALWAYS_SHOW},
     {CONFIG_SERIAL_LOCK, CONFIG_TYPE_ONOFF, "on", &ldbm_config_serial_lock_get, &ldbm_config_serial_lock_set, CONFIG_FLAG_ALWAYS_SHOW | CONFIG_FLAG_ALLOW_RUNNING_CHANGE},
     {CONFIG_USE_LEGACY_ERRORCODE, CONFIG_TYPE_ONOFF, "off", &ldbm_config_legacy_errcode_get, &ldbm_config_legacy_errcode_set, 0},
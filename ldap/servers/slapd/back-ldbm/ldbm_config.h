@@ -124,6 +124,7 @@ struct config_info
 #define CONFIG_IDL_UPDATE "nsslapd-idl-update"
 #define CONFIG_BYPASS_FILTER_TEST "nsslapd-search-bypass-filter-test"
 #define CONFIG_USE_VLV_INDEX "nsslapd-search-use-vlv-index"
+#define CONFIG_FILTER_PLANNING "nsslapd-search-filter-planning"
 #define CONFIG_SERIAL_LOCK "nsslapd-serial-lock"
 #define CONFIG_BACKEND_OPT_LEVEL "nsslapd-backend-opt-level"
 
@@ -137,6 +138,8 @@ struct config_info
 
 #define CONFIG_INSTANCE_REQUIRE_INDEX "nsslapd-require-index"
 #define CONFIG_INSTANCE_REQUIRE_INTERNALOP_INDEX "nsslapd-require-internalop-index"
+#define CONFIG_INSTANCE_OUTOFLINE_THRESHOLD "nsslapd-outofline-values-threshold"
+#define CONFIG_INSTANCE_SUBCOUNT_FLUSH_INTERVAL "nsslapd-numsubordinates-flush-interval"
 
 #define CONFIG_USE_LEGACY_ERRORCODE "nsslapd-do-not-use-vlv-error"
 
@@ -52,6 +52,7 @@ ldbm_back_delete(Slapi_PBlock *pb)
     char *e_uniqueid = NULL;
     Slapi_DN nscpEntrySDN;
     Slapi_Operation *operation;
+    struct timespec commit_start;
     CSN *opcsn = NULL;
     int is_fixup_operation = 0;
     int is_ruv = 0; /* True if the current entry is RUV */
@@ -304,7 +305,7 @@ replace_entry:
                 goto error_return;
             }
             /* this has to be handled by urp for replicated operations */
-            retval = slapi_entry_has_children(e->ep_entry);
+            retval = parent_has_children(be, e, 0);
             if (retval && !is_replicated_operation) {
                 ldap_result_code= LDAP_NOT_ALLOWED_ON_NONLEAF;
                 if (slapi_entry_has_conflict_children(e->ep_entry, (void *)li->li_identity) > 0) {
@@ -573,6 +574,7 @@ replace_entry:
                     parent = find_entry2modify_only_ext(pb, be, &parent_addr, TOMBSTONE_INCLUDED, &txn, &result_sent);
                 }
                 if (parent) {
+                    struct backentry *newparent = NULL;
                     int isglue;
                     size_t haschildren = 0;
                     int op = PARENTUPDATE_DEL;
@@ -589,7 +591,7 @@ replace_entry:
                     } else if (delete_tombstone_entry) {
                         op |= PARENTUPDATE_DELETE_TOMBSTONE;
                     }
-                    retval = parent_update_on_childchange(&parent_modify_c, op, &haschildren);
+                    retval = parent_update_on_childchange(be, &parent_modify_c, op, &haschildren);
                     /* The modify context now contains info needed later */
                     if (0 != retval) {
                         slapi_log_err(SLAPI_LOG_ERR, "ldbm_back_delete",
@@ -607,11 +609,13 @@ replace_entry:
                      * Those urp condition checkings are done here to
                      * save unnecessary entry dup.
                      */
-                    isglue = slapi_entry_attr_hasvalue(parent_modify_c.new_entry->ep_entry,
+                    /* No copy of the parent if its counts are kept in memory */
+                    newparent = parent_modify_c.new_entry ? parent_modify_c.new_entry : parent_modify_c.old_entry;
+                    isglue = slapi_entry_attr_hasvalue(newparent->ep_entry,
                                                        SLAPI_ATTR_OBJECTCLASS, "glue");
-                    if (opcsn && parent_modify_c.new_entry && !haschildren && isglue) {
+                    if (opcsn && !haschildren && isglue) {
                         slapi_pblock_set(pb, SLAPI_DELETE_GLUE_PARENT_ENTRY,
-                                         slapi_entry_dup(parent_modify_c.new_entry->ep_entry));
+                                         slapi_entry_dup(newparent->ep_entry));
                     }
                 }
             }
@@ -1301,7 +1305,9 @@ replace_entry:
 
 commit_return:
     /* Release SERIAL LOCK */
+    clock_gettime(CLOCK_MONOTONIC, &commit_start);
     retval = dblayer_txn_commit(be, &txn);
+    latency_record(operation, LATENCY_PHASE_TXN_COMMIT, &commit_start);
     /* after commit - txn is no longer valid - replace SLAPI_TXN with parent */
     slapi_pblock_set(pb, SLAPI_TXN, parent_txn);
     if (0 != retval) {
@@ -1311,6 +1317,11 @@ commit_return:
         goto error_return;
     }
 
+    if (e && !create_tombstone_entry) {
+        /* the entry is gone, a tombstone keeps its ID and counts */
+        parent_subcount_forget(be, e->ep_id);
+    }
+
     /* delete from cache and clean up */
     if (e) {
         if (!create_tombstone_entry) {
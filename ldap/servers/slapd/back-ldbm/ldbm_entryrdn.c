@@ -905,6 +905,81 @@ bail:
     return rc;
 }
 
+/*
+ * Count the direct children of the entry id: the live ones in count and
+ * the tombstones in tombstone_count
+ */
+int
+entryrdn_count_children(backend *be,
+                        ID id,
+                        uint64_t *count,
+                        uint64_t *tombstone_count,
+                        back_txn *txn)
+{
+    entryrdn_db_ctx_t ctx = {0};
+    char *keybuf = NULL;
+    dbi_val_t key = {0};
+    dbi_bulk_t data = {0};
+    char buffer[RDN_BULK_FETCH_BUFFER_SIZE];
+    int rc = 0;
+
+    *count = 0;
+    *tombstone_count = 0;
+    rc = entryrdn_ctx_open(&ctx, be, txn);
+    if (rc) {
+        return rc;
+    }
+
+    /* E.g., C5 */
+    keybuf = slapi_ch_smprintf("%c%u", RDN_INDEX_CHILD, id);
+    dblayer_value_set(ctx.be, &key, keybuf, strlen(keybuf) + 1);
+    dblayer_bulk_set_buffer(ctx.be, &data, buffer, sizeof(buffer), DBI_VF_BULK_DATA);
+
+retry_get0:
+    rc = dblayer_cursor_bulkop(&ctx.cursor, DBI_OP_MOVE_TO_KEY, &key, &data);
+    if ((DBI_RC_RETRY == rc) && !ctx.db_txn) {
+        goto retry_get0;
+    }
+    while (0 == rc) {
+        rdn_elem *elem = NULL;
+        dbi_val_t dataret = {0};
+        for (dblayer_bulk_start(&data); DBI_RC_SUCCESS == dblayer_bulk_nextdata(&data, &dataret);) {
+            elem = (rdn_elem *)dataret.data;
+            if (RDN_IS_REDIRECT(elem)) {
+                rc = _entryrdn_resolve_redirect(&ctx, &elem, 0);
+                if (rc) {
+                    goto bail;
+                }
+            }
+            if (slapi_is_special_rdn(elem->rdn_elem_nrdn_rdn, RDN_IS_TOMBSTONE) ||
+                strcasestr(elem->rdn_elem_nrdn_rdn, "cenotaphid")) {
+                (*tombstone_count)++;
+            } else {
+                (*count)++;
+            }
+            if (elem != dataret.data) {
+                /* elem was alloc by _entryrdn_resolve_redirect */
+                slapi_ch_free((void **)&elem);
+            }
+        }
+    retry_get1:
+        rc = dblayer_cursor_bulkop(&ctx.cursor, DBI_OP_NEXT_DATA, &key, &data);
+        if ((DBI_RC_RETRY == rc) && !ctx.db_txn) {
+            goto retry_get1;
+        }
+    }
+    if (DBI_RC_NOTFOUND == rc) {
+        rc = 0; /* okay not to have (more) children */
+    } else if (rc) {
+        _entryrdn_cursor_print_error("entryrdn_count_children",
+                                     key.data, data.v.size, data.v.ulen, rc);
+    }
+
+bail:
+    dblayer_value_free(ctx.be, &key);
+    return entryrdn_ctx_close(&ctx, rc);
+}
+
 /*
  * Input: (rdn, id)
  * Output: dn
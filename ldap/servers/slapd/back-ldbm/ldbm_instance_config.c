@@ -255,6 +255,22 @@ ldbm_instance_config_require_internalop_index_get(void *arg)
     return (void *)((uintptr_t)inst->require_internalop_index);
 }
 
+static void *
+ldbm_instance_config_outofline_threshold_get(void *arg)
+{
+    ldbm_instance *inst = (ldbm_instance *)arg;
+
+    return (void *)((uintptr_t)inst->inst_outofline_threshold);
+}
+
+static void *
+ldbm_instance_config_subcount_flush_interval_get(void *arg)
+{
+    ldbm_instance *inst = (ldbm_instance *)arg;
+
+    return (void *)((uintptr_t)inst->inst_subcount_flush_interval);
+}
+
 static int
 ldbm_instance_config_readonly_set(void *arg,
                                   void *value,
@@ -325,6 +341,67 @@ ldbm_instance_config_require_internalop_index_set(void *arg,
     return LDAP_SUCCESS;
 }
 
+static int
+ldbm_instance_config_outofline_threshold_set(void *arg,
+                                             void *value,
+                                             char *errorbuf,
+                                             int phase __attribute__((unused)),
+                                             int apply)
+{
+    ldbm_instance *inst = (ldbm_instance *)arg;
+    int val = (int)((uintptr_t)value);
+
+    if (val < 0) {
+        slapi_create_errormsg(errorbuf, SLAPI_DSE_RETURNTEXT_SIZE,
+                              "Error: Invalid value for %s (%d). Must be 0 (disabled) or a number of values.",
+                              CONFIG_INSTANCE_OUTOFLINE_THRESHOLD, val);
+        return LDAP_UNWILLING_TO_PERFORM;
+    }
+    if (!apply) {
+        return LDAP_SUCCESS;
+    }
+
+    inst->inst_outofline_threshold = val;
+    if (val > 0) {
+        id2values_activate(inst);
+    }
+
+    return LDAP_SUCCESS;
+}
+
+static int
+ldbm_instance_config_subcount_flush_interval_set(void *arg,
+                                                 void *value,
+                                                 char *errorbuf,
+                                                 int phase,
+                                                 int apply)
+{
+    ldbm_instance *inst = (ldbm_instance *)arg;
+    int val = (int)((uintptr_t)value);
+
+    if (val < 0) {
+        slapi_create_errormsg(errorbuf, SLAPI_DSE_RETURNTEXT_SIZE,
+                              "Error: Invalid value for %s (%d). Must be 0 (disabled) or a number of seconds.",
+                              CONFIG_INSTANCE_SUBCOUNT_FLUSH_INTERVAL, val);
+        return LDAP_UNWILLING_TO_PERFORM;
+    }
+    if (!apply) {
+        return LDAP_SUCCESS;
+    }
+
+    /* Once the in-memory counts are in use they stay in use until the
+     * backend is restarted, the parents are then flushed and rewritten
+     * inline again. */
+    if (CONFIG_PHASE_RUNNING == phase && val == 0 && inst->inst_subcount) {
+        slapi_log_err(SLAPI_LOG_NOTICE, "ldbm_instance_config_subcount_flush_interval_set",
+                      "%s: %s set to 0, the subordinate counts stay in memory and are flushed every second until the backend is restarted\n",
+                      inst->inst_name, CONFIG_INSTANCE_SUBCOUNT_FLUSH_INTERVAL);
+    }
+    inst->inst_subcount_flush_interval = val;
+
+    return LDAP_SUCCESS;
+}
+
 /*------------------------------------------------------------------------
  * ldbm instance configuration array
  *----------------------------------------------------------------------*/
@@ -335,6 +412,8 @@ static config_info ldbm_instance_config[] = {
     {CONFIG_INSTANCE_REQUIRE_INDEX, CONFIG_TYPE_ONOFF, "off", &ldbm_instance_config_require_index_get, &ldbm_instance_config_require_index_set, CONFIG_FLAG_ALWAYS_SHOW | CONFIG_FLAG_ALLOW_RUNNING_CHANGE},
     {CONFIG_INSTANCE_REQUIRE_INTERNALOP_INDEX, CONFIG_TYPE_ONOFF, "off", &ldbm_instance_config_require_internalop_index_get, &ldbm_instance_config_require_internalop_index_set, CONFIG_FLAG_ALWAYS_SHOW | CONFIG_FLAG_ALLOW_RUNNING_CHANGE},
     {CONFIG_INSTANCE_DNCACHEMEMSIZE, CONFIG_TYPE_UINT64, DEFAULT_DNCACHE_SIZE_STR, &ldbm_instance_config_dncachememsize_get, &ldbm_instance_config_dncachememsize_set, CONFIG_FLAG_ALWAYS_SHOW | CONFIG_FLAG_ALLOW_RUNNING_CHANGE},
+    {CONFIG_INSTANCE_OUTOFLINE_THRESHOLD, CONFIG_TYPE_INT, "0", &ldbm_instance_config_outofline_threshold_get, &ldbm_instance_config_outofline_threshold_set, CONFIG_FLAG_ALWAYS_SHOW | CONFIG_FLAG_ALLOW_RUNNING_CHANGE},
+    {CONFIG_INSTANCE_SUBCOUNT_FLUSH_INTERVAL, CONFIG_TYPE_INT, "0", &ldbm_instance_config_subcount_flush_interval_get, &ldbm_instance_config_subcount_flush_interval_set, CONFIG_FLAG_ALWAYS_SHOW | CONFIG_FLAG_ALLOW_RUNNING_CHANGE},
     {NULL, 0, NULL, NULL, NULL, 0}};
 
 void
@@ -82,6 +82,7 @@ modify_term(modify_context *mc, struct backend *be)
 
     CACHE_RETURN(&(inst->inst_cache), &(mc->new_entry));
     mc->new_entry = NULL;
+    mc->subcount_deferred = 0;
     return 0;
 }
 
@@ -91,6 +92,11 @@ modify_switch_entries(modify_context *mc, backend *be)
 {
     ldbm_instance *inst = (ldbm_instance *)be->be_instance_info;
     int ret = 0;
+    if (mc->subcount_deferred) {
+        /* the parent itself is unchanged, only its in-memory counts */
+        parent_subcount_apply(be, mc, 0);
+        return ret;
+    }
     if (mc->old_entry && mc->new_entry) {
         ret = cache_replace(&(inst->inst_cache), mc->old_entry, mc->new_entry);
         if (ret) {
@@ -114,6 +120,10 @@ modify_unswitch_entries(modify_context *mc, backend *be)
     ldbm_instance *inst = (ldbm_instance *)be->be_instance_info;
     int ret = 0;
 
+    if (mc->subcount_deferred) {
+        parent_subcount_apply(be, mc, 1);
+        return ret;
+    }
     if (mc->old_entry && mc->new_entry &&
         cache_is_in_cache(&inst->inst_cache, mc->new_entry)) {
         /* switch the entries, and reset the new, new, entry */
@@ -177,6 +187,10 @@ modify_update_all(backend *be, Slapi_PBlock *pb, modify_context *mc, back_txn *t
         slapi_pblock_get(pb, SLAPI_OPERATION, &operation);
         is_ruv = operation_is_flag_set(operation, OP_FLAG_REPL_RUV);
     }
+    if (mc->subcount_deferred) {
+        /* the subordinate counts of the parent are kept in memory */
+        return 0;
+    }
     if (NULL == mc->new_entry) {
         /* test entry to avoid crashing in id2entry_add_ext */
         slapi_log_err(SLAPI_LOG_BACKLDBM, "modify_update_all",
@@ -515,6 +529,7 @@ ldbm_back_modify(Slapi_PBlock *pb)
     char *ldap_result_message = NULL;
     int rc = 0;
     Slapi_Operation *operation;
+    struct timespec commit_start;
     entry_address *addr;
     int is_fixup_operation = 0;
     int is_ruv = 0; /* True if the current entry is RUV */
@@ -1040,7 +1055,9 @@ ldbm_back_modify(Slapi_PBlock *pb)
     }
 
     /* Release SERIAL LOCK */
+    clock_gettime(CLOCK_MONOTONIC, &commit_start);
     retval = dblayer_txn_commit(be, &txn);
+    latency_record(operation, LATENCY_PHASE_TXN_COMMIT, &commit_start);
     /* after commit - txn is no longer valid - replace SLAPI_TXN with parent */
     slapi_pblock_set(pb, SLAPI_TXN, parent_txn);
     if (0 != retval) {
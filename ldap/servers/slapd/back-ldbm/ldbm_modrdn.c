@@ -78,6 +78,7 @@ ldbm_back_modrdn(Slapi_PBlock *pb)
     Slapi_Mods smods_generated = {0};
     Slapi_Mods smods_generated_wsi = {0};
     Slapi_Operation *operation;
+    struct timespec commit_start;
     int is_replicated_operation = 0;
     int is_fixup_operation = 0;
     int is_resurect_operation = 0;
@@ -856,7 +857,7 @@ ldbm_back_modrdn(Slapi_PBlock *pb)
                  * Update the subordinate count of the parents to reflect the moved child.
                  */
                 if (parententry) {
-                    retval = parent_update_on_childchange(&parent_modify_context,
+                    retval = parent_update_on_childchange(be, &parent_modify_context,
                                                           PARENTUPDATE_DEL, NULL);
                     slapi_log_err(SLAPI_LOG_BACKLDBM, "ldbm_back_modrdn",
                                   "conn=%" PRIu64 " op=%d parent_update_on_childchange: old_entry=0x%p, new_entry=0x%p, rc=%d\n",
@@ -868,7 +869,7 @@ ldbm_back_modrdn(Slapi_PBlock *pb)
                     }
                 }
                 if (newparententry) {
-                    retval = parent_update_on_childchange(&newparent_modify_context,
+                    retval = parent_update_on_childchange(be, &newparent_modify_context,
                                                           PARENTUPDATE_ADD, NULL);
                     slapi_log_err(SLAPI_LOG_BACKLDBM, "ldbm_back_modrdn",
                                   "conn=%" PRIu64 " op=%d parent_update_on_childchange: old_entry=0x%p, new_entry=0x%p, rc=%d\n",
@@ -881,7 +882,7 @@ ldbm_back_modrdn(Slapi_PBlock *pb)
             }
             /* is_resurect_operation case, there's no new superior.  Just rename. */
             if (is_resurect_operation && parententry) {
-                retval = parent_update_on_childchange(&parent_modify_context, PARENTUPDATE_RESURECT, NULL);
+                retval = parent_update_on_childchange(be, &parent_modify_context, PARENTUPDATE_RESURECT, NULL);
                 if (retval) {
                     slapi_log_err(SLAPI_LOG_BACKLDBM, "ldbm_back_modrdn",
                                   "conn=%" PRIu64 " op=%d parent_update_on_childchange parent %s of %s failed, rc=%d\n",
@@ -896,7 +897,7 @@ ldbm_back_modrdn(Slapi_PBlock *pb)
              * If the entry has children including tombstones,
              * then we're going to have to rename them all.
              */
-            if (slapi_entry_has_children_ext(e->ep_entry, 1)) {
+            if (parent_has_children(be, e, 1)) {
                 /* JCM - This is where the subtree lock will appear */
                 if (is_resurect_operation) {
 #if defined(DEBUG)
@@ -1228,7 +1229,9 @@ ldbm_back_modrdn(Slapi_PBlock *pb)
     }
 
     /* Release SERIAL LOCK */
+    clock_gettime(CLOCK_MONOTONIC, &commit_start);
     retval = dblayer_txn_commit(be, &txn);
+    latency_record(operation, LATENCY_PHASE_TXN_COMMIT, &commit_start);
     /* after commit - txn is no longer valid - replace SLAPI_TXN with parent */
     slapi_pblock_set(pb, SLAPI_TXN, parent_txn);
     if (0 != retval) {
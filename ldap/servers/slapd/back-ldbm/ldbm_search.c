@@ -662,8 +662,13 @@ ldbm_back_search(Slapi_PBlock *pb)
             }
         }
         if (candidates == NULL) {
-            int rc = build_candidate_list(pb, be, e, base, scope,
-                                          &lookup_returned_allids, &candidates);
+            struct timespec start;
+            int rc = 0;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            rc = build_candidate_list(pb, be, e, base, scope,
+                                      &lookup_returned_allids, &candidates);
+            latency_record(operation, LATENCY_PHASE_CANDIDATES, &start);
             if (rc) {
                 /* Error result sent by build_candidate_list */
                 if (virtual_list_view) {
@@ -1411,6 +1416,10 @@ grok_filter(struct slapi_filter *f)
         /* If there's an ID list and an equality filter, we can skip the filter test */
         return grok_filter_not_subtype(f);
     case LDAP_FILTER_SUBSTRINGS:
+        /* only if the positional substring keys checked every component */
+        if (f->f_flags & SLAPI_FILTER_INDEX_EXACT) {
+            return grok_filter_not_subtype(f);
+        }
         return 0;
 
     case LDAP_FILTER_GE:
@@ -1677,6 +1686,8 @@ ldbm_back_next_search_entry(Slapi_PBlock *pb)
             slapi_send_ldap_result(pb, LDAP_TIMELIMIT_EXCEEDED, NULL, NULL, nentries, urls);
             goto bail;
         }
+        /* do not hold back the entries already returned during a long scan */
+        send_ldap_search_entry_batch_check(pb);
         /* check lookthrough limit */
         if (llimit != -1 && sr->sr_lookthroughcount >= llimit) {
             slapi_pblock_set(pb, SLAPI_SEARCH_RESULT_SET_SIZE_ESTIMATE, &estimate);
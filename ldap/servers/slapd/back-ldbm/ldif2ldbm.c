@@ -199,6 +199,13 @@ ldbm_back_ldbm2ldif(Slapi_PBlock *pb)
 }
 
 
+static int
+ldbm_index_stats_reset_callback(caddr_t data, caddr_t arg __attribute__((unused)))
+{
+    index_stats_reset((struct attrinfo *)data);
+    return 0;
+}
+
 /*
  * ldbm_back_ldbm2index - backend routine to create a new index from an
  * existing database
@@ -224,8 +231,19 @@ ldbm_back_ldbm2index(Slapi_PBlock *pb)
     }
 
     dblayer_private *priv = (dblayer_private *)li->li_dblayer_private;
+    int rc = priv->dblayer_db2index_fn(pb);
 
-    return priv->dblayer_db2index_fn(pb);;
+    if (!run_from_cmdline) {
+        /* The index statistics of the instance are now stale */
+        char *instance_name = NULL;
+        ldbm_instance *inst = NULL;
+
+        slapi_pblock_get(pb, SLAPI_BACKEND_INSTANCE_NAME, &instance_name);
+        if (instance_name && (inst = ldbm_instance_find_by_name(li, instance_name))) {
+            avl_apply(inst->inst_attrs, ldbm_index_stats_reset_callback, NULL, -1, AVL_INORDER);
+        }
+    }
+    return rc;
 }
 
 /*
@@ -14,11 +14,243 @@
 /* parents.c - where the adults live */
 
 #include "back-ldbm.h"
+#include "dblayer.h"
 
 char *numsubordinates = LDBM_NUMSUBORDINATES_STR;
 char *hassubordinates = "hassubordinates";
 char *tombstone_numsubordinates = LDBM_TOMBSTONE_NUMSUBORDINATES_STR;
 
+/*
+ * In-memory subordinate counts
+ *
+ * With nsslapd-numsubordinates-flush-interval set, adding, deleting or
+ * moving a child no longer duplicates, reindexes and rewrites its parent.
+ * The counts of the parents are kept in a table striped by parent ID:
+ * parent_update_on_childchange() only records the change in the modify
+ * context, it is applied to the table when the entries are switched and
+ * reverted when they are unswitched. numSubordinates and hasSubordinates are
+ * computed from the table when they are returned, and the counts are written
+ * back to the parents periodically and when the instance is closed, which
+ * keeps the numsubordinates index usable for the rewritten filters.
+ *
+ * A parent is seeded from entryrdn the first time one of its children
+ * changes, within the transaction of that change. The values stored in the
+ * parent are not used: after a crash they miss the changes of the last
+ * interval. Parents not in the table are counted in entryrdn as well when
+ * their counts are read.
+ */
+#define SUBCOUNT_STRIPES 64 /* must be a power of 2 */
+#define SUBCOUNT_HASHTABLE_SIZE 64
+
+typedef struct _subcount_entry
+{
+    uint64_t sce_count;           /* numsubordinates */
+    uint64_t sce_tombstone_count; /* tombstonenumsubordinates */
+    int sce_has_tombstone_count;  /* tombstonenumsubordinates is present */
+    int sce_dirty;                /* changed since the last flush */
+} subcount_entry;
+
+typedef struct _subcount_stripe
+{
+    PRLock *scs_lock;
+    PLHashTable *scs_hashtable; /* ID -> subcount_entry */
+} subcount_stripe;
+
+typedef struct _subcount_table
+{
+    subcount_stripe sct_stripes[SUBCOUNT_STRIPES];
+    time_t sct_last_flush;
+} subcount_table;
+
+static PRIntn
+subcount_hash_compare_keys(const void *v1, const void *v2)
+{
+    return (((ID)((uintptr_t)v1) == (ID)((uintptr_t)v2)) ? 1 : 0);
+}
+
+static PRIntn
+subcount_hash_compare_values(const void *v1, const void *v2)
+{
+    return ((v1 == v2) ? 1 : 0);
+}
+
+static PLHashNumber
+subcount_hash_fn(const void *id)
+{
+    return (PLHashNumber)((uintptr_t)id);
+}
+
+static subcount_stripe *
+subcount_get_stripe(subcount_table *sct, ID id)
+{
+    return &sct->sct_stripes[id & (SUBCOUNT_STRIPES - 1)];
+}
+
+/* The caller holds the stripe lock */
+static subcount_entry *
+subcount_lookup(subcount_stripe *scs, ID id)
+{
+    return (subcount_entry *)PL_HashTableLookup(scs->scs_hashtable, (void *)((uintptr_t)id));
+}
+
+/* Returns 1 and the value if the count attribute is present in e */
+static int
+parent_stored_count(Slapi_Entry *e, const char *type, uint64_t *count)
+{
+    Slapi_Attr *read_attr = NULL;
+    Slapi_Value *sval = NULL;
+    const struct berval *bval = NULL;
+
+    *count = 0;
+    if (slapi_entry_attr_find(e, type, &read_attr) ||
+        slapi_attr_first_value(read_attr, &sval) == -1 ||
+        NULL == (bval = slapi_value_get_berval(sval))) {
+        return 0;
+    }
+    *count = strtoull(bval->bv_val, NULL, 10);
+    return 1;
+}
+
+/* Counts the children of id in entryrdn, within the transaction of the
+ * running operation if there is one */
+static int
+parent_subcount_count(backend *be, ID id, uint64_t *count, uint64_t *tombstone_count)
+{
+    int rc = entryrdn_count_children(be, id, count, tombstone_count, dblayer_get_pvt_txn());
+
+    if (rc && (DBI_RC_RETRY != rc)) {
+        slapi_log_err(SLAPI_LOG_WARNING, "parent_subcount_count",
+                      "%s: Failed to count the children of entry %lu in entryrdn, rc=%d\n",
+                      be->be_name, (u_long)id, rc);
+    }
+    return rc;
+}
+
+/* Allocates the table entry of the parent e */
+static subcount_entry *
+parent_subcount_seed(backend *be, struct backentry *e)
+{
+    subcount_entry *sce = (subcount_entry *)slapi_ch_calloc(1, sizeof(subcount_entry));
+    uint64_t stored = 0;
+    uint64_t stored_tombstone = 0;
+    int has_stored_tombstone = 0;
+
+    parent_stored_count(e->ep_entry, numsubordinates, &stored);
+    has_stored_tombstone = parent_stored_count(e->ep_entry, tombstone_numsubordinates, &stored_tombstone);
+    if (parent_subcount_count(be, e->ep_id, &sce->sce_count, &sce->sce_tombstone_count)) {
+        /* the stored values are the best we have */
+        sce->sce_count = stored;
+        sce->sce_tombstone_count = stored_tombstone;
+        sce->sce_has_tombstone_count = has_stored_tombstone;
+        return sce;
+    }
+    sce->sce_has_tombstone_count = has_stored_tombstone || sce->sce_tombstone_count;
+    if ((sce->sce_count != stored) || (sce->sce_tombstone_count != stored_tombstone)) {
+        /* left behind by a crash, the next flush repairs them */
+        slapi_log_err(SLAPI_LOG_NOTICE, "parent_subcount_seed",
+                      "%s: Subordinate counts of %s were %" PRIu64 "/%" PRIu64 ", entryrdn has %" PRIu64 "/%" PRIu64 "\n",
+                      be->be_name, slapi_entry_get_dn_const(e->ep_entry), stored, stored_tombstone,
+                      sce->sce_count, sce->sce_tombstone_count);
+        sce->sce_dirty = 1;
+    }
+    return sce;
+}
+
+/* Returns the subordinate count table of the instance, creating it if
+ * nsslapd-numsubordinates-flush-interval is set */
+static subcount_table *
+parent_subcount_table(ldbm_instance *inst)
+{
+    subcount_table *sct = inst->inst_subcount;
+    size_t i;
+
+    if (sct || inst->inst_subcount_flush_interval <= 0) {
+        return sct;
+    }
+
+    PR_Lock(inst->inst_subcount_mutex);
+    if (NULL == inst->inst_subcount) {
+        sct = (subcount_table *)slapi_ch_calloc(1, sizeof(subcount_table));
+        for (i = 0; i < SUBCOUNT_STRIPES; i++) {
+            sct->sct_stripes[i].scs_lock = PR_NewLock();
+            sct->sct_stripes[i].scs_hashtable = PL_NewHashTable(SUBCOUNT_HASHTABLE_SIZE,
+                                                                subcount_hash_fn, subcount_hash_compare_keys,
+                                                                subcount_hash_compare_values, NULL, NULL);
+        }
+        sct->sct_last_flush = slapi_current_rel_time_t();
+        inst->inst_subcount = sct;
+        slapi_log_err(SLAPI_LOG_INFO, "parent_subcount_table",
+                      "%s: subordinate counts are kept in memory and flushed every %d seconds\n",
+                      inst->inst_name, inst->inst_subcount_flush_interval);
+    }
+    sct = inst->inst_subcount;
+    PR_Unlock(inst->inst_subcount_mutex);
+
+    return sct;
+}
+
+/* Records in mc the changes parent_update_on_childchange() would have
+ * applied to the parent, the counts come from the table */
+static int
+parent_defer_childchange(backend *be, subcount_table *sct, modify_context *mc, int op, int repl_op, size_t *new_sub_count)
+{
+    ID id = mc->old_entry->ep_id;
+    subcount_stripe *scs = subcount_get_stripe(sct, id);
+    subcount_entry *sce = NULL;
+    subcount_entry *seed = NULL;
+    int ret = 0;
+
+    PR_Lock(scs->scs_lock);
+    sce = subcount_lookup(scs, id);
+    if (NULL == sce) {
+        /* not holding the stripe while reading entryrdn */
+        PR_Unlock(scs->scs_lock);
+        seed = parent_subcount_seed(be, mc->old_entry);
+        PR_Lock(scs->scs_lock);
+        sce = subcount_lookup(scs, id);
+        if (NULL == sce) {
+            sce = seed;
+            PL_HashTableAdd(scs->scs_hashtable, (void *)((uintptr_t)id), sce);
+        } else {
+            slapi_ch_free((void **)&seed);
+        }
+    }
+
+    mc->subcount_delta = 0;
+    mc->tombstone_delta = 0;
+    if ((PARENTUPDATE_ADD == op) && (PARENTUPDATE_CREATE_TOMBSTONE == repl_op)) {
+        /* directly adding a tombstone entry */
+    } else if (PARENTUPDATE_DELETE_TOMBSTONE != repl_op) {
+        if (PARENTUPDATE_DEL == op) {
+            if (0 == sce->sce_count) {
+                slapi_log_err(SLAPI_LOG_ERR, "parent_update_on_childchange",
+                              "Parent %s has no children. (op 0x%x, repl_op 0x%x)\n",
+                              slapi_entry_get_dn(mc->old_entry->ep_entry), op, repl_op);
+                ret = -1;
+                goto done;
+            }
+            mc->subcount_delta = -1;
+        } else {
+            mc->subcount_delta = 1;
+        }
+        if (new_sub_count) {
+            *new_sub_count = sce->sce_count + mc->subcount_delta;
+        }
+    }
+    if ((PARENTUPDATE_DELETE_TOMBSTONE == repl_op) || (PARENTUPDATE_RESURECT == op)) {
+        if (sce->sce_has_tombstone_count && sce->sce_tombstone_count > 0) {
+            mc->tombstone_delta = -1;
+        }
+    } else if (PARENTUPDATE_CREATE_TOMBSTONE == repl_op) {
+        mc->tombstone_delta = 1;
+    }
+    mc->subcount_deferred = 1;
+
+done:
+    PR_Unlock(scs->scs_lock);
+    return ret;
+}
+
 /* Routine where any in-memory modification of a parent entry happens on some
  * state-change in one of its children. vaid op values are:
  *     PARENTUPDATE_ADD == child entry newly added,
@@ -43,7 +275,7 @@ char *tombstone_numsubordinates = LDBM_TOMBSTONE_NUMSUBORDINATES_STR;
  */
 
 int
-parent_update_on_childchange(modify_context *mc, int op, size_t *new_sub_count)
+parent_update_on_childchange(backend *be, modify_context *mc, int op, size_t *new_sub_count)
 {
     int ret = 0;
     int mod_op = 0;
@@ -52,6 +284,7 @@ parent_update_on_childchange(modify_context *mc, int op, size_t *new_sub_count)
     int already_present = 0;
     int repl_op = 0;
     Slapi_Mods *smods = NULL;
+    subcount_table *sct = NULL;
     char value_buffer[22] = {0}; /* enough digits for 2^64 children */
 
     if (new_sub_count)
@@ -63,6 +296,12 @@ parent_update_on_childchange(modify_context *mc, int op, size_t *new_sub_count)
     /* Check nobody is trying to use op == 3, it's not implemented yet */
     PR_ASSERT((op == PARENTUPDATE_ADD) || (op == PARENTUPDATE_DEL) || (op == PARENTUPDATE_RESURECT));
 
+    /* Leave the parent alone if its counts are kept in memory */
+    sct = parent_subcount_table((ldbm_instance *)be->be_instance_info);
+    if (sct) {
+        return parent_defer_childchange(be, sct, mc, op, repl_op, new_sub_count);
+    }
+
     /* We want to invent a mods set to be passed to modify_apply_mods() */
 
     /* For now, we're only interested in subordinatecount.
@@ -190,3 +429,392 @@ parent_update_on_childchange(modify_context *mc, int op, size_t *new_sub_count)
     ret = modify_apply_mods(mc, smods); /* smods passed in */
     return ret;
 }
+
+/*
+ * Applies (or reverts) the change recorded by parent_update_on_childchange()
+ * to the in-memory counts, called when the entries are switched (unswitched)
+ */
+void
+parent_subcount_apply(backend *be, modify_context *mc, int revert)
+{
+    ldbm_instance *inst = (ldbm_instance *)be->be_instance_info;
+    subcount_table *sct = inst->inst_subcount;
+    subcount_stripe *scs = NULL;
+    subcount_entry *sce = NULL;
+    int64_t delta = revert ? -mc->subcount_delta : mc->subcount_delta;
+    int64_t tombstone_delta = revert ? -mc->tombstone_delta : mc->tombstone_delta;
+
+    if (NULL == sct || NULL == mc->old_entry ||
+        mc->subcount_deferred != (revert ? 2 : 1)) {
+        return;
+    }
+
+    scs = subcount_get_stripe(sct, mc->old_entry->ep_id);
+    PR_Lock(scs->scs_lock);
+    sce = subcount_lookup(scs, mc->old_entry->ep_id);
+    if (sce) {
+        if (delta < 0 && sce->sce_count < (uint64_t)-delta) {
+            sce->sce_count = 0;
+        } else {
+            sce->sce_count += delta;
+        }
+        if (tombstone_delta) {
+            if (tombstone_delta < 0 && sce->sce_tombstone_count < (uint64_t)-tombstone_delta) {
+                sce->sce_tombstone_count = 0;
+            } else {
+                sce->sce_tombstone_count += tombstone_delta;
+            }
+            sce->sce_has_tombstone_count = 1;
+        }
+        sce->sce_dirty = 1;
+    }
+    PR_Unlock(scs->scs_lock);
+    mc->subcount_deferred = revert ? 1 : 2;
+}
+
+/*
+ * Gets the subordinate counts of the entry id from the in-memory table, or
+ * from entryrdn if it is not in the table. Returns 0 if the counts are kept
+ * in memory, -1 if the values stored in the entry apply.
+ */
+int
+parent_subcount_get(backend *be, ID id, size_t *count, size_t *tombstone_count)
+{
+    ldbm_instance *inst = (ldbm_instance *)be->be_instance_info;
+    subcount_table *sct = inst->inst_subcount;
+    subcount_stripe *scs = NULL;
+    subcount_entry *sce = NULL;
+    uint64_t rdn_count = 0;
+    uint64_t rdn_tombstone_count = 0;
+    int rc = -1;
+
+    if (NULL == sct) {
+        return rc;
+    }
+    scs = subcount_get_stripe(sct, id);
+    PR_Lock(scs->scs_lock);
+    sce = subcount_lookup(scs, id);
+    if (sce) {
+        rdn_count = sce->sce_count;
+        rdn_tombstone_count = sce->sce_tombstone_count;
+        rc = 0;
+    }
+    PR_Unlock(scs->scs_lock);
+    if (rc && parent_subcount_count(be, id, &rdn_count, &rdn_tombstone_count) == 0) {
+        /* the stored values may be stale, do not trust them */
+        rc = 0;
+    }
+    if (0 == rc) {
+        if (count) {
+            *count = (size_t)rdn_count;
+        }
+        if (tombstone_count) {
+            *tombstone_count = (size_t)rdn_tombstone_count;
+        }
+    }
+
+    return rc;
+}
+
+/* Same as slapi_entry_has_children_ext() with the in-memory counts */
+int
+parent_has_children(backend *be, struct backentry *e, int include_tombstone)
+{
+    size_t count = 0;
+    size_t tombstone_count = 0;
+
+    if (parent_subcount_get(be, e->ep_id, &count, &tombstone_count)) {
+        return slapi_entry_has_children_ext(e->ep_entry, include_tombstone);
+    }
+    if (count > 0) {
+        return (int)count;
+    }
+    return include_tombstone ? (int)tombstone_count : 0;
+}
+
+/*
+ * BACK_INFO_SUBORDINATE_COUNTS: lets slapi_entry_has_children_ext() see the
+ * in-memory counts when it is called outside of the backend (URP, tombstone
+ * reaping). Returns -1 if the values stored in the entry apply.
+ */
+int
+parent_subcount_get_info(backend *be, struct _back_info_subordinates *info)
+{
+    ldbm_instance *inst = (ldbm_instance *)be->be_instance_info;
+    size_t count = 0;
+    size_t tombstone_count = 0;
+    ID id = NOID;
+
+    if (NULL == inst || NULL == inst->inst_subcount || NULL == info->entry) {
+        return -1;
+    }
+    /* Only the entries read from this backend carry their ID */
+    id = (ID)slapi_entry_attr_get_ulong(info->entry, LDBM_ENTRYID_STR);
+    if (0 == id || NOID == id) {
+        return -1;
+    }
+    if (parent_subcount_get(be, id, &count, &tombstone_count)) {
+        return -1;
+    }
+    info->count = count;
+    info->tombstone_count = tombstone_count;
+    return 0;
+}
+
+/* Builds the mods bringing the values stored in e up to date with the
+ * in-memory counts, NULL if they already are */
+static Slapi_Mods *
+parent_subcount_mods(subcount_table *sct, Slapi_Entry *e, ID id)
+{
+    subcount_stripe *scs = subcount_get_stripe(sct, id);
+    subcount_entry *sce = NULL;
+    Slapi_Mods *smods = NULL;
+    uint64_t stored = 0;
+    int present = 0;
+    char value_buffer[22] = {0}; /* enough digits for 2^64 children */
+
+    PR_Lock(scs->scs_lock);
+    sce = subcount_lookup(scs, id);
+    if (NULL == sce || !sce->sce_dirty) {
+        PR_Unlock(scs->scs_lock);
+        return NULL;
+    }
+    sce->sce_dirty = 0;
+
+    smods = slapi_mods_new();
+    present = parent_stored_count(e, numsubordinates, &stored);
+    if (0 == sce->sce_count) {
+        if (present) {
+            slapi_mods_add(smods, LDAP_MOD_DELETE | LDAP_MOD_BVALUES, numsubordinates, 0, NULL);
+        }
+    } else if (!present || stored != sce->sce_count) {
+        sprintf(value_buffer, "%" PRIu64, sce->sce_count);
+        slapi_mods_add(smods, LDAP_MOD_REPLACE | LDAP_MOD_BVALUES,
+                       numsubordinates, strlen(value_buffer), value_buffer);
+    }
+    present = parent_stored_count(e, tombstone_numsubordinates, &stored);
+    if (sce->sce_has_tombstone_count && (!present || stored != sce->sce_tombstone_count)) {
+        sprintf(value_buffer, "%" PRIu64, sce->sce_tombstone_count);
+        slapi_mods_add(smods, LDAP_MOD_REPLACE | LDAP_MOD_BVALUES,
+                       tombstone_numsubordinates, strlen(value_buffer), value_buffer);
+    }
+    PR_Unlock(scs->scs_lock);
+
+    if (0 == slapi_mods_get_num_mods(smods)) {
+        slapi_mods_free(&smods);
+    }
+    return smods;
+}
+
+/* Drops the counts of an entry that no longer exists */
+static void
+parent_subcount_remove(subcount_table *sct, ID id)
+{
+    subcount_stripe *scs = subcount_get_stripe(sct, id);
+    subcount_entry *sce = NULL;
+
+    PR_Lock(scs->scs_lock);
+    sce = subcount_lookup(scs, id);
+    if (sce) {
+        PL_HashTableRemove(scs->scs_hashtable, (void *)((uintptr_t)id));
+        slapi_ch_free((void **)&sce);
+    }
+    PR_Unlock(scs->scs_lock);
+}
+
+/* Called when the entry id is removed from the backend */
+void
+parent_subcount_forget(backend *be, ID id)
+{
+    ldbm_instance *inst = (ldbm_instance *)be->be_instance_info;
+
+    if (inst->inst_subcount) {
+        parent_subcount_remove(inst->inst_subcount, id);
+    }
+}
+
+static void
+parent_subcount_set_dirty(subcount_table *sct, ID id)
+{
+    subcount_stripe *scs = subcount_get_stripe(sct, id);
+    subcount_entry *sce = NULL;
+
+    PR_Lock(scs->scs_lock);
+    sce = subcount_lookup(scs, id);
+    if (sce) {
+        sce->sce_dirty = 1;
+    }
+    PR_Unlock(scs->scs_lock);
+}
+
+/* Writes the in-memory counts of the entry id back to it */
+static int
+parent_subcount_flush_one(backend *be, subcount_table *sct, ID id)
+{
+    ldbm_instance *inst = (ldbm_instance *)be->be_instance_info;
+    modify_context mc = {0};
+    back_txn txn = {0};
+    struct backentry *e = NULL;
+    Slapi_Mods *smods = NULL;
+    int err = 0;
+    int rc = 0;
+
+    rc = dblayer_txn_begin(be, NULL, &txn);
+    if (rc) {
+        parent_subcount_set_dirty(sct, id);
+        return rc;
+    }
+    e = id2entry(be, id, &txn, &err);
+    if (NULL == e) {
+        dblayer_txn_abort(be, &txn);
+        if (err && (DBI_RC_NOTFOUND != err)) {
+            parent_subcount_set_dirty(sct, id);
+            return err;
+        }
+        /* the parent is gone, so are its counts */
+        parent_subcount_remove(sct, id);
+        return 0;
+    }
+    if (cache_lock_entry(&inst->inst_cache, e)) {
+        CACHE_RETURN(&inst->inst_cache, &e);
+        dblayer_txn_abort(be, &txn);
+        parent_subcount_set_dirty(sct, id);
+        return 0;
+    }
+    modify_init(&mc, e);
+    smods = parent_subcount_mods(sct, e->ep_entry, id);
+    if (NULL == smods) {
+        dblayer_txn_abort(be, &txn);
+        modify_term(&mc, be);
+        return 0;
+    }
+    rc = modify_apply_mods(&mc, smods); /* smods passed in */
+    if (0 == rc) {
+        rc = modify_update_all(be, NULL, &mc, &txn);
+    }
+    if (0 == rc) {
+        rc = dblayer_txn_commit(be, &txn);
+    } else {
+        dblayer_txn_abort(be, &txn);
+    }
+    if (0 == rc) {
+        modify_switch_entries(&mc, be);
+    } else {
+        slapi_log_err(DBI_RC_RETRY == rc ? SLAPI_LOG_BACKLDBM : SLAPI_LOG_ERR, "parent_subcount_flush_one",
+                      "%s: Failed to write the subordinate counts of %s, rc=%d\n",
+                      inst->inst_name, slapi_entry_get_dn_const(e->ep_entry), rc);
+        parent_subcount_set_dirty(sct, id);
+    }
+    modify_term(&mc, be);
+
+    return rc;
+}
+
+typedef struct
+{
+    ID *ids;
+    size_t count;
+    size_t size;
+} subcount_dirty_ids;
+
+static PRIntn
+parent_subcount_collect_dirty(PLHashEntry *he, PRIntn i __attribute__((unused)), void *arg)
+{
+    subcount_dirty_ids *dirty = (subcount_dirty_ids *)arg;
+    subcount_entry *sce = (subcount_entry *)he->value;
+
+    if (sce->sce_dirty) {
+        if (dirty->count == dirty->size) {
+            dirty->size = dirty->size ? dirty->size * 2 : 64;
+            dirty->ids = (ID *)slapi_ch_realloc((char *)dirty->ids, dirty->size * sizeof(ID));
+        }
+        dirty->ids[dirty->count++] = (ID)((uintptr_t)he->key);
+    }
+    return HT_ENUMERATE_NEXT;
+}
+
+static PRIntn
+parent_subcount_free_entry(PLHashEntry *he, PRIntn i __attribute__((unused)), void *arg __attribute__((unused)))
+{
+    slapi_ch_free(&he->value);
+    return HT_ENUMERATE_REMOVE;
+}
+
+/*
+ * Writes the counts changed since the last flush back to the parents once
+ * the flush interval has elapsed. With destroy, called when the instance is
+ * closed, they are written at once, the table is freed and the parents are
+ * rewritten inline again until it is recreated.
+ */
+int
+parent_subcount_flush(backend *be, int destroy)
+{
+    ldbm_instance *inst = (ldbm_instance *)be->be_instance_info;
+    subcount_table *sct = NULL;
+    subcount_dirty_ids dirty = {0};
+    size_t i;
+    int rc = 0;
+
+    PR_Lock(inst->inst_subcount_mutex);
+    sct = inst->inst_subcount;
+    if (NULL == sct ||
+        (!destroy && (is_instance_busy(inst) || be->be_state != BE_STATE_STARTED ||
+                      slapi_current_rel_time_t() - sct->sct_last_flush < inst->inst_subcount_flush_interval))) {
+        PR_Unlock(inst->inst_subcount_mutex);
+        return 0;
+    }
+
+    for (i = 0; i < SUBCOUNT_STRIPES; i++) {
+        PR_Lock(sct->sct_stripes[i].scs_lock);
+        PL_HashTableEnumerateEntries(sct->sct_stripes[i].scs_hashtable,
+                                     parent_subcount_collect_dirty, &dirty);
+        PR_Unlock(sct->sct_stripes[i].scs_lock);
+    }
+    for (i = 0; i < dirty.count; i++) {
+        rc |= parent_subcount_flush_one(be, sct, dirty.ids[i]);
+    }
+    if (dirty.count) {
+        slapi_log_err(SLAPI_LOG_BACKLDBM, "parent_subcount_flush",
+                      "%s: Flushed the subordinate counts of %lu entries\n",
+                      inst->inst_name, (unsigned long)dirty.count);
+    }
+    slapi_ch_free((void **)&dirty.ids);
+    sct->sct_last_flush = slapi_current_rel_time_t();
+
+    if (destroy) {
+        for (i = 0; i < SUBCOUNT_STRIPES; i++) {
+            PL_HashTableEnumerateEntries(sct->sct_stripes[i].scs_hashtable,
+                                         parent_subcount_free_entry, NULL);
+            PL_HashTableDestroy(sct->sct_stripes[i].scs_hashtable);
+            PR_DestroyLock(sct->sct_stripes[i].scs_lock);
+        }
+        slapi_ch_free((void **)&sct);
+        inst->inst_subcount = NULL;
+    }
+    PR_Unlock(inst->inst_subcount_mutex);
+
+    return rc;
+}
+
+/* Event queue callback flushing the instances whose interval elapsed */
+void
+parent_subcount_flush_event(time_t when __attribute__((unused)), void *arg)
+{
+    struct ldbminfo *li = (struct ldbminfo *)arg;
+    Object *inst_obj = NULL;
+    ldbm_instance *inst = NULL;
+    int shutdown;
+
+    PR_Lock(li->li_shutdown_mutex);
+    shutdown = li->li_shutdown;
+    PR_Unlock(li->li_shutdown_mutex);
+    if (shutdown) {
+        return;
+    }
+
+    for (inst_obj = objset_first_obj(li->li_instance_set); inst_obj;
+         inst_obj = objset_next_obj(li->li_instance_set, inst_obj)) {
+        inst = (ldbm_instance *)object_get_data(inst_obj);
+        parent_subcount_flush(inst->inst_be, 0);
+    }
+}
@@ -87,6 +87,8 @@ int dblayer_release_index_file(backend *be, struct attrinfo *a, dbi_db_t *pDB);
 int dblayer_erase_index_file(backend *be, struct attrinfo *a, PRBool use_lock, int no_force_chkpt);
 int dblayer_get_id2entry(backend *be, dbi_db_t **ppDB);
 int dblayer_get_changelog(backend *be, dbi_db_t ** ppDB, int create);
+int dblayer_get_id2values(backend *be, dbi_db_t ** ppDB, int create);
+int dblayer_close_id2values(backend *be);
 int dblayer_release_id2entry(backend *be, dbi_db_t *pDB);
 void dblayer_destroy_txn_stack(void);
 int dblayer_txn_init(struct ldbminfo *li, back_txn *txn);
@@ -107,7 +109,7 @@ void dblayer_lock_backend(backend *be);
 int dblayer_plugin_begin(Slapi_PBlock *pb);
 int dblayer_plugin_commit(Slapi_PBlock *pb);
 int dblayer_plugin_abort(Slapi_PBlock *pb);
-int dblayer_backup(struct ldbminfo *li, char *destination_directory, Slapi_Task *task);
+int dblayer_backup(struct ldbminfo *li, char *destination_directory, const char *base_dir, Slapi_Task *task);
 int dblayer_restore(struct ldbminfo *li, char *source_directory, Slapi_Task *task);
 int dblayer_delete_database(struct ldbminfo *li);
 int dblayer_close_indexes(backend *be);
@@ -160,6 +162,11 @@ struct backentry *uniqueid2entry(backend *be, const char *uniqueid, back_txn *tx
 IDList *filter_candidates(Slapi_PBlock *pb, backend *be, const char *base, Slapi_Filter *f, Slapi_Filter *nextf, int range, int *err);
 IDList *filter_candidates_ext(Slapi_PBlock *pb, backend *be, const char *base, Slapi_Filter *f, Slapi_Filter *nextf, int range, int *err, int allidslimit);
 
+/*
+ * substrpos.c
+ */
+IDList *substrpos_candidates(Slapi_PBlock *pb, backend *be, struct attrinfo *ai, char *type, char *initial, char **any, char * final, back_txn *txn, int allidslimit, int *exact);
+
 /*
  * findentry.c
  */
@@ -185,6 +192,16 @@ int id2entry_add_ext(backend *be, struct backentry *e, back_txn *txn, int encryp
 int id2entry_delete(backend *be, struct backentry *e, back_txn *txn);
 struct backentry *id2entry(backend *be, ID id, back_txn *txn, int *err);
 
+/*
+ * id2values.c
+ */
+int id2values_store(backend *be, ID id, Slapi_Entry *e, back_txn *txn, id2values_detached **detached);
+void id2values_reattach(Slapi_Entry *e, id2values_detached **detached);
+int id2values_delete(backend *be, ID id, back_txn *txn);
+char *id2values_merge(backend *be, ID id, const char *entrystr, back_txn *txn, int *err);
+void id2values_activate(ldbm_instance *inst);
+void id2values_instance_start(backend *be);
+
 /*
  * idl.c
  */
@@ -248,6 +265,18 @@ int64_t idl_set_union_shortcut(IDListSet *idl_set);
 int64_t idl_set_intersection_shortcut(IDListSet *idl_set);
 IDList *idl_set_union(IDListSet *idl_set, backend *be);
 IDList *idl_set_intersect(IDListSet *idl_set, backend *be);
+size_t idl_set_minimum_nids(IDListSet *idl_set);
+
+/*
+ * index_stats.c
+ */
+void index_stats_init(struct attrinfo *ai);
+void index_stats_free(struct attrinfo *ai);
+void index_stats_note_read(struct attrinfo *ai, const dbi_val_t *key, IDList *idl);
+void index_stats_note_write(struct attrinfo *ai, const dbi_val_t *key, int delta);
+uint64_t index_stats_key_estimate(struct attrinfo *ai, const dbi_val_t *key);
+uint64_t index_stats_type_estimate(struct attrinfo *ai, const char *indextype);
+void index_stats_reset(struct attrinfo *ai);
 
 /*
  * index.c
@@ -262,6 +291,7 @@ int id_array_init(Id_Array *new_guy, int size);
 IDList *index_read(backend *be, const char *type, const char *indextype, const struct berval *val, back_txn *txn, int *err);
 IDList *index_read_ext(backend *be, char *type, const char *indextype, const struct berval *val, back_txn *txn, int *err, int *unindexed);
 IDList *index_read_ext_allids(Slapi_PBlock *pb, backend *be, char *type, const char *indextype, const struct berval *val, back_txn *txn, int *err, int *unindexed, int allidslimit);
+uint64_t index_read_estimate(backend *be, char *type, const char *indextype, const struct berval *val, int *known);
 IDList *index_range_read(Slapi_PBlock *pb, backend *be, char *type, const char *indextype, int ftype, struct berval *val, struct berval *nextval, int range, back_txn *txn, int *err);
 IDList *index_range_read_ext(Slapi_PBlock *pb, backend *be, char *type, const char *indextype, int ftype, struct berval *val, struct berval *nextval, int range, back_txn *txn, int *err, int allidslimit);
 const char *encode(const struct berval *data, char buf[BUFSIZ]);
@@ -376,7 +406,14 @@ void backdn_free(struct backdn **bdn);
 /*
  * parents.c
  */
-int parent_update_on_childchange(modify_context *mc, int op, size_t *numofchildren);
+int parent_update_on_childchange(backend *be, modify_context *mc, int op, size_t *numofchildren);
+void parent_subcount_apply(backend *be, modify_context *mc, int revert);
+int parent_subcount_get(backend *be, ID id, size_t *count, size_t *tombstone_count);
+int parent_has_children(backend *be, struct backentry *e, int include_tombstone);
+int parent_subcount_get_info(backend *be, struct _back_info_subordinates *info);
+void parent_subcount_forget(backend *be, ID id);
+int parent_subcount_flush(backend *be, int destroy);
+void parent_subcount_flush_event(time_t when, void *arg);
 
 /*
  * perfctrs.c
@@ -637,6 +674,7 @@ int
 entryrdn_index_read_ext(backend *be, const Slapi_DN *sdn, ID *id, int flags, back_txn *txn);
 int entryrdn_rename_subtree(backend *be, const Slapi_DN *oldsdn, Slapi_RDN *newsrdn, const Slapi_DN *newsupsdn, ID id, back_txn *txn, int flags);
 int entryrdn_get_subordinates(backend *be, const Slapi_DN *sdn, ID id, IDList **subordinates, back_txn *txn, int flags);
+int entryrdn_count_children(backend *be, ID id, uint64_t *count, uint64_t *tombstone_count, back_txn *txn);
 int entryrdn_lookup_dn(backend *be, const char *rdn, ID id, char **dn, Slapi_RDN **psrdn, back_txn *txn);
 int entryrdn_get_parent(backend *be, const char *rdn, ID id, char **prdn, ID *pid, back_txn *txn);
 int entryrdn_compare_rdn_elem(const void *elem_a, const void *elem_b);
@@ -169,6 +169,12 @@ ldbm_back_start(Slapi_PBlock *pb)
     /* initialize the USN counter */
     ldbm_usn_init(li);
 
+    /* flush the subordinate counts kept in memory, see parents.c */
+    if (NULL == li->li_subcount_flush_ctx) {
+        li->li_subcount_flush_ctx = slapi_eq_repeat_rel(parent_subcount_flush_event, li,
+                                                        slapi_current_rel_time_t() + 1, 1000);
+    }
+
     slapi_log_err(SLAPI_LOG_TRACE, "ldbm_back_start", "ldbm backend done starting\n");
 
     return (0);
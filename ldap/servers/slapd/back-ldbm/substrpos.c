@@ -0,0 +1,413 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+/*
+ * Positional substring index (nsSubStrPositional: on)
+ *
+ * The middle n-grams of the values are also indexed with their position,
+ * see INDEX_SUBSTRPOS in slap.h. For a substring assertion, the postings
+ * (ID, value hash, offset, value length) of the n-grams of the components
+ * are read by walking the keys "*<n-gram>\001...", then:
+ *  - a component occurs at the offsets where its n-grams are adjacent. Only
+ *    the n-grams covering the component are read, e.g. "smi" and "ith" for
+ *    "smith",
+ *  - the initial component must be at offset 0, the final one must end the
+ *    value,
+ *  - the components must occur in order, without overlapping, in the same
+ *    value.
+ * This is what the filter test checks. A component shorter than an n-gram
+ * can not be checked: the remaining ones still reduce the candidates but
+ * the filter test is needed. When every component is checked, the
+ * candidates are exact.
+ */
+
+#include "back-ldbm.h"
+#include "dblayer.h"
+
+typedef struct substrpos_posting
+{
+    ID id;
+    uint32_t offset; /* of the n-gram or component in the value */
+    uint32_t length; /* of the value */
+    uint64_t hash;   /* of the value */
+} substrpos_posting;
+
+typedef struct substrpos_list
+{
+    substrpos_posting *p;
+    size_t count;
+    size_t size;
+} substrpos_list;
+
+typedef struct substrpos_comp
+{
+    char kind;              /* '^', '*' or '$' */
+    uint32_t length;        /* normalized length */
+    const char **ngrams;    /* n-grams, by offset in the component */
+    size_t nngrams;
+    int verified;           /* occ holds all the occurrences */
+    substrpos_list occ;     /* offset is the start of the component */
+} substrpos_comp;
+
+typedef struct substrpos_scan
+{
+    char *prefix; /* "*<n-gram>\001" */
+    size_t prefixlen;
+    substrpos_list *list;
+    size_t limit;
+    int overflow;
+    struct timespec *expire_time;
+} substrpos_scan;
+
+static void
+substrpos_list_add(substrpos_list *list, const substrpos_posting *posting)
+{
+    if (list->count == list->size) {
+        list->size = list->size ? list->size * 2 : 64;
+        list->p = (substrpos_posting *)slapi_ch_realloc((char *)list->p, list->size * sizeof(substrpos_posting));
+    }
+    list->p[list->count++] = *posting;
+}
+
+static void
+substrpos_list_done(substrpos_list *list)
+{
+    slapi_ch_free((void **)&list->p);
+    list->count = list->size = 0;
+}
+
+static int
+substrpos_posting_cmp(const void *x, const void *y)
+{
+    const substrpos_posting *a = x;
+    const substrpos_posting *b = y;
+
+    if (a->id != b->id) {
+        return a->id < b->id ? -1 : 1;
+    }
+    if (a->hash != b->hash) {
+        return a->hash < b->hash ? -1 : 1;
+    }
+    if (a->offset != b->offset) {
+        return a->offset < b->offset ? -1 : 1;
+    }
+    return 0;
+}
+
+/* First posting >= (id, hash, offset) in a sorted list, or NULL */
+static substrpos_posting *
+substrpos_lower_bound(substrpos_list *list, ID id, uint64_t hash, uint32_t offset)
+{
+    substrpos_posting key = {id, offset, 0, hash};
+    size_t lo = 0;
+    size_t hi = list->count;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (substrpos_posting_cmp(&list->p[mid], &key) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < list->count ? &list->p[lo] : NULL;
+}
+
+static int
+substrpos_scan_cb(dbi_val_t *key, dbi_val_t *data, void *ctx)
+{
+    substrpos_scan *scan = ctx;
+    substrpos_posting posting = {0};
+    char buf[64];
+    size_t len;
+
+    if (key->data == NULL || key->size < scan->prefixlen ||
+        memcmp(key->data, scan->prefix, scan->prefixlen) != 0) {
+        /* past the keys of this n-gram */
+        return DBI_RC_NOTFOUND;
+    }
+    if (data->size != sizeof(ID)) {
+        scan->overflow = 1;
+        return DBI_RC_NOTFOUND;
+    }
+    if (scan->list->count >= scan->limit ||
+        ((scan->list->count & 0xff) == 0 &&
+         slapi_timespec_expire_check(scan->expire_time) == TIMER_EXPIRED)) {
+        scan->overflow = 1;
+        return DBI_RC_NOTFOUND;
+    }
+    len = key->size - scan->prefixlen;
+    if (len >= sizeof(buf)) {
+        return DBI_RC_SUCCESS;
+    }
+    memcpy(buf, (char *)key->data + scan->prefixlen, len);
+    buf[len] = '\0';
+    if (sscanf(buf, "%" SCNx64 ":%" SCNx32 ":%" SCNx32, &posting.hash, &posting.offset, &posting.length) != 3) {
+        return DBI_RC_SUCCESS;
+    }
+    memcpy(&posting.id, data->data, sizeof(ID));
+    substrpos_list_add(scan->list, &posting);
+    return DBI_RC_SUCCESS;
+}
+
+/* Reads the postings of an n-gram, returns 0 or -1 if there are too many */
+static int
+substrpos_read(backend *be, dbi_db_t *db, dbi_txn_t *db_txn, const char *ngram, size_t ngramlen, size_t limit, struct timespec *expire_time, substrpos_list *list)
+{
+    struct ldbminfo *li = (struct ldbminfo *)be->be_database->plg_private;
+    dbi_cursor_t cursor = {0};
+    dbi_val_t startkey = {0};
+    substrpos_scan scan = {0};
+    back_txn s_txn;
+    int ret;
+
+    scan.prefixlen = ngramlen + 2;
+    scan.prefix = (char *)slapi_ch_malloc(scan.prefixlen + 1);
+    scan.prefix[0] = SUB_PREFIX;
+    memcpy(scan.prefix + 1, ngram, ngramlen);
+    scan.prefix[ngramlen + 1] = INDEX_SUBSTRPOS_SEP;
+    scan.prefix[ngramlen + 2] = '\0';
+    scan.list = list;
+    scan.limit = limit;
+    scan.expire_time = expire_time;
+
+    dblayer_txn_init(li, &s_txn);
+    if (db_txn) {
+        dblayer_read_txn_begin(be, db_txn, &s_txn);
+    }
+    ret = dblayer_new_cursor(be, db, s_txn.back_txn_txn, &cursor);
+    if (ret == 0) {
+        dblayer_value_set_buffer(be, &startkey, scan.prefix, scan.prefixlen);
+        ret = dblayer_cursor_iterate(&cursor, substrpos_scan_cb, &startkey, &scan);
+        if (ret == DBI_RC_NOTFOUND) {
+            ret = 0;
+        }
+        dblayer_cursor_op(&cursor, DBI_OP_CLOSE, NULL, NULL);
+    }
+    if (ret) {
+        slapi_log_err(SLAPI_LOG_ERR, "substrpos_read",
+                      "Failed to read the positional keys %s, error %d\n", scan.prefix, ret);
+        dblayer_read_txn_abort(be, &s_txn);
+    } else {
+        dblayer_read_txn_commit(be, &s_txn);
+    }
+    slapi_ch_free_string(&scan.prefix);
+    return (ret || scan.overflow) ? -1 : 0;
+}
+
+/*
+ * Finds the occurrences of a component: the offsets where the n-grams
+ * covering it are adjacent, in the same value.
+ */
+static int
+substrpos_comp_occurrences(backend *be, dbi_db_t *db, dbi_txn_t *db_txn, substrpos_comp *comp, size_t ngramlen, size_t limit, struct timespec *expire_time)
+{
+    size_t *offsets = (size_t *)slapi_ch_calloc(comp->nngrams, sizeof(size_t));
+    substrpos_list *lists = (substrpos_list *)slapi_ch_calloc(comp->nngrams, sizeof(substrpos_list));
+    size_t nsel = 0;
+    int rc = 0;
+
+    /* n-grams covering the component without overlap, plus the last one */
+    for (size_t off = 0; off < comp->nngrams; off += ngramlen) {
+        offsets[nsel++] = off;
+    }
+    if (offsets[nsel - 1] != comp->nngrams - 1) {
+        offsets[nsel++] = comp->nngrams - 1;
+    }
+    for (size_t i = 0; i < nsel; i++) {
+        if (substrpos_read(be, db, db_txn, comp->ngrams[offsets[i]], ngramlen, limit, expire_time, &lists[i])) {
+            rc = -1;
+            goto done;
+        }
+        qsort(lists[i].p, lists[i].count, sizeof(substrpos_posting), substrpos_posting_cmp);
+    }
+
+    for (size_t k = 0; k < lists[0].count; k++) {
+        substrpos_posting occ = lists[0].p[k];
+        size_t i;
+
+        if ((comp->kind == '^' && occ.offset != 0) ||
+            (comp->kind == '$' && occ.offset + comp->length != occ.length)) {
+            continue;
+        }
+        for (i = 1; i < nsel; i++) {
+            substrpos_posting *p = substrpos_lower_bound(&lists[i], occ.id, occ.hash, occ.offset + offsets[i]);
+            if (p == NULL || p->id != occ.id || p->hash != occ.hash || p->offset != occ.offset + offsets[i]) {
+                break;
+            }
+        }
+        if (i == nsel) {
+            substrpos_list_add(&comp->occ, &occ);
+        }
+    }
+    comp->verified = 1;
+
+done:
+    for (size_t i = 0; i < nsel; i++) {
+        substrpos_list_done(&lists[i]);
+    }
+    slapi_ch_free((void **)&lists);
+    slapi_ch_free((void **)&offsets);
+    return rc;
+}
+
+/*
+ * Returns the candidates of a substring filter using the positional keys,
+ * or NULL if the index has no positional keys or they can not be used.
+ * *exact is set if the candidates do not need the filter test.
+ */
+IDList *
+substrpos_candidates(
+    Slapi_PBlock *pb,
+    backend *be,
+    struct attrinfo *ai,
+    char *type,
+    char *initial,
+    char **any,
+    char * final,
+    back_txn *txn,
+    int allidslimit,
+    int *exact)
+{
+    int substrlens[INDEX_SUBSTRLEN];
+    Slapi_Value **descs = NULL;
+    Slapi_Attr sattr;
+    substrpos_comp *comps = NULL;
+    size_t ncomps = 0;
+    size_t nverified = 0;
+    size_t ngramlen;
+    dbi_db_t *db = NULL;
+    dbi_txn_t *db_txn = txn ? txn->back_txn_txn : NULL;
+    Slapi_Operation *op = NULL;
+    struct timespec expire_time = {0};
+    int timelimit = -1;
+    size_t limit;
+    IDList *idl = NULL;
+    substrpos_comp *first = NULL;
+
+    *exact = 0;
+    if (ai->ai_substr_lens == NULL || ai->ai_substr_lens[INDEX_SUBSTRPOS] != INDEX_SUBSTRPOS_INDEX ||
+        !idl_get_idl_new()) {
+        return NULL;
+    }
+
+    /* get the n-grams of the components */
+    memcpy(substrlens, ai->ai_substr_lens, sizeof(substrlens));
+    substrlens[INDEX_SUBSTRPOS] = INDEX_SUBSTRPOS_QUERY;
+    slapi_pblock_set(pb, SLAPI_SYNTAX_SUBSTRLENS, substrlens);
+    slapi_attr_init(&sattr, type);
+    slapi_attr_assertion2keys_sub_sv_pb(pb, &sattr, initial, any, final, &descs);
+    attr_done(&sattr);
+    slapi_pblock_set(pb, SLAPI_SYNTAX_SUBSTRLENS, ai->ai_substr_lens);
+    if (descs == NULL || *descs == NULL) {
+        goto done;
+    }
+    /* the syntax sets the default lengths */
+    ngramlen = substrlens[INDEX_SUBSTRMIDDLE];
+
+    ncomps = (initial ? 1 : 0) + (final ? 1 : 0);
+    for (size_t i = 0; any && any[i]; i++) {
+        ncomps++;
+    }
+    comps = (substrpos_comp *)slapi_ch_calloc(ncomps, sizeof(substrpos_comp));
+    for (Slapi_Value **d = descs; *d; d++) {
+        const struct berval *bv = slapi_value_get_berval(*d);
+        uint32_t c, offset, length;
+        char kind;
+
+        if (bv->bv_len <= ngramlen || bv->bv_val[ngramlen] != INDEX_SUBSTRPOS_SEP ||
+            sscanf(bv->bv_val + ngramlen + 1, "%" SCNx32 ":%c:%" SCNx32 ":%" SCNx32, &c, &kind, &offset, &length) != 4 ||
+            c >= ncomps || offset != comps[c].nngrams) {
+            /* not a descriptor: the syntax does not support the positional keys */
+            goto done;
+        }
+        comps[c].kind = kind;
+        comps[c].length = length;
+        comps[c].ngrams = (const char **)slapi_ch_realloc((char *)comps[c].ngrams, (offset + 1) * sizeof(char *));
+        comps[c].ngrams[comps[c].nngrams++] = bv->bv_val;
+    }
+
+    if (dblayer_get_index_file(be, ai, &db, DBOPEN_CREATE) != 0) {
+        goto done;
+    }
+    slapi_pblock_get(pb, SLAPI_OPERATION, &op);
+    if (op) {
+        slapi_pblock_get(pb, SLAPI_SEARCH_TIMELIMIT, &timelimit);
+        slapi_operation_time_expiry(op, (time_t)timelimit, &expire_time);
+    }
+    limit = allidslimit > 0 ? (size_t)allidslimit : SIZE_MAX;
+    for (size_t c = 0; c < ncomps; c++) {
+        if (comps[c].nngrams &&
+            substrpos_comp_occurrences(be, db, db_txn, &comps[c], ngramlen, limit, &expire_time) == 0) {
+            nverified++;
+        }
+    }
+    dblayer_release_index_file(be, ai, db);
+    if (nverified == 0) {
+        goto done;
+    }
+
+    /*
+     * For each value having the first checked component, place the
+     * checked components in order, each one at its first occurrence after
+     * the previous one.
+     */
+    idl = idl_alloc(IDLIST_MIN_BLOCK_SIZE);
+    for (size_t c = 0; c < ncomps; c++) {
+        if (comps[c].verified) {
+            first = first ? first : &comps[c];
+            qsort(comps[c].occ.p, comps[c].occ.count, sizeof(substrpos_posting), substrpos_posting_cmp);
+        }
+    }
+    for (size_t k = 0; k < first->occ.count; k++) {
+        substrpos_posting *occ = &first->occ.p[k];
+        uint32_t end = occ->offset + first->length;
+        size_t c;
+
+        if (k > 0 && occ->id == first->occ.p[k - 1].id && occ->hash == first->occ.p[k - 1].hash) {
+            /* the first occurrence in this value was already tried */
+            continue;
+        }
+        if (idl->b_nids && idl->b_ids[idl->b_nids - 1] == occ->id) {
+            continue;
+        }
+        for (c = (first - comps) + 1; c < ncomps; c++) {
+            substrpos_posting *p;
+
+            if (!comps[c].verified) {
+                continue;
+            }
+            p = substrpos_lower_bound(&comps[c].occ, occ->id, occ->hash, end);
+            if (p == NULL || p->id != occ->id || p->hash != occ->hash) {
+                break;
+            }
+            end = p->offset + comps[c].length;
+        }
+        if (c == ncomps) {
+            idl_append_extend(&idl, occ->id);
+        }
+    }
+
+    /* the filter test trims the leading blanks of the initial component */
+    *exact = (nverified == ncomps) && !(initial && *initial == ' ');
+
+    slapi_log_err(SLAPI_LOG_FILTER, "substrpos_candidates", "%s: %lu candidates, %lu/%lu components checked\n",
+                  type, (u_long)IDL_NIDS(idl), (u_long)nverified, (u_long)ncomps);
+done:
+    for (size_t c = 0; c < ncomps; c++) {
+        slapi_ch_free((void **)&comps[c].ngrams);
+        substrpos_list_done(&comps[c].occ);
+    }
+    slapi_ch_free((void **)&comps);
+    valuearray_free(&descs);
+    return idl;
+}
@@ -982,6 +982,87 @@ vlv_update_index(struct vlvIndex *p, back_txn *txn, struct ldbminfo *li, Slapi_P
     return return_value;
 }
 
+/*
+ * Check whether the attributes of a base type differ between two entries.
+ * The values are compared as stored, in order, so that equal attributes are
+ * known to give the same filter results and the same VLV keys.
+ */
+static int
+vlv_type_changed(const Slapi_Entry *oldEntry, const Slapi_Entry *newEntry, const char *basetype)
+{
+    const Slapi_Entry *entries[2] = {oldEntry, newEntry};
+    int count[2] = {0, 0};
+    Slapi_Attr *a = NULL;
+    Slapi_Attr *na = NULL;
+
+    for (size_t i = 0; i < 2; i++) {
+        for (slapi_entry_first_attr(entries[i], &a); a != NULL; slapi_entry_next_attr(entries[i], a, &a)) {
+            Slapi_Value **va, **nva;
+
+            if (slapi_attr_type_cmp(basetype, a->a_type, SLAPI_TYPE_CMP_BASE) != 0) {
+                continue;
+            }
+            count[i]++;
+            if (i == 1) {
+                continue;
+            }
+            /* Same type in the new entry with the same values */
+            if (slapi_entry_attr_find(newEntry, a->a_type, &na) != 0 ||
+                slapi_attr_type_cmp(a->a_type, na->a_type, SLAPI_TYPE_CMP_EXACT) != 0 ||
+                slapi_valueset_count(&a->a_present_values) != slapi_valueset_count(&na->a_present_values)) {
+                return 1;
+            }
+            va = valueset_get_valuearray(&a->a_present_values);
+            nva = valueset_get_valuearray(&na->a_present_values);
+            for (size_t v = 0; va && va[v]; v++) {
+                const struct berval *bv = slapi_value_get_berval(va[v]);
+                const struct berval *nbv = slapi_value_get_berval(nva[v]);
+                if (bv->bv_len != nbv->bv_len || memcmp(bv->bv_val, nbv->bv_val, bv->bv_len) != 0) {
+                    return 1;
+                }
+            }
+        }
+    }
+    return count[0] != count[1];
+}
+
+/*
+ * Check whether any of the types differ between the entries. The types found
+ * changed or unchanged are remembered, the VLV searches share most of them.
+ */
+static int
+vlv_types_changed(const Slapi_Entry *oldEntry, const Slapi_Entry *newEntry, char **types, char ***changed, char ***unchanged)
+{
+    for (size_t i = 0; types && types[i]; i++) {
+        if (charray_inlist(*changed, types[i])) {
+            return 1;
+        }
+        if (charray_inlist(*unchanged, types[i])) {
+            continue;
+        }
+        if (vlv_type_changed(oldEntry, newEntry, types[i])) {
+            charray_add(changed, slapi_ch_strdup(types[i]));
+            return 1;
+        }
+        charray_add(unchanged, slapi_ch_strdup(types[i]));
+    }
+    return 0;
+}
+
+static int
+vlv_sortkeys_changed(const Slapi_Entry *oldEntry, const Slapi_Entry *newEntry, struct vlvIndex *p, char ***changed, char ***unchanged)
+{
+    char *type[2] = {NULL, NULL};
+    int rc = 0;
+
+    for (size_t i = 0; rc == 0 && p->vlv_sortkey && p->vlv_sortkey[i]; i++) {
+        type[0] = slapi_attr_basetype(p->vlv_sortkey[i]->sk_attrtype, NULL, 0);
+        rc = vlv_types_changed(oldEntry, newEntry, type, changed, unchanged);
+        slapi_ch_free_string(&type[0]);
+    }
+    return rc;
+}
+
 /*
  * Given an entry modification check if a VLV index needs to be updated.
  *
@@ -994,8 +1075,10 @@ vlv_update_index(struct vlvIndex *p, back_txn *txn, struct ldbminfo *li, Slapi_P
  * DEL: oldEntry!=NULL && newEntry==NULL
  * MOD: oldEntry!=NULL && newEntry!=NULL
  *
- * JCM: If only non-sorted attributes are changed, then the indexes don't need updating.
- * JCM: Detecting this fact, given multi-valued atribibutes, might be tricky...
+ * MOD of an entry keeping its DN: an index is left alone when neither the
+ * types tested by its search filter nor its sort types changed, the entry
+ * has the same key in it or is still out of it.
+ *
  * Read lock (traverse vlvSearchList; no change on vlvSearchList/vlvIndex lists)
  */
 
@@ -1005,15 +1088,35 @@ vlv_update_all_indexes(back_txn *txn, backend *be, Slapi_PBlock *pb, struct back
     int return_value = LDAP_SUCCESS;
     struct vlvSearch *ps = NULL;
     struct ldbminfo *li = ((ldbm_instance *)be->be_instance_info)->inst_li;
+    char **changed = NULL;
+    char **unchanged = NULL;
+    int samedn = 0;
+
+    if (oldEntry != NULL && newEntry != NULL) {
+        samedn = (slapi_sdn_compare(backentry_get_sdn(oldEntry), backentry_get_sdn(newEntry)) == 0);
+    }
 
     slapi_rwlock_rdlock(be->vlvSearchList_lock);
     ps = (struct vlvSearch *)be->vlvSearchList;
     for (; ps != NULL; ps = ps->vlv_next) {
         struct vlvIndex *pi = ps->vlv_index;
-        for (return_value = LDAP_SUCCESS; return_value == LDAP_SUCCESS && pi != NULL; pi = pi->vlv_next)
+        int filterchanged = 1;
+
+        if (samedn && !ps->vlv_filter_anytype) {
+            filterchanged = vlv_types_changed(oldEntry->ep_entry, newEntry->ep_entry,
+                                              ps->vlv_filter_types, &changed, &unchanged);
+        }
+        for (return_value = LDAP_SUCCESS; return_value == LDAP_SUCCESS && pi != NULL; pi = pi->vlv_next) {
+            if (samedn && !filterchanged &&
+                !vlv_sortkeys_changed(oldEntry->ep_entry, newEntry->ep_entry, pi, &changed, &unchanged)) {
+                continue;
+            }
             return_value = vlv_update_index(pi, txn, li, pb, oldEntry, newEntry);
+        }
     }
     slapi_rwlock_unlock(be->vlvSearchList_lock);
+    charray_free(changed);
+    charray_free(unchanged);
     return return_value;
 }
 
@@ -70,6 +70,52 @@ trimspaces(char *s)
     }
 }
 
+/*
+ * Collect the base types tested by a filter, so that an update not
+ * touching them is known to leave the filter result unchanged.
+ */
+static void
+vlvSearch_collect_filter_types(struct vlvSearch *p, Slapi_Filter *f)
+{
+    Slapi_Filter *fi;
+    char *type = NULL;
+    char *basetype = NULL;
+
+    switch (slapi_filter_get_choice(f)) {
+    case LDAP_FILTER_AND:
+    case LDAP_FILTER_OR:
+    case LDAP_FILTER_NOT:
+        for (fi = slapi_filter_list_first(f); fi != NULL; fi = slapi_filter_list_next(f, fi)) {
+            vlvSearch_collect_filter_types(p, fi);
+        }
+        break;
+    default:
+        if (slapi_filter_get_attribute_type(f, &type) != 0 || type == NULL) {
+            /* e.g. an extensible match without a type */
+            p->vlv_filter_anytype = 1;
+            break;
+        }
+        basetype = slapi_attr_basetype(type, NULL, 0);
+        if (!charray_inlist(p->vlv_filter_types, basetype)) {
+            charray_add(&p->vlv_filter_types, basetype);
+        } else {
+            slapi_ch_free_string(&basetype);
+        }
+        break;
+    }
+}
+
+static void
+vlvSearch_set_filter_types(struct vlvSearch *p)
+{
+    charray_free(p->vlv_filter_types);
+    p->vlv_filter_types = NULL;
+    p->vlv_filter_anytype = 0;
+    if (p->vlv_slapifilter) {
+        vlvSearch_collect_filter_types(p, p->vlv_slapifilter);
+    }
+}
+
 /*
  * Re-Initialise a vlvSearch object
  */
@@ -92,6 +138,7 @@ vlvSearch_reinit(struct vlvSearch *p, const struct backentry *base)
     /* make (&(parentid=idofbase)(|(originalfilter)(objectclass=referral))) */
     p->vlv_slapifilter = create_onelevel_filter(p->vlv_slapifilter, base, 0 /* managedsait */);
     slapi_filter_optimise(p->vlv_slapifilter);
+    vlvSearch_set_filter_types(p);
 }
 
 /*
@@ -180,6 +227,7 @@ vlvSearch_init(struct vlvSearch *p, Slapi_PBlock *pb, const Slapi_Entry *e, ldbm
         slapi_filter_optimise(p->vlv_slapifilter);
     } break;
     }
+    vlvSearch_set_filter_types(p);
 }
 
 /*
@@ -198,6 +246,7 @@ vlvSearch_delete(struct vlvSearch **ppvs)
         slapi_sdn_free(&((*ppvs)->vlv_base));
         slapi_ch_free((void **)&((*ppvs)->vlv_filter));
         slapi_filter_free((*ppvs)->vlv_slapifilter, 1);
+        charray_free((*ppvs)->vlv_filter_types);
         for (pi = (*ppvs)->vlv_index; pi != NULL;) {
             ni = pi->vlv_next;
             if (pi->vlv_be != NULL) {
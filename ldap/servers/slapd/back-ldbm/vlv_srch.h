@@ -55,6 +55,10 @@ struct vlvSearch
     /* Derived from the VLV Entry */
     Slapi_Filter *vlv_slapifilter;
 
+    /* Base types tested by vlv_slapifilter, unless it may test any type */
+    char **vlv_filter_types;
+    int vlv_filter_anytype;
+
     /* List of Indexes for this Search */
     struct vlvIndex *vlv_index;
 
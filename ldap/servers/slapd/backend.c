@@ -176,6 +176,7 @@ be_addsuffix(Slapi_Backend *be, const Slapi_DN *suffix)
     if (be->be_state != BE_STATE_DELETED) {
         slapi_sdn_free(&be->be_suffix);
         be->be_suffix = slapi_sdn_dup(suffix);
+        slapi_sdn_intern(be->be_suffix);
     }
 }
 
@@ -786,6 +786,10 @@ do_bind(Slapi_PBlock *pb)
                     } else {
                         pb_conn->c_bind_auth_token = 1;
                     }
+                    if (rc == SLAPI_BIND_BUSY) {
+                        /* LDAP_BUSY was sent: not a failed bind, the password was not checked */
+                        goto free_and_return;
+                    }
                     if (rc != SLAPI_BIND_SUCCESS) {
                         /* Invalid pass - lets bail ... */
                         goto bind_failed;
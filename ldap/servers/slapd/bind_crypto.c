@@ -0,0 +1,123 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+/*
+ * Bind password verification limit
+ *
+ * Comparing a bind password with a PBKDF2/crypt hash is deliberately slow,
+ * and it is done by the worker thread of the bind: operations are run start
+ * to finish by a single worker thread, they can not be suspended while
+ * another thread hashes the password.
+ *
+ * nsslapd-bind-crypto-max-pending bounds the number of binds verifying a
+ * password at the same time. Above it, binds fail at once with LDAP_BUSY
+ * instead of tying up more worker threads in the hashing, which keeps the
+ * other worker threads available for the other operations.
+ *
+ * The pending verifications and the hash times are published in
+ * cn=bind crypto,cn=monitor.
+ */
+
+#include <pthread.h>
+#include "slap.h"
+
+static pthread_mutex_t bind_crypto_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* statistics */
+static uint64_t bind_crypto_pending = 0; /* running verifications */
+static uint64_t bind_crypto_peak_pending = 0;
+static uint64_t bind_crypto_verifications = 0;
+static uint64_t bind_crypto_rejected = 0;
+static uint64_t bind_crypto_hash_nsec = 0;
+static uint64_t bind_crypto_hash_max_nsec = 0;
+
+/*
+ * Same as slapi_pw_find_sv: 0 if the credential matches one of the values,
+ * 1 if it does not, or BIND_CRYPTO_BUSY if too many verifications are
+ * already pending.
+ *
+ * No atomic add/max in the counters API: the statistics are updated under
+ * the lock, which is not held while hashing.
+ */
+int32_t
+bind_crypto_pw_find_sv(Slapi_Value **vals, const Slapi_Value *cred)
+{
+    int32_t max_pending = config_get_bind_crypto_max_pending();
+    struct timespec start;
+    struct timespec now;
+    uint64_t nsec = 0;
+    int32_t rc;
+
+    pthread_mutex_lock(&bind_crypto_lock);
+    if (max_pending > 0 && bind_crypto_pending >= (uint64_t)max_pending) {
+        bind_crypto_rejected++;
+        pthread_mutex_unlock(&bind_crypto_lock);
+        return BIND_CRYPTO_BUSY;
+    }
+    bind_crypto_pending++;
+    if (bind_crypto_pending > bind_crypto_peak_pending) {
+        bind_crypto_peak_pending = bind_crypto_pending;
+    }
+    pthread_mutex_unlock(&bind_crypto_lock);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    rc = slapi_pw_find_sv(vals, cred);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    nsec = (uint64_t)(now.tv_sec - start.tv_sec) * 1000000000ULL + now.tv_nsec - start.tv_nsec;
+
+    pthread_mutex_lock(&bind_crypto_lock);
+    bind_crypto_pending--;
+    bind_crypto_verifications++;
+    bind_crypto_hash_nsec += nsec;
+    if (nsec > bind_crypto_hash_max_nsec) {
+        bind_crypto_hash_max_nsec = nsec;
+    }
+    pthread_mutex_unlock(&bind_crypto_lock);
+    return rc;
+}
+
+static void
+bind_crypto_add_u64(Slapi_Entry *e, const char *type, uint64_t value)
+{
+    char buf[32];
+    struct berval val = {0};
+    struct berval *vals[2] = {&val, NULL};
+
+    val.bv_val = buf;
+    val.bv_len = snprintf(buf, sizeof(buf), "%" PRIu64, value);
+    attrlist_replace(&e->e_attrs, type, vals);
+}
+
+/* cn=bind crypto,cn=monitor, the times are in microseconds */
+void
+bind_crypto_as_entry(Slapi_Entry *e)
+{
+    uint64_t verifications, hash_nsec, hash_max_nsec;
+    uint64_t pending, peak, rejected;
+
+    pthread_mutex_lock(&bind_crypto_lock);
+    verifications = bind_crypto_verifications;
+    hash_nsec = bind_crypto_hash_nsec;
+    hash_max_nsec = bind_crypto_hash_max_nsec;
+    pending = bind_crypto_pending;
+    peak = bind_crypto_peak_pending;
+    rejected = bind_crypto_rejected;
+    pthread_mutex_unlock(&bind_crypto_lock);
+
+    bind_crypto_add_u64(e, "maxPending", config_get_bind_crypto_max_pending());
+    bind_crypto_add_u64(e, "pending", pending);
+    bind_crypto_add_u64(e, "peakPending", peak);
+    bind_crypto_add_u64(e, "verifications", verifications);
+    bind_crypto_add_u64(e, "rejected", rejected);
+    bind_crypto_add_u64(e, "hashTimeAvg", verifications ? hash_nsec / verifications / 1000 : 0);
+    bind_crypto_add_u64(e, "hashTimeMax", hash_max_nsec / 1000);
+}
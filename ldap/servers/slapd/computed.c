@@ -119,6 +119,13 @@ compute_attribute(char *type, Slapi_PBlock *pb, BerElement *ber, Slapi_Entry *e,
     return compute_call_evaluators(&context, compute_output_callback, type, e);
 }
 
+/* Returns the pblock of the operation the attribute is computed for */
+Slapi_PBlock *
+compute_get_pblock(computed_attr_context *c)
+{
+    return c ? c->pb : NULL;
+}
+
 static int
 compute_stock_evaluator(computed_attr_context *c, char *type, Slapi_Entry *e, slapi_compute_output_t outputfn)
 {
@@ -577,6 +577,7 @@ connection_dispatch_operation(Connection *conn, Operation *op, Slapi_PBlock *pb)
     int32_t minssf = conn->c_minssf;
     int32_t minssf_exclude_rootdse = conn->c_minssf_exclude_rootdse;
     int32_t log_format = config_get_accesslog_log_format();
+    struct timespec elapsed;
 
 #ifdef TCP_CORK
     int32_t enable_nagle = conn->c_enable_nagle;
@@ -771,8 +772,14 @@ connection_dispatch_operation(Connection *conn, Operation *op, Slapi_PBlock *pb)
         slapi_log_err(SLAPI_LOG_ERR,
                       "connection_dispatch_operation", "Ignoring unknown LDAP request (conn=%" PRIu64 ", tag=0x%lx)\n",
                       conn->c_connid, op->o_tag);
-        break;
+        return;
     }
+
+    /* The operation type is known now: record its latencies */
+    slapi_operation_workq_time_elapsed(op, &elapsed);
+    latency_record_elapsed(op, LATENCY_PHASE_QUEUE_WAIT, &elapsed);
+    slapi_operation_op_time_elapsed(op, &elapsed);
+    latency_record_elapsed(op, LATENCY_PHASE_OPERATION, &elapsed);
 }
 
 /* this function should be called under c_mutex */
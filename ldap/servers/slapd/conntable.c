@@ -680,6 +680,16 @@ connection_table_as_entry(Connection_Table *ct, Slapi_Entry *e)
     val.bv_len = strlen(buf);
     attrlist_replace(&e->e_attrs, "maxthreadsperconnhits", vals);
 
+    snprintf(buf, sizeof(buf), "%" PRIu64, slapi_counter_get_value(entry_writes));
+    val.bv_val = buf;
+    val.bv_len = strlen(buf);
+    attrlist_replace(&e->e_attrs, "entrywrites", vals);
+
+    snprintf(buf, sizeof(buf), "%" PRIu64, slapi_counter_get_value(entry_write_bytes));
+    val.bv_val = buf;
+    val.bv_len = strlen(buf);
+    attrlist_replace(&e->e_attrs, "entrywritebytes", vals);
+
     snprintf(buf, sizeof(buf), "%d", (ct != NULL ? ct->size : 0));
     val.bv_val = buf;
     val.bv_len = strlen(buf);
@@ -86,6 +86,28 @@ struct ndn_cache {
 static int ndn_cache_lookup(char *dn, size_t dn_len, char **result, char **udn, int *rc);
 static void ndn_cache_add(char *dn, size_t dn_len, char *ndn, size_t ndn_len);
 
+/*
+ * Interned DNs: see dn_intern_get()
+ */
+struct slapi_dn_node
+{
+    struct slapi_dn_node *parent; /* interned parent, NULL for a top level DN */
+    struct slapi_dn_node *next;   /* next node of the hash bucket */
+    uint64_t refcnt;
+    uint64_t hash;
+    uint32_t depth; /* number of RDNs */
+    size_t len;
+    char ndn[]; /* case normalized DN */
+};
+
+#define DN_INTERN_BUCKETS 4096 /* power of 2 */
+#define DN_INTERN_LOCKS 64     /* power of 2 */
+
+static struct slapi_dn_node *dn_intern_get(const char *ndn, size_t len);
+static struct slapi_dn_node *dn_intern_ref(struct slapi_dn_node *node);
+static void dn_intern_release(struct slapi_dn_node *node);
+static int dn_intern_issuffix(const struct slapi_dn_node *node, const struct slapi_dn_node *suffix);
+
 #define ISBLANK(c) ((c) == ' ')
 #define ISBLANKSTR(s) (((*(s)) == '2') && (*((s) + 1) == '0'))
 #define ISSPACE(c) (ISBLANK(c) || ((c) == '\n') || ((c) == '\r')) /* XXX 518524 */
@@ -1885,6 +1907,7 @@ slapi_sdn_init(Slapi_DN *sdn)
     sdn->dn = NULL;
     sdn->ndn = NULL;
     sdn->ndn_len = 0;
+    sdn->node = NULL;
     if (!counters_created) {
         sdn_create_counters();
     }
@@ -2289,6 +2312,10 @@ slapi_sdn_done(Slapi_DN *sdn)
     }
     sdn->flag = slapi_unsetbit_uchar(sdn->flag, FLAG_NDN);
     sdn->ndn_len = 0;
+    if (sdn->node != NULL) {
+        dn_intern_release(sdn->node);
+        sdn->node = NULL;
+    }
     if (sdn->udn != NULL) {
         if (slapi_isbitset_uchar(sdn->flag, FLAG_UDN)) {
             slapi_ch_free((void **)&(sdn->udn));
@@ -2448,6 +2475,11 @@ slapi_sdn_dup(const Slapi_DN *sdn)
     Slapi_DN *tmp;
     SDN_DUMP(sdn, "slapi_sdn_dup");
     tmp = slapi_sdn_new_normdn_byval(slapi_sdn_get_dn(sdn));
+    if (sdn && sdn->node) {
+        /* share the interned DN rather than copying the ndn */
+        tmp->node = dn_intern_ref(sdn->node);
+        tmp->ndn = tmp->node->ndn;
+    }
     return tmp;
 }
 
@@ -2478,7 +2510,12 @@ slapi_sdn_copy(const Slapi_DN *from, Slapi_DN *to)
         PR_INCREMENT_COUNTER(slapi_sdn_counter_dn_created);
         PR_INCREMENT_COUNTER(slapi_sdn_counter_dn_exist);
     }
-    if (from->ndn) {
+    if (from->node) {
+        /* share the interned DN rather than copying the ndn */
+        to->node = dn_intern_ref(from->node);
+        to->ndn = to->node->ndn;
+        to->ndn_len = to->node->len;
+    } else if (from->ndn) {
         to->flag = slapi_setbit_uchar(to->flag, FLAG_NDN);
         to->ndn = slapi_ch_strdup(from->ndn);
         to->ndn_len = strlen(to->ndn);
@@ -2491,8 +2528,18 @@ int
 slapi_sdn_compare(const Slapi_DN *sdn1, const Slapi_DN *sdn2)
 {
     int rc;
-    const char *ndn1 = slapi_sdn_get_ndn(sdn1);
-    const char *ndn2 = slapi_sdn_get_ndn(sdn2);
+    const char *ndn1 = NULL;
+    const char *ndn2 = NULL;
+
+    if (sdn1 && sdn2 && sdn1->node && sdn2->node) {
+        /* Interned DNs are equal only if they are the same node */
+        if (sdn1->node == sdn2->node) {
+            return 0;
+        }
+        return strcmp(sdn1->node->ndn, sdn2->node->ndn);
+    }
+    ndn1 = slapi_sdn_get_ndn(sdn1);
+    ndn2 = slapi_sdn_get_ndn(sdn2);
     if (ndn1 == ndn2) {
         rc = 0;
     } else {
@@ -2523,8 +2570,14 @@ int
 slapi_sdn_issuffix(const Slapi_DN *sdn, const Slapi_DN *suffixsdn)
 {
     int rc;
-    const char *dn = slapi_sdn_get_ndn(sdn);
-    const char *suffixdn = slapi_sdn_get_ndn(suffixsdn);
+    const char *dn = NULL;
+    const char *suffixdn = NULL;
+
+    if (sdn && suffixsdn && sdn->node && suffixsdn->node) {
+        return dn_intern_issuffix(sdn->node, suffixsdn->node);
+    }
+    dn = slapi_sdn_get_ndn(sdn);
+    suffixdn = slapi_sdn_get_ndn(suffixsdn);
     if (dn != NULL && suffixdn != NULL) {
         int dnlen = slapi_sdn_get_ndn_len(sdn);
         int suffixlen = slapi_sdn_get_ndn_len(suffixsdn);
@@ -2560,6 +2613,9 @@ slapi_sdn_isparent(const Slapi_DN *parent, const Slapi_DN *child)
 {
     int rc = 0;
 
+    if (parent && child && parent->node && child->node) {
+        return (child->node->parent == parent->node);
+    }
     /* child is root - has no parent */
     if (!slapi_sdn_isempty(child)) {
         Slapi_DN childparent;
@@ -2576,6 +2632,9 @@ slapi_sdn_isgrandparent(const Slapi_DN *parent, const Slapi_DN *child)
 {
     int rc = 0;
 
+    if (parent && child && parent->node && child->node) {
+        return (child->node->parent && child->node->parent->parent == parent->node);
+    }
     /* child is root - has no parent */
     if (!slapi_sdn_isempty(child)) {
         Slapi_DN childparent;
@@ -2720,6 +2779,226 @@ slapi_sdn_get_size(const Slapi_DN *sdn)
     return sz;
 }
 
+/*
+ *
+ *  Interned DNs
+ *
+ * An interned DN is a refcounted node shared by all the Slapi_DN
+ * that intern the same normalized DN. Each node holds a reference on
+ * the node of its parent DN, so the ancestors of an interned DN are
+ * interned as well and ancestry tests (slapi_sdn_issuffix,
+ * slapi_sdn_isparent, ...) between two interned Slapi_DN are pointer
+ * walks that neither allocate nor compare strings.
+ *
+ * Interning is optional: it is done for the long lived DNs that are
+ * compared over and over (mapping tree nodes, backend suffixes) and
+ * for the operation target and search base they are compared with;
+ * the other Slapi_DN keep using the string comparisons. An interned
+ * Slapi_DN shares the ndn of its node.
+ *
+ * A node is freed (and releases its parent) when its last reference
+ * is released.
+ */
+
+static struct slapi_dn_node *dn_intern_table[DN_INTERN_BUCKETS];
+static pthread_mutex_t dn_intern_locks[DN_INTERN_LOCKS];
+static uint64_t dn_intern_seed = 0;
+static uint64_t dn_intern_count = 0;
+static pthread_once_t dn_intern_once = PTHREAD_ONCE_INIT;
+
+static void
+dn_intern_init(void)
+{
+    for (size_t i = 0; i < DN_INTERN_LOCKS; i++) {
+        pthread_mutex_init(&dn_intern_locks[i], NULL);
+    }
+    /* The search base comes from the clients: do not let them choose the buckets */
+    dn_intern_seed = ((uint64_t)slapi_rand() << 32) ^ (uint64_t)slapi_rand();
+}
+
+/* FNV-1a hash of the ndn */
+static uint64_t
+dn_intern_hash(const char *ndn, size_t len)
+{
+    uint64_t h = 14695981039346656037ULL ^ dn_intern_seed;
+
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)ndn[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static pthread_mutex_t *
+dn_intern_lock(uint64_t hash)
+{
+    return &dn_intern_locks[hash & (DN_INTERN_LOCKS - 1)];
+}
+
+/*
+ * Takes another reference on a node the caller already holds a
+ * reference on: the node can not be freed meanwhile, so the bucket
+ * lock is not needed. Otherwise the references are taken and released
+ * with the bucket lock held.
+ */
+static struct slapi_dn_node *
+dn_intern_ref(struct slapi_dn_node *node)
+{
+    slapi_atomic_incr_64(&node->refcnt, __ATOMIC_ACQ_REL);
+    return node;
+}
+
+/*
+ * Returns a reference on the node of the case normalized DN ndn
+ * (ndn does not need to be NUL terminated), interning the DN and
+ * its ancestors if they are not yet. The reference must be released
+ * with dn_intern_release.
+ */
+static struct slapi_dn_node *
+dn_intern_get(const char *ndn, size_t len)
+{
+    uint64_t hash = 0;
+    pthread_mutex_t *lock = NULL;
+    struct slapi_dn_node **bucket = NULL;
+    struct slapi_dn_node *node = NULL;
+    struct slapi_dn_node *parent = NULL;
+    const char *parentdn = NULL;
+    char *copy = NULL;
+
+    if (ndn == NULL || len == 0) {
+        return NULL;
+    }
+    pthread_once(&dn_intern_once, dn_intern_init);
+    hash = dn_intern_hash(ndn, len);
+    lock = dn_intern_lock(hash);
+    bucket = &dn_intern_table[hash & (DN_INTERN_BUCKETS - 1)];
+
+    pthread_mutex_lock(lock);
+    for (node = *bucket; node; node = node->next) {
+        if (node->hash == hash && node->len == len && memcmp(node->ndn, ndn, len) == 0) {
+            slapi_atomic_incr_64(&node->refcnt, __ATOMIC_ACQ_REL);
+            pthread_mutex_unlock(lock);
+            return node;
+        }
+    }
+    pthread_mutex_unlock(lock);
+
+    /* Not interned yet: get the parent first */
+    copy = slapi_ch_malloc(len + 1);
+    memcpy(copy, ndn, len);
+    copy[len] = '\0';
+    parentdn = slapi_dn_find_parent(copy);
+    if (parentdn && *parentdn) {
+        parent = dn_intern_get(parentdn, len - (parentdn - copy));
+    }
+    slapi_ch_free_string(&copy);
+
+    node = (struct slapi_dn_node *)slapi_ch_malloc(sizeof(struct slapi_dn_node) + len + 1);
+    node->parent = parent;
+    node->refcnt = 1;
+    node->hash = hash;
+    node->depth = parent ? parent->depth + 1 : 1;
+    node->len = len;
+    memcpy(node->ndn, ndn, len);
+    node->ndn[len] = '\0';
+
+    pthread_mutex_lock(lock);
+    for (struct slapi_dn_node *n = *bucket; n; n = n->next) {
+        if (n->hash == hash && n->len == len && memcmp(n->ndn, ndn, len) == 0) {
+            /* Interned by another thread in the meantime */
+            slapi_atomic_incr_64(&n->refcnt, __ATOMIC_ACQ_REL);
+            pthread_mutex_unlock(lock);
+            slapi_ch_free((void **)&node);
+            dn_intern_release(parent);
+            return n;
+        }
+    }
+    node->next = *bucket;
+    *bucket = node;
+    pthread_mutex_unlock(lock);
+    slapi_atomic_incr_64(&dn_intern_count, __ATOMIC_RELAXED);
+    return node;
+}
+
+static void
+dn_intern_release(struct slapi_dn_node *node)
+{
+    while (node) {
+        pthread_mutex_t *lock = dn_intern_lock(node->hash);
+        struct slapi_dn_node *parent = node->parent;
+        struct slapi_dn_node **prev = NULL;
+
+        pthread_mutex_lock(lock);
+        if (slapi_atomic_decr_64(&node->refcnt, __ATOMIC_ACQ_REL) > 0) {
+            pthread_mutex_unlock(lock);
+            return;
+        }
+        for (prev = &dn_intern_table[node->hash & (DN_INTERN_BUCKETS - 1)]; *prev; prev = &(*prev)->next) {
+            if (*prev == node) {
+                *prev = node->next;
+                break;
+            }
+        }
+        pthread_mutex_unlock(lock);
+        slapi_ch_free((void **)&node);
+        slapi_atomic_decr_64(&dn_intern_count, __ATOMIC_RELAXED);
+        /* Release the reference the node held on its parent */
+        node = parent;
+    }
+}
+
+/* Is suffix an ancestor of (or the same DN as) node */
+static int
+dn_intern_issuffix(const struct slapi_dn_node *node, const struct slapi_dn_node *suffix)
+{
+    while (node && node->depth > suffix->depth) {
+        node = node->parent;
+    }
+    return (node == suffix);
+}
+
+int
+slapi_sdn_intern(Slapi_DN *sdn)
+{
+    const char *ndn = NULL;
+
+    if (sdn == NULL) {
+        return -1;
+    }
+    if (sdn->node) {
+        return 0;
+    }
+    ndn = slapi_sdn_get_ndn(sdn);
+    if (ndn == NULL || *ndn == '\0') {
+        /* the root DSE DN is not interned */
+        return -1;
+    }
+    sdn->node = dn_intern_get(ndn, strlen(ndn));
+    /* share the interned ndn, as slapi_sdn_dup does, rather than keep a private copy */
+    if (slapi_isbitset_uchar(sdn->flag, FLAG_NDN)) {
+        slapi_ch_free((void **)&(sdn->ndn));
+        sdn->flag = slapi_unsetbit_uchar(sdn->flag, FLAG_NDN);
+        PR_INCREMENT_COUNTER(slapi_sdn_counter_ndn_deleted);
+        PR_DECREMENT_COUNTER(slapi_sdn_counter_ndn_exist);
+    }
+    sdn->ndn = sdn->node->ndn;
+    sdn->ndn_len = sdn->node->len;
+    return 0;
+}
+
+int
+slapi_sdn_is_interned(const Slapi_DN *sdn)
+{
+    return (sdn && sdn->node);
+}
+
+/* Number of the interned DNs (for the monitor) */
+uint64_t
+dn_intern_get_count(void)
+{
+    return slapi_atomic_load_64(&dn_intern_count, __ATOMIC_RELAXED);
+}
+
 /*
  *
  *  Normalized DN Cache
@@ -1547,6 +1547,36 @@ entry2str_internal_put_valueset(const char *attrtype, const CSN *attrcsn, CSNTyp
     }
 }
 
+/*
+ * Dumps a single value, in the same format as entry2str (with its CSNs if
+ * SLAPI_DUMP_STATEINFO is set). Used by the backend to store the values
+ * of the very large attributes out of the entry.
+ * The caller frees the returned string, *len is its length.
+ */
+char *
+entry_value2str(const char *type, const Slapi_Value *v, int value_deleted, int entry2str_ctrl, size_t *len)
+{
+    int value_state = value_deleted ? VALUE_DELETED : VALUE_PRESENT;
+    size_t typebuf_len = 0;
+    char *typebuf = NULL;
+    char *buf = NULL;
+    char *ecur = NULL;
+    size_t size;
+
+    size = entry2str_internal_size_value(type, v, entry2str_ctrl, ATTRIBUTE_PRESENT, value_state);
+    if (size == 0) {
+        *len = 0;
+        return NULL;
+    }
+    buf = ecur = slapi_ch_malloc(size + 1);
+    entry2str_internal_put_value(type, NULL, CSN_TYPE_UNKNOWN, ATTRIBUTE_PRESENT, v, value_state,
+                                 &ecur, &typebuf, &typebuf_len, entry2str_ctrl);
+    *ecur = '\0';
+    *len = ecur - buf;
+    slapi_ch_free_string(&typebuf);
+    return buf;
+}
+
 int
 is_type_protected(const char *type)
 {
@@ -3211,7 +3241,8 @@ slapi_entry_add_rdn_values(Slapi_Entry *e)
  *
  * Description: We (RJP+DB) modified this code to take advantage
  *             of the subordinatecount operational attribute that
- *             each entry now has.
+ *             each entry now has. The counts of the backend are
+ *             used instead when it keeps them in memory.
  *
  * Author/Modifier: RJP
  */
@@ -3219,11 +3250,29 @@ int
 slapi_entry_has_children_ext(const Slapi_Entry *entry, int include_tombstone)
 {
     Slapi_Attr *attr;
+    Slapi_Backend *be;
+    struct _back_info_subordinates bck_info = {0};
     int count = 0;
 
     slapi_log_err(SLAPI_LOG_TRACE, "slapi_entry_has_children_ext", "=> ( %s )\n",
                   slapi_entry_get_dn_const(entry));
 
+    /* The backend may keep counts more recent than the stored ones. Only the
+     * entries read from an ldbm backend carry an entryid to look them up. */
+    bck_info.entry = entry;
+    if (slapi_entry_attr_find(entry, "entryid", &attr) == 0 &&
+        (be = slapi_be_select(slapi_entry_get_sdn_const(entry))) != NULL &&
+        slapi_back_get_info(be, BACK_INFO_SUBORDINATE_COUNTS, (void **)&bck_info) == 0) {
+        if (bck_info.count > 0) {
+            count = (int)bck_info.count;
+        } else if (include_tombstone) {
+            count = (int)bck_info.tombstone_count;
+        }
+        slapi_log_err(SLAPI_LOG_TRACE, "slapi_entry_has_children_ext",
+                      "<= slapi_has_children (backend) %d\n", count);
+        return count;
+    }
+
     /*If the subordinatecount exists, and it's nonzero, then return 1.*/
     if (slapi_entry_attr_find(entry, "numsubordinates", &attr) == 0) {
         Slapi_Value *sval;
@@ -24,6 +24,8 @@ extern Slapi_Counter *ops_initiated;
 extern Slapi_Counter *ops_completed;
 extern Slapi_Counter *max_threads_count;
 extern Slapi_Counter *conns_in_maxthreads;
+extern Slapi_Counter *entry_writes;
+extern Slapi_Counter *entry_write_bytes;
 extern PRThread *listener_tid;
 extern PRThread *listener_tid;
 extern Slapi_Counter *num_conns;
@@ -103,6 +103,16 @@ static const char *internal_entries[] =
         "objectclass:extensibleObject\n"
         "cn:counters\n",
 
+        "dn:cn=latency,cn=monitor\n"
+        "objectclass:top\n"
+        "objectclass:extensibleObject\n"
+        "cn:latency\n",
+
+        "dn:cn=bind crypto,cn=monitor\n"
+        "objectclass:top\n"
+        "objectclass:extensibleObject\n"
+        "cn:bind crypto\n",
+
         "dn:cn=sasl,cn=config\n"
         "objectclass:top\n"
         "objectclass:nsContainer\n"
@@ -2867,6 +2877,30 @@ search_counters(Slapi_PBlock *pb __attribute__((unused)),
     return SLAPI_DSE_CALLBACK_OK;
 }
 
+int
+search_latency(Slapi_PBlock *pb __attribute__((unused)),
+               Slapi_Entry *entryBefore,
+               Slapi_Entry *e __attribute__((unused)),
+               int *returncode __attribute__((unused)),
+               char *returntext __attribute__((unused)),
+               void *arg __attribute__((unused)))
+{
+    latency_as_entry(entryBefore);
+    return SLAPI_DSE_CALLBACK_OK;
+}
+
+int
+search_bind_crypto(Slapi_PBlock *pb __attribute__((unused)),
+                   Slapi_Entry *entryBefore,
+                   Slapi_Entry *e __attribute__((unused)),
+                   int *returncode __attribute__((unused)),
+                   char *returntext __attribute__((unused)),
+                   void *arg __attribute__((unused)))
+{
+    bind_crypto_as_entry(entryBefore);
+    return SLAPI_DSE_CALLBACK_OK;
+}
+
 int
 search_snmp(Slapi_PBlock *pb __attribute__((unused)),
             Slapi_Entry *entryBefore,
@@ -2897,6 +2931,8 @@ setup_internal_backends(char *configdir)
     if (rc) {
         Slapi_DN monitor;
         Slapi_DN counters;
+        Slapi_DN latency;
+        Slapi_DN bind_crypto;
         Slapi_DN snmp;
         Slapi_DN root;
         Slapi_Backend *be;
@@ -2907,6 +2943,8 @@ setup_internal_backends(char *configdir)
 
         slapi_sdn_init_ndn_byref(&monitor, "cn=monitor");
         slapi_sdn_init_ndn_byref(&counters, "cn=counters,cn=monitor");
+        slapi_sdn_init_ndn_byref(&latency, "cn=latency,cn=monitor");
+        slapi_sdn_init_ndn_byref(&bind_crypto, "cn=bind crypto,cn=monitor");
         slapi_sdn_init_ndn_byref(&snmp, "cn=snmp,cn=monitor");
         slapi_sdn_init_ndn_byref(&diskspace, "cn=disk space,cn=monitor");
         slapi_sdn_init_ndn_byref(&root, "");
@@ -2922,6 +2960,8 @@ setup_internal_backends(char *configdir)
         dse_register_callback(pfedse, SLAPI_OPERATION_SEARCH, DSE_FLAG_PREOP, &root, LDAP_SCOPE_BASE, "(objectclass=*)", read_root_dse, NULL, NULL);
         dse_register_callback(pfedse, SLAPI_OPERATION_SEARCH, DSE_FLAG_PREOP, &monitor, LDAP_SCOPE_SUBTREE, EGG_FILTER, search_easter_egg, NULL, NULL); /* Egg */
         dse_register_callback(pfedse, SLAPI_OPERATION_SEARCH, DSE_FLAG_PREOP, &counters, LDAP_SCOPE_BASE, "(objectclass=*)", search_counters, NULL, NULL);
+        dse_register_callback(pfedse, SLAPI_OPERATION_SEARCH, DSE_FLAG_PREOP, &latency, LDAP_SCOPE_BASE, "(objectclass=*)", search_latency, NULL, NULL);
+        dse_register_callback(pfedse, SLAPI_OPERATION_SEARCH, DSE_FLAG_PREOP, &bind_crypto, LDAP_SCOPE_BASE, "(objectclass=*)", search_bind_crypto, NULL, NULL);
         dse_register_callback(pfedse, SLAPI_OPERATION_SEARCH, DSE_FLAG_PREOP, &snmp, LDAP_SCOPE_BASE, "(objectclass=*)", search_snmp, NULL, NULL);
         dse_register_callback(pfedse, SLAPI_OPERATION_SEARCH, DSE_FLAG_PREOP, &encryption, LDAP_SCOPE_BASE, "(objectclass=*)", search_encryption, NULL, NULL);
 
@@ -2936,6 +2976,8 @@ setup_internal_backends(char *configdir)
         dse_register_callback(pfedse, SLAPI_OPERATION_DELETE, DSE_FLAG_PREOP, &config, LDAP_SCOPE_BASE, "(objectclass=*)", dont_allow_that, NULL, NULL);
         dse_register_callback(pfedse, SLAPI_OPERATION_DELETE, DSE_FLAG_PREOP, &monitor, LDAP_SCOPE_BASE, "(objectclass=*)", dont_allow_that, NULL, NULL);
         dse_register_callback(pfedse, SLAPI_OPERATION_DELETE, DSE_FLAG_PREOP, &counters, LDAP_SCOPE_BASE, "(objectclass=*)", dont_allow_that, NULL, NULL);
+        dse_register_callback(pfedse, SLAPI_OPERATION_DELETE, DSE_FLAG_PREOP, &latency, LDAP_SCOPE_BASE, "(objectclass=*)", dont_allow_that, NULL, NULL);
+        dse_register_callback(pfedse, SLAPI_OPERATION_DELETE, DSE_FLAG_PREOP, &bind_crypto, LDAP_SCOPE_BASE, "(objectclass=*)", dont_allow_that, NULL, NULL);
         dse_register_callback(pfedse, SLAPI_OPERATION_DELETE, DSE_FLAG_PREOP, &snmp, LDAP_SCOPE_BASE, "(objectclass=*)", dont_allow_that, NULL, NULL);
         dse_register_callback(pfedse, SLAPI_OPERATION_DELETE, DSE_FLAG_PREOP, &root, LDAP_SCOPE_BASE, "(objectclass=*)", dont_allow_that, NULL, NULL);
         dse_register_callback(pfedse, SLAPI_OPERATION_DELETE, DSE_FLAG_PREOP, &encryption, LDAP_SCOPE_BASE, "(objectclass=*)", dont_allow_that, NULL, NULL);
@@ -2967,6 +3009,8 @@ setup_internal_backends(char *configdir)
 
         slapi_sdn_done(&monitor);
         slapi_sdn_done(&counters);
+        slapi_sdn_done(&latency);
+        slapi_sdn_done(&bind_crypto);
         slapi_sdn_done(&snmp);
         slapi_sdn_done(&root);
         slapi_sdn_done(&saslmapping);
@@ -171,7 +171,8 @@ get_filter_internal(Connection *conn, BerElement *ber, struct slapi_filter **fil
     ber_len_t len;
     int err;
     struct slapi_filter *f;
-    char *ftmp, *type = NULL;
+    char *ftmp;
+    struct berval type = {0};
 
     slapi_log_err(SLAPI_LOG_FILTER, "get_filter_internal", "==>\n");
 
@@ -300,13 +301,11 @@ get_filter_internal(Connection *conn, BerElement *ber, struct slapi_filter **fil
 
     case LDAP_FILTER_PRESENT:
         slapi_log_err(SLAPI_LOG_FILTER, "get_filter_internal", "PRESENT\n");
-        if (ber_scanf(ber, "a", &type) == LBER_ERROR) {
-            slapi_ch_free_string(&type);
+        if (ber_scanf(ber, "m", &type) == LBER_ERROR) {
             err = LDAP_PROTOCOL_ERROR;
         } else {
             err = LDAP_SUCCESS;
-            f->f_type = slapi_attr_syntax_normalize(type);
-            slapi_ch_free_string(&type);
+            f->f_type = slapi_attr_syntax_normalize(type.bv_val);
             filter_compute_hash(f);
             *fstr = slapi_ch_smprintf("(%s=*)", f->f_type);
         }
@@ -456,17 +455,16 @@ get_substring_filter(
 {
     ber_tag_t tag, rc;
     ber_len_t len = -1;
-    char *val, *eval, *last, *type = NULL;
+    char *val, *eval, *last;
+    struct berval type = {0};
     size_t fstr_len;
 
     slapi_log_err(SLAPI_LOG_FILTER, "get_substring_filter", "=>\n");
 
-    if (ber_scanf(ber, "{a", &type) == LBER_ERROR) {
-        slapi_ch_free_string(&type);
+    if (ber_scanf(ber, "{m", &type) == LBER_ERROR) {
         return (LDAP_PROTOCOL_ERROR);
     }
-    f->f_sub_type = slapi_attr_syntax_normalize(type);
-    slapi_ch_free_string(&type);
+    f->f_sub_type = slapi_attr_syntax_normalize(type.bv_val);
     f->f_sub_initial = NULL;
     f->f_sub_any = NULL;
     f->f_sub_final = NULL;
@@ -614,13 +612,11 @@ get_extensible_filter(BerElement *ber, mr_filter_t *mrf)
                 }
             }
             {
-                char *type = NULL;
-                if (ber_scanf(ber, "a", &type) == LBER_ERROR) {
-                    slapi_ch_free_string(&type);
+                struct berval type = {0};
+                if (ber_scanf(ber, "m", &type) == LBER_ERROR) {
                     rc = LDAP_PROTOCOL_ERROR;
                 } else {
-                    mrf->mrf_type = slapi_attr_syntax_normalize(type);
-                    slapi_ch_free_string(&type);
+                    mrf->mrf_type = slapi_attr_syntax_normalize(type.bv_val);
                 }
             }
             gotelem++;
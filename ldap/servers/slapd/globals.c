@@ -49,6 +49,8 @@ Slapi_PBlock *repl_pb = NULL;
 Slapi_Counter *num_conns;
 Slapi_Counter *max_threads_count;
 Slapi_Counter *conns_in_maxthreads;
+Slapi_Counter *entry_writes;
+Slapi_Counter *entry_write_bytes;
 Connection_Table *the_connection_table = NULL;
 
 char *pid_file = "/dev/null";
@@ -75,8 +77,12 @@ set_entry_points()
     if (config_get_slapi_counters()) {
         max_threads_count = slapi_counter_new();
         conns_in_maxthreads = slapi_counter_new();
+        entry_writes = slapi_counter_new();
+        entry_write_bytes = slapi_counter_new();
     } else {
         max_threads_count = NULL;
         conns_in_maxthreads = NULL;
+        entry_writes = NULL;
+        entry_write_bytes = NULL;
     }
 }
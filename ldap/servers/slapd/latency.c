@@ -0,0 +1,332 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+/*
+ * Operation latency histograms
+ *
+ * The time spent in each phase of the operations (queue wait, plugins,
+ * candidate list, search entries, result sending, txn commit) is recorded
+ * in log-linear histograms: two buckets per power of two microseconds, so a
+ * bucket is at most 50% wide.
+ *
+ * The clock is read at the phase boundaries only, never per entry: the
+ * fetch, access control and sending of the search entries are a single
+ * phase, and access control of the updates is part of their backend time.
+ *
+ * Each thread records in its own histograms, so recording takes no lock.
+ * They are merged on read by the cn=latency,cn=monitor search callback.
+ * The histograms of the exited threads are merged in latency_retired.
+ *
+ * When built with --enable-systemtap, each recorded latency also fires the
+ * ns-slapd:op_latency USDT probe (optype, phase, nanoseconds, conn id, op id),
+ * so that systemtap or bpftrace can attach to a running server.
+ */
+
+#include <pthread.h>
+#include "slap.h"
+
+#ifdef SYSTEMTAP
+#include <sys/sdt.h>
+#endif
+
+#define LATENCY_NB_BUCKETS 64
+
+typedef enum {
+    LATENCY_OP_BIND = 0,
+    LATENCY_OP_UNBIND,
+    LATENCY_OP_SEARCH,
+    LATENCY_OP_MODIFY,
+    LATENCY_OP_ADD,
+    LATENCY_OP_DELETE,
+    LATENCY_OP_MODRDN,
+    LATENCY_OP_COMPARE,
+    LATENCY_OP_ABANDON,
+    LATENCY_OP_EXTENDED,
+    LATENCY_OP_OTHER,
+    LATENCY_NB_OPTYPES
+} latency_optype_t;
+
+static const char *latency_optype_names[LATENCY_NB_OPTYPES] = {
+    "bind", "unbind", "search", "modify", "add", "delete",
+    "modrdn", "compare", "abandon", "extended", "other"};
+
+static const char *latency_phase_names[LATENCY_NB_PHASES] = {
+    "operation", "queuewait", "preop", "betxnpreop", "betxnpostop", "postop",
+    "candidates", "entries", "result", "txncommit"};
+
+typedef struct latency_stat
+{
+    uint64_t count;
+    uint64_t sum;  /* nanoseconds */
+    uint64_t max;  /* nanoseconds */
+    uint64_t buckets[LATENCY_NB_BUCKETS];
+} latency_stat;
+
+typedef struct latency_thread
+{
+    struct latency_thread *next;
+    latency_stat stats[LATENCY_NB_OPTYPES][LATENCY_NB_PHASES];
+} latency_thread;
+
+static pthread_once_t latency_once = PTHREAD_ONCE_INIT;
+static pthread_key_t latency_key;
+static pthread_mutex_t latency_lock = PTHREAD_MUTEX_INITIALIZER;
+static latency_thread *latency_threads = NULL; /* protected by latency_lock */
+static latency_thread latency_retired;         /* protected by latency_lock */
+
+static void
+latency_merge(latency_thread *to, latency_thread *from)
+{
+    for (size_t t = 0; t < LATENCY_NB_OPTYPES; t++) {
+        for (size_t p = 0; p < LATENCY_NB_PHASES; p++) {
+            latency_stat *dst = &to->stats[t][p];
+            latency_stat *src = &from->stats[t][p];
+            uint64_t max = slapi_atomic_load_64(&src->max, __ATOMIC_RELAXED);
+
+            dst->count += slapi_atomic_load_64(&src->count, __ATOMIC_RELAXED);
+            dst->sum += slapi_atomic_load_64(&src->sum, __ATOMIC_RELAXED);
+            if (max > dst->max) {
+                dst->max = max;
+            }
+            for (size_t b = 0; b < LATENCY_NB_BUCKETS; b++) {
+                dst->buckets[b] += slapi_atomic_load_64(&src->buckets[b], __ATOMIC_RELAXED);
+            }
+        }
+    }
+}
+
+/* A thread exits: keep its histograms in latency_retired */
+static void
+latency_thread_destructor(void *priv)
+{
+    latency_thread *lt = (latency_thread *)priv;
+
+    pthread_mutex_lock(&latency_lock);
+    for (latency_thread **prev = &latency_threads; *prev; prev = &(*prev)->next) {
+        if (*prev == lt) {
+            *prev = lt->next;
+            break;
+        }
+    }
+    latency_merge(&latency_retired, lt);
+    pthread_mutex_unlock(&latency_lock);
+    slapi_ch_free((void **)&lt);
+}
+
+static void
+latency_init(void)
+{
+    if (pthread_key_create(&latency_key, latency_thread_destructor) != 0) {
+        slapi_log_err(SLAPI_LOG_CRIT, "latency_init", "Failed to create private thread index for the latency histograms\n");
+    }
+}
+
+static latency_thread *
+latency_get_thread(void)
+{
+    latency_thread *lt = NULL;
+
+    pthread_once(&latency_once, latency_init);
+    lt = (latency_thread *)pthread_getspecific(latency_key);
+    if (lt == NULL) {
+        lt = (latency_thread *)slapi_ch_calloc(1, sizeof(latency_thread));
+        if (pthread_setspecific(latency_key, lt) != 0) {
+            slapi_ch_free((void **)&lt);
+            return NULL;
+        }
+        pthread_mutex_lock(&latency_lock);
+        lt->next = latency_threads;
+        latency_threads = lt;
+        pthread_mutex_unlock(&latency_lock);
+    }
+    return lt;
+}
+
+static latency_optype_t
+latency_optype(Slapi_Operation *op)
+{
+    switch (operation_get_type(op)) {
+    case SLAPI_OPERATION_BIND:
+        return LATENCY_OP_BIND;
+    case SLAPI_OPERATION_UNBIND:
+        return LATENCY_OP_UNBIND;
+    case SLAPI_OPERATION_SEARCH:
+        return LATENCY_OP_SEARCH;
+    case SLAPI_OPERATION_MODIFY:
+        return LATENCY_OP_MODIFY;
+    case SLAPI_OPERATION_ADD:
+        return LATENCY_OP_ADD;
+    case SLAPI_OPERATION_DELETE:
+        return LATENCY_OP_DELETE;
+    case SLAPI_OPERATION_MODRDN:
+        return LATENCY_OP_MODRDN;
+    case SLAPI_OPERATION_COMPARE:
+        return LATENCY_OP_COMPARE;
+    case SLAPI_OPERATION_ABANDON:
+        return LATENCY_OP_ABANDON;
+    case SLAPI_OPERATION_EXTENDED:
+        return LATENCY_OP_EXTENDED;
+    default:
+        return LATENCY_OP_OTHER;
+    }
+}
+
+/*
+ * Bucket 0 is [0, 1us[, bucket 1 is [1us, 2us[, then each power of two
+ * [2^n us, 2^(n+1) us[ is split in two buckets.
+ */
+static uint32_t
+latency_bucket(uint64_t nsec)
+{
+    uint64_t usec = nsec / 1000;
+    uint32_t msb = 0;
+    uint32_t bucket = 0;
+
+    if (usec < 2) {
+        return (uint32_t)usec;
+    }
+    msb = 63 - __builtin_clzll(usec);
+    bucket = 2 * msb + ((usec >> (msb - 1)) & 1);
+    return (bucket < LATENCY_NB_BUCKETS) ? bucket : LATENCY_NB_BUCKETS - 1;
+}
+
+/* Upper bound of a bucket in microseconds */
+static uint64_t
+latency_bucket_limit(uint32_t bucket)
+{
+    bucket++;
+    if (bucket < 2) {
+        return bucket;
+    }
+    return (uint64_t)(2 + (bucket & 1)) << (bucket / 2 - 1);
+}
+
+void
+latency_record_elapsed(Slapi_Operation *op, latency_phase_t phase, const struct timespec *elapsed)
+{
+    latency_thread *lt = NULL;
+    latency_stat *stat = NULL;
+    latency_optype_t optype;
+    uint64_t nsec = 0;
+    uint64_t *bucket = NULL;
+
+    if (op == NULL || phase >= LATENCY_NB_PHASES) {
+        return;
+    }
+    if ((lt = latency_get_thread()) == NULL) {
+        return;
+    }
+    optype = latency_optype(op);
+    nsec = (uint64_t)elapsed->tv_sec * 1000000000 + (uint64_t)elapsed->tv_nsec;
+    stat = &lt->stats[optype][phase];
+    bucket = &stat->buckets[latency_bucket(nsec)];
+
+    /* Only this thread updates its histograms */
+    slapi_atomic_store_64(&stat->count, stat->count + 1, __ATOMIC_RELAXED);
+    slapi_atomic_store_64(&stat->sum, stat->sum + nsec, __ATOMIC_RELAXED);
+    slapi_atomic_store_64(bucket, *bucket + 1, __ATOMIC_RELAXED);
+    if (nsec > stat->max) {
+        slapi_atomic_store_64(&stat->max, nsec, __ATOMIC_RELAXED);
+    }
+#ifdef SYSTEMTAP
+    STAP_PROBE5(ns-slapd, op_latency, optype, phase, nsec, op->o_connid, op->o_opid);
+#endif
+}
+
+/* Record the time elapsed since start (CLOCK_MONOTONIC) */
+void
+latency_record(Slapi_Operation *op, latency_phase_t phase, const struct timespec *start)
+{
+    struct timespec now;
+    struct timespec elapsed;
+
+    if (op == NULL) {
+        return;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    slapi_timespec_diff(&now, (struct timespec *)start, &elapsed);
+    latency_record_elapsed(op, phase, &elapsed);
+}
+
+/* Smallest bucket limit (usec) reached by the given per mille of the count */
+static uint64_t
+latency_percentile(latency_stat *stat, uint64_t permille)
+{
+    uint64_t rank = (stat->count * permille + 999) / 1000;
+    uint64_t count = 0;
+
+    for (uint32_t b = 0; b < LATENCY_NB_BUCKETS; b++) {
+        count += stat->buckets[b];
+        if (count >= rank) {
+            return latency_bucket_limit(b);
+        }
+    }
+    return latency_bucket_limit(LATENCY_NB_BUCKETS - 1);
+}
+
+/*
+ * Fill the cn=latency,cn=monitor entry. For each operation type and
+ * phase that has been recorded:
+ *   latency: op=<type> phase=<phase> count=<n> avg=<us> p50=<us> p90=<us> p99=<us> max=<us>
+ *   latencyHistogram: op=<type> phase=<phase> <bucket limit us>:<count> ...
+ * Percentiles are the upper limits of the buckets they fall in.
+ */
+void
+latency_as_entry(Slapi_Entry *e)
+{
+    latency_thread *merged = (latency_thread *)slapi_ch_calloc(1, sizeof(latency_thread));
+    struct berval val;
+    struct berval *vals[2] = {&val, NULL};
+
+    pthread_mutex_lock(&latency_lock);
+    latency_merge(merged, &latency_retired);
+    for (latency_thread *lt = latency_threads; lt; lt = lt->next) {
+        latency_merge(merged, lt);
+    }
+    pthread_mutex_unlock(&latency_lock);
+
+    attrlist_delete(&e->e_attrs, "latency");
+    attrlist_delete(&e->e_attrs, "latencyHistogram");
+    for (size_t t = 0; t < LATENCY_NB_OPTYPES; t++) {
+        for (size_t p = 0; p < LATENCY_NB_PHASES; p++) {
+            latency_stat *stat = &merged->stats[t][p];
+            char buf[BUFSIZ];
+            size_t len = 0;
+
+            if (stat->count == 0) {
+                continue;
+            }
+            val.bv_len = snprintf(buf, sizeof(buf),
+                                  "op=%s phase=%s count=%" PRIu64 " avg=%" PRIu64 " p50=%" PRIu64
+                                  " p90=%" PRIu64 " p99=%" PRIu64 " max=%" PRIu64,
+                                  latency_optype_names[t], latency_phase_names[p], stat->count,
+                                  stat->sum / stat->count / 1000,
+                                  latency_percentile(stat, 500), latency_percentile(stat, 900),
+                                  latency_percentile(stat, 990), stat->max / 1000);
+            val.bv_val = buf;
+            attrlist_merge(&e->e_attrs, "latency", vals);
+
+            len = snprintf(buf, sizeof(buf), "op=%s phase=%s",
+                           latency_optype_names[t], latency_phase_names[p]);
+            for (uint32_t b = 0; b < LATENCY_NB_BUCKETS && len < sizeof(buf); b++) {
+                if (stat->buckets[b]) {
+                    len += snprintf(buf + len, sizeof(buf) - len, " %" PRIu64 ":%" PRIu64,
+                                    latency_bucket_limit(b), stat->buckets[b]);
+                }
+            }
+            val.bv_val = buf;
+            val.bv_len = (len < sizeof(buf)) ? len : sizeof(buf) - 1;
+            attrlist_merge(&e->e_attrs, "latencyHistogram", vals);
+        }
+    }
+    slapi_ch_free((void **)&merged);
+}
@@ -26,6 +26,222 @@ struct ldapi_mapping {
 static struct ldapi_mapping *ldapi_mappings = NULL;
 static Slapi_RWLock *dn_mapping_lock = NULL;
 
+#if defined(ENABLE_AUTOBIND)
+/*
+ * Cache of the entries found by the uid/gid search of the autobind, so that
+ * a local client does not run a subtree search on each connection. Only the
+ * DN is kept: the entry is read again at each bind to check the account lock.
+ * The whole cache is flushed when an entry under the search base changes, or
+ * when the search configuration is not the one the DNs were found with.
+ */
+#define LDAPI_BIND_CACHE_MAX 1024
+
+struct ldapi_bind_cache_entry {
+    char key[32]; /* uid:gid */
+    char *ndn;
+};
+
+static PLHashTable *ldapi_bind_cache = NULL;
+static Slapi_RWLock *ldapi_bind_cache_lock = NULL;
+static Slapi_DN *ldapi_bind_cache_base = NULL; /* base the cached DNs were found under */
+static char *ldapi_bind_cache_config = NULL;   /* uid type, gid type and base of the search */
+static int32_t ldapi_bind_cache_count = 0;
+static uint64_t ldapi_bind_cache_hits = 0;
+static uint64_t ldapi_bind_cache_misses = 0;
+static uint64_t ldapi_bind_cache_flushes = 0;
+static uint64_t ldapi_bind_cache_generation = 0; /* bumped by each change */
+
+static PRIntn
+ldapi_bind_cache_free_entry(PLHashEntry *he, PRIntn i __attribute__((unused)), void *arg __attribute__((unused)))
+{
+    struct ldapi_bind_cache_entry *entry = (struct ldapi_bind_cache_entry *)he->value;
+
+    slapi_ch_free_string(&entry->ndn);
+    slapi_ch_free((void **)&entry);
+
+    return HT_ENUMERATE_REMOVE;
+}
+
+/* The caller holds the write lock */
+static void
+ldapi_bind_cache_flush_nolock(void)
+{
+    if (ldapi_bind_cache_count) {
+        PL_HashTableEnumerateEntries(ldapi_bind_cache, ldapi_bind_cache_free_entry, NULL);
+        slapi_atomic_store_32(&ldapi_bind_cache_count, 0, __ATOMIC_RELEASE);
+        slapi_atomic_incr_64(&ldapi_bind_cache_flushes, __ATOMIC_RELAXED);
+    }
+}
+
+/* An online import or restore changes the entries without telling us */
+static void
+ldapi_bind_cache_be_state_change(void *handle __attribute__((unused)),
+                                 char *be_name __attribute__((unused)),
+                                 int old_be_state __attribute__((unused)),
+                                 int new_be_state __attribute__((unused)))
+{
+    slapi_rwlock_wrlock(ldapi_bind_cache_lock);
+    ldapi_bind_cache_flush_nolock();
+    slapi_rwlock_unlock(ldapi_bind_cache_lock);
+}
+
+static void
+ldapi_bind_cache_init(void)
+{
+    if ((ldapi_bind_cache_lock = slapi_new_rwlock()) == NULL) {
+        slapi_log_err(SLAPI_LOG_ERR, "ldapi_bind_cache_init", "Cannot create new lock.\n");
+        exit(-1);
+    }
+    ldapi_bind_cache = PL_NewHashTable(0, PL_HashString, PL_CompareStrings,
+                                       PL_CompareValues, NULL, NULL);
+    slapi_register_backend_state_change((void *)ldapi_bind_cache_be_state_change,
+                                        ldapi_bind_cache_be_state_change);
+}
+
+static void
+ldapi_bind_cache_destroy(void)
+{
+    if (ldapi_bind_cache_lock == NULL) {
+        return;
+    }
+    slapi_unregister_backend_state_change((void *)ldapi_bind_cache_be_state_change);
+    slapi_rwlock_wrlock(ldapi_bind_cache_lock);
+    ldapi_bind_cache_flush_nolock();
+    PL_HashTableDestroy(ldapi_bind_cache);
+    ldapi_bind_cache = NULL;
+    slapi_sdn_free(&ldapi_bind_cache_base);
+    slapi_ch_free_string(&ldapi_bind_cache_config);
+    slapi_rwlock_unlock(ldapi_bind_cache_lock);
+    slapi_destroy_rwlock(ldapi_bind_cache_lock);
+    ldapi_bind_cache_lock = NULL;
+}
+
+/* Returns a copy of the DN the uid/gid was mapped to, NULL if it is not known */
+static char *
+ldapi_bind_cache_get(const char *key, const char *config)
+{
+    struct ldapi_bind_cache_entry *entry = NULL;
+    char *ndn = NULL;
+
+    slapi_rwlock_rdlock(ldapi_bind_cache_lock);
+    if (ldapi_bind_cache_config && strcmp(ldapi_bind_cache_config, config) == 0) {
+        entry = (struct ldapi_bind_cache_entry *)PL_HashTableLookup(ldapi_bind_cache, key);
+        if (entry) {
+            ndn = slapi_ch_strdup(entry->ndn);
+        }
+    }
+    slapi_rwlock_unlock(ldapi_bind_cache_lock);
+
+    if (ndn) {
+        slapi_atomic_incr_64(&ldapi_bind_cache_hits, __ATOMIC_RELAXED);
+    } else {
+        slapi_atomic_incr_64(&ldapi_bind_cache_misses, __ATOMIC_RELAXED);
+    }
+    return ndn;
+}
+
+/*
+ * Keeps the DN found by a search started at generation, unless an entry
+ * changed while the search was running
+ */
+static void
+ldapi_bind_cache_add(const char *key, const char *config, const char *base_dn, const char *ndn, uint64_t generation)
+{
+    struct ldapi_bind_cache_entry *entry = NULL;
+
+    slapi_rwlock_wrlock(ldapi_bind_cache_lock);
+    if (slapi_atomic_load_64(&ldapi_bind_cache_generation, __ATOMIC_ACQUIRE) != generation) {
+        slapi_rwlock_unlock(ldapi_bind_cache_lock);
+        return;
+    }
+    if (ldapi_bind_cache_config == NULL || strcmp(ldapi_bind_cache_config, config) ||
+        ldapi_bind_cache_count >= LDAPI_BIND_CACHE_MAX) {
+        ldapi_bind_cache_flush_nolock();
+        slapi_ch_free_string(&ldapi_bind_cache_config);
+        ldapi_bind_cache_config = slapi_ch_strdup(config);
+        slapi_sdn_free(&ldapi_bind_cache_base);
+        ldapi_bind_cache_base = slapi_sdn_new_dn_byval(base_dn);
+    }
+    entry = (struct ldapi_bind_cache_entry *)PL_HashTableLookup(ldapi_bind_cache, key);
+    if (entry) {
+        slapi_ch_free_string(&entry->ndn);
+    } else {
+        entry = (struct ldapi_bind_cache_entry *)slapi_ch_calloc(1, sizeof(struct ldapi_bind_cache_entry));
+        PR_snprintf(entry->key, sizeof(entry->key), "%s", key);
+        PL_HashTableAdd(ldapi_bind_cache, entry->key, entry);
+        slapi_atomic_incr_32(&ldapi_bind_cache_count, __ATOMIC_RELEASE);
+    }
+    entry->ndn = slapi_ch_strdup(ndn);
+    slapi_rwlock_unlock(ldapi_bind_cache_lock);
+}
+
+static void
+ldapi_bind_cache_remove(const char *key)
+{
+    struct ldapi_bind_cache_entry *entry = NULL;
+
+    slapi_rwlock_wrlock(ldapi_bind_cache_lock);
+    entry = (struct ldapi_bind_cache_entry *)PL_HashTableLookup(ldapi_bind_cache, key);
+    if (entry) {
+        PL_HashTableRemove(ldapi_bind_cache, entry->key);
+        slapi_ch_free_string(&entry->ndn);
+        slapi_ch_free((void **)&entry);
+        slapi_atomic_decr_32(&ldapi_bind_cache_count, __ATOMIC_RELEASE);
+    }
+    slapi_rwlock_unlock(ldapi_bind_cache_lock);
+}
+
+/*
+ * Called for each successful add, delete, modify and modrdn: a change under
+ * the search base may add, remove or move the entry a uid/gid maps to.
+ */
+void
+ldapi_bind_cache_entry_changed(Slapi_Entry *e, Slapi_Entry *eprev)
+{
+    int32_t flush = 0;
+
+    slapi_atomic_incr_64(&ldapi_bind_cache_generation, __ATOMIC_RELEASE);
+    if (slapi_atomic_load_32(&ldapi_bind_cache_count, __ATOMIC_ACQUIRE) == 0) {
+        return;
+    }
+
+    slapi_rwlock_rdlock(ldapi_bind_cache_lock);
+    if (ldapi_bind_cache_base) {
+        flush = (e && slapi_sdn_issuffix(slapi_entry_get_sdn_const(e), ldapi_bind_cache_base)) ||
+                (eprev && slapi_sdn_issuffix(slapi_entry_get_sdn_const(eprev), ldapi_bind_cache_base));
+    }
+    slapi_rwlock_unlock(ldapi_bind_cache_lock);
+
+    if (flush) {
+        slapi_rwlock_wrlock(ldapi_bind_cache_lock);
+        ldapi_bind_cache_flush_nolock();
+        slapi_rwlock_unlock(ldapi_bind_cache_lock);
+    }
+}
+
+void
+ldapi_bind_cache_as_entry(Slapi_Entry *e)
+{
+    char buf[BUFSIZ];
+    struct berval val;
+    struct berval *vals[2] = {&val, NULL};
+
+    val.bv_val = buf;
+    val.bv_len = snprintf(buf, sizeof(buf), "%" PRId32,
+                          slapi_atomic_load_32(&ldapi_bind_cache_count, __ATOMIC_ACQUIRE));
+    attrlist_replace(&e->e_attrs, "ldapiautobindcacheentries", vals);
+    val.bv_len = snprintf(buf, sizeof(buf), "%" PRIu64,
+                          slapi_atomic_load_64(&ldapi_bind_cache_hits, __ATOMIC_RELAXED));
+    attrlist_replace(&e->e_attrs, "ldapiautobindcachehits", vals);
+    val.bv_len = snprintf(buf, sizeof(buf), "%" PRIu64,
+                          slapi_atomic_load_64(&ldapi_bind_cache_misses, __ATOMIC_RELAXED));
+    attrlist_replace(&e->e_attrs, "ldapiautobindcachemisses", vals);
+    val.bv_len = snprintf(buf, sizeof(buf), "%" PRIu64,
+                          slapi_atomic_load_64(&ldapi_bind_cache_flushes, __ATOMIC_RELAXED));
+    attrlist_replace(&e->e_attrs, "ldapiautobindcacheflushes", vals);
+}
+#endif /* ENABLE_AUTOBIND */
+
 void
 initialize_ldapi_auth_dn_mappings(slapi_ldapi_state reload)
 {
@@ -36,6 +252,17 @@ initialize_ldapi_auth_dn_mappings(slapi_ldapi_state reload)
     char *filter = "(|(objectclass=nsLDAPIAuthMap)(objectclass=nsLDAPIFixedAuthMap))";
     int32_t result = 0;
 
+#if defined(ENABLE_AUTOBIND)
+    if (reload) {
+        /* A reload is also how an admin drops what the autobind cached */
+        slapi_rwlock_wrlock(ldapi_bind_cache_lock);
+        ldapi_bind_cache_flush_nolock();
+        slapi_rwlock_unlock(ldapi_bind_cache_lock);
+    } else {
+        ldapi_bind_cache_init();
+    }
+#endif
+
     if (base_dn == NULL) {
         /* nothing to do */
         return;
@@ -132,6 +359,9 @@ free_ldapi_auth_dn_mappings(int32_t shutdown)
 
     if (shutdown == LDAPI_SHUTDOWN) {
         slapi_destroy_rwlock(dn_mapping_lock);
+#if defined(ENABLE_AUTOBIND)
+        ldapi_bind_cache_destroy();
+#endif
     }
 }
 
@@ -230,6 +460,12 @@ slapd_bind_local_user(Connection *conn)
             char *filter_tpl = NULL;
             char *filter = NULL;
 
+            /* bind cache vars */
+            char cache_key[32];
+            char *cache_config = NULL;
+            char *cached_dn = NULL;
+            uint64_t generation = 0;
+
             /* create filter, matching whatever is given */
             if (utype && gtype) {
                 filter_tpl = "(&(%s=%u)(%s=%u))";
@@ -256,6 +492,33 @@ slapd_bind_local_user(Connection *conn)
                 filter = slapi_ch_smprintf(filter_tpl, utype, uid, gtype, gid);
             }
 
+            /* the uid/gid may already be mapped, then only read the entry */
+            PR_snprintf(cache_key, sizeof(cache_key), "%u:%u", uid, gid);
+            cache_config = slapi_ch_smprintf("%s:%s:%s", utype ? utype : "",
+                                             gtype ? gtype : "", base_dn ? base_dn : "");
+            generation = slapi_atomic_load_64(&ldapi_bind_cache_generation, __ATOMIC_ACQUIRE);
+            if ((cached_dn = ldapi_bind_cache_get(cache_key, cache_config))) {
+                Slapi_Entry *e = NULL;
+                Slapi_DN sdn;
+
+                slapi_sdn_init_normdn_byref(&sdn, cached_dn);
+                slapi_search_internal_get_entry(&sdn, NULL, &e, plugin_get_default_component_id());
+                slapi_sdn_done(&sdn);
+                if (e) {
+                    ret = slapi_check_account_lock(0, e, 0, 0, 0);
+                    if (0 == ret) {
+                        bind_credentials_set_nolock(conn, SLAPD_AUTH_OS, cached_dn,
+                                                    NULL, NULL, NULL, e);
+                        cached_dn = NULL; /* consumed by bind creds set */
+                    }
+                    slapi_entry_free(e);
+                    goto entry_map_free;
+                }
+                /* the entry went away, search again */
+                ldapi_bind_cache_remove(cache_key);
+                slapi_ch_free_string(&cached_dn);
+            }
+
             /* search for single entry matching types */
             search_pb = slapi_pblock_new();
             slapi_search_internal_set_pb(
@@ -281,6 +544,11 @@ slapd_bind_local_user(Connection *conn)
             if (entries) {
                 /* zero or multiple entries fail */
                 if (entries[0] && 0 == entries[1]) {
+                    if (base_dn) {
+                        ldapi_bind_cache_add(cache_key, cache_config, base_dn,
+                                             slapi_entry_get_ndn(entries[0]), generation);
+                    }
+
                     /* observe account locking */
                     ret = slapi_check_account_lock(
                         0, /* pb not req */
@@ -307,6 +575,8 @@ slapd_bind_local_user(Connection *conn)
             slapi_free_search_results_internal(search_pb);
             slapi_pblock_destroy(search_pb);
             slapi_ch_free_string(&filter);
+            slapi_ch_free_string(&cache_config);
+            slapi_ch_free_string(&cached_dn);
             slapi_ch_free_string(&utype);
             slapi_ch_free_string(&gtype);
             slapi_ch_free_string(&base_dn);
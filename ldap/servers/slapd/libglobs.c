@@ -1466,6 +1466,26 @@ static struct config_get_and_set
      NULL, 0,
      (void **)&global_slapdFrontendConfig.return_orig_dn,
      CONFIG_ON_OFF, (ConfigGetFunc)config_get_return_orig_dn, &init_return_orig_dn, NULL},
+    {CONFIG_BIND_CRYPTO_MAX_PENDING, config_set_bind_crypto_max_pending,
+     NULL, 0,
+     (void **)&global_slapdFrontendConfig.bind_crypto_max_pending,
+     CONFIG_INT, (ConfigGetFunc)config_get_bind_crypto_max_pending,
+     SLAPD_DEFAULT_BIND_CRYPTO_MAX_PENDING_STR, NULL},
+    {CONFIG_PAGEDRESULTS_CURSOR_MAXMEMORY, config_set_pagedresults_cursor_maxmemory,
+     NULL, 0,
+     (void **)&global_slapdFrontendConfig.pagedresults_cursor_maxmemory,
+     CONFIG_INT, (ConfigGetFunc)config_get_pagedresults_cursor_maxmemory,
+     SLAPD_DEFAULT_PAGEDRESULTS_CURSOR_MAXMEMORY_STR, NULL},
+    {CONFIG_SEARCH_ENTRY_BATCH_SIZE, config_set_search_entry_batch_size,
+     NULL, 0,
+     (void **)&global_slapdFrontendConfig.search_entry_batch_size,
+     CONFIG_INT, (ConfigGetFunc)config_get_search_entry_batch_size,
+     SLAPD_DEFAULT_SEARCH_ENTRY_BATCH_SIZE_STR, NULL},
+    {CONFIG_SEARCH_ENTRY_BATCH_LATENCY, config_set_search_entry_batch_latency,
+     NULL, 0,
+     (void **)&global_slapdFrontendConfig.search_entry_batch_latency,
+     CONFIG_INT, (ConfigGetFunc)config_get_search_entry_batch_latency,
+     SLAPD_DEFAULT_SEARCH_ENTRY_BATCH_LATENCY_STR, NULL},
     /* End config */
     };
 
@@ -2019,6 +2039,10 @@ FrontendConfig_init(void)
 #endif
     init_extract_pem = cfg->extract_pem = LDAP_ON;
     cfg->referral_check_period = SLAPD_DEFAULT_REFERRAL_CHECK_PERIOD;
+    cfg->bind_crypto_max_pending = SLAPD_DEFAULT_BIND_CRYPTO_MAX_PENDING;
+    cfg->pagedresults_cursor_maxmemory = SLAPD_DEFAULT_PAGEDRESULTS_CURSOR_MAXMEMORY;
+    cfg->search_entry_batch_size = SLAPD_DEFAULT_SEARCH_ENTRY_BATCH_SIZE;
+    cfg->search_entry_batch_latency = SLAPD_DEFAULT_SEARCH_ENTRY_BATCH_LATENCY;
     init_return_orig_dn = cfg->return_orig_dn = LDAP_ON;
     /*
      * Default upgrade hash to on - this is an important security step, meaning that old
@@ -9092,6 +9116,126 @@ config_set_referral_check_period(const char *attrname, char *value, char *errorb
     return LDAP_SUCCESS;
 }
 
+int32_t
+config_get_bind_crypto_max_pending()
+{
+    slapdFrontendConfig_t *slapdFrontendConfig = getFrontendConfig();
+    return slapi_atomic_load_32(&(slapdFrontendConfig->bind_crypto_max_pending), __ATOMIC_ACQUIRE);
+}
+
+int32_t
+config_set_bind_crypto_max_pending(const char *attrname, char *value, char *errorbuf, int apply)
+{
+    slapdFrontendConfig_t *slapdFrontendConfig = getFrontendConfig();
+    int32_t max_pending;
+    char *endp = NULL;
+
+    if (config_value_is_null(attrname, value, errorbuf, 0)) {
+        return LDAP_OPERATIONS_ERROR;
+    }
+    errno = 0;
+    max_pending = strtol(value, &endp, 10);
+    if ((*endp != '\0') || (errno == ERANGE) || (max_pending < 0)) {
+        slapi_create_errormsg(errorbuf, SLAPI_DSE_RETURNTEXT_SIZE, "limit \"%s\" is invalid, %s must be 0 (no limit) or more",
+                              value, CONFIG_BIND_CRYPTO_MAX_PENDING);
+        return LDAP_OPERATIONS_ERROR;
+    }
+    if (apply) {
+        slapi_atomic_store_32(&(slapdFrontendConfig->bind_crypto_max_pending), max_pending, __ATOMIC_RELEASE);
+    }
+    return LDAP_SUCCESS;
+}
+
+int32_t
+config_get_pagedresults_cursor_maxmemory()
+{
+    slapdFrontendConfig_t *slapdFrontendConfig = getFrontendConfig();
+    return slapi_atomic_load_32(&(slapdFrontendConfig->pagedresults_cursor_maxmemory), __ATOMIC_ACQUIRE);
+}
+
+int32_t
+config_set_pagedresults_cursor_maxmemory(const char *attrname, char *value, char *errorbuf, int apply)
+{
+    slapdFrontendConfig_t *slapdFrontendConfig = getFrontendConfig();
+    int32_t maxmemory;
+    char *endp = NULL;
+
+    if (config_value_is_null(attrname, value, errorbuf, 0)) {
+        return LDAP_OPERATIONS_ERROR;
+    }
+    errno = 0;
+    maxmemory = strtol(value, &endp, 10);
+    if ((*endp != '\0') || (errno == ERANGE) || (maxmemory < 0)) {
+        slapi_create_errormsg(errorbuf, SLAPI_DSE_RETURNTEXT_SIZE, "limit \"%s\" is invalid, %s must be 0 (no cursor kept) or more",
+                              value, CONFIG_PAGEDRESULTS_CURSOR_MAXMEMORY);
+        return LDAP_OPERATIONS_ERROR;
+    }
+    if (apply) {
+        slapi_atomic_store_32(&(slapdFrontendConfig->pagedresults_cursor_maxmemory), maxmemory, __ATOMIC_RELEASE);
+    }
+    return LDAP_SUCCESS;
+}
+
+int32_t
+config_get_search_entry_batch_size()
+{
+    slapdFrontendConfig_t *slapdFrontendConfig = getFrontendConfig();
+    return slapi_atomic_load_32(&(slapdFrontendConfig->search_entry_batch_size), __ATOMIC_ACQUIRE);
+}
+
+int32_t
+config_set_search_entry_batch_size(const char *attrname, char *value, char *errorbuf, int apply)
+{
+    slapdFrontendConfig_t *slapdFrontendConfig = getFrontendConfig();
+    int32_t size;
+    char *endp = NULL;
+
+    if (config_value_is_null(attrname, value, errorbuf, 0)) {
+        return LDAP_OPERATIONS_ERROR;
+    }
+    errno = 0;
+    size = strtol(value, &endp, 10);
+    if ((*endp != '\0') || (errno == ERANGE) || (size < 0)) {
+        slapi_create_errormsg(errorbuf, SLAPI_DSE_RETURNTEXT_SIZE, "limit \"%s\" is invalid, %s must be 0 (entries written one by one) or more",
+                              value, CONFIG_SEARCH_ENTRY_BATCH_SIZE);
+        return LDAP_OPERATIONS_ERROR;
+    }
+    if (apply) {
+        slapi_atomic_store_32(&(slapdFrontendConfig->search_entry_batch_size), size, __ATOMIC_RELEASE);
+    }
+    return LDAP_SUCCESS;
+}
+
+int32_t
+config_get_search_entry_batch_latency()
+{
+    slapdFrontendConfig_t *slapdFrontendConfig = getFrontendConfig();
+    return slapi_atomic_load_32(&(slapdFrontendConfig->search_entry_batch_latency), __ATOMIC_ACQUIRE);
+}
+
+int32_t
+config_set_search_entry_batch_latency(const char *attrname, char *value, char *errorbuf, int apply)
+{
+    slapdFrontendConfig_t *slapdFrontendConfig = getFrontendConfig();
+    int32_t latency;
+    char *endp = NULL;
+
+    if (config_value_is_null(attrname, value, errorbuf, 0)) {
+        return LDAP_OPERATIONS_ERROR;
+    }
+    errno = 0;
+    latency = strtol(value, &endp, 10);
+    if ((*endp != '\0') || (errno == ERANGE) || (latency < 0)) {
+        slapi_create_errormsg(errorbuf, SLAPI_DSE_RETURNTEXT_SIZE, "limit \"%s\" is invalid, %s must be 0 or more milliseconds",
+                              value, CONFIG_SEARCH_ENTRY_BATCH_LATENCY);
+        return LDAP_OPERATIONS_ERROR;
+    }
+    if (apply) {
+        slapi_atomic_store_32(&(slapdFrontendConfig->search_entry_batch_latency), latency, __ATOMIC_RELEASE);
+    }
+    return LDAP_SUCCESS;
+}
+
 int32_t
 config_get_return_orig_dn()
 {
@@ -353,7 +353,7 @@ usage(char *name, char *extraname, int slapd_exemode)
     case SLAPD_EXEMODE_DB2LDIF:
         usagestr = "usage: %s %s%s-D configdir [-n backend-instance-name] [-d debuglevel] "
                    "[-N] [-a outputfile] [-r] [-C] [{-s includesuffix}*] "
-                   "[{-x excludesuffix}*] [-u] [-U] [-m] [-M] [-E] [-q]\n"
+                   "[{-x excludesuffix}*] [-u] [-U] [-m] [-M] [-E] [-z] [-q]\n"
                    "Note: either \"-n backend_instance_name\" or \"-s includesuffix\" is required.\n";
         break;
     case SLAPD_EXEMODE_LDIF2DB:
@@ -1200,7 +1200,7 @@ process_command_line(int argc, char **argv, struct main_config *mcfg)
      *
      */
 
-    char *opts_db2ldif = "vd:D:ENa:rs:x:CSut:n:UmMo1qRV";
+    char *opts_db2ldif = "vd:D:ENa:rs:x:CSut:n:UmMo1qRVz";
     struct opt_ext long_options_db2ldif[] = {
         {"version", ArgNone, 'v'},
         {"debug", ArgRequired, 'd'},
@@ -1222,6 +1222,7 @@ process_command_line(int argc, char **argv, struct main_config *mcfg)
         {"noVersionNum", ArgNone, '1'},
         {"quiet", ArgNone, 'q'},
         {"verbose", ArgNone, 'V'},
+        {"gzip", ArgNone, 'z'},
         {0, 0, 0}};
 
     char *opts_ldif2db = "vd:i:g:G:n:s:x:NOCc:St:D:EqV";
@@ -1745,6 +1746,18 @@ process_command_line(int argc, char **argv, struct main_config *mcfg)
              */
             mcfg->ldif_printkey |= EXPORT_NOVERSION;
 
+            break;
+        case 'z': /* db2ldif only */
+            if (mcfg->slapd_exemode != SLAPD_EXEMODE_DB2LDIF) {
+                usage(mcfg->myname, mcfg->extraname, mcfg->slapd_exemode);
+                exit(1);
+            }
+
+            /*
+             * gzip compress the ldif file
+             */
+            mcfg->ldif_printkey |= EXPORT_GZIP;
+
             break;
         case 'q': /* quiet option for db2ldif, ldif2db, db2bak, bak2db */
             mcfg->is_quiet = 1;
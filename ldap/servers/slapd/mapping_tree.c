@@ -285,6 +285,8 @@ mapping_tree_node_new(Slapi_DN *dn, Slapi_Backend **be, char **backend_names, in
     mapping_tree_node *node;
     node = (mapping_tree_node *)slapi_ch_calloc(1, sizeof(mapping_tree_node));
     node->mtn_subtree = dn;
+    /* the subtree is compared with the target DN of every operation */
+    slapi_sdn_intern(node->mtn_subtree);
     node->mtn_be = be;
     node->mtn_be_states = be_states;
     node->mtn_backend_names = backend_names;
@@ -61,6 +61,10 @@ monitor_info(Slapi_PBlock *pb __attribute__((unused)),
     attrlist_replace(&e->e_attrs, "threads", vals);
 
     connection_table_as_entry(the_connection_table, e);
+    pagedresults_cursors_as_entry(e);
+#if defined(ENABLE_LDAPI) && defined(ENABLE_AUTOBIND)
+    ldapi_bind_cache_as_entry(e);
+#endif
 
     val.bv_len = snprintf(buf, sizeof(buf), "%" PRIu64, g_get_num_ops_initiated());
     val.bv_val = buf;
@@ -224,6 +224,11 @@ operation_done(Slapi_Operation **op, Connection *conn)
         }
         slapi_ch_free_string(&(*op)->o_results.result_matched);
         slapi_ch_free_string(&(*op)->o_results.result_text);
+        if ((*op)->o_entry_batch) {
+            /* the search entries of an abandoned operation are not written */
+            ber_free((*op)->o_entry_batch, 1);
+            (*op)->o_entry_batch = NULL;
+        }
         int options = 0;
         /* save the old options */
         if ((*op)->o_ber) {
@@ -391,6 +396,8 @@ operation_set_target_spec(Slapi_Operation *op, const Slapi_DN *target_spec)
     PR_ASSERT(target_spec);
 
     op->o_target_spec = slapi_sdn_dup(target_spec);
+    /* the mapping tree and the plugins match it against their subtrees */
+    slapi_sdn_intern(op->o_target_spec);
 }
 
 void
@@ -94,6 +94,10 @@ static ps_service_fn_ptr ps_service_fn = NULL;
 void
 do_ps_service(Slapi_Entry *e, Slapi_Entry *eprev, ber_int_t chgtype, ber_int_t chgnum)
 {
+#if defined(ENABLE_LDAPI) && defined(ENABLE_AUTOBIND)
+    /* Every successful change comes here, whether there are psearches or not */
+    ldapi_bind_cache_entry_changed(e, eprev);
+#endif
     if (NULL == ps_service_fn) {
         if (get_entry_point(ENTRY_POINT_PS_SERVICE, (caddr_t *)(&ps_service_fn)) < 0) {
             return;
@@ -306,6 +310,8 @@ op_shared_search(Slapi_PBlock *pb, int send_result)
         goto free_and_return_nolock;
     }
     basesdn = slapi_sdn_dup(sdn);
+    /* the base is tested against every backend suffix below */
+    slapi_sdn_intern(basesdn);
 
     slapi_pblock_get(pb, SLAPI_SEARCH_SCOPE, &scope);
     slapi_pblock_get(pb, SLAPI_SEARCH_STRFILTER, &fstr);
@@ -666,6 +672,7 @@ op_shared_search(Slapi_PBlock *pb, int send_result)
                     basesdn = operation_get_target_spec(operation);
                     slapi_sdn_free(&basesdn);
                     basesdn = slapi_sdn_dup(sdn);
+                    slapi_sdn_intern(basesdn);
                     operation_set_target_spec(operation, basesdn);
                 }
                 break;
@@ -1249,6 +1256,8 @@ iterate(Slapi_PBlock *pb, Slapi_Backend *be, int send_result, int *pnentries, in
         Slapi_Operation *operation;
 
         slapi_pblock_get(pb, SLAPI_OPERATION, &operation);
+        /* the backend may take a while to return the next entry */
+        send_ldap_search_entry_batch_check(pb);
         rc = be->be_next_search_entry(pb);
         if (rc < 0) {
             /*
@@ -1573,9 +1582,12 @@ static int
 send_results_ext(Slapi_PBlock *pb, int send_result, int *nentries, int pagesize, unsigned int *pr_stat)
 {
     Slapi_Backend *be;
+    Slapi_Operation *op = NULL;
+    struct timespec start;
     int rc;
 
     slapi_pblock_get(pb, SLAPI_BACKEND, &be);
+    slapi_pblock_get(pb, SLAPI_OPERATION, &op);
 
     if (be->be_next_search_entry == NULL) {
         /* we need to send the result, but the function to iterate through
@@ -1602,7 +1614,11 @@ send_results_ext(Slapi_PBlock *pb, int send_result, int *nentries, int pagesize,
     *    rc = iterate_with_lookahead(pb, be, send_result, nentries);
     * } else {
     */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    send_ldap_search_entry_batch_start(pb);
     rc = iterate(pb, be, send_result, nentries, pagesize, pr_stat);
+    send_ldap_search_entry_batch_end(pb);
+    latency_record(op, LATENCY_PHASE_ENTRIES, &start);
     /*
         }
     } else { // if (be->be_next_search_entry_ext != NULL)
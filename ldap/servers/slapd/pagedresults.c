@@ -16,6 +16,37 @@
 
 static pthread_mutex_t *lock_hash = NULL;
 
+/*
+ * Parked paged searches
+ *
+ * The cookie of a paged search is "<slot>.<cursor id>", the cursor id being
+ * unique in the server. When a connection is closed, its paged searches are
+ * parked here instead of being released: a client reconnecting, as the same
+ * identity, can resume a search by sending the same search with the cookie
+ * it got. The parked searches are kept within
+ * nsslapd-pagedresults-cursor-maxmemory, estimated from their candidate
+ * counts, the oldest ones are released first.
+ */
+typedef struct _pr_cursor
+{
+    PagedResults pr;          /* slot of the closed connection */
+    char *be_name;            /* to check the backend still exists */
+    size_t size;              /* estimated memory */
+    struct _pr_cursor *prev;
+    struct _pr_cursor *next;
+} pr_cursor;
+
+static pthread_mutex_t pr_cursor_lock = PTHREAD_MUTEX_INITIALIZER;
+static pr_cursor *pr_cursor_oldest = NULL;
+static pr_cursor *pr_cursor_newest = NULL;
+static uint64_t pr_cursor_count = 0;
+static uint64_t pr_cursor_memory = 0;
+static uint64_t pr_cursor_parked = 0;
+static uint64_t pr_cursor_resumed = 0;
+static uint64_t pr_cursor_evicted = 0;
+
+static void _pr_cursor_release(pr_cursor *cursor);
+
 void
 pageresult_lock_init()
 {
@@ -28,10 +59,21 @@ pageresult_lock_init()
 void
 pageresult_lock_cleanup()
 {
+    pr_cursor *cursor;
+
     for (size_t i=0; i<LOCK_HASH_SIZE; i++) {
         pthread_mutex_destroy(&lock_hash[i]);
     }
     slapi_ch_free((void**)&lock_hash);
+
+    pthread_mutex_lock(&pr_cursor_lock);
+    while ((cursor = pr_cursor_oldest)) {
+        pr_cursor_oldest = cursor->next;
+        _pr_cursor_release(cursor);
+    }
+    pr_cursor_newest = NULL;
+    pr_cursor_count = pr_cursor_memory = 0;
+    pthread_mutex_unlock(&pr_cursor_lock);
 }
 
 /* Beware to the lock order with c_mutex:
@@ -56,7 +98,8 @@ _pr_cleanup_one_slot(PagedResults *prp)
         prp->pr_current_be->be_search_results_release(&(prp->pr_search_result_set));
     }
 
-    /* clean up the slot except the mutex */
+    /* clean up the slot except the mutex and the cursor identity, the search
+     * may go on with the next backend */
     prp->pr_current_be = NULL;
     prp->pr_search_result_set = NULL;
     prp->pr_search_result_count = 0;
@@ -68,6 +111,278 @@ _pr_cleanup_one_slot(PagedResults *prp)
     prp->pr_msgid = 0;
 }
 
+/* free the cursor identity of a slot */
+static void
+_pr_cleanup_cursor_id(PagedResults *prp)
+{
+    prp->pr_cursor_id = 0;
+    slapi_ch_free_string(&prp->pr_bind_ndn);
+    slapi_ch_free_string(&prp->pr_search_key);
+}
+
+/* what a resumed search must match: scope, base and filter */
+static char *
+_pr_search_key(Slapi_PBlock *pb)
+{
+    Slapi_DN *sdn = NULL;
+    char *fstr = NULL;
+    int scope = 0;
+
+    slapi_pblock_get(pb, SLAPI_SEARCH_TARGET_SDN, &sdn);
+    slapi_pblock_get(pb, SLAPI_SEARCH_SCOPE, &scope);
+    slapi_pblock_get(pb, SLAPI_SEARCH_STRFILTER, &fstr);
+    return slapi_ch_smprintf("%d:%s:%s", scope, sdn ? slapi_sdn_get_ndn(sdn) : "", fstr ? fstr : "");
+}
+
+static char *
+_pr_bind_ndn(Slapi_PBlock *pb)
+{
+    char *ndn = NULL;
+
+    slapi_pblock_get(pb, SLAPI_REQUESTOR_NDN, &ndn);
+    return slapi_ch_strdup(ndn ? ndn : "");
+}
+
+/* release a parked search, pr_cursor_lock not held or the cursor unlinked */
+static void
+_pr_cursor_release(pr_cursor *cursor)
+{
+    Slapi_Backend *be = cursor->pr.pr_current_be;
+
+    /* The backend may have been removed while the search was parked */
+    if (be && cursor->pr.pr_search_result_set && be->be_search_results_release &&
+        slapi_be_select_by_instance_name(cursor->be_name) == be) {
+        be->be_search_results_release(&(cursor->pr.pr_search_result_set));
+    }
+    _pr_cleanup_cursor_id(&cursor->pr);
+    slapi_ch_free_string(&cursor->be_name);
+    slapi_ch_free((void **)&cursor);
+}
+
+/* pr_cursor_lock held */
+static void
+_pr_cursor_unlink(pr_cursor *cursor)
+{
+    if (cursor->prev) {
+        cursor->prev->next = cursor->next;
+    } else {
+        pr_cursor_oldest = cursor->next;
+    }
+    if (cursor->next) {
+        cursor->next->prev = cursor->prev;
+    } else {
+        pr_cursor_newest = cursor->prev;
+    }
+    cursor->prev = cursor->next = NULL;
+    pr_cursor_count--;
+    pr_cursor_memory -= cursor->size;
+}
+
+/*
+ * Park the paged search of a slot of a closing connection. On success the
+ * cursor owns the search result set and the identity of the slot.
+ * Returns 1 if the search was parked.
+ */
+static int
+_pr_cursor_park(PagedResults *prp)
+{
+    int32_t maxmemory = config_get_pagedresults_cursor_maxmemory();
+    pr_cursor *cursor = NULL;
+    pr_cursor *evicted = NULL;
+    size_t size;
+
+    if (maxmemory <= 0 || prp->pr_cursor_id == 0 || prp->pr_current_be == NULL ||
+        (prp->pr_flags & CONN_FLAG_PAGEDRESULTS_ABANDONED) ||
+        slapi_timespec_expire_check(&(prp->pr_timelimit_hr)) == TIMER_EXPIRED) {
+        return 0;
+    }
+    size = sizeof(pr_cursor) + strlen(prp->pr_bind_ndn) + strlen(prp->pr_search_key) +
+           (size_t)(prp->pr_search_result_set_size_estimate > 0 ? prp->pr_search_result_set_size_estimate : 0) *
+               sizeof(uint32_t);
+    if (size > (size_t)maxmemory) {
+        return 0;
+    }
+
+    cursor = (pr_cursor *)slapi_ch_calloc(1, sizeof(pr_cursor));
+    cursor->pr = *prp;
+    cursor->pr.pr_mutex = NULL;
+    cursor->pr.pr_flags &= ~CONN_FLAG_PAGEDRESULTS_PROCESSING;
+    cursor->be_name = slapi_ch_strdup(slapi_be_get_name(prp->pr_current_be));
+    cursor->size = size;
+    prp->pr_search_result_set = NULL;
+    prp->pr_bind_ndn = NULL;
+    prp->pr_search_key = NULL;
+    prp->pr_cursor_id = 0;
+
+    pthread_mutex_lock(&pr_cursor_lock);
+    cursor->prev = pr_cursor_newest;
+    if (pr_cursor_newest) {
+        pr_cursor_newest->next = cursor;
+    } else {
+        pr_cursor_oldest = cursor;
+    }
+    pr_cursor_newest = cursor;
+    pr_cursor_count++;
+    pr_cursor_memory += size;
+    pr_cursor_parked++;
+    /* Make room, the releases are done out of the lock */
+    while (pr_cursor_memory > (uint64_t)maxmemory) {
+        pr_cursor *oldest = pr_cursor_oldest;
+        _pr_cursor_unlink(oldest);
+        oldest->next = evicted;
+        evicted = oldest;
+        pr_cursor_evicted++;
+    }
+    pthread_mutex_unlock(&pr_cursor_lock);
+
+    while (evicted) {
+        pr_cursor *next = evicted->next;
+        _pr_cursor_release(evicted);
+        evicted = next;
+    }
+    return 1;
+}
+
+/*
+ * Take the parked search of a cookie, if it was started by the same identity
+ * with the same search. Returns NULL if there is none.
+ */
+static pr_cursor *
+_pr_cursor_take(uint64_t cursor_id, const char *bind_ndn, const char *search_key)
+{
+    pr_cursor *cursor;
+
+    pthread_mutex_lock(&pr_cursor_lock);
+    for (cursor = pr_cursor_oldest; cursor; cursor = cursor->next) {
+        if (cursor->pr.pr_cursor_id == cursor_id) {
+            break;
+        }
+    }
+    if (cursor && (strcmp(cursor->pr.pr_bind_ndn, bind_ndn) || strcmp(cursor->pr.pr_search_key, search_key))) {
+        cursor = NULL;
+    }
+    if (cursor) {
+        _pr_cursor_unlink(cursor);
+    }
+    pthread_mutex_unlock(&pr_cursor_lock);
+
+    if (cursor && slapi_timespec_expire_check(&(cursor->pr.pr_timelimit_hr)) == TIMER_EXPIRED) {
+        _pr_cursor_release(cursor);
+        cursor = NULL;
+    }
+    return cursor;
+}
+
+/*
+ * Get a free slot for a new paged search, pageresult_lock_get_addr(conn) held
+ */
+static int
+_pr_new_slot(Connection *conn, Slapi_Backend *be, int maxreqs, int *index)
+{
+    PagedResults *prp = NULL;
+    int maxlen = conn->c_pagedresults.prl_maxlen;
+    int i;
+
+    if (conn->c_pagedresults.prl_count == maxlen) {
+        if (0 == maxlen) { /* first time */
+            conn->c_pagedresults.prl_maxlen = 1;
+            conn->c_pagedresults.prl_list = (PagedResults *)slapi_ch_calloc(1, sizeof(PagedResults));
+        } else {
+            /* new max length */
+            conn->c_pagedresults.prl_maxlen *= 2;
+            conn->c_pagedresults.prl_list = (PagedResults *)slapi_ch_realloc(
+                (char *)conn->c_pagedresults.prl_list,
+                sizeof(PagedResults) * conn->c_pagedresults.prl_maxlen);
+            /* initialze newly allocated area */
+            memset(conn->c_pagedresults.prl_list + maxlen, '\0', sizeof(PagedResults) * maxlen);
+        }
+        *index = maxlen; /* the first position in the new area */
+        prp = conn->c_pagedresults.prl_list + *index;
+        prp->pr_current_be = be;
+    } else {
+        prp = conn->c_pagedresults.prl_list;
+        for (i = 0; i < conn->c_pagedresults.prl_maxlen; i++, prp++) {
+            if (!prp->pr_current_be) { /* unused slot; take it */
+                _pr_cleanup_one_slot(prp);
+                prp->pr_current_be = be;
+                *index = i;
+                break;
+            } else if (slapi_timespec_expire_check(&(prp->pr_timelimit_hr)) == TIMER_EXPIRED || /* timelimit exceeded */
+                       (prp->pr_flags & CONN_FLAG_PAGEDRESULTS_ABANDONED) /* abandoned */) {
+                _pr_cleanup_one_slot(prp);
+                conn->c_pagedresults.prl_count--;
+                prp->pr_current_be = be;
+                *index = i;
+                break;
+            }
+        }
+    }
+    if ((maxreqs > 0) && (*index >= maxreqs)) {
+        slapi_log_err(SLAPI_LOG_TRACE, "pagedresults_parse_control_value",
+                      "Simple paged results requests per conn exeeded the limit: %d\n",
+                      maxreqs);
+        return LDAP_UNWILLING_TO_PERFORM;
+    }
+
+    if ((*index > -1) && (*index < conn->c_pagedresults.prl_maxlen) &&
+        !conn->c_pagedresults.prl_list[*index].pr_mutex) {
+        conn->c_pagedresults.prl_list[*index].pr_mutex = PR_NewLock();
+    }
+    conn->c_pagedresults.prl_count++;
+    return LDAP_SUCCESS;
+}
+
+/*
+ * Resume on this connection a paged search parked by a closed one,
+ * pageresult_lock_get_addr(conn) held
+ */
+static int
+_pr_cursor_resume(Slapi_PBlock *pb, Connection *conn, uint64_t cursor_id, int maxreqs, int *index)
+{
+    char *bind_ndn = _pr_bind_ndn(pb);
+    char *search_key = _pr_search_key(pb);
+    pr_cursor *cursor = _pr_cursor_take(cursor_id, bind_ndn, search_key);
+    PagedResults *prp = NULL;
+    int rc;
+
+    slapi_ch_free_string(&bind_ndn);
+    slapi_ch_free_string(&search_key);
+    if (cursor == NULL) {
+        return LDAP_PROTOCOL_ERROR;
+    }
+    if (slapi_be_select_by_instance_name(cursor->be_name) != cursor->pr.pr_current_be) {
+        /* The backend was removed meanwhile */
+        _pr_cursor_release(cursor);
+        return LDAP_PROTOCOL_ERROR;
+    }
+
+    *index = -1;
+    rc = _pr_new_slot(conn, cursor->pr.pr_current_be, maxreqs, index);
+    if (rc != LDAP_SUCCESS) {
+        _pr_cursor_release(cursor);
+        return rc;
+    }
+    prp = conn->c_pagedresults.prl_list + *index;
+    _pr_cleanup_cursor_id(prp);
+    prp->pr_search_result_set = cursor->pr.pr_search_result_set;
+    prp->pr_search_result_count = cursor->pr.pr_search_result_count;
+    prp->pr_search_result_set_size_estimate = cursor->pr.pr_search_result_set_size_estimate;
+    prp->pr_sort_result_code = cursor->pr.pr_sort_result_code;
+    prp->pr_timelimit_hr = cursor->pr.pr_timelimit_hr;
+    prp->pr_flags = cursor->pr.pr_flags;
+    prp->pr_cursor_id = cursor->pr.pr_cursor_id;
+    prp->pr_bind_ndn = cursor->pr.pr_bind_ndn;
+    prp->pr_search_key = cursor->pr.pr_search_key;
+    slapi_ch_free_string(&cursor->be_name);
+    slapi_ch_free((void **)&cursor);
+    slapi_atomic_incr_64(&pr_cursor_resumed, __ATOMIC_RELAXED);
+
+    slapi_log_err(SLAPI_LOG_TRACE, "pagedresults_parse_control_value",
+                  "conn=%" PRIu64 " resumed the paged search %" PRIx64 " in slot %d\n",
+                  conn->c_connid, prp->pr_cursor_id, *index);
+    return LDAP_SUCCESS;
+}
+
 /*
  * Parse the value from an LDAPv3 "Simple Paged Results" control.  They look
  * like this:
@@ -97,6 +412,7 @@ pagedresults_parse_control_value(Slapi_PBlock *pb,
     PagedResults *prp = NULL;
     int i;
     int maxreqs = config_get_maxsimplepaged_per_conn();
+    uint64_t cursor_id = 0;
 
     slapi_pblock_get(pb, SLAPI_OPERATION, &op);
     slapi_pblock_get(pb, SLAPI_CONNECTION, &conn);
@@ -141,72 +457,54 @@ pagedresults_parse_control_value(Slapi_PBlock *pb,
     ber_free(ber, 1);
     if (cookie.bv_len <= 0) {
         /* first time? */
-        int maxlen = conn->c_pagedresults.prl_maxlen;
-        if (conn->c_pagedresults.prl_count == maxlen) {
-            if (0 == maxlen) { /* first time */
-                conn->c_pagedresults.prl_maxlen = 1;
-                conn->c_pagedresults.prl_list = (PagedResults *)slapi_ch_calloc(1, sizeof(PagedResults));
-            } else {
-                /* new max length */
-                conn->c_pagedresults.prl_maxlen *= 2;
-                conn->c_pagedresults.prl_list = (PagedResults *)slapi_ch_realloc(
-                    (char *)conn->c_pagedresults.prl_list,
-                    sizeof(PagedResults) * conn->c_pagedresults.prl_maxlen);
-                /* initialze newly allocated area */
-                memset(conn->c_pagedresults.prl_list + maxlen, '\0', sizeof(PagedResults) * maxlen);
-            }
-            *index = maxlen; /* the first position in the new area */
-            prp = conn->c_pagedresults.prl_list + *index;
-            prp->pr_current_be = be;
-        } else {
-            prp = conn->c_pagedresults.prl_list;
-            for (i = 0; i < conn->c_pagedresults.prl_maxlen; i++, prp++) {
-                if (!prp->pr_current_be) { /* unused slot; take it */
-                    _pr_cleanup_one_slot(prp);
-                    prp->pr_current_be = be;
-                    *index = i;
-                    break;
-                } else if (slapi_timespec_expire_check(&(prp->pr_timelimit_hr)) == TIMER_EXPIRED || /* timelimit exceeded */
-                           (prp->pr_flags & CONN_FLAG_PAGEDRESULTS_ABANDONED) /* abandoned */) {
-                    _pr_cleanup_one_slot(prp);
-                    conn->c_pagedresults.prl_count--;
-                    prp->pr_current_be = be;
-                    *index = i;
-                    break;
-                }
-            }
-        }
-        if ((maxreqs > 0) && (*index >= maxreqs)) {
-            rc = LDAP_UNWILLING_TO_PERFORM;
-            slapi_log_err(SLAPI_LOG_TRACE, "pagedresults_parse_control_value",
-                          "Simple paged results requests per conn exeeded the limit: %d\n",
-                          maxreqs);
+        rc = _pr_new_slot(conn, be, maxreqs, index);
+        if (rc != LDAP_SUCCESS) {
             goto bail;
         }
-
-        if ((*index > -1) && (*index < conn->c_pagedresults.prl_maxlen) &&
-            !conn->c_pagedresults.prl_list[*index].pr_mutex) {
-            conn->c_pagedresults.prl_list[*index].pr_mutex = PR_NewLock();
+        if ((*index > -1) && (*index < conn->c_pagedresults.prl_maxlen)) {
+            prp = conn->c_pagedresults.prl_list + *index;
+            _pr_cleanup_cursor_id(prp);
+            /* The id resumes the search from another connection: it must not be guessable */
+            do {
+                slapi_rand_array(&prp->pr_cursor_id, sizeof(prp->pr_cursor_id));
+            } while (prp->pr_cursor_id == 0);
+            prp->pr_bind_ndn = _pr_bind_ndn(pb);
+            prp->pr_search_key = _pr_search_key(pb);
         }
-        conn->c_pagedresults.prl_count++;
     } else {
         /* Repeated paged results request.
          * PagedResults is already allocated. */
         char *ptr = slapi_ch_malloc(cookie.bv_len + 1);
+        char *endp = NULL;
         memcpy(ptr, cookie.bv_val, cookie.bv_len);
         *(ptr + cookie.bv_len) = '\0';
-        *index = strtol(ptr, NULL, 10);
+        *index = strtol(ptr, &endp, 10);
+        if (*endp == '.') {
+            cursor_id = strtoull(endp + 1, NULL, 16);
+        }
         slapi_ch_free_string(&ptr);
-        if ((conn->c_pagedresults.prl_maxlen <= *index) || (*index < 0)) {
+        if (cursor_id &&
+            ((conn->c_pagedresults.prl_maxlen <= *index) || (*index < 0) ||
+             (conn->c_pagedresults.prl_list[*index].pr_cursor_id != cursor_id))) {
+            /* Not a search of this connection, it may have been parked */
+            rc = _pr_cursor_resume(pb, conn, cursor_id, maxreqs, index);
+            if (rc != LDAP_SUCCESS) {
+                slapi_log_err(SLAPI_LOG_ERR, "pagedresults_parse_control_value",
+                              "Invalid cookie: %d.%" PRIx64 "\n", *index, cursor_id);
+                *index = -1; /* index is invalid. reinitializing it. */
+                goto bail;
+            }
+        } else if ((conn->c_pagedresults.prl_maxlen <= *index) || (*index < 0)) {
             rc = LDAP_PROTOCOL_ERROR;
             slapi_log_err(SLAPI_LOG_ERR, "pagedresults_parse_control_value",
                           "Invalid cookie: %d\n", *index);
             *index = -1; /* index is invalid. reinitializing it. */
             goto bail;
-        }
-        prp = conn->c_pagedresults.prl_list + *index;
-        if (!(prp->pr_search_result_set)) { /* freed and reused for the next backend. */
-            conn->c_pagedresults.prl_count++;
+        } else {
+            prp = conn->c_pagedresults.prl_list + *index;
+            if (!(prp->pr_search_result_set)) { /* freed and reused for the next backend. */
+                conn->c_pagedresults.prl_count++;
+            }
         }
     }
     /* reset sizelimit */
@@ -273,6 +571,8 @@ pagedresults_set_response_control(Slapi_PBlock *pb, int iscritical, ber_int_t es
     int found = 0;
     int i;
     int cookie = 0;
+    uint64_t cursor_id = 0;
+    Connection *conn = NULL;
 
     slapi_log_err(SLAPI_LOG_TRACE, "pagedresults_set_response_control",
                   "=> idx=%d\n", index);
@@ -287,7 +587,19 @@ pagedresults_set_response_control(Slapi_PBlock *pb, int iscritical, ber_int_t es
         cookie_str = slapi_ch_strdup("");
     } else {
         cookie = index;
-        cookie_str = slapi_ch_smprintf("%d", index);
+        slapi_pblock_get(pb, SLAPI_CONNECTION, &conn);
+        if (conn && (index > -1)) {
+            pthread_mutex_lock(pageresult_lock_get_addr(conn));
+            if (index < conn->c_pagedresults.prl_maxlen) {
+                cursor_id = conn->c_pagedresults.prl_list[index].pr_cursor_id;
+            }
+            pthread_mutex_unlock(pageresult_lock_get_addr(conn));
+        }
+        if (cursor_id) {
+            cookie_str = slapi_ch_smprintf("%d.%" PRIx64, index, cursor_id);
+        } else {
+            cookie_str = slapi_ch_smprintf("%d", index);
+        }
     }
     slapi_pblock_set(pb, SLAPI_PAGED_RESULTS_COOKIE, &cookie);
     ber_printf(ber, "{io}", estimate, cookie_str, strlen(cookie_str));
@@ -796,7 +1108,10 @@ pagedresults_cleanup(Connection *conn, int needlock)
                 i < conn->c_pagedresults.prl_maxlen;
          i++) {
         prp = conn->c_pagedresults.prl_list + i;
-        if (prp->pr_current_be && prp->pr_search_result_set &&
+        if (_pr_cursor_park(prp)) {
+            /* the client may resume it from another connection */
+            rc = 1;
+        } else if (prp->pr_current_be && prp->pr_search_result_set &&
             prp->pr_current_be->be_search_results_release) {
             prp->pr_current_be->be_search_results_release(&(prp->pr_search_result_set));
             rc = 1;
@@ -805,6 +1120,7 @@ pagedresults_cleanup(Connection *conn, int needlock)
         if (prp->pr_mutex) {
             PR_DestroyLock(prp->pr_mutex);
         }
+        _pr_cleanup_cursor_id(prp);
         memset(prp, '\0', sizeof(PagedResults));
     }
     conn->c_pagedresults.prl_count = 0;
@@ -848,6 +1164,7 @@ pagedresults_cleanup_all(Connection *conn, int needlock)
             rc = 1;
         }
         prp->pr_current_be = NULL;
+        _pr_cleanup_cursor_id(prp);
     }
     slapi_ch_free((void **)&conn->c_pagedresults.prl_list);
     conn->c_pagedresults.prl_maxlen = 0;
@@ -1098,3 +1415,43 @@ pagedresults_set_search_result_pb(Slapi_PBlock *pb, void *sr, int locked)
                   "pagedresults_set_search_result_pb", "<= %d\n", rc);
     return rc;
 }
+
+/*
+ * Fill cn=monitor with the parked paged searches:
+ *   pagedresultscursors: parked searches
+ *   pagedresultscursormemory: their estimated memory, in bytes
+ *   pagedresultscursorsparked, pagedresultscursorsresumed,
+ *   pagedresultscursorsevicted: searches parked, resumed and released to
+ *   make room since the startup
+ */
+void
+pagedresults_cursors_as_entry(Slapi_Entry *e)
+{
+    uint64_t count, memory, parked, evicted;
+    char buf[32];
+    struct berval val;
+    struct berval *vals[2] = {&val, NULL};
+
+    pthread_mutex_lock(&pr_cursor_lock);
+    count = pr_cursor_count;
+    memory = pr_cursor_memory;
+    parked = pr_cursor_parked;
+    evicted = pr_cursor_evicted;
+    pthread_mutex_unlock(&pr_cursor_lock);
+
+    val.bv_val = buf;
+    val.bv_len = snprintf(buf, sizeof(buf), "%" PRIu64, count);
+    attrlist_replace(&e->e_attrs, "pagedresultscursors", vals);
+
+    val.bv_len = snprintf(buf, sizeof(buf), "%" PRIu64, memory);
+    attrlist_replace(&e->e_attrs, "pagedresultscursormemory", vals);
+
+    val.bv_len = snprintf(buf, sizeof(buf), "%" PRIu64, parked);
+    attrlist_replace(&e->e_attrs, "pagedresultscursorsparked", vals);
+
+    val.bv_len = snprintf(buf, sizeof(buf), "%" PRIu64, slapi_atomic_load_64(&pr_cursor_resumed, __ATOMIC_RELAXED));
+    attrlist_replace(&e->e_attrs, "pagedresultscursorsresumed", vals);
+
+    val.bv_len = snprintf(buf, sizeof(buf), "%" PRIu64, evicted);
+    attrlist_replace(&e->e_attrs, "pagedresultscursorsevicted", vals);
+}
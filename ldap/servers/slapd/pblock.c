@@ -2993,6 +2993,17 @@ slapi_pblock_get_ldif_changelog(Slapi_PBlock *pblock, void *value)
     return 0;
 }
 
+static int32_t
+slapi_pblock_get_backup_incremental_base(Slapi_PBlock *pblock, void *value)
+{
+    if (pblock->pb_task != NULL) {
+        (*(char **)value) = pblock->pb_task->backup_incremental_base;
+    } else {
+        (*(char **)value) = NULL;
+    }
+    return 0;
+}
+
 static int32_t
 slapi_pblock_get_dbverify_dbdir(Slapi_PBlock *pblock, void *value)
 {
@@ -5962,6 +5973,14 @@ slapi_pblock_set_ldif_changelog(Slapi_PBlock *pblock, void *value)
     return 0;
 }
 
+static int32_t
+slapi_pblock_set_backup_incremental_base(Slapi_PBlock *pblock, void *value)
+{
+    _pblock_assert_pb_task(pblock);
+    pblock->pb_task->backup_incremental_base = (char *)value;
+    return 0;
+}
+
 static int32_t
 slapi_pblock_set_ldif_encrypted(Slapi_PBlock *pblock, void *value)
 {
@@ -8499,7 +8518,7 @@ static int32_t (*get_cbtable[])(Slapi_PBlock *, void *) = {
     NULL, /* slot 1759 available */
     NULL, /* slot 1760 available */
     slapi_pblock_get_ldif_changelog,
-    NULL, /* slot 1762 available */
+    slapi_pblock_get_backup_incremental_base,
     NULL, /* slot 1763 available */
     NULL, /* slot 1764 available */
     NULL, /* slot 1765 available */
@@ -10474,7 +10493,7 @@ static int32_t (*set_cbtable[])(Slapi_PBlock *, void *) = {
     NULL, /* slot 1759 available */
     NULL, /* slot 1760 available */
     slapi_pblock_set_ldif_changelog,
-    NULL, /* slot 1762 available */
+    slapi_pblock_set_backup_incremental_base,
     NULL, /* slot 1763 available */
     NULL, /* slot 1764 available */
     NULL, /* slot 1765 available */
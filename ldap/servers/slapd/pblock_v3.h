@@ -47,6 +47,7 @@ typedef struct _slapi_pblock_task
     char *seq_val;
     char *dbverify_dbdir;
     char *ldif_file;
+    char *backup_incremental_base;
     char **db2index_attrs;
 
     /*
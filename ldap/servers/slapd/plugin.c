@@ -304,6 +304,46 @@ slapi_register_plugin_ext(
     return rc;
 }
 
+/*
+ * Latency phase of a plugin call (-1 if the call is not a phase of
+ * the operation, i.e it is done for each entry sent)
+ */
+static int32_t
+plugin_latency_phase(int whichfunction, int plugin_list_number)
+{
+    switch (whichfunction) {
+    case SLAPI_PLUGIN_PRE_ENTRY_FN:
+    case SLAPI_PLUGIN_PRE_REFERRAL_FN:
+    case SLAPI_PLUGIN_PRE_RESULT_FN:
+    case SLAPI_PLUGIN_POST_ENTRY_FN:
+    case SLAPI_PLUGIN_POST_REFERRAL_FN:
+    case SLAPI_PLUGIN_POST_RESULT_FN:
+    case SLAPI_PLUGIN_BE_PRE_CLOSE_FN:
+    case SLAPI_PLUGIN_BE_POST_OPEN_FN:
+    case SLAPI_PLUGIN_BE_POST_EXPORT_FN:
+    case SLAPI_PLUGIN_BE_POST_IMPORT_FN:
+        return -1;
+    }
+    switch (plugin_list_number) {
+    case PLUGIN_LIST_PREOPERATION:
+    case PLUGIN_LIST_INTERNAL_PREOPERATION:
+    case PLUGIN_LIST_PREEXTENDED_OPERATION:
+    case PLUGIN_LIST_BEPREOPERATION:
+        return LATENCY_PHASE_PREOP;
+    case PLUGIN_LIST_BETXNPREOPERATION:
+        return LATENCY_PHASE_BETXN_PREOP;
+    case PLUGIN_LIST_BETXNPOSTOPERATION:
+        return LATENCY_PHASE_BETXN_POSTOP;
+    case PLUGIN_LIST_POSTOPERATION:
+    case PLUGIN_LIST_INTERNAL_POSTOPERATION:
+    case PLUGIN_LIST_POSTEXTENDED_OPERATION:
+    case PLUGIN_LIST_BEPOSTOPERATION:
+        return LATENCY_PHASE_POSTOP;
+    default:
+        return -1;
+    }
+}
+
 int
 plugin_call_plugins(Slapi_PBlock *pb, int whichfunction)
 {
@@ -403,6 +443,14 @@ plugin_call_plugins(Slapi_PBlock *pb, int whichfunction)
         /* We stash the pblock plugin pointer to preserve the callers context */
         struct slapdplugin *p;
         int locked = 0;
+        int32_t phase = plugin_latency_phase(whichfunction, plugin_list_number);
+        Operation *op = NULL;
+        struct timespec start;
+
+        if (phase >= 0) {
+            slapi_pblock_get(pb, SLAPI_OPERATION, &op);
+            clock_gettime(CLOCK_MONOTONIC, &start);
+        }
 
         locked = slapi_td_get_plugin_locked();
         if (!locked) {
@@ -417,6 +465,9 @@ plugin_call_plugins(Slapi_PBlock *pb, int whichfunction)
         if (!locked) {
             slapi_rwlock_unlock(global_rwlock);
         }
+        if (op) {
+            latency_record(op, (latency_phase_t)phase, &start);
+        }
     } else {
         /* Programmer error! or the callback is denied during startup */
     }
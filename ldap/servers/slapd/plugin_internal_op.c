@@ -42,8 +42,19 @@ typedef struct plugin_search_internal_data
     int num_referrals;
     Entry_Node *entry_list_head;
     Referral_Node *referral_list_head;
+    char **project_attrs; /* when set, entries only carry these attributes */
 } plugin_search_internal_data;
 
+/* data that must be passed through slapi_search_internal_stream_pb */
+typedef struct plugin_search_stream_data
+{
+    int rc;
+    int num_entries;
+    int stopped;
+    plugin_search_entry_callback psec;
+    void *callback_data;
+} plugin_search_stream_data;
+
 /* callback functions */
 typedef struct callback_fn_ptrs
 {
@@ -55,7 +66,7 @@ typedef struct callback_fn_ptrs
 
 /* forward declarations */
 static int seq_internal_callback_pb(Slapi_PBlock *pb, void *callback_data, plugin_result_callback prc, plugin_search_entry_callback psec, plugin_referral_entry_callback prec);
-static int search_internal_pb(Slapi_PBlock *pb);
+static int search_internal_pb(Slapi_PBlock *pb, PRBool project);
 static int search_internal_callback_pb(Slapi_PBlock *pb, void *callback_data, plugin_result_callback prc, plugin_search_entry_callback psec, plugin_referral_entry_callback prec);
 
 void
@@ -443,7 +454,7 @@ slapi_search_internal(const char *base,
     if (pb) {
         slapi_search_internal_set_pb(pb, base, scope, filter, attrs, attrsonly, controls,
                                      NULL, plugin_get_default_component_id(), 0);
-        search_internal_pb(pb);
+        search_internal_pb(pb, PR_FALSE);
     }
     return pb;
 }
@@ -506,7 +517,87 @@ slapi_search_internal_pb(Slapi_PBlock *pb)
         return 0;
     }
 
-    return search_internal_pb(pb);
+    return search_internal_pb(pb, PR_FALSE);
+}
+
+/*
+ * Same as slapi_search_internal_pb, but the returned entries only carry the
+ * attributes listed in SLAPI_SEARCH_ATTRS (and their subtypes) instead of a
+ * full copy of the cached entry.  "1.1" returns the DN only, while a NULL
+ * list or "*" returns complete entries.
+ */
+int
+slapi_search_internal_projected_pb(Slapi_PBlock *pb)
+{
+    if (pb == NULL)
+        return -1;
+
+    if (!allow_operation(pb)) {
+        slapi_send_ldap_result(pb, LDAP_UNWILLING_TO_PERFORM, NULL,
+                               "This plugin is not configured to access operation target data", 0, NULL);
+        return 0;
+    }
+
+    return search_internal_pb(pb, PR_TRUE);
+}
+
+static int
+internal_plugin_search_stream_entry_callback(Slapi_Entry *e, void *callback_data)
+{
+    plugin_search_stream_data *pssd = (plugin_search_stream_data *)callback_data;
+
+    pssd->num_entries++;
+    if (pssd->psec && pssd->psec(e, pssd->callback_data) != 0) {
+        /* the caller has seen enough, abandon the rest of the search */
+        pssd->stopped = 1;
+        return -1;
+    }
+    return 0;
+}
+
+static void
+internal_plugin_stream_result_callback(int rc, void *callback_data)
+{
+    ((plugin_search_stream_data *)callback_data)->rc = rc;
+}
+
+/*
+ * Streaming variant of slapi_search_internal_pb: no copy of the matching
+ * entries is made.  Each entry is handed to psec while it is still pinned
+ * in the backend entry cache, so it is only valid for the duration of the
+ * callback and must be treated as read-only (dup it to keep it).
+ *
+ * psec returns 0 to get the next entry, or non-zero to stop the search; a
+ * search stopped that way reports LDAP_SUCCESS.  Referrals are ignored.
+ * On return SLAPI_PLUGIN_INTOP_RESULT and SLAPI_NENTRIES are set in pb.
+ */
+int
+slapi_search_internal_stream_pb(Slapi_PBlock *pb, void *callback_data, plugin_search_entry_callback psec)
+{
+    plugin_search_stream_data pssd = {0};
+    int opresult;
+
+    if (pb == NULL)
+        return -1;
+
+    if (!allow_operation(pb)) {
+        slapi_send_ldap_result(pb, LDAP_UNWILLING_TO_PERFORM, NULL,
+                               "This plugin is not configured to access operation target data", 0, NULL);
+        return 0;
+    }
+
+    pssd.rc = -1;
+    pssd.psec = psec;
+    pssd.callback_data = callback_data;
+
+    search_internal_callback_pb(pb, &pssd, internal_plugin_stream_result_callback,
+                                internal_plugin_search_stream_entry_callback, NULL);
+
+    opresult = pssd.stopped ? LDAP_SUCCESS : pssd.rc;
+    slapi_pblock_set(pb, SLAPI_NENTRIES, &pssd.num_entries);
+    slapi_pblock_set(pb, SLAPI_PLUGIN_INTOP_RESULT, &opresult);
+
+    return 0;
 }
 
 /* pblock should contain the same data as for slapi_search_internal_pb */
@@ -525,15 +616,55 @@ slapi_search_internal_callback_pb(Slapi_PBlock *pb, void *callback_data, plugin_
     return (search_internal_callback_pb(pb, callback_data, prc, psec, prec));
 }
 
+/*
+ * Copy the DN of e and only the attributes named in attrs.
+ * Falls back to a complete copy if all user attributes were requested.
+ */
+static Slapi_Entry *
+internal_entry_dup_projected(const Slapi_Entry *e, char **attrs)
+{
+    Slapi_Entry *ec;
+    Slapi_Attr *a = NULL;
+    char *type = NULL;
+
+    if (attrs == NULL || charray_inlist(attrs, "*")) {
+        return slapi_entry_dup(e);
+    }
+
+    ec = slapi_entry_alloc();
+    slapi_entry_init(ec, NULL, NULL);
+    slapi_sdn_copy(slapi_entry_get_sdn_const(e), &ec->e_sdn);
+    slapi_srdn_copy(slapi_entry_get_srdn_const(e), &ec->e_srdn);
+
+    for (slapi_entry_first_attr(e, &a); a; slapi_entry_next_attr(e, a, &a)) {
+        slapi_attr_get_type(a, &type);
+        for (size_t i = 0; attrs[i]; i++) {
+            if (slapi_attr_type_cmp(attrs[i], type, SLAPI_TYPE_CMP_SUBTYPE) == 0 ||
+                slapi_attr_types_equivalent(attrs[i], type)) {
+                attrlist_add(&ec->e_attrs, slapi_attr_dup(a));
+                break;
+            }
+        }
+    }
+
+    return ec;
+}
+
 static int
 internal_plugin_search_entry_callback(Slapi_Entry *e, void *callback_data)
 {
+    plugin_search_internal_data *psid = (plugin_search_internal_data *)callback_data;
     Entry_Node *this_entry;
 
     /* add this entry to the list of entries we are making */
     this_entry = (Entry_Node *)slapi_ch_calloc(1, sizeof(Entry_Node));
 
-    if ((this_entry->data = slapi_entry_dup(e)) == NULL) {
+    if (psid->project_attrs) {
+        this_entry->data = internal_entry_dup_projected(e, psid->project_attrs);
+    } else {
+        this_entry->data = slapi_entry_dup(e);
+    }
+    if (this_entry->data == NULL) {
         slapi_ch_free((void**)&this_entry);
         return (0);
     }
@@ -570,7 +701,7 @@ internal_plugin_result_callback(int rc, void *callback_data)
 }
 
 static int
-search_internal_pb(Slapi_PBlock *pb)
+search_internal_pb(Slapi_PBlock *pb, PRBool project)
 {
     plugin_search_internal_data psid;
     Entry_Node *iterator, *tmp;
@@ -588,6 +719,14 @@ search_internal_pb(Slapi_PBlock *pb)
     psid.num_referrals = 0;
     psid.entry_list_head = NULL;
     psid.referral_list_head = NULL;
+    psid.project_attrs = NULL;
+
+    if (project) {
+        char **attrs = NULL;
+        /* the search may rewrite SLAPI_SEARCH_ATTRS, keep our own copy */
+        slapi_pblock_get(pb, SLAPI_SEARCH_ATTRS, &attrs);
+        psid.project_attrs = slapi_ch_array_dup(attrs);
+    }
 
     /* setup additional pb data */
     slapi_pblock_set(pb, SLAPI_PLUGIN_INTOP_RESULT, &opresult);
@@ -624,6 +763,7 @@ search_internal_pb(Slapi_PBlock *pb)
         }
     }
     psid.entry_list_head = NULL;
+    slapi_ch_array_free(psid.project_attrs);
 
     /* stuff referrals list into an array if we got any to put into the pblock */
     if (psid.num_referrals != 0) {
@@ -847,6 +987,17 @@ set_common_params(Slapi_PBlock *pb)
 }
 
 
+static int
+internal_get_entry_callback(Slapi_Entry *e, void *callback_data)
+{
+    Slapi_Entry **ret_entry = (Slapi_Entry **)callback_data;
+
+    if (ret_entry && *ret_entry == NULL) {
+        *ret_entry = slapi_entry_dup(e);
+    }
+    return 0;
+}
+
 /*
  * Given a DN, find an entry by doing an internal search.  An LDAP error
  * code is returned.  To check if an entry exists without returning a
@@ -855,8 +1006,8 @@ set_common_params(Slapi_PBlock *pb)
 int
 slapi_search_internal_get_entry(Slapi_DN *dn, char **attrs, Slapi_Entry **ret_entry, void *component_identity)
 {
-    Slapi_Entry **entries = NULL;
     Slapi_PBlock *int_search_pb = NULL;
+    int nentries = 0;
     int rc = 0;
 
     if (ret_entry) {
@@ -869,23 +1020,19 @@ slapi_search_internal_get_entry(Slapi_DN *dn, char **attrs, Slapi_Entry **ret_en
                                  0 /* attrsonly */, NULL /* controls */,
                                  NULL /* uniqueid */,
                                  component_identity, 0 /* actions */);
-    slapi_search_internal_pb(int_search_pb);
+    /* The entry is only copied once, and not at all for an existence check */
+    slapi_search_internal_stream_pb(int_search_pb, ret_entry, internal_get_entry_callback);
     slapi_pblock_get(int_search_pb, SLAPI_PLUGIN_INTOP_RESULT, &rc);
     if (LDAP_SUCCESS == rc) {
-        slapi_pblock_get(int_search_pb, SLAPI_PLUGIN_INTOP_SEARCH_ENTRIES, &entries);
-        if (NULL != entries && NULL != entries[0]) {
-            /* Only need to dup the entry if the caller passed ret_entry in. */
-            if (ret_entry) {
-                Slapi_Entry *temp_entry = NULL;
-                temp_entry = entries[0];
-                *ret_entry = slapi_entry_dup(temp_entry);
-            }
-        } else {
+        slapi_pblock_get(int_search_pb, SLAPI_NENTRIES, &nentries);
+        if (nentries == 0) {
             /* No entry there */
             rc = LDAP_NO_SUCH_OBJECT;
         }
+    } else if (ret_entry) {
+        slapi_entry_free(*ret_entry);
+        *ret_entry = NULL;
     }
-    slapi_free_search_results_internal(int_search_pb);
     slapi_pblock_destroy(int_search_pb);
     int_search_pb = NULL;
     return rc;
@@ -223,6 +223,7 @@ void do_compare(Slapi_PBlock *pb);
  * computed.c
  */
 int compute_attribute(char *type, Slapi_PBlock *pb, BerElement *ber, Slapi_Entry *e, int attrsonly, char *requested_type);
+Slapi_PBlock *compute_get_pblock(computed_attr_context *c);
 int compute_init(void);
 int compute_terminate(void);
 void compute_plugins_started(void);
@@ -647,6 +648,15 @@ int32_t config_get_ldapssotoken_ttl(void);
 int32_t config_get_referral_check_period(void);
 int32_t config_set_referral_check_period(const char *attrname, char *value, char *errorbuf, int apply);
 
+int32_t config_get_bind_crypto_max_pending(void);
+int32_t config_set_bind_crypto_max_pending(const char *attrname, char *value, char *errorbuf, int apply);
+int32_t config_get_pagedresults_cursor_maxmemory(void);
+int32_t config_set_pagedresults_cursor_maxmemory(const char *attrname, char *value, char *errorbuf, int apply);
+int32_t config_get_search_entry_batch_size(void);
+int32_t config_set_search_entry_batch_size(const char *attrname, char *value, char *errorbuf, int apply);
+int32_t config_get_search_entry_batch_latency(void);
+int32_t config_set_search_entry_batch_latency(const char *attrname, char *value, char *errorbuf, int apply);
+
 int32_t config_get_return_orig_dn(void);
 int32_t config_set_return_orig_dn(const char *attrname, char *value, char *errorbuf, int apply);
 
@@ -1112,6 +1122,9 @@ void send_nobackend_ldap_result(Slapi_PBlock *pb);
 int send_ldap_referral(Slapi_PBlock *pb, Slapi_Entry *e, struct berval **refs, struct berval ***urls);
 int send_ldapv3_referral(Slapi_PBlock *pb, struct berval **urls);
 int set_db_default_result_handlers(Slapi_PBlock *pb);
+void send_ldap_search_entry_batch_start(Slapi_PBlock *pb);
+void send_ldap_search_entry_batch_check(Slapi_PBlock *pb);
+void send_ldap_search_entry_batch_end(Slapi_PBlock *pb);
 void disconnect_server_nomutex(Connection *conn, PRUint64 opconnid, int opid, PRErrorCode reason, PRInt32 error);
 void disconnect_server_nomutex_ext(Connection *conn, PRUint64 opconnid, int opid, PRErrorCode reason, PRInt32 error, int schedule_closure_job);
 long g_get_current_conn_count(void);
@@ -1643,6 +1656,7 @@ void pagedresults_lock(Connection *conn, int index);
 void pagedresults_unlock(Connection *conn, int index);
 int pagedresults_is_abandoned_or_notavailable(Connection *conn, int locked, int index);
 int pagedresults_set_search_result_pb(Slapi_PBlock *pb, void *sr, int locked);
+void pagedresults_cursors_as_entry(Slapi_Entry *e);
 
 /*
  * sort.c
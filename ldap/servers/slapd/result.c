@@ -1814,6 +1814,190 @@ cleanup:
 }
 
 
+/*
+ * Search entries are queued in the operation while the backend returns
+ * them, and written together once nsslapd-search-entry-batch-size bytes are
+ * queued or the first of them waited nsslapd-search-entry-batch-latency ms.
+ * The backend checks the latency while it looks through the candidates, so
+ * queued entries are not held back by a long scan.
+ * Anything else sent for the operation writes the queued entries first, and
+ * the batch ends with the backend search so that the entries sent later by
+ * a persistent search are not delayed.
+ *
+ * A queued entry counts as sent: dsEntriesSent and the POST_ENTRY plugins
+ * are done when it is queued. The bytes are accounted for when the batch is
+ * written.
+ */
+void
+send_ldap_search_entry_batch_start(Slapi_PBlock *pb)
+{
+    Operation *op = NULL;
+    Connection *conn = NULL;
+
+    slapi_pblock_get(pb, SLAPI_OPERATION, &op);
+    slapi_pblock_get(pb, SLAPI_CONNECTION, &conn);
+    if ((op == NULL) || (conn == NULL) || operation_is_flag_set(op, OP_FLAG_INTERNAL)) {
+        return;
+    }
+    op->o_entry_batch_size = config_get_search_entry_batch_size();
+}
+
+static void
+account_bytes_sent(Connection *conn, ber_len_t bytes)
+{
+    PRUint64 b;
+
+    slapi_log_err(SLAPI_LOG_BER, "flush_ber",
+                  "Wrote %lu bytes to socket %d\n", bytes, conn->c_sd);
+    LL_I2L(b, bytes);
+    slapi_counter_add(g_get_per_thread_snmp_vars()->server_tbl.dsBytesSent, b);
+    if (!config_check_referral_mode())
+        slapi_counter_add(g_get_per_thread_snmp_vars()->ops_tbl.dsBytesSent, bytes);
+}
+
+/*
+ * Writes the queued search entries, the caller holds the c_pdumutex.
+ * Always frees the batch.
+ */
+static int
+flush_entry_batch_nolock(Connection *conn, Operation *op)
+{
+    ber_len_t bytes = 0;
+    int rc;
+
+    if (op->o_entry_batch == NULL) {
+        return 0;
+    }
+
+    ber_get_option(op->o_entry_batch, LBER_OPT_BYTES_TO_WRITE, &bytes);
+    rc = ber_flush(conn->c_sb, op->o_entry_batch, 1);
+    if (rc == 0) {
+        slapi_counter_increment(entry_writes);
+        slapi_counter_add(entry_write_bytes, bytes);
+        account_bytes_sent(conn, bytes);
+    } else {
+        ber_free(op->o_entry_batch, 1);
+    }
+    op->o_entry_batch = NULL;
+
+    return rc;
+}
+
+/*
+ * Adds an encoded search entry to the batch, and writes the batch when it is
+ * full or old enough. The caller holds the c_pdumutex. Always frees the ber.
+ */
+static int
+queue_entry_batch_nolock(Connection *conn, Operation *op, BerElement *ber, struct timespec *now)
+{
+    struct berval bv = {0};
+    struct timespec waited;
+    ber_len_t queued = 0;
+    int rc = 0;
+
+    if (op->o_entry_batch == NULL) {
+        op->o_entry_batch = der_alloc();
+        op->o_entry_batch_start = *now;
+    }
+    if ((op->o_entry_batch == NULL) || (ber_flatten2(ber, &bv, 0) != 0) ||
+        (ber_write(op->o_entry_batch, bv.bv_val, bv.bv_len, 0) != (ber_slen_t)bv.bv_len)) {
+        /* Not queued, write it after the entries already queued */
+        slapi_log_err(SLAPI_LOG_CONNS, "queue_entry_batch_nolock",
+                      "Failed to queue the entry, writing it alone\n");
+        if ((rc = flush_entry_batch_nolock(conn, op)) == 0) {
+            ber_get_option(ber, LBER_OPT_BYTES_TO_WRITE, &queued);
+            if ((rc = ber_flush(conn->c_sb, ber, 1)) == 0) {
+                slapi_counter_increment(entry_writes);
+                slapi_counter_add(entry_write_bytes, queued);
+                account_bytes_sent(conn, queued);
+                return rc;
+            }
+        }
+        ber_free(ber, 1);
+        return rc;
+    }
+    ber_free(ber, 1);
+
+    ber_get_option(op->o_entry_batch, LBER_OPT_BYTES_TO_WRITE, &queued);
+    slapi_timespec_diff(now, &op->o_entry_batch_start, &waited);
+    if ((queued >= (ber_len_t)op->o_entry_batch_size) ||
+        ((waited.tv_sec * 1000 + waited.tv_nsec / 1000000) >= config_get_search_entry_batch_latency())) {
+        rc = flush_entry_batch_nolock(conn, op);
+    }
+
+    return rc;
+}
+
+/*
+ * Writes the queued search entries, or drops them if the operation was
+ * abandoned or the connection is closing.
+ */
+static void
+write_entry_batch(Slapi_PBlock *pb, Connection *conn, Operation *op)
+{
+    int rc = 0;
+
+    PR_Lock(conn->c_pdumutex);
+    if ((conn->c_flags & CONN_FLAG_CLOSING) || slapi_op_abandoned(pb)) {
+        ber_free(op->o_entry_batch, 1);
+        op->o_entry_batch = NULL;
+    } else {
+        rc = flush_entry_batch_nolock(conn, op);
+    }
+    PR_Unlock(conn->c_pdumutex);
+    if (rc != 0) {
+        int oserr = errno;
+        op->o_status = SLAPI_OP_STATUS_ABANDONED;
+        slapi_log_err(SLAPI_LOG_CONNS, "write_entry_batch", "Failed, error %d (%s)\n",
+                      oserr, slapd_system_strerror(oserr));
+        do_disconnect_server(conn, op->o_connid, op->o_opid);
+    }
+}
+
+/*
+ * Writes the queued search entries if the first of them waited
+ * nsslapd-search-entry-batch-latency ms. Called by the backend while it
+ * looks for the next entry to return.
+ */
+void
+send_ldap_search_entry_batch_check(Slapi_PBlock *pb)
+{
+    Operation *op = NULL;
+    Connection *conn = NULL;
+    struct timespec now;
+    struct timespec waited;
+
+    slapi_pblock_get(pb, SLAPI_OPERATION, &op);
+    slapi_pblock_get(pb, SLAPI_CONNECTION, &conn);
+    /* Only the thread of the operation queues entries, no lock needed here */
+    if ((op == NULL) || (conn == NULL) || (op->o_entry_batch == NULL)) {
+        return;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    slapi_timespec_diff(&now, &op->o_entry_batch_start, &waited);
+    if ((waited.tv_sec * 1000 + waited.tv_nsec / 1000000) >= config_get_search_entry_batch_latency()) {
+        write_entry_batch(pb, conn, op);
+    }
+}
+
+void
+send_ldap_search_entry_batch_end(Slapi_PBlock *pb)
+{
+    Operation *op = NULL;
+    Connection *conn = NULL;
+
+    slapi_pblock_get(pb, SLAPI_OPERATION, &op);
+    slapi_pblock_get(pb, SLAPI_CONNECTION, &conn);
+    if ((op == NULL) || (conn == NULL)) {
+        return;
+    }
+    op->o_entry_batch_size = 0;
+    if (op->o_entry_batch == NULL) {
+        return;
+    }
+    write_entry_batch(pb, conn, op);
+}
+
 /*
  * always frees the ber
  */
@@ -1853,11 +2037,32 @@ flush_ber(
         op->o_status = SLAPI_OP_STATUS_ABANDONED;
         rc = -1;
     } else {
+        struct timespec start = {0};
+        int batched = (type == _LDAP_SEND_ENTRY) && op->o_entry_batch_size;
+        int queued = 0;
+
         ber_get_option(ber, LBER_OPT_BYTES_TO_WRITE, &bytes);
 
+        /* Not read for the unbatched entries: the search entries phase covers them */
+        if (batched || (type == _LDAP_SEND_RESULT)) {
+            clock_gettime(CLOCK_MONOTONIC, &start);
+        }
         PR_Lock(conn->c_pdumutex);
-        rc = ber_flush(conn->c_sb, ber, 1);
+        if (batched) {
+            rc = queue_entry_batch_nolock(conn, op, ber, &start);
+            ber = NULL; /* freed by the batch */
+            queued = 1;
+        } else if ((rc = flush_entry_batch_nolock(conn, op)) == 0) {
+            rc = ber_flush(conn->c_sb, ber, 1);
+            if ((rc == 0) && (type == _LDAP_SEND_ENTRY)) {
+                slapi_counter_increment(entry_writes);
+                slapi_counter_add(entry_write_bytes, bytes);
+            }
+        }
         PR_Unlock(conn->c_pdumutex);
+        if (type == _LDAP_SEND_RESULT) {
+            latency_record(op, LATENCY_PHASE_RESULT, &start);
+        }
 
         if (rc != 0) {
             int oserr = errno;
@@ -1876,19 +2081,17 @@ flush_ber(
             */
             }
             do_disconnect_server(conn, op->o_connid, op->o_opid);
-            ber_free(ber, 1);
+            if (ber) {
+                ber_free(ber, 1);
+            }
         } else {
-            PRUint64 b;
-            slapi_log_err(SLAPI_LOG_BER, "flush_ber",
-                          "Wrote %lu bytes to socket %d\n", bytes, conn->c_sd);
-            LL_I2L(b, bytes);
-            slapi_counter_add(g_get_per_thread_snmp_vars()->server_tbl.dsBytesSent, b);
-
+            if (!queued) {
+                /* the queued entries are accounted for when they are written */
+                account_bytes_sent(conn, bytes);
+            }
             if (type == _LDAP_SEND_ENTRY) {
                 slapi_counter_increment(g_get_per_thread_snmp_vars()->server_tbl.dsEntriesSent);
             }
-            if (!config_check_referral_mode())
-                slapi_counter_add(g_get_per_thread_snmp_vars()->ops_tbl.dsBytesSent, bytes);
         }
     }
 
@@ -1946,6 +2149,7 @@ static struct slapi_note_map notemap[] = {
     {SLAPI_OP_NOTE_FULL_UNINDEXED, "A", "Fully Unindexed Filter"},
     {SLAPI_OP_NOTE_FILTER_INVALID, "F", "Filter Element Missing From Schema"},
     {SLAPI_OP_NOTE_MFA_AUTH, "M", "Multi-factor Authentication"},
+    {SLAPI_OP_NOTE_FILTER_PLANNED, "C", "Cost-based Filter Plan"},
 };
 
 #define SLAPI_NOTEMAP_COUNT (sizeof(notemap) / sizeof(struct slapi_note_map))
@@ -452,6 +452,17 @@ typedef void (*VFPV)(); /* takes undefined arguments */
 #define SLAPD_DEFAULT_REFERRAL_CHECK_PERIOD 300
 #define SLAPD_DEFAULT_REFERRAL_CHECK_PERIOD_STR "300"
 
+#define SLAPD_DEFAULT_BIND_CRYPTO_MAX_PENDING 0 /* no limit */
+#define SLAPD_DEFAULT_BIND_CRYPTO_MAX_PENDING_STR "0"
+
+#define SLAPD_DEFAULT_PAGEDRESULTS_CURSOR_MAXMEMORY 10485760 /* 10MB of parked paged searches */
+#define SLAPD_DEFAULT_PAGEDRESULTS_CURSOR_MAXMEMORY_STR "10485760"
+
+#define SLAPD_DEFAULT_SEARCH_ENTRY_BATCH_SIZE 16384 /* one TLS record */
+#define SLAPD_DEFAULT_SEARCH_ENTRY_BATCH_SIZE_STR "16384"
+#define SLAPD_DEFAULT_SEARCH_ENTRY_BATCH_LATENCY 20 /* milliseconds */
+#define SLAPD_DEFAULT_SEARCH_ENTRY_BATCH_LATENCY_STR "20"
+
 #define MIN_THREADS 16
 #define MAX_THREADS 512
 
@@ -810,6 +821,7 @@ struct slapi_dn
     const char *dn;  /* Normalised DN */
     const char *ndn; /* Case Normalised DN */
     int ndn_len;     /* normalized dn length */
+    struct slapi_dn_node *node; /* Interned DN (see slapi_sdn_intern) */
 };
 
 /*
@@ -1634,6 +1646,9 @@ typedef struct op
     struct slapi_operation_results o_results;
     int o_pagedresults_sizelimit;
     int o_reverse_search_state;
+    int32_t o_entry_batch_size;              /* bytes of search entries written at once, 0 when not batching */
+    BerElement *o_entry_batch;               /* search entries encoded but not written yet */
+    struct timespec o_entry_batch_start;     /* when the first of them was queued */
 } Operation;
 
 /*
@@ -1661,6 +1676,9 @@ typedef struct _paged_results
     int pr_flags;
     ber_int_t pr_msgid; /* msgid of the request; to abandon */
     PRLock *pr_mutex;   /* protect each conn structure    */
+    uint64_t pr_cursor_id;  /* server wide id of the search, in the cookie */
+    char *pr_bind_ndn;      /* identity allowed to resume the search on another connection */
+    char *pr_search_key;    /* scope, base and filter of the search */
 } PagedResults;
 
 /* array of simple paged structure stashed in connection */
@@ -1932,7 +1950,27 @@ void slapi_pblock_set_op_stack_elem(Slapi_PBlock *pb, void *stack_elem);
 #define INDEX_SUBSTRBEGIN  0
 #define INDEX_SUBSTRMIDDLE 1
 #define INDEX_SUBSTREND    2
-#define INDEX_SUBSTRLEN    3 /* size of the substrlens */
+#define INDEX_SUBSTRPOS    3 /* positional keys, one of INDEX_SUBSTRPOS_* or 0 */
+#define INDEX_SUBSTRLEN    4 /* size of the substrlens */
+
+/*
+ * Positional substring keys (nsSubStrPositional: on)
+ *
+ * In addition to the substring keys, every middle n-gram of a value is
+ * indexed with its position:
+ *     <n-gram> INDEX_SUBSTRPOS_SEP <value hash>:<offset>:<value length>
+ * (hexadecimal numbers, offset and length in bytes of the normalized value).
+ * The value hash tells apart the values of a multi-valued attribute.
+ *
+ * With INDEX_SUBSTRPOS_QUERY, the substring assertion is turned into one
+ * descriptor per n-gram of its components instead of the substring keys:
+ *     <n-gram> INDEX_SUBSTRPOS_SEP <component>:<kind>:<offset>:<component length>
+ * kind is '^' (initial), '*' (any) or '$' (final), component is its rank
+ * in the assertion, offset the n-gram offset in the component.
+ */
+#define INDEX_SUBSTRPOS_INDEX 1 /* values2keys: add the positional keys */
+#define INDEX_SUBSTRPOS_QUERY 2 /* assertion2keys: return the n-gram descriptors */
+#define INDEX_SUBSTRPOS_SEP   '\001'
 
 /* The referral element */
 typedef struct ref
@@ -2418,6 +2456,13 @@ typedef struct _slapdEntryPoints
 #define CONFIG_TCP_FIN_TIMEOUT       "nsslapd-tcp-fin-timeout"
 #define CONFIG_TCP_KEEPALIVE_TIME    "nsslapd-tcp-keepalive-time"
 
+#define CONFIG_BIND_CRYPTO_MAX_PENDING "nsslapd-bind-crypto-max-pending"
+
+#define CONFIG_PAGEDRESULTS_CURSOR_MAXMEMORY "nsslapd-pagedresults-cursor-maxmemory"
+
+#define CONFIG_SEARCH_ENTRY_BATCH_SIZE "nsslapd-search-entry-batch-size"
+#define CONFIG_SEARCH_ENTRY_BATCH_LATENCY "nsslapd-search-entry-batch-latency"
+
 /*
  * Define the backlog number for use in listen() call.
  * We use the same definition as in ldapserver/include/base/systems.h
@@ -2757,6 +2802,10 @@ typedef struct _slapdFrontendConfig
     slapi_onoff_t return_orig_dn;
     slapi_onoff_t pw_admin_skip_info;
     char *auditlog_display_attrs;
+    slapi_int_t bind_crypto_max_pending; /* max concurrent password verifications, 0 for no limit */
+    slapi_int_t pagedresults_cursor_maxmemory; /* bytes of paged searches kept after a disconnect */
+    slapi_int_t search_entry_batch_size;       /* bytes of search entries written at once */
+    slapi_int_t search_entry_batch_latency;    /* ms a search entry may wait for the next ones */
 } slapdFrontendConfig_t;
 
 /* possible values for slapdFrontendConfig_t.schemareplace */
@@ -2885,6 +2934,7 @@ extern char *attr_dataversion;
 #define EXPORT_ID2ENTRY_ONLY 0x10
 #define EXPORT_NOVERSION 0x20
 #define EXPORT_APPENDMODE_1 0x40
+#define EXPORT_GZIP 0x80
 #define EXPORT_INTERNAL 0x100
 
 #define MTN_CONTROL_USE_ONE_BACKEND_OID     "2.16.840.1.113730.3.4.14"
@@ -2932,6 +2982,10 @@ void initialize_ldapi_auth_dn_mappings(slapi_ldapi_state reload);
 void free_ldapi_auth_dn_mappings(int32_t shutdown);
 int32_t slapd_identify_local_user(Connection *conn);
 int32_t slapd_bind_local_user(Connection *conn);
+#if defined(ENABLE_AUTOBIND)
+void ldapi_bind_cache_entry_changed(Slapi_Entry *e, Slapi_Entry *eprev);
+void ldapi_bind_cache_as_entry(Slapi_Entry *e);
+#endif
 #endif
 
 #endif /* _slap_h_ */
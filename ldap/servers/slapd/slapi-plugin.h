@@ -392,6 +392,7 @@ PR_fprintf(struct PRFileDesc *fd, const char *fmt, ...) __ATTRIBUTE__((format(pr
 #define SLAPI_BIND_ANONYMOUS  3  /* front end will send result */
 #define SLAPI_BIND_REFERRAL   4  /* caller should send result */
 #define SLAPI_BIND_NO_BACKEND 5  /* caller should send result */
+#define SLAPI_BIND_BUSY       6  /* back end sent LDAP_BUSY, the credentials were not checked */
 
 
 /* commonly used attributes names */
@@ -2860,6 +2861,33 @@ int slapi_sdn_isempty(const Slapi_DN *sdn);
  */
 int slapi_sdn_issuffix(const Slapi_DN *sdn, const Slapi_DN *suffixsdn);
 
+/**
+ * Interns the normalized DN of a \c Slapi_DN structure.
+ *
+ * The interned DN is shared by all the \c Slapi_DN structures interning the
+ * same DN, and knows its interned parent. Comparing two interned \c Slapi_DN
+ * structures with slapi_sdn_compare(), slapi_sdn_issuffix(), slapi_sdn_isparent()
+ * or slapi_sdn_scope_test() does not compare the DN strings. It is worth
+ * interning the DNs that are compared many times (e.g. configured subtrees).
+ * The interned DN is released by slapi_sdn_done() or by setting another DN.
+ *
+ * \param sdn A pointer to the \c Slapi_DN structure to intern.
+ * \return \c 0 if the DN is interned.
+ * \return \c -1 if \c sdn is empty or its DN is not valid.
+ * \see slapi_sdn_is_interned()
+ */
+int slapi_sdn_intern(Slapi_DN *sdn);
+
+/**
+ * Checks whether the DN of a \c Slapi_DN structure is interned.
+ *
+ * \param sdn A pointer to the \c Slapi_DN structure to check.
+ * \return \c 1 if the DN is interned.
+ * \return \c 0 if the DN is not interned.
+ * \see slapi_sdn_intern()
+ */
+int slapi_sdn_is_interned(const Slapi_DN *sdn);
+
 /**
  * Checks whether a DN is the parent of a given DN.
  *
@@ -5943,6 +5971,31 @@ void slapi_free_search_results_internal(Slapi_PBlock *pb);
 
 int slapi_search_internal_pb(Slapi_PBlock *pb);
 int slapi_search_internal_callback_pb(Slapi_PBlock *pb, void *callback_data, plugin_result_callback prc, plugin_search_entry_callback psec, plugin_referral_entry_callback prec);
+/**
+ * Search without copying the matching entries.
+ *
+ * Each entry is passed to \c psec while it is pinned in the backend entry
+ * cache: it is read-only and only valid until the callback returns.  The
+ * callback returns \c 0 to continue, or non-zero to stop the search early.
+ *
+ * \param pb Parameter block set up with slapi_search_internal_set_pb().
+ * \param callback_data Passed unchanged to \c psec.
+ * \param psec Called once per matching entry.
+ * \return \c -1 if \c pb is \c NULL, \c 0 otherwise.  The result code is
+ *         available in \c SLAPI_PLUGIN_INTOP_RESULT and the number of
+ *         entries seen in \c SLAPI_NENTRIES.
+ * \see slapi_search_internal_pb()
+ */
+int slapi_search_internal_stream_pb(Slapi_PBlock *pb, void *callback_data, plugin_search_entry_callback psec);
+/**
+ * Same as slapi_search_internal_pb(), but the returned entries only contain
+ * the attributes requested in \c SLAPI_SEARCH_ATTRS rather than a copy of
+ * the whole entry.  Free them with slapi_free_search_results_internal().
+ *
+ * \param pb Parameter block set up with slapi_search_internal_set_pb().
+ * \return \c -1 if \c pb is \c NULL, \c 0 otherwise.
+ */
+int slapi_search_internal_projected_pb(Slapi_PBlock *pb);
 int slapi_add_internal_pb(Slapi_PBlock *pb);
 int slapi_modify_internal_pb(Slapi_PBlock *pb);
 int slapi_modrdn_internal_pb(Slapi_PBlock *pb);
@@ -7329,6 +7382,7 @@ typedef enum _slapi_op_note_t {
     SLAPI_OP_NOTE_FULL_UNINDEXED = 0x04,
     SLAPI_OP_NOTE_FILTER_INVALID = 0x08,
     SLAPI_OP_NOTE_MFA_AUTH = 0x10,
+    SLAPI_OP_NOTE_FILTER_PLANNED = 0x20,
 } slapi_op_note_t;
 
 /**
@@ -7481,6 +7535,8 @@ void slapi_pblock_set_operation_notes(Slapi_PBlock *pb, uint32_t opnotes);
 #define SLAPI_BACKEND_INSTANCE_NAME 178
 #define SLAPI_BACKEND_TASK          179
 #define SLAPI_TASK_FLAGS            181
+/* db2bak: previous backup an incremental backup is based on */
+#define SLAPI_BACKUP_INCREMENTAL_BASE 1762
 
 /* bulk import (online wire import) */
 #define SLAPI_BULK_IMPORT_ENTRY 182
@@ -7852,7 +7908,8 @@ enum
     BACK_INFO_INDEX_KEY,           /* Get the status of a key in an index */
     BACK_INFO_DB_DIRECTORY,        /* Get the db directory */
     BACK_INFO_DBHOME_DIRECTORY,    /* Get the dbhome directory */
-    BACK_INFO_CLDB_FILENAME        /* Get the backend replication changelog name */
+    BACK_INFO_CLDB_FILENAME,       /* Get the backend replication changelog name */
+    BACK_INFO_SUBORDINATE_COUNTS   /* Get the up to date subordinate counts of an entry */
 };
 
 struct _back_info_index_key
@@ -7862,6 +7919,12 @@ struct _back_info_index_key
     PRBool key_found;         /* output: TRUE if '=0' is found in the index */
     u_int32_t id;             /* output: if key_found it is the first value (suffix entryID) */
 };
+struct _back_info_subordinates
+{
+    const Slapi_Entry *entry; /* input: entry whose children are counted */
+    uint64_t count;           /* output: numsubordinates */
+    uint64_t tombstone_count; /* output: tombstonenumsubordinates */
+};
 struct _back_info_crypt_init
 {
     char *dn;                  /* input -- entry to store nsSymmetricKey */
@@ -59,6 +59,7 @@ typedef enum _slapi_filter_flags_t {
     SLAPI_FILTER_NORMALIZED_VALUE = 16,
     SLAPI_FILTER_INVALID_ATTR_UNDEFINE = 32,
     SLAPI_FILTER_INVALID_ATTR_WARN = 64,
+    SLAPI_FILTER_INDEX_EXACT = 128, /* the index candidates of this component need no filter test */
 } slapi_filter_flags;
 
 /*
@@ -322,6 +323,7 @@ int entry_next_deleted_attribute(const Slapi_Entry *e, Slapi_Attr **a);
 /* entry.c */
 int entry_apply_mods(Slapi_Entry *e, LDAPMod **mods);
 int is_type_protected(const char *type);
+char *entry_value2str(const char *type, const Slapi_Value *v, int value_deleted, int entry2str_ctrl, size_t *len);
 int entry_apply_mods_ignore_error(Slapi_Entry *e, LDAPMod **mods, int ignore_error);
 int slapi_entries_diff(Slapi_Entry **old_entries, Slapi_Entry **new_entries, int testall, const char *logging_prestr, const int force_update, void *plg_id);
 void set_attr_to_protected_list(char *attr, int flag);
@@ -386,6 +388,7 @@ int ndn_cache_started(void);
 void ndn_cache_get_stats(uint64_t *hits, uint64_t *tries, uint64_t *size, uint64_t *max_size, uint64_t *thread_size, uint64_t *evicts, uint64_t *slots, uint64_t *count);
 void ndn_cache_inc_import_task(void);
 void ndn_cache_dec_import_task(void);
+uint64_t dn_intern_get_count(void);
 #define NDN_DEFAULT_SIZE 20971520 /* 20mb - size of normalized dn cache */
 
 /* filter.c */
@@ -394,6 +397,29 @@ char *slapi_filter_to_string(const Slapi_Filter *f, char *buffer, size_t bufsize
 char *slapi_filter_to_string_internal(const struct slapi_filter *f, char *buf, size_t *bufsize);
 void slapi_filter_optimise(Slapi_Filter *f);
 
+/* latency.c */
+typedef enum {
+    LATENCY_PHASE_OPERATION = 0, /* whole operation, queue wait excluded */
+    LATENCY_PHASE_QUEUE_WAIT,    /* time spent in the work queue */
+    LATENCY_PHASE_PREOP,         /* pre-operation plugins */
+    LATENCY_PHASE_BETXN_PREOP,   /* backend transaction pre-operation plugins */
+    LATENCY_PHASE_BETXN_POSTOP,  /* backend transaction post-operation plugins */
+    LATENCY_PHASE_POSTOP,        /* post-operation plugins */
+    LATENCY_PHASE_CANDIDATES,    /* search candidate list */
+    LATENCY_PHASE_ENTRIES,       /* search entries fetch, access control and sending */
+    LATENCY_PHASE_RESULT,        /* result sending */
+    LATENCY_PHASE_TXN_COMMIT,    /* backend transaction commit */
+    LATENCY_NB_PHASES
+} latency_phase_t;
+void latency_record(Slapi_Operation *op, latency_phase_t phase, const struct timespec *start);
+void latency_record_elapsed(Slapi_Operation *op, latency_phase_t phase, const struct timespec *elapsed);
+void latency_as_entry(Slapi_Entry *e);
+
+/* bind_crypto.c */
+#define BIND_CRYPTO_BUSY -1
+int32_t bind_crypto_pw_find_sv(Slapi_Value **vals, const Slapi_Value *cred);
+void bind_crypto_as_entry(Slapi_Entry *e);
+
 /* operation.c */
 
 #define OP_FLAG_PS 0x000001
@@ -1376,6 +1376,11 @@ task_export_add(Slapi_PBlock *pb __attribute__((unused)),
     if (!strcasecmp(ldif_printkey, "true")) /* true */
         ldif_printkey_flag |= EXPORT_NOVERSION;
 
+    /* -z: eq "true" ==> gzip compress the output */
+    ldif_printkey = slapi_fetch_attr(e, "nsExportGzip", "false");
+    if (!strcasecmp(ldif_printkey, "true")) /* true */
+        ldif_printkey_flag |= EXPORT_GZIP;
+
     /* -u: eq "false" ==> does not dump unique id */
     dump_uniqueid = slapi_fetch_attr(e, "nsDumpUniqId", "true");
     if (!strcasecmp(dump_uniqueid, "true")) /* true */
@@ -1511,8 +1516,11 @@ task_backup_thread(void *arg)
 
     slapi_task_finish(task, rv);
     char *seq_val = NULL;
+    char *base = NULL;
     slapi_pblock_get(pb, SLAPI_SEQ_VAL, &seq_val);
     slapi_ch_free((void **)&seq_val);
+    slapi_pblock_get(pb, SLAPI_BACKUP_INCREMENTAL_BASE, &base);
+    slapi_ch_free_string(&base);
     slapi_pblock_destroy(pb);
     g_decr_active_threadcnt();
 }
@@ -1600,6 +1608,9 @@ task_backup_add(Slapi_PBlock *pb __attribute__((unused)),
     }
     char *seq_val = slapi_ch_strdup(archive_dir);
     slapi_pblock_set(mypb, SLAPI_SEQ_VAL, seq_val);
+    /* only store the blocks changed since this backup */
+    slapi_pblock_set(mypb, SLAPI_BACKUP_INCREMENTAL_BASE,
+                     slapi_ch_strdup(slapi_entry_attr_get_ref(e, "nsIncrementalBase")));
     slapi_pblock_set(mypb, SLAPI_PLUGIN, (be->be_database));
     slapi_pblock_set(mypb, SLAPI_BACKEND_TASK, task);
     int32_t task_flags = SLAPI_TASK_RUNNING_AS_TASK;
@@ -1614,6 +1625,9 @@ task_backup_add(Slapi_PBlock *pb __attribute__((unused)),
                       "task_backup_add", "Unable to create backup thread!\n");
         *returncode = LDAP_OPERATIONS_ERROR;
         rv = SLAPI_DSE_CALLBACK_ERROR;
+        char *base = NULL;
+        slapi_pblock_get(mypb, SLAPI_BACKUP_INCREMENTAL_BASE, &base);
+        slapi_ch_free_string(&base);
         slapi_ch_free((void **)&seq_val);
         slapi_pblock_destroy(mypb);
         goto out;
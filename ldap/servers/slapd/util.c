@@ -1934,6 +1934,7 @@ struct oid_map oidmap[] = {
     {"2.16.840.1.113730.3.5.9", "REPL_NSDS71_REPLICATION_ENTRY_REQUEST_OID"},
     {"2.16.840.1.113730.3.5.12", "REPL_START_NSDS90_REPLICATION_REQUEST_OID"},
     {"2.16.840.1.113730.3.5.13", "REPL_NSDS90_REPLICATION_RESPONSE_OID"},
+    {"2.16.840.1.113730.3.5.17", "REPL_NSDS_REPLICATION_ENTRY_BATCH_REQUEST_OID"},
     {"2.16.840.1.113730.3.6.5", "REPL_CLEANRUV_OID"},
     {"2.16.840.1.113730.3.6.6", "REPL_ABORT_CLEANRUV_OID"},
     {"2.16.840.1.113730.3.6.7", "REPL_CLEANRUV_GET_MAXCSN_OID"},
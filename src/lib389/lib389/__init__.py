@@ -2729,7 +2729,7 @@ class DirSrv(SimpleLDAPObject, object):
         return True
 
     def db2ldif(self, bename, suffixes, excludeSuffixes, encrypt, repl_data,
-                outputfile, export_cl=False):
+                outputfile, export_cl=False, gzip=False):
         """
         @param bename - The backend name of the database to export
         @param suffixes - List/tuple of suffixes to export
@@ -2737,6 +2737,7 @@ class DirSrv(SimpleLDAPObject, object):
         @param encrypt - Perform attribute encryption
         @param repl_data - Export the replication data
         @param outputfile - The filename for the exported LDIF
+        @param gzip - Compress the exported LDIF with gzip
         @return - True if export succeeded
         """
         DirSrvTools.lib389User(user=DEFAULT_USER)
@@ -2773,6 +2774,8 @@ class DirSrv(SimpleLDAPObject, object):
             cmd.append('-r')
         if export_cl:
             cmd.append('-R')
+        if gzip:
+            cmd.append('-z')
         if outputfile is not None:
             cmd.append('-a')
             cmd.append(outputfile)
@@ -2784,6 +2787,8 @@ class DirSrv(SimpleLDAPObject, object):
                 ldifname = os.path.join(self.ds_paths.ldif_dir, "%s-%s-%s.ldif" % (self.serverid, bename, tnow))
             else:
                 ldifname = os.path.join(self.ds_paths.ldif_dir, "%s-%s.ldif" % (self.serverid, tnow))
+            if gzip:
+                ldifname += ".gz"
             cmd.append(ldifname)
         try:
             result = subprocess.check_output(cmd, encoding='utf-8')
@@ -3470,8 +3475,12 @@ class DirSrv(SimpleLDAPObject, object):
             self.log.debug("Delete entry children %s", ent.dn)
             self.delete_ext_s(ent.dn, serverctrls=serverctrls, clientctrls=clientctrls, escapehatch='i am sure')
 
-    def backup_online(self, archive=None, db_type=None):
-        """Creates a backup of the database"""
+    def backup_online(self, archive=None, db_type=None, incremental_base=None):
+        """Creates a backup of the database
+
+        With incremental_base (a previous backup), only the changes since
+        that backup are stored (lmdb only).
+        """
 
         if archive is None:
             # Use the instance name and date/time as the default backup name
@@ -3489,6 +3498,10 @@ class DirSrv(SimpleLDAPObject, object):
         task_properties = {'nsArchiveDir': archive}
         if db_type is not None:
             task_properties['nsDatabaseType'] = db_type
+        if incremental_base is not None:
+            if incremental_base[0] != "/":
+                incremental_base = os.path.join(self.ds_paths.backup_dir, incremental_base)
+            task_properties['nsIncrementalBase'] = incremental_base
         task.create(properties=task_properties)
 
         return task
@@ -542,7 +542,8 @@ class Backend(DSLdapObject):
         db_config = DatabaseConfig(self._instance)
         config_attrs = db_config.get()
 
-        mdb_only_attrs = ['nsslapd-mdb-max-size', 'nsslapd-mdb-max-readers', 'nsslapd-mdb-max-dbs']
+        mdb_only_attrs = ['nsslapd-mdb-max-size', 'nsslapd-mdb-max-readers', 'nsslapd-mdb-max-dbs',
+                          'nsslapd-mdb-reindex-throttle', 'nsslapd-mdb-export-threads']
         bdb_only_attrs = ['nsslapd-dbcachesize',
                           'nsslapd-dbncache',
                           'nsslapd-db-logdirectory',
@@ -899,12 +900,13 @@ class Backend(DSLdapObject):
         return task
 
     def export_ldif(self, ldif=None, use_id2entry=False, encrypted=False, min_base64=False, no_uniq_id=False,
-                    replication=False, not_folded=False, no_seq_num=False, include_suffixes=None, exclude_suffixes=None):
+                    replication=False, not_folded=False, no_seq_num=False, include_suffixes=None, exclude_suffixes=None,
+                    gzip=False):
         """Do an export of the suffix"""
 
         bs = Backends(self._instance)
         task = bs.export_ldif(self.rdn, ldif, use_id2entry, encrypted, min_base64, no_uniq_id,
-                              replication, not_folded, no_seq_num, include_suffixes, exclude_suffixes)
+                              replication, not_folded, no_seq_num, include_suffixes, exclude_suffixes, gzip)
         return task
 
     def get_vlv_searches(self, vlv_name=None):
@@ -1031,7 +1033,7 @@ class Backends(DSLdapObjects):
         ldif_paths = []
         for ldif in list(ldifs):
             if not ldif.startswith("/"):
-                if ldif.endswith(".ldif"):
+                if ldif.endswith((".ldif", ".ldif.gz")):
                     ldif = os.path.join(self._instance.ds_paths.ldif_dir, ldif)
                 else:
                     ldif = os.path.join(self._instance.ds_paths.ldif_dir, "%s.ldif" % ldif)
@@ -1061,28 +1063,30 @@ class Backends(DSLdapObjects):
         return task
 
     def export_ldif(self, be_names, ldif=None, use_id2entry=False, encrypted=False, min_base64=False, no_dump_uniq_id=False,
-                    replication=False, not_folded=False, no_seq_num=False, include_suffixes=None, exclude_suffixes=None):
+                    replication=False, not_folded=False, no_seq_num=False, include_suffixes=None, exclude_suffixes=None,
+                    gzip=False):
         """Do an export of the suffix"""
 
         task = ExportTask(self._instance)
         task_properties = {'nsInstance': be_names}
+        ext = ".ldif.gz" if gzip else ".ldif"
         if ldif == "":
             ldif = None
         if ldif is not None and not ldif.startswith("/"):
-            if ldif.endswith(".ldif"):
+            if ldif.endswith(ext):
                 task_properties['nsFilename'] = os.path.join(self._instance.ds_paths.ldif_dir, ldif)
             else:
-                task_properties['nsFilename'] = os.path.join(self._instance.ds_paths.ldif_dir, "%s.ldif" % ldif)
+                task_properties['nsFilename'] = os.path.join(self._instance.ds_paths.ldif_dir, "%s%s" % (ldif, ext))
         elif ldif is not None and ldif.startswith("/"):
-            if ldif.endswith(".ldif"):
+            if ldif.endswith(ext):
                 task_properties['nsFilename'] = ldif
             else:
-                task_properties['nsFilename'] = "%s.ldif" % ldif
+                task_properties['nsFilename'] = "%s%s" % (ldif, ext)
         else:
             tnow = datetime.now().strftime("%Y_%m_%d_%H_%M_%S")
             task_properties['nsFilename'] = os.path.join(self._instance.ds_paths.ldif_dir,
-                                                         "%s-%s-%s.ldif" % (self._instance.serverid,
-                                                                            "-".join(be_names), tnow))
+                                                         "%s-%s-%s%s" % (self._instance.serverid,
+                                                                         "-".join(be_names), tnow, ext))
         if include_suffixes is not None:
             task_properties['nsIncludeSuffix'] = include_suffixes
         if exclude_suffixes is not None:
@@ -1101,6 +1105,8 @@ class Backends(DSLdapObjects):
             task_properties['nsDumpUniqId'] = 'false'
         if no_seq_num:
             task_properties['nsPrintKey'] = 'false'
+        if gzip:
+            task_properties['nsExportGzip'] = 'true'
 
         task = task.create(properties=task_properties)
         return task
@@ -1151,6 +1157,7 @@ class DatabaseConfig(DSLdapObject):
             'nsslapd-idl-switch',
             'nsslapd-search-bypass-filter-test',
             'nsslapd-search-use-vlv-index',
+            'nsslapd-search-filter-planning',
             'nsslapd-exclude-from-export',
             'nsslapd-serial-lock',
             'nsslapd-pagedlookthroughlimit',
@@ -1192,6 +1199,8 @@ class DatabaseConfig(DSLdapObject):
                     'nsslapd-mdb-max-size',
                     'nsslapd-mdb-max-readers',
                     'nsslapd-mdb-max-dbs',
+                    'nsslapd-mdb-reindex-throttle',
+                    'nsslapd-mdb-export-threads',
                 ]
         }
         self._create_objectclasses = ['top', 'extensibleObject']
@@ -1257,6 +1266,8 @@ class BackendSuffixView(CompositeDSLdapObject):
             'nsslapd-cachememsize',
             'nsslapd-cachesize',
             'nsslapd-dncachememsize',
+            'nsslapd-numsubordinates-flush-interval',
+            'nsslapd-outofline-values-threshold',
             'nsslapd-readonly',
             'nsslapd-require-index',
             'nsslapd-suffix'
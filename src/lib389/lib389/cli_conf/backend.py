@@ -63,12 +63,15 @@ arg_to_attr = {
         'pagedidlistscanlimit': 'nsslapd-pagedidlistscanlimit',
         'rangelookthroughlimit': 'nsslapd-rangelookthroughlimit',
         'backend_opt_level': 'nsslapd-backend-opt-level',
+        'filter_planning': 'nsslapd-search-filter-planning',
         'deadlock_policy': 'nsslapd-db-deadlock-policy',
         'db_home_directory': 'nsslapd-db-home-directory',
         'db_lib': 'nsslapd-backend-implement',
         'mdb_max_size': 'nsslapd-mdb-max-size',
         'mdb_max_readers': 'nsslapd-mdb-max-readers',
         'mdb_max_dbs': 'nsslapd-mdb-max-dbs',
+        'mdb_reindex_throttle': 'nsslapd-mdb-reindex-throttle',
+        'mdb_export_threads': 'nsslapd-mdb-export-threads',
         # VLV attributes
         'search_base': 'vlvbase',
         'search_scope': 'vlvscope',
@@ -297,7 +300,8 @@ def backend_export(inst, basedn, log, args):
     task = mc.export_ldif(be_names=be_cn_names, ldif=args.ldif, use_id2entry=args.use_id2entry,
                           encrypted=args.encrypted, min_base64=args.min_base64, no_dump_uniq_id=args.no_dump_uniq_id,
                           replication=args.replication, not_folded=args.not_folded, no_seq_num=args.no_seq_num,
-                          include_suffixes=args.include_suffixes, exclude_suffixes=args.exclude_suffixes)
+                          include_suffixes=args.include_suffixes, exclude_suffixes=args.exclude_suffixes,
+                          gzip=args.gzip)
     task.wait(timeout=args.timeout)
     result = task.get_exit_code()
 
@@ -506,6 +510,10 @@ def backend_set(inst, basedn, log, args):
         bev.set('nsslapd-cachememsize', args.cache_memsize)
     if args.dncache_memsize:
         bev.set('nsslapd-dncachememsize', args.dncache_memsize)
+    if args.outofline_values_threshold is not None:
+        bev.set('nsslapd-outofline-values-threshold', args.outofline_values_threshold)
+    if args.numsubordinates_flush_interval is not None:
+        bev.set('nsslapd-numsubordinates-flush-interval', args.numsubordinates_flush_interval)
     if args.require_index:
         bev.set('nsslapd-require-index', 'on')
     if args.ignore_index:
@@ -887,6 +895,13 @@ def create_parser(subparsers):
     set_backend_parser.add_argument('--cache-size', help='Sets the maximum number of entries to keep in the entry cache')
     set_backend_parser.add_argument('--cache-memsize', help='Sets the maximum size in bytes that the entry cache can grow to')
     set_backend_parser.add_argument('--dncache-memsize', help='Sets the maximum size in bytes that the DN cache can grow to')
+    set_backend_parser.add_argument('--outofline-values-threshold',
+                                    help='Stores the attributes having more values than this number apart from their entry, '
+                                         'so that modifying them only writes the changed values (0 disables it)')
+    set_backend_parser.add_argument('--numsubordinates-flush-interval',
+                                    help='Keeps the subordinate counts in memory instead of rewriting the parent on '
+                                         'every child add or delete, and writes them back every this many seconds '
+                                         '(0 disables it)')
     set_backend_parser.add_argument('--state', help='Changes the backend state to: "backend", "disabled", "referral", or "referral on update"')
     set_backend_parser.add_argument('be_name', help='The backend name or suffix')
 
@@ -1082,12 +1097,18 @@ def create_parser(subparsers):
                                                                       'range search request.')
     set_db_config_parser.add_argument('--backend-opt-level', help='Sets the backend optimization level for write performance (0, 1, 2, or 4). '
                                                                   'WARNING: This parameter can trigger experimental code.')
+    set_db_config_parser.add_argument('--filter-planning', help='Enables or disables the ordering of the components of an AND search filter '
+                                                                'by their estimated number of candidates. Can be "on" or "off"')
     set_db_config_parser.add_argument('--deadlock-policy', help='Adjusts the backend database deadlock policy (Advanced setting)')
     set_db_config_parser.add_argument('--db-home-directory', help='Sets the directory for the database mmapped files (Advanced setting)')
     set_db_config_parser.add_argument('--db-lib', help='Sets which db lib is used. Valid values are: bdb or mdb')
     set_db_config_parser.add_argument('--mdb-max-size', help='Sets the lmdb database maximum size (in bytes).')
     set_db_config_parser.add_argument('--mdb-max-readers', help='Sets the lmdb database maximum number of readers (Advanced setting)')
     set_db_config_parser.add_argument('--mdb-max-dbs', help='Sets the lmdb database maximum number of sub databases (Advanced setting)')
+    set_db_config_parser.add_argument('--mdb-reindex-throttle', help='Sets the percentage of time (0-90) an online reindex task stays idle '
+                                                                    'to let the other write operations update the lmdb database')
+    set_db_config_parser.add_argument('--mdb-export-threads', help='Sets the number of threads converting the entries to LDIF during an export, '
+                                                                  '0 exports with a single thread')
 
 
     #######################################################
@@ -1156,6 +1177,8 @@ def create_parser(subparsers):
                                help="Specifies the suffixes or the subtrees to be included")
     export_parser.add_argument('-x', '--exclude-suffixes', nargs='+',
                                help="Specifies the suffixes to be excluded")
+    export_parser.add_argument('-z', '--gzip', action='store_true',
+                               help="Compresses the LDIF file with gzip (lmdb only). The import reads compressed LDIF files.")
     export_parser.add_argument('--timeout', default=0, type=int,
                                help="Set a timeout to wait for the export task.  Default is 0 (no timeout)")
 
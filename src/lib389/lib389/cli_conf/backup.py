@@ -11,7 +11,8 @@ from lib389.cli_base import CustomHelpFormatter
 def backup_create(inst, basedn, log, args):
     log = log.getChild('backup_create')
 
-    task = inst.backup_online(archive=args.archive, db_type=args.db_type)
+    task = inst.backup_online(archive=args.archive, db_type=args.db_type,
+                              incremental_base=args.incremental_base)
     task.wait(timeout=args.timeout)
     result = task.get_exit_code()
 
@@ -54,6 +55,9 @@ def create_parser(subparsers):
                                            "Default: /var/lib/dirsrv/slapd-instance/bak/ ")
     create_backup_parser.add_argument('-t', '--db-type', default="ldbm database",
                                       help="Sets the database type. Default: ldbm database")
+    create_backup_parser.add_argument('-i', '--incremental-base', default=None,
+                                      help="Only stores the database changes since this previous backup "
+                                           "(LMDB only). The restore needs all the backups of the chain.")
     create_backup_parser.add_argument('--timeout', type=int, default=120,
                                       help="Sets the task timeout.  Default is 120 seconds,")
 
@@ -24,6 +24,7 @@ arg_to_attr_config = {
     'state_attr': 'stateattrname',
     'login_history': 'lastLoginHistory',
     'login_history_size': 'lastLoginHistorySize',
+    'login_flush_interval': 'lastLoginFlushInterval',
     'check_all_state_attrs': 'checkallstateattrs'
 }
 
@@ -104,6 +105,9 @@ def _add_parser_args(parser):
                         help='Specifies the primary time attribute used to evaluate an account policy (stateAttrName)')
     parser.add_argument('--login-history-size',
                         help='Specifies the number of login timestamps to store (lastLoginHistSize) )')
+    parser.add_argument('--login-flush-interval',
+                        help='Specifies the number of seconds the login times are kept in memory before '
+                             'being written to the entries, 0 writes them at each bind (lastLoginFlushInterval)')
     parser.add_argument('--check-all-state-attrs', choices=['yes', 'no'], type=str.lower,
                         help="Check both state and alternate state attributes for account state")
 
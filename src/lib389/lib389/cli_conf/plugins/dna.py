@@ -26,7 +26,8 @@ arg_to_attr = {
     'shared_config_entry': 'dnaSharedCfgDN',
     'threshold': 'dnaThreshold',
     'next_range': 'dnaNextRange',
-    'range_request_timeout': 'dnaRangeRequestTimeout'
+    'range_request_timeout': 'dnaRangeRequestTimeout',
+    'reservation_size': 'dnaReservationSize'
 }
 
 arg_to_attr_config = {
@@ -200,6 +201,10 @@ def _add_parser_args(parser):
                         help='Sets a timeout period, in seconds, for range requests so that the server '
                              'does not stall waiting on a new range from one server and '
                              'can request a range from a new server (dnaRangeRequestTimeout)')
+    parser.add_argument('--reservation-size',
+                        help='Sets how many values are reserved each time the next value is written to '
+                             'the configuration entry.  Larger values speed up bulk adds, but a crash '
+                             'can skip up to that many values (dnaReservationSize)')
 
 def create_parser(subparsers):
     dna = subparsers.add_parser('dna', help='Manage and configure DNA plugin', formatter_class=CustomHelpFormatter)
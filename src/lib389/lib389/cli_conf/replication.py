@@ -77,6 +77,7 @@ arg_to_attr = {
         'session_pause_time': 'nsds5replicaSessionPauseTime',
         'flow_control_window': 'nsds5replicaflowcontrolwindow',
         'flow_control_pause': 'nsds5replicaflowcontrolpause',
+        'total_update_batch_size': 'nsds5replicatotalupdatebatchsize',
         # Additional Winsync Agmt attrs
         'win_subtree': 'nsds7windowsreplicasubtree',
         'ds_subtree': 'nsds7directoryreplicasubtree',
@@ -1720,6 +1721,9 @@ def create_parser(subparsers):
     agmt_add_parser.add_argument('--flow-control-pause',
                                  help="Sets the time in milliseconds to pause after reaching the number of entries and "
                                       "updates set in \"--flow-control-window\"")
+    agmt_add_parser.add_argument('--total-update-batch-size',
+                                 help="Sets the number of entries sent per operation during a total update (0-10000). "
+                                      "The batches are compressed. 0, the default, sends the entries one by one.")
     agmt_add_parser.add_argument('--bootstrap-bind-dn',
                                  help="Sets an optional bind DN the agreement can use to bootstrap initialization when "
                                       "bind groups are being used")
@@ -1764,6 +1768,9 @@ def create_parser(subparsers):
     agmt_set_parser.add_argument('--flow-control-pause',
                                  help="Sets the time in milliseconds to pause after reaching the number of entries and "
                                       "updates set in \"--flow-control-window\"")
+    agmt_set_parser.add_argument('--total-update-batch-size',
+                                 help="Sets the number of entries sent per operation during a total update (0-10000). "
+                                      "The batches are compressed. 0, the default, sends the entries one by one.")
     agmt_set_parser.add_argument('--bootstrap-bind-dn',
                                  help="Sets an optional bind DN the agreement can use to bootstrap initialization when "
                                       "bind groups are being used")
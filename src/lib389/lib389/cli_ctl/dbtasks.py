@@ -67,7 +67,8 @@ def dbtasks_db2ldif(inst, log, args):
 
     # Export backend
     if not inst.db2ldif(bename=args.backend, encrypt=args.encrypted, repl_data=args.replication,
-                        outputfile=args.ldif, suffixes=None, excludeSuffixes=None, export_cl=False):
+                        outputfile=args.ldif, suffixes=None, excludeSuffixes=None, export_cl=False,
+                        gzip=args.gzip):
         log.fatal("db2ldif failed")
         return False
     else:
@@ -147,6 +148,7 @@ def create_parser(subcommands):
     #                                                         "This option also implies the '--replication' option is set.",
     #                             default=False, action='store_true')
     db2ldif_parser.add_argument('--encrypted', help="Export encrypted attributes", default=False, action='store_true')
+    db2ldif_parser.add_argument('--gzip', help="Compress the LDIF file with gzip (lmdb only)", default=False, action='store_true')
     db2ldif_parser.set_defaults(func=dbtasks_db2ldif)
 
     dbverify_parser = subcommands.add_parser('dbverify', help="Perform a db verification. You should only do this at direction of support", formatter_class=CustomHelpFormatter)
@@ -94,7 +94,15 @@ loginShell: /bin/false
             raise(e)
         self.log.debug(result)
 
-    def _run_ldclt(self, cmd):
+    def _run_ldclt(self, cmd, stats=False):
+        """Run ldclt and return the global rate of operations per second
+
+        :param cmd: ldclt command line
+        :type cmd: list
+        :param stats: return the parsed statistics instead of the rate
+        :type stats: bool
+        :returns: the rate (str) or a dict {'rate': float, 'total': int, 'errors': int}
+        """
         result = None
         self.log.debug("ldclt loadtest ...")
         self.log.debug(format_cmd_list(cmd))
@@ -115,20 +123,31 @@ loginShell: /bin/false
         # ldclt[44308]: Global no error occurs during this session.
         # So we want the "global avg rate" per second.
         section = None
+        total = 0
+        errors = 0
         for line in result.splitlines():
             if 'Global average rate' in line:
                 section = line.split('(')[1].split(')')[0].split('/')[0]
+                total = int(line.split('total:')[1].strip())
+            elif 'Global error' in line:
+                # ldclt[44308]: Global error 32 No such object occurs    12 times
+                errors += int(line.split('occurs')[1].split()[0])
+        if stats:
+            return {'rate': float(section or 0), 'total': total, 'errors': errors}
         return section
 
-    def bind_loadtest(self, subtree, min=1000, max=9999, rounds=10):
+    def bind_loadtest(self, subtree, min=1000, max=9999, rounds=10, threads=10, stats=False, digits=None):
         # The bind users will be uid=userXXXX
-        digits = len('%s' % max)
+        if digits is None:
+            digits = len('%s' % max)
         cmd = [
             '%s/ldclt' % self.ds.get_bin_dir(),
             '-h',
             self.ds.host,
             '-p',
             '%s' % self.ds.port,
+            '-n',
+            '%s' % threads,
             '-N',
             '%s' % rounds,
             '-D',
@@ -140,9 +159,10 @@ loginShell: /bin/false
             '-e',
             'bindonly',
         ]
-        return self._run_ldclt(cmd)
+        return self._run_ldclt(cmd, stats)
 
-    def search_loadtest(self, subtree, fpattern, min=1000, max=9999, rounds=10):
+    def search_loadtest(self, subtree, fpattern, min=1000, max=9999, rounds=10, threads=10, stats=False,
+                        scope='subtree'):
         # digits = len('%s' % max)
         cmd = [
             '%s/ldclt' % self.ds.get_bin_dir(),
@@ -150,8 +170,14 @@ loginShell: /bin/false
             self.ds.host,
             '-p',
             '%s' % self.ds.port,
+            '-n',
+            '%s' % threads,
             '-N',
             '%s' % rounds,
+            '-b',
+            subtree,
+            '-s',
+            scope,
             '-f',
             fpattern,
             '-e',
@@ -163,4 +189,40 @@ loginShell: /bin/false
             '-e',
             'randomattrlist=cn:uid:ou',
         ]
-        return self._run_ldclt(cmd)
+        return self._run_ldclt(cmd, stats)
+
+    def modify_loadtest(self, subtree, fpattern, attr='description', min=1000, max=9999, rounds=10,
+                        threads=10, stats=False):
+        """Replace the value of an attribute of random existing entries
+
+        The entries are <fpattern>,<subtree> (i.e fpattern='uid=userXXXX')
+        and the new values are random strings.
+        """
+        cmd = [
+            '%s/ldclt' % self.ds.get_bin_dir(),
+            '-h',
+            self.ds.host,
+            '-p',
+            '%s' % self.ds.port,
+            '-n',
+            '%s' % threads,
+            '-N',
+            '%s' % rounds,
+            '-D',
+            self.ds.binddn,
+            '-w',
+            self.ds.bindpw,
+            '-b',
+            subtree,
+            '-f',
+            fpattern,
+            '-e',
+            'attreplace=%s:benchmark XXXXXXXX' % attr,
+            '-e',
+            'random',
+            '-r%s' % min,
+            '-R%s' % max,
+            '-I',
+            '32',
+        ]
+        return self._run_ldclt(cmd, stats)
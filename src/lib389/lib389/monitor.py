@@ -157,6 +157,8 @@ class Monitor(DSLdapObject):
             'maxthreadsperconnhits',
             'dtablesize',
             'readwaiters',
+            'entrywrites',
+            'entrywritebytes',
             'opsinitiated',
             'opscompleted',
             'entriessent',
@@ -418,7 +420,9 @@ class MonitorChaining(DSLdapObject):
             'nsunbindcount',
             'nscomparecount',
             'nsopenopconnectioncount',
-            'nsopenbindconnectioncount'
+            'nsopenbindconnectioncount',
+            'nsopconnectionwaithistogram',
+            'nsopconnectioninflighthistogram'
         ]
         self._protected = False
 
@@ -470,6 +474,57 @@ class MonitorSNMP(DSLdapObject):
         return self.get_attrs_vals_utf8(self._snmp_keys)
 
 
+class MonitorLatency(DSLdapObject):
+    """A class for representing "cn=latency,cn=monitor" entry"""
+
+    def __init__(self, instance, dn=None):
+        super(MonitorLatency, self).__init__(instance=instance, dn=dn)
+        self._dn = "cn=latency,cn=monitor"
+
+    def get_latencies(self):
+        """Get the latency summaries of the operation phases
+
+        :returns: A dict {(optype, phase): {'count': .., 'avg': .., 'p50': ..,
+                  'p90': .., 'p99': .., 'max': ..}}, the durations are in
+                  microseconds
+        """
+        latencies = {}
+        for value in self.get_attr_vals_utf8('latency'):
+            fields = dict(f.split('=', 1) for f in value.split())
+            key = (fields.pop('op'), fields.pop('phase'))
+            latencies[key] = {k: int(v) for k, v in fields.items()}
+        return latencies
+
+    def get_histograms(self):
+        """Get the latency histograms of the operation phases
+
+        :returns: A dict {(optype, phase): {bucket upper limit (usec): count}}
+        """
+        histograms = {}
+        for value in self.get_attr_vals_utf8('latencyHistogram'):
+            fields = value.split()
+            key = (fields[0].split('=', 1)[1], fields[1].split('=', 1)[1])
+            histograms[key] = {int(l): int(c) for l, c in (f.split(':') for f in fields[2:])}
+        return histograms
+
+
+class MonitorBindCrypto(DSLdapObject):
+    """A class for representing "cn=bind crypto,cn=monitor" entry"""
+
+    def __init__(self, instance, dn=None):
+        super(MonitorBindCrypto, self).__init__(instance=instance, dn=dn)
+        self._dn = "cn=bind crypto,cn=monitor"
+
+    def get_status(self):
+        """Get the password verification statistics, the times are in microseconds
+
+        :returns: A dict {attribute: int}
+        """
+        attrs = ['maxPending', 'pending', 'peakPending', 'verifications',
+                 'rejected', 'hashTimeAvg', 'hashTimeMax']
+        return {attr: int(self.get_attr_val_utf8(attr)) for attr in attrs}
+
+
 class MonitorDiskSpace(DSLdapObject):
     """A class for representing "cn=disk space,cn=monitor" entry"""
 
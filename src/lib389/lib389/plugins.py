@@ -175,6 +175,16 @@ class AttributeUniquenessPlugin(Plugin):
 
         self.set('uniqueness-across-all-subtrees', 'off')
 
+    def enable_cache(self):
+        """Set uniqueness-cache to on"""
+
+        self.set('uniqueness-cache', 'on')
+
+    def disable_cache(self):
+        """Set uniqueness-cache to off"""
+
+        self.set('uniqueness-cache', 'off')
+
 
 class AttributeUniquenessPlugins(DSLdapObjects):
     """A DSLdapObjects entity which represents Attribute Uniqueness plugin instances
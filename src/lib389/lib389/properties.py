@@ -322,6 +322,7 @@ AGMT_ENABLED = 'nsds5ReplicaEnabled'
 AGMT_STRIP_ATTRS = 'nsds5ReplicaStripAttrs'
 AGMT_FLOW_WINDOW = 'nsds5ReplicaFlowControlWindow'
 AGMT_FLOW_PAUSE = 'nsds5ReplicaFlowControlPause'
+AGMT_TOTAL_UPDATE_BATCH_SIZE = 'nsds5ReplicaTotalUpdateBatchSize'
 AGMT_MAXCSN = 'nsds5AgmtMaxCSN'
 AGMT_UPDATE_START = 'nsds5replicaLastUpdateStart'
 AGMT_UPDATE_END = 'nsds5replicaLastUpdateEnd'
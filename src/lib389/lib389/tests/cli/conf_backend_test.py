@@ -388,6 +388,7 @@ def test_import_export(topology_st):
     args.no_seq_num = None
     args.include_suffixes = None
     args.exclude_suffixes = [EXCLUDE_SUFFIX]
+    args.gzip = None
     backend_export(topology_st.standalone, None, topology_st.logcap.log, args)
 
     # Verify export worked
@@ -44,6 +44,7 @@ def test_ldif2db_db2ldif_no_repl(topology_be_latest):
     args.ldif = os.path.join(standalone.get_ldif_dir(), "test.ldif")
     args.encrypted = False
     args.replication = False
+    args.gzip = False
     # Stop the instance
     dbtasks_db2ldif(standalone, topology_be_latest.logcap.log, args)
     # Assert none.
@@ -62,6 +63,7 @@ def test_ldif2db_db2ldif_repl(topology_be_latest):
     args.ldif = os.path.join(standalone.get_ldif_dir(), "test.ldif")
     args.encrypted = False
     args.replication = False
+    args.gzip = False
     args.archive = os.path.join(standalone.get_ldif_dir(), "test.ldif")
     # Stop the instance
     dbtasks_db2ldif(standalone, topology_be_latest.logcap.log, args)
@@ -0,0 +1,115 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+#include "../bench.h"
+
+#include <back-ldbm.h>
+
+/*
+ * idl_intersection / idl_union of two IDLs of a given size in an ID space
+ * of a given size: the density is the ratio of the IDs present.
+ */
+typedef struct
+{
+    IDList *a;
+    IDList *b;
+} bench_idl_state;
+
+static IDList *
+bench_idl_new(NIDS nids, ID space, uint32_t seed)
+{
+    IDList *idl = idl_alloc(nids);
+    ID id = 0;
+
+    /* Evenly spread IDs with a small deterministic jitter, sorted */
+    for (NIDS i = 0; i < nids; i++) {
+        ID next = (ID)(((uint64_t)i * space) / nids) + 1;
+        seed = seed * 1103515245 + 12345;
+        next += (seed >> 16) % ((space / nids) ? (space / nids) : 1);
+        if (next <= id) {
+            next = id + 1;
+        }
+        id = next;
+        idl_append(idl, id);
+    }
+    return idl;
+}
+
+static void *
+bench_idl_setup(NIDS nids_a, NIDS nids_b, ID space)
+{
+    bench_idl_state *state = (bench_idl_state *)slapi_ch_calloc(1, sizeof(bench_idl_state));
+
+    state->a = bench_idl_new(nids_a, space, 1);
+    state->b = bench_idl_new(nids_b, space, 2);
+    return state;
+}
+
+static void
+bench_idl_intersection_run(void *arg)
+{
+    bench_idl_state *state = (bench_idl_state *)arg;
+    IDList *idl = idl_intersection(NULL, state->a, state->b);
+
+    idl_free(&idl);
+}
+
+static void
+bench_idl_union_run(void *arg)
+{
+    bench_idl_state *state = (bench_idl_state *)arg;
+    IDList *idl = idl_union(NULL, state->a, state->b);
+
+    idl_free(&idl);
+}
+
+static void
+bench_idl_teardown(void *arg)
+{
+    bench_idl_state *state = (bench_idl_state *)arg;
+
+    idl_free(&state->a);
+    idl_free(&state->b);
+    slapi_ch_free((void **)&state);
+}
+
+/* 1M IDs space: sparse (1%), medium (10%), dense (50%) and skewed sizes */
+static void *
+bench_idl_sparse_setup(void)
+{
+    return bench_idl_setup(10000, 10000, 1000000);
+}
+
+static void *
+bench_idl_medium_setup(void)
+{
+    return bench_idl_setup(100000, 100000, 1000000);
+}
+
+static void *
+bench_idl_dense_setup(void)
+{
+    return bench_idl_setup(500000, 500000, 1000000);
+}
+
+static void *
+bench_idl_skewed_setup(void)
+{
+    return bench_idl_setup(100, 500000, 1000000);
+}
+
+const bench_case bench_idl_cases[] = {
+    {"idl_intersection/sparse", bench_idl_sparse_setup, bench_idl_intersection_run, bench_idl_teardown},
+    {"idl_intersection/medium", bench_idl_medium_setup, bench_idl_intersection_run, bench_idl_teardown},
+    {"idl_intersection/dense", bench_idl_dense_setup, bench_idl_intersection_run, bench_idl_teardown},
+    {"idl_intersection/skewed", bench_idl_skewed_setup, bench_idl_intersection_run, bench_idl_teardown},
+    {"idl_union/sparse", bench_idl_sparse_setup, bench_idl_union_run, bench_idl_teardown},
+    {"idl_union/medium", bench_idl_medium_setup, bench_idl_union_run, bench_idl_teardown},
+    {"idl_union/dense", bench_idl_dense_setup, bench_idl_union_run, bench_idl_teardown},
+    {"idl_union/skewed", bench_idl_skewed_setup, bench_idl_union_run, bench_idl_teardown},
+    {NULL, NULL, NULL, NULL}};
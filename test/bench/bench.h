@@ -0,0 +1,46 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+#pragma once
+
+#include <config.h>
+#include <slapi-plugin.h>
+
+#include <stdint.h>
+
+/*
+ * A benchmark case.
+ *
+ * setup() builds the input data and returns it as the state given to run()
+ * and teardown(). It may return NULL if the case can not run (i.e a syntax
+ * plugin could not be loaded), the case is then skipped.
+ *
+ * run() is the measured operation. It must release everything it allocates
+ * so that the allocations per operation are meaningful.
+ */
+typedef struct bench_case
+{
+    const char *name;
+    void *(*setup)(void);
+    void (*run)(void *state);
+    void (*teardown)(void *state);
+} bench_case;
+
+/* Benchmark suites, each terminated by an empty case */
+extern const bench_case bench_dn_cases[];
+extern const bench_case bench_entry_cases[];
+extern const bench_case bench_filter_cases[];
+extern const bench_case bench_valueset_cases[];
+extern const bench_case bench_syntax_cases[];
+extern const bench_case bench_idl_cases[];
+
+/* Register the syntax plugins used by the cases (once) */
+int bench_syntax_init(void);
+
+/* A representative user entry, the caller frees it */
+Slapi_Entry *bench_entry_new(void);
@@ -0,0 +1,56 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+#include "../bench.h"
+
+#include <string.h>
+
+/* slapi_dn_normalize_ext may normalize in place, so work on a copy */
+static void
+bench_dn_normalize(const char *dn)
+{
+    char buf[256];
+    char *dest = NULL;
+    size_t dest_len = 0;
+
+    strcpy(buf, dn);
+    if (slapi_dn_normalize_ext(buf, 0, &dest, &dest_len) > 0) {
+        slapi_ch_free_string(&dest);
+    }
+}
+
+static void
+bench_dn_normalize_normalized(void *state __attribute__((unused)))
+{
+    bench_dn_normalize("uid=user0042,ou=people,dc=example,dc=com");
+}
+
+static void
+bench_dn_normalize_spaces(void *state __attribute__((unused)))
+{
+    bench_dn_normalize("uid = user0042 , ou = People, dc = Example, dc = COM");
+}
+
+static void
+bench_dn_normalize_escaped(void *state __attribute__((unused)))
+{
+    bench_dn_normalize("cn=Smith\\2C John \\+ Co,ou=people,dc=example,dc=com");
+}
+
+static void
+bench_dn_normalize_multivalued_rdn(void *state __attribute__((unused)))
+{
+    bench_dn_normalize("uid=user0042+cn=John Smith,ou=people,dc=example,dc=com");
+}
+
+const bench_case bench_dn_cases[] = {
+    {"dn_normalize_ext/normalized", NULL, bench_dn_normalize_normalized, NULL},
+    {"dn_normalize_ext/spaces", NULL, bench_dn_normalize_spaces, NULL},
+    {"dn_normalize_ext/escaped", NULL, bench_dn_normalize_escaped, NULL},
+    {"dn_normalize_ext/multivalued_rdn", NULL, bench_dn_normalize_multivalued_rdn, NULL},
+    {NULL, NULL, NULL, NULL}};
@@ -0,0 +1,118 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+#include "../bench.h"
+
+#include <string.h>
+
+static const char bench_entry_ldif[] =
+    "dn: uid=user0042,ou=people,dc=example,dc=com\n"
+    "objectClass: top\n"
+    "objectClass: person\n"
+    "objectClass: organizationalPerson\n"
+    "objectClass: inetOrgPerson\n"
+    "objectClass: posixAccount\n"
+    "uid: user0042\n"
+    "cn: John Smith\n"
+    "cn: Johnny Smith\n"
+    "sn: Smith\n"
+    "givenName: John\n"
+    "initials: J. S.\n"
+    "description: This is John Smith's description, long enough to look like a real one.\n"
+    "mail: john.smith@example.com\n"
+    "mail: user0042@example.com\n"
+    "telephoneNumber: +1 303 573-9570\n"
+    "mobile: +1 818 618-1671\n"
+    "l: Mountain View\n"
+    "ou: people\n"
+    "title: Senior Engineer\n"
+    "employeeType: Manager\n"
+    "departmentNumber: 1230\n"
+    "roomNumber: 5164\n"
+    "uidNumber: 1042\n"
+    "gidNumber: 1042\n"
+    "homeDirectory: /home/user0042\n"
+    "loginShell: /bin/bash\n"
+    "userPassword: {PBKDF2-SHA512}10000$c2FsdHNhbHRzYWx0$aGFzaGhhc2hoYXNoaGFzaGhhc2hoYXNo\n"
+    "memberOf: cn=group_1,ou=groups,dc=example,dc=com\n"
+    "memberOf: cn=group_2,ou=groups,dc=example,dc=com\n"
+    "memberOf: cn=group_3,ou=groups,dc=example,dc=com\n"
+    "nsUniqueId: 6e2a8f01-1dd211b2-80a4c1b3-7f4e2d90\n"
+    "creatorsName: cn=directory manager\n"
+    "modifiersName: cn=directory manager\n"
+    "createTimestamp: 20260101000000Z\n"
+    "modifyTimestamp: 20260101000000Z\n";
+
+Slapi_Entry *
+bench_entry_new(void)
+{
+    char *ldif = slapi_ch_strdup(bench_entry_ldif);
+    Slapi_Entry *e = slapi_str2entry(ldif, 0);
+
+    slapi_ch_free_string(&ldif);
+    return e;
+}
+
+/* str2entry modifies its input, each run parses a fresh copy */
+static void *
+bench_str2entry_setup(void)
+{
+    bench_syntax_init();
+    return slapi_ch_malloc(sizeof(bench_entry_ldif));
+}
+
+static void
+bench_str2entry_run(void *state)
+{
+    memcpy(state, bench_entry_ldif, sizeof(bench_entry_ldif));
+    Slapi_Entry *e = slapi_str2entry((char *)state, 0);
+    slapi_entry_free(e);
+}
+
+static void
+bench_free_state(void *state)
+{
+    slapi_ch_free(&state);
+}
+
+static void *
+bench_entry2str_setup(void)
+{
+    bench_syntax_init();
+    return bench_entry_new();
+}
+
+static void
+bench_entry2str_run(void *state)
+{
+    int len = 0;
+    char *s = slapi_entry2str((Slapi_Entry *)state, &len);
+
+    slapi_ch_free_string(&s);
+}
+
+static void
+bench_entry_dup_run(void *state)
+{
+    Slapi_Entry *e = slapi_entry_dup((Slapi_Entry *)state);
+
+    slapi_entry_free(e);
+}
+
+static void
+bench_entry_free_state(void *state)
+{
+    slapi_entry_free((Slapi_Entry *)state);
+}
+
+/* str2entry_fast: well formed LDIF and no flag forcing the dupcheck path */
+const bench_case bench_entry_cases[] = {
+    {"str2entry_fast/user", bench_str2entry_setup, bench_str2entry_run, bench_free_state},
+    {"entry2str/user", bench_entry2str_setup, bench_entry2str_run, bench_entry_free_state},
+    {"entry_dup/user", bench_entry2str_setup, bench_entry_dup_run, bench_entry_free_state},
+    {NULL, NULL, NULL, NULL}};
@@ -0,0 +1,82 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+#include "../bench.h"
+
+typedef struct
+{
+    Slapi_Entry *e;
+    Slapi_Filter *f;
+} bench_filter_state;
+
+static void *
+bench_filter_setup(const char *fstr)
+{
+    bench_filter_state *state = NULL;
+    char *dup = NULL;
+
+    if (bench_syntax_init()) {
+        return NULL;
+    }
+    state = (bench_filter_state *)slapi_ch_calloc(1, sizeof(bench_filter_state));
+    state->e = bench_entry_new();
+    dup = slapi_ch_strdup(fstr);
+    state->f = slapi_str2filter(dup);
+    slapi_ch_free_string(&dup);
+    return state;
+}
+
+static void
+bench_filter_run(void *arg)
+{
+    bench_filter_state *state = (bench_filter_state *)arg;
+
+    slapi_filter_test_simple(state->e, state->f);
+}
+
+static void
+bench_filter_teardown(void *arg)
+{
+    bench_filter_state *state = (bench_filter_state *)arg;
+
+    slapi_filter_free(state->f, 1);
+    slapi_entry_free(state->e);
+    slapi_ch_free((void **)&state);
+}
+
+#define BENCH_FILTER_SETUP(name, fstr)    \
+    static void *                         \
+    bench_filter_##name##_setup(void)     \
+    {                                     \
+        return bench_filter_setup(fstr);  \
+    }
+
+BENCH_FILTER_SETUP(eq_match, "(uid=user0042)")
+BENCH_FILTER_SETUP(eq_nomatch, "(uid=user0043)")
+BENCH_FILTER_SETUP(pres, "(mail=*)")
+BENCH_FILTER_SETUP(sub, "(cn=*smith*)")
+BENCH_FILTER_SETUP(ge, "(uidNumber>=1000)")
+BENCH_FILTER_SETUP(and, "(&(objectClass=inetOrgPerson)(uid=user0042)(mail=*))")
+BENCH_FILTER_SETUP(or_nomatch, "(|(uid=user1)(uid=user2)(uid=user3)(uid=user4)(uid=user5))")
+BENCH_FILTER_SETUP(not, "(!(memberOf=cn=group_4,ou=groups,dc=example,dc=com))")
+BENCH_FILTER_SETUP(memberof, "(memberOf=cn=group_3,ou=groups,dc=example,dc=com)")
+
+#define BENCH_FILTER_CASE(name) \
+    {"filter_test/" #name, bench_filter_##name##_setup, bench_filter_run, bench_filter_teardown}
+
+const bench_case bench_filter_cases[] = {
+    BENCH_FILTER_CASE(eq_match),
+    BENCH_FILTER_CASE(eq_nomatch),
+    BENCH_FILTER_CASE(pres),
+    BENCH_FILTER_CASE(sub),
+    BENCH_FILTER_CASE(ge),
+    BENCH_FILTER_CASE(and),
+    BENCH_FILTER_CASE(or_nomatch),
+    BENCH_FILTER_CASE(not),
+    BENCH_FILTER_CASE(memberof),
+    {NULL, NULL, NULL, NULL}};
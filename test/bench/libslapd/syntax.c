@@ -0,0 +1,178 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+#include "../bench.h"
+
+#include <slap.h>
+#include <proto-slap.h>
+
+/* From the syntax plugin, linked in the benchmark */
+int cis_init(Slapi_PBlock *pb);
+int ces_init(Slapi_PBlock *pb);
+int int_init(Slapi_PBlock *pb);
+int dn_init(Slapi_PBlock *pb);
+
+static struct
+{
+    const char *name;
+    const char *oid;
+    const char *syntax;
+} bench_attrs[] = {
+    {"uid", "0.9.2342.19200300.100.1.1", DIRSTRING_SYNTAX_OID},
+    {"cn", "2.5.4.3", DIRSTRING_SYNTAX_OID},
+    {"sn", "2.5.4.4", DIRSTRING_SYNTAX_OID},
+    {"givenName", "2.5.4.42", DIRSTRING_SYNTAX_OID},
+    {"description", "2.5.4.13", DIRSTRING_SYNTAX_OID},
+    {"l", "2.5.4.7", DIRSTRING_SYNTAX_OID},
+    {"ou", "2.5.4.11", DIRSTRING_SYNTAX_OID},
+    {"title", "2.5.4.12", DIRSTRING_SYNTAX_OID},
+    {"objectClass", "2.5.4.0", DIRSTRING_SYNTAX_OID},
+    {"mail", "0.9.2342.19200300.100.1.3", IA5STRING_SYNTAX_OID},
+    {"homeDirectory", "1.3.6.1.1.1.1.3", IA5STRING_SYNTAX_OID},
+    {"uidNumber", "1.3.6.1.1.1.1.0", INTEGER_SYNTAX_OID},
+    {"gidNumber", "1.3.6.1.1.1.1.1", INTEGER_SYNTAX_OID},
+    {"member", "2.5.4.31", DN_SYNTAX_OID},
+    {"memberOf", "1.2.840.113556.1.2.102", DN_SYNTAX_OID},
+    {NULL, NULL, NULL}};
+
+/*
+ * There is no server configuration here: register the syntax plugins the
+ * way the plugins register their sub plugins, then the schema of the
+ * attributes used by the benchmarks.
+ */
+int
+bench_syntax_init(void)
+{
+    static int initialized = 0;
+    static int rc = 0;
+    void *identity = plugin_get_default_component_id();
+
+    if (initialized) {
+        return rc;
+    }
+    initialized = 1;
+
+    rc |= slapi_register_plugin("syntax", 1, "cis_init", cis_init, "bench cis syntax", NULL, identity);
+    rc |= slapi_register_plugin("syntax", 1, "ces_init", ces_init, "bench ces syntax", NULL, identity);
+    rc |= slapi_register_plugin("syntax", 1, "int_init", int_init, "bench int syntax", NULL, identity);
+    rc |= slapi_register_plugin("syntax", 1, "dn_init", dn_init, "bench dn syntax", NULL, identity);
+
+    for (size_t i = 0; rc == 0 && bench_attrs[i].name; i++) {
+        struct asyntaxinfo *asi = NULL;
+        char *names[2] = {(char *)bench_attrs[i].name, NULL};
+
+        rc = attr_syntax_create(bench_attrs[i].oid, names, "benchmark attribute type",
+                                NULL, NULL, NULL, NULL, NULL, bench_attrs[i].syntax,
+                                SLAPI_SYNTAXLENGTH_NONE, SLAPI_ATTR_FLAG_STD_ATTR, &asi);
+        if (rc == 0) {
+            rc = attr_syntax_add(asi, 0);
+        }
+    }
+    if (rc) {
+        fprintf(stderr, "bench_syntax_init: failed to register the syntaxes (%d)\n", rc);
+    }
+    return rc;
+}
+
+typedef struct
+{
+    Slapi_Attr *attr;
+    Slapi_Value **values;
+    int ftype;
+} bench_keys_state;
+
+static void *
+bench_keys_setup(const char *type, const char **values, int ftype)
+{
+    bench_keys_state *state = NULL;
+    size_t nvalues = 0;
+
+    if (bench_syntax_init()) {
+        return NULL;
+    }
+    while (values[nvalues]) {
+        nvalues++;
+    }
+    state = (bench_keys_state *)slapi_ch_calloc(1, sizeof(bench_keys_state));
+    state->attr = slapi_attr_new();
+    slapi_attr_init(state->attr, type);
+    state->values = (Slapi_Value **)slapi_ch_calloc(nvalues + 1, sizeof(Slapi_Value *));
+    for (size_t i = 0; i < nvalues; i++) {
+        state->values[i] = slapi_value_new_string(values[i]);
+    }
+    state->ftype = ftype;
+    return state;
+}
+
+static void
+bench_keys_run(void *arg)
+{
+    bench_keys_state *state = (bench_keys_state *)arg;
+    Slapi_Value **keys = NULL;
+
+    slapi_attr_values2keys_sv(state->attr, state->values, &keys, state->ftype);
+    valuearray_free(&keys);
+}
+
+static void
+bench_keys_teardown(void *arg)
+{
+    bench_keys_state *state = (bench_keys_state *)arg;
+
+    valuearray_free(&state->values);
+    slapi_attr_free(&state->attr);
+    slapi_ch_free((void **)&state);
+}
+
+static const char *bench_cn_values[] = {"John Smith", "Johnny Smith", NULL};
+static const char *bench_mail_values[] = {"john.smith@example.com", "user0042@example.com", NULL};
+static const char *bench_uidnumber_values[] = {"1042", NULL};
+static const char *bench_member_values[] = {
+    "uid=user0001,ou=people,dc=example,dc=com",
+    "uid=user0002,ou=People,dc=Example,dc=com",
+    "UID=user0003, ou=people, dc=example, dc=com",
+    "uid=user0004,ou=people,dc=example,dc=com",
+    NULL};
+
+static void *
+bench_keys_cis_eq_setup(void)
+{
+    return bench_keys_setup("cn", bench_cn_values, LDAP_FILTER_EQUALITY);
+}
+
+static void *
+bench_keys_cis_sub_setup(void)
+{
+    return bench_keys_setup("cn", bench_cn_values, LDAP_FILTER_SUBSTRINGS);
+}
+
+static void *
+bench_keys_ces_eq_setup(void)
+{
+    return bench_keys_setup("mail", bench_mail_values, LDAP_FILTER_EQUALITY);
+}
+
+static void *
+bench_keys_int_eq_setup(void)
+{
+    return bench_keys_setup("uidNumber", bench_uidnumber_values, LDAP_FILTER_EQUALITY);
+}
+
+static void *
+bench_keys_dn_eq_setup(void)
+{
+    return bench_keys_setup("member", bench_member_values, LDAP_FILTER_EQUALITY);
+}
+
+const bench_case bench_syntax_cases[] = {
+    {"values2keys/cis_eq", bench_keys_cis_eq_setup, bench_keys_run, bench_keys_teardown},
+    {"values2keys/cis_sub", bench_keys_cis_sub_setup, bench_keys_run, bench_keys_teardown},
+    {"values2keys/ces_eq", bench_keys_ces_eq_setup, bench_keys_run, bench_keys_teardown},
+    {"values2keys/int_eq", bench_keys_int_eq_setup, bench_keys_run, bench_keys_teardown},
+    {"values2keys/dn_eq", bench_keys_dn_eq_setup, bench_keys_run, bench_keys_teardown},
+    {NULL, NULL, NULL, NULL}};
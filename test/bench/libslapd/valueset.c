@@ -0,0 +1,99 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+#include "../bench.h"
+
+#include <slap.h>
+
+/*
+ * valueset_find_sorted on a member valueset of various sizes, looking up
+ * the values in turn (half of them are not in the set).
+ */
+typedef struct
+{
+    Slapi_Attr *attr;
+    Slapi_ValueSet *vs;
+    Slapi_Value **lookups;
+    size_t nlookups;
+    size_t next;
+} bench_valueset_state;
+
+static void *
+bench_valueset_setup(size_t nvalues)
+{
+    bench_valueset_state *state = NULL;
+    Slapi_Value **values = NULL;
+
+    if (bench_syntax_init()) {
+        return NULL;
+    }
+    state = (bench_valueset_state *)slapi_ch_calloc(1, sizeof(bench_valueset_state));
+    state->attr = slapi_attr_new();
+    slapi_attr_init(state->attr, "member");
+    state->vs = slapi_valueset_new();
+
+    values = (Slapi_Value **)slapi_ch_calloc(nvalues + 1, sizeof(Slapi_Value *));
+    state->nlookups = 2 * nvalues;
+    state->lookups = (Slapi_Value **)slapi_ch_calloc(state->nlookups + 1, sizeof(Slapi_Value *));
+    for (size_t i = 0; i < nvalues; i++) {
+        char *dn = slapi_ch_smprintf("uid=user%06zu,ou=people,dc=example,dc=com", 2 * i);
+        values[i] = slapi_value_new_string_passin(dn);
+        state->lookups[2 * i] = slapi_value_dup(values[i]);
+        dn = slapi_ch_smprintf("uid=user%06zu,ou=people,dc=example,dc=com", 2 * i + 1);
+        state->lookups[2 * i + 1] = slapi_value_new_string_passin(dn);
+    }
+    /* Sorted since more than VALUESET_ARRAY_SORT_THRESHOLD values or dupcheck */
+    slapi_valueset_add_attr_valuearray_ext(state->attr, state->vs, values, nvalues,
+                                           SLAPI_VALUE_FLAG_PASSIN | SLAPI_VALUE_FLAG_DUPCHECK, NULL);
+    slapi_ch_free((void **)&values);
+    return state;
+}
+
+static void
+bench_valueset_run(void *arg)
+{
+    bench_valueset_state *state = (bench_valueset_state *)arg;
+
+    valueset_find_sorted(state->attr, state->vs, state->lookups[state->next], NULL);
+    state->next = (state->next + 1) % state->nlookups;
+}
+
+static void
+bench_valueset_teardown(void *arg)
+{
+    bench_valueset_state *state = (bench_valueset_state *)arg;
+
+    valuearray_free(&state->lookups);
+    slapi_valueset_free(state->vs);
+    slapi_attr_free(&state->attr);
+    slapi_ch_free((void **)&state);
+}
+
+static void *
+bench_valueset_16_setup(void)
+{
+    return bench_valueset_setup(16);
+}
+
+static void *
+bench_valueset_1k_setup(void)
+{
+    return bench_valueset_setup(1000);
+}
+
+static void *
+bench_valueset_100k_setup(void)
+{
+    return bench_valueset_setup(100000);
+}
+
+const bench_case bench_valueset_cases[] = {
+    {"valueset_find_sorted/16", bench_valueset_16_setup, bench_valueset_run, bench_valueset_teardown},
+    {"valueset_find_sorted/1000", bench_valueset_1k_setup, bench_valueset_run, bench_valueset_teardown},
+    {"valueset_find_sorted/100000", bench_valueset_100k_setup, bench_valueset_run, bench_valueset_teardown},
+    {NULL, NULL, NULL, NULL}};
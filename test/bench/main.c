@@ -0,0 +1,197 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+/*
+ * Microbenchmarks of the libslapd hot path primitives.
+ *
+ * usage: bench_slapd [-t <msec>] [-c] [<pattern> ...]
+ *   -t  minimum measurement time of a case, default 1000ms
+ *   -c  CSV output
+ *   <pattern> only run the cases whose name contains one of the patterns
+ *
+ * Every case is run until it reaches the minimum time, doubling the number
+ * of iterations, then reports the time and the heap allocations (count and
+ * bytes requested) per operation. The allocations are counted by wrapping
+ * the glibc allocator, so they include the ones not done by slapi_ch_*.
+ */
+
+#include "bench.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+
+static uint64_t bench_allocs = 0;
+static uint64_t bench_alloc_bytes = 0;
+
+void *
+malloc(size_t size)
+{
+    bench_allocs++;
+    bench_alloc_bytes += size;
+    return __libc_malloc(size);
+}
+
+void *
+calloc(size_t nmemb, size_t size)
+{
+    bench_allocs++;
+    bench_alloc_bytes += nmemb * size;
+    return __libc_calloc(nmemb, size);
+}
+
+void *
+realloc(void *ptr, size_t size)
+{
+    bench_allocs++;
+    bench_alloc_bytes += size;
+    return __libc_realloc(ptr, size);
+}
+
+int
+posix_memalign(void **memptr, size_t alignment, size_t size)
+{
+    void *p = NULL;
+
+    bench_allocs++;
+    bench_alloc_bytes += size;
+    if ((p = __libc_memalign(alignment, size)) == NULL) {
+        return ENOMEM;
+    }
+    *memptr = p;
+    return 0;
+}
+
+static const bench_case *bench_suites[] = {
+    bench_dn_cases,
+    bench_entry_cases,
+    bench_filter_cases,
+    bench_valueset_cases,
+    bench_syntax_cases,
+    bench_idl_cases,
+    NULL};
+
+static uint64_t
+bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int
+bench_selected(const char *name, char **patterns, int npatterns)
+{
+    if (npatterns == 0) {
+        return 1;
+    }
+    for (int i = 0; i < npatterns; i++) {
+        if (strstr(name, patterns[i])) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void
+bench_run_case(const bench_case *bc, uint64_t min_ns, int csv)
+{
+    void *state = NULL;
+    uint64_t iterations = 1;
+    uint64_t elapsed = 0;
+    uint64_t allocs = 0;
+    uint64_t bytes = 0;
+
+    if (bc->setup && (state = bc->setup()) == NULL) {
+        fprintf(stderr, "%s: skipped, setup failed\n", bc->name);
+        return;
+    }
+
+    /* Warm up the caches and the lazy initialisations */
+    bc->run(state);
+
+    for (;;) {
+        uint64_t start_allocs = bench_allocs;
+        uint64_t start_bytes = bench_alloc_bytes;
+        uint64_t start = bench_now_ns();
+
+        for (uint64_t i = 0; i < iterations; i++) {
+            bc->run(state);
+        }
+        elapsed = bench_now_ns() - start;
+        allocs = bench_allocs - start_allocs;
+        bytes = bench_alloc_bytes - start_bytes;
+        if (elapsed >= min_ns || iterations >= (1ULL << 40)) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    if (csv) {
+        printf("%s,%" PRIu64 ",%.1f,%.2f,%.1f\n", bc->name, iterations,
+               (double)elapsed / iterations, (double)allocs / iterations,
+               (double)bytes / iterations);
+    } else {
+        printf("%-48s %12" PRIu64 " %12.1f %10.2f %10.1f\n", bc->name, iterations,
+               (double)elapsed / iterations, (double)allocs / iterations,
+               (double)bytes / iterations);
+    }
+    fflush(stdout);
+
+    if (bc->teardown) {
+        bc->teardown(state);
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    uint64_t min_ns = 1000000000ULL;
+    int csv = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:c")) != -1) {
+        switch (opt) {
+        case 't':
+            min_ns = strtoull(optarg, NULL, 10) * 1000000ULL;
+            break;
+        case 'c':
+            csv = 1;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-t <msec>] [-c] [<pattern> ...]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (csv) {
+        printf("name,iterations,ns/op,allocs/op,B/op\n");
+    } else {
+        printf("%-48s %12s %12s %10s %10s\n", "benchmark", "iterations", "ns/op", "allocs/op", "B/op");
+    }
+    for (size_t s = 0; bench_suites[s]; s++) {
+        for (const bench_case *bc = bench_suites[s]; bc->name; bc++) {
+            if (bench_selected(bc->name, argv + optind, argc - optind)) {
+                bench_run_case(bc, min_ns, csv);
+            }
+        }
+    }
+
+    PR_Cleanup();
+    return 0;
+}
@@ -0,0 +1,79 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+#include "../../test_slapd.h"
+#include <slapi-private.h>
+
+void
+test_libslapd_dn_intern(void **state __attribute__((unused)))
+{
+    Slapi_DN *suffix = slapi_sdn_new_normdn_byval("dc=example,dc=com");
+    Slapi_DN *ou = slapi_sdn_new_normdn_byval("ou=People,dc=example,dc=com");
+    Slapi_DN *user = slapi_sdn_new_normdn_byval("uid=user,ou=People,dc=example,dc=com");
+    Slapi_DN *other = slapi_sdn_new_normdn_byval("dc=example,dc=org");
+    Slapi_DN *escaped = slapi_sdn_new_normdn_byval("cn=a\\,dc=example,dc=com");
+    Slapi_DN *empty = slapi_sdn_new_normdn_byval("");
+    Slapi_DN *copy = NULL;
+    uint64_t count = dn_intern_get_count();
+
+    /* The root DSE is not interned */
+    assert_int_equal(slapi_sdn_intern(empty), -1);
+    assert_false(slapi_sdn_is_interned(empty));
+
+    assert_int_equal(slapi_sdn_intern(user), 0);
+    assert_true(slapi_sdn_is_interned(user));
+    /* user, ou, suffix and dc=com */
+    assert_int_equal(dn_intern_get_count(), count + 4);
+    /* Interning an already interned DN does not create nodes */
+    assert_int_equal(slapi_sdn_intern(suffix), 0);
+    assert_int_equal(slapi_sdn_intern(ou), 0);
+    assert_int_equal(slapi_sdn_intern(user), 0);
+    assert_int_equal(dn_intern_get_count(), count + 4);
+    assert_int_equal(slapi_sdn_intern(other), 0);
+    assert_int_equal(slapi_sdn_intern(escaped), 0);
+    assert_int_equal(dn_intern_get_count(), count + 7);
+
+    /* The interned and the string comparisons agree */
+    assert_true(slapi_sdn_issuffix(user, suffix));
+    assert_true(slapi_sdn_issuffix(user, ou));
+    assert_true(slapi_sdn_issuffix(suffix, suffix));
+    assert_false(slapi_sdn_issuffix(suffix, user));
+    assert_false(slapi_sdn_issuffix(user, other));
+    assert_true(slapi_sdn_issuffix(user, empty));
+    assert_true(slapi_sdn_isparent(ou, user));
+    assert_false(slapi_sdn_isparent(suffix, user));
+    assert_true(slapi_sdn_isgrandparent(suffix, user));
+    assert_false(slapi_sdn_isgrandparent(ou, user));
+    assert_true(slapi_sdn_scope_test(user, suffix, LDAP_SCOPE_SUBTREE));
+    assert_true(slapi_sdn_scope_test(user, ou, LDAP_SCOPE_ONELEVEL));
+    assert_false(slapi_sdn_scope_test(user, suffix, LDAP_SCOPE_ONELEVEL));
+    assert_int_equal(slapi_sdn_compare(suffix, suffix), 0);
+    assert_int_not_equal(slapi_sdn_compare(suffix, other), 0);
+    /* The escaped comma does not separate RDNs */
+    assert_true(slapi_sdn_isparent(suffix, escaped));
+
+    /* Copies share the interned DN */
+    copy = slapi_sdn_dup(ou);
+    assert_true(slapi_sdn_is_interned(copy));
+    assert_ptr_equal(slapi_sdn_get_ndn(copy), slapi_sdn_get_ndn(ou));
+    assert_true(slapi_sdn_isparent(copy, user));
+    slapi_sdn_free(&ou);
+    assert_string_equal(slapi_sdn_get_ndn(copy), "ou=people,dc=example,dc=com");
+    assert_true(slapi_sdn_issuffix(user, copy));
+
+    /* Nodes are freed with their last reference */
+    slapi_sdn_free(&escaped);
+    slapi_sdn_free(&other);
+    assert_int_equal(dn_intern_get_count(), count + 4);
+    slapi_sdn_free(&suffix);
+    slapi_sdn_free(&copy);
+    assert_int_equal(dn_intern_get_count(), count + 4);
+    slapi_sdn_free(&user);
+    assert_int_equal(dn_intern_get_count(), count);
+    slapi_sdn_free(&empty);
+}
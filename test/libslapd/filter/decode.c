@@ -0,0 +1,67 @@
+/** BEGIN COPYRIGHT BLOCK
+ * Copyright (C) 2026 Red Hat, Inc.
+ * All rights reserved.
+ *
+ * License: GPL (version 3 or any later version).
+ * See LICENSE for details.
+ * END COPYRIGHT BLOCK **/
+
+#include "../../test_slapd.h"
+
+/* To access get_filter */
+#include <slap.h>
+#include <proto-slap.h>
+
+static BerElement *
+test_filter_ber(struct berval **bvp)
+{
+    BerElement *ber = ber_alloc_t(LBER_USE_DER);
+
+    assert_non_null(ber);
+    /* (&(cn=Foo)(sn=*)(uid=ab*cd*ef)(uidnumber>=10)) */
+    assert_true(ber_printf(ber, "t{", LDAP_FILTER_AND) >= 0);
+    assert_true(ber_printf(ber, "t{ss}", LDAP_FILTER_EQUALITY, "cn", "Foo") >= 0);
+    assert_true(ber_printf(ber, "ts", LDAP_FILTER_PRESENT, "sn") >= 0);
+    assert_true(ber_printf(ber, "t{s{tststs}}", LDAP_FILTER_SUBSTRINGS, "uid",
+                           LDAP_SUBSTRING_INITIAL, "ab", LDAP_SUBSTRING_ANY, "cd",
+                           LDAP_SUBSTRING_FINAL, "ef") >= 0);
+    assert_true(ber_printf(ber, "t{ss}", LDAP_FILTER_GE, "uidnumber", "10") >= 0);
+    assert_true(ber_printf(ber, "}") >= 0);
+    assert_int_equal(ber_flatten(ber, bvp), 0);
+    ber_free(ber, 1);
+
+    return ber_init(*bvp);
+}
+
+void
+test_libslapd_filter_decode(void **state __attribute__((unused)))
+{
+    struct slapi_filter *filter = NULL;
+    struct slapi_filter *f = NULL;
+    struct berval *bvp = NULL;
+    BerElement *ber = test_filter_ber(&bvp);
+    char *fstr = NULL;
+
+    assert_non_null(ber);
+    /* The types are read in place, they must still be terminated correctly */
+    assert_int_equal(get_filter(NULL, ber, LDAP_SCOPE_SUBTREE, &filter, &fstr), 0);
+    assert_string_equal(fstr, "(&(cn=Foo)(sn=*)(uid=ab*cd*ef)(uidnumber>=10))");
+
+    f = filter->f_and;
+    assert_string_equal(f->f_avtype, "cn");
+    assert_string_equal(f->f_avvalue.bv_val, "Foo");
+    f = f->f_next;
+    assert_string_equal(f->f_type, "sn");
+    f = f->f_next;
+    assert_string_equal(f->f_sub_type, "uid");
+    assert_string_equal(f->f_sub_initial, "ab");
+    assert_string_equal(f->f_sub_final, "ef");
+    f = f->f_next;
+    assert_string_equal(f->f_avtype, "uidnumber");
+    assert_null(f->f_next);
+
+    slapi_filter_free(filter, 1);
+    slapi_ch_free_string(&fstr);
+    ber_free(ber, 1);
+    ber_bvfree(bvp);
+}
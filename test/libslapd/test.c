@@ -31,8 +31,10 @@ run_libslapd_tests(void)
         cmocka_unit_test(test_libslapd_counters_atomic_usage),
         cmocka_unit_test(test_libslapd_counters_atomic_overflow),
         cmocka_unit_test(test_libslapd_filter_optimise),
+        cmocka_unit_test(test_libslapd_filter_decode),
         cmocka_unit_test(test_libslapd_pal_meminfo),
         cmocka_unit_test(test_libslapd_util_cachesane),
+        cmocka_unit_test(test_libslapd_dn_intern),
         cmocka_unit_test(test_libslapd_haproxy_v1),
         cmocka_unit_test(test_libslapd_haproxy_v2_valid),
         cmocka_unit_test(test_libslapd_haproxy_v2_valid_local),
@@ -30,6 +30,9 @@ void test_libslapd_hello(void **state);
 /* libslapd-filter-optimise */
 void test_libslapd_filter_optimise(void **state);
 
+/* libslapd-filter-decode */
+void test_libslapd_filter_decode(void **state);
+
 /* libslapd-pblock-analytics */
 void test_libslapd_pblock_analytics(void **state);
 
@@ -55,6 +58,9 @@ void test_libslapd_counters_atomic_overflow(void **state);
 void test_libslapd_pal_meminfo(void **state);
 void test_libslapd_util_cachesane(void **state);
 
+/* libslapd-dn-intern */
+void test_libslapd_dn_intern(void **state);
+
 /* libslapd-haproxy */
 void test_libslapd_haproxy_v1(void **state);
 void test_libslapd_haproxy_v2_valid(void **state);